@@ -20,6 +20,9 @@
 #include "BELogChannels.h"
 #include "Character/BEPawnMeshAssistInterface.h"
 #include "GameplayTag/BETags_Flag.h"
+#include "Performance/BEInputLatencyStats.h"
+
+#include "AbilitySystemBlueprintLibrary.h"
 
 #include "Abilities/GameplayAbility.h"
 #include "Abilities/GameplayAbilityTargetTypes.h"
@@ -32,7 +35,10 @@
 #include "GameplayEffect.h"
 #include "GameplayEffectTypes.h"
 #include "GameplayTagContainer.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
 #include "HAL/PlatformMath.h"
+#include "HAL/PlatformTime.h"
 #include "HAL/UnrealMemory.h"
 #include "Logging/LogCategory.h"
 #include "Logging/LogMacros.h"
@@ -49,6 +55,43 @@
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(BEAbilitySystemComponent)
 
+namespace BEAbilitySystemComponentCommands
+{
+	static void SimulateInputPress(const TArray<FString>& Args, UWorld* World)
+	{
+		if ((World == nullptr) || (Args.Num() < 1))
+		{
+			return;
+		}
+
+		const FGameplayTag InputTag = FGameplayTag::RequestGameplayTag(FName(*Args[0]), /*ErrorIfNotFound=*/ false);
+		if (!InputTag.IsValid())
+		{
+			UE_LOG(LogBEAbilitySystem, Warning, TEXT("BE.InputLatency.SimulatePress: [%s] is not a gameplay tag"), *Args[0]);
+			return;
+		}
+
+		for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+		{
+			const APlayerController* PC = It->Get();
+			if (PC && PC->IsLocalController())
+			{
+				if (UBEAbilitySystemComponent* ASC = Cast<UBEAbilitySystemComponent>(UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(PC->GetPawn())))
+				{
+					// A tap, processed together in the next ProcessAbilityInput
+					ASC->AbilityInputTagPressed(InputTag);
+					ASC->AbilityInputTagReleased(InputTag);
+				}
+			}
+		}
+	}
+
+	static FAutoConsoleCommand CmdSimulateInputPress(
+		TEXT("BE.InputLatency.SimulatePress"),
+		TEXT("Taps an ability input tag on every local player's pawn, so input latency can be measured without hardware input (e.g. on headless clients). Usage: BE.InputLatency.SimulatePress <InputTag>"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(SimulateInputPress));
+}
+
 
 UBEAbilitySystemComponent::UBEAbilitySystemComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -222,12 +265,20 @@ void UBEAbilitySystemComponent::AbilityInputTagPressed(const FGameplayTag& Input
 {
 	if (InputTag.IsValid())
 	{
+		const FBEInputLatencyStamp InputStamp = FBEInputLatencyStamp::Make();
+
 		for (const FGameplayAbilitySpec& AbilitySpec : ActivatableAbilities.Items)
 		{
 			if (AbilitySpec.Ability && (AbilitySpec.DynamicAbilityTags.HasTagExact(InputTag)))
 			{
 				InputPressedSpecHandles.AddUnique(AbilitySpec.Handle);
 				InputHeldSpecHandles.AddUnique(AbilitySpec.Handle);
+
+				// Keep the first press of the frame
+				if (!InputPressedStamps.Contains(AbilitySpec.Handle))
+				{
+					InputPressedStamps.Add(AbilitySpec.Handle, InputStamp);
+				}
 			}
 		}
 	}
@@ -316,7 +367,10 @@ void UBEAbilitySystemComponent::ProcessAbilityInput(float DeltaTime, bool bGameP
 	//
 	for (const FGameplayAbilitySpecHandle& AbilitySpecHandle : AbilitiesToActivate)
 	{
+		// Picked up by NotifyAbilityActivated to measure the input latency
+		ActivatingInputStamp = InputPressedStamps.FindRef(AbilitySpecHandle);
 		TryActivateAbility(AbilitySpecHandle);
+		ActivatingInputStamp = FBEInputLatencyStamp();
 	}
 
 	//
@@ -344,6 +398,7 @@ void UBEAbilitySystemComponent::ProcessAbilityInput(float DeltaTime, bool bGameP
 	//
 	InputPressedSpecHandles.Reset();
 	InputReleasedSpecHandles.Reset();
+	InputPressedStamps.Reset();
 }
 
 void UBEAbilitySystemComponent::ClearAbilityInput()
@@ -351,6 +406,7 @@ void UBEAbilitySystemComponent::ClearAbilityInput()
 	InputPressedSpecHandles.Reset();
 	InputReleasedSpecHandles.Reset();
 	InputHeldSpecHandles.Reset();
+	InputPressedStamps.Reset();
 }
 
 void UBEAbilitySystemComponent::NotifyAbilityActivated(const FGameplayAbilitySpecHandle Handle, UGameplayAbility* Ability)
@@ -360,6 +416,50 @@ void UBEAbilitySystemComponent::NotifyAbilityActivated(const FGameplayAbilitySpe
 	UBEGameplayAbility* BEAbility = CastChecked<UBEGameplayAbility>(Ability);
 
 	AddAbilityToActivationGroup(BEAbility->GetActivationGroup(), BEAbility);
+
+	if (ActivatingInputStamp.IsValid())
+	{
+		const double ActivateTime = FPlatformTime::Seconds();
+		FBEInputLatencyStats::Get().AddSample(EBEInputLatencyStage::InputToActivate, ActivatingInputStamp, ActivateTime - ActivatingInputStamp.Time);
+
+		// Predicted activations are confirmed once the server catches up with their prediction key
+		const FGameplayAbilitySpec* Spec = FindAbilitySpecFromHandle(Handle);
+		const FGameplayAbilityActivationInfo ActivationInfo = (Ability->IsInstantiated() || !Spec) ? Ability->GetCurrentActivationInfo() : Spec->ActivationInfo;
+		const FPredictionKey PredictionKey = ActivationInfo.GetActivationPredictionKey();
+
+		if (!IsOwnerActorAuthoritative() && PredictionKey.IsValidKey())
+		{
+			// Drop confirmations that never came (e.g. the connection was lost)
+			for (auto It = PendingServerConfirms.CreateIterator(); It; ++It)
+			{
+				if ((ActivateTime - It.Value().ActivateTime) > 10.0)
+				{
+					It.RemoveCurrent();
+				}
+			}
+
+			PendingServerConfirms.Add(PredictionKey.Current, { ActivatingInputStamp, ActivateTime });
+			FPredictionKeyDelegates::NewCaughtUpDelegate(PredictionKey.Current).BindUObject(this, &ThisClass::HandleInputPredictionCaughtUp, PredictionKey.Current);
+			FPredictionKeyDelegates::NewRejectedDelegate(PredictionKey.Current).BindUObject(this, &ThisClass::HandleInputPredictionRejected, PredictionKey.Current);
+		}
+
+		// Only measure the first ability the press activates
+		ActivatingInputStamp = FBEInputLatencyStamp();
+	}
+}
+
+void UBEAbilitySystemComponent::HandleInputPredictionCaughtUp(FPredictionKey::KeyType PredictionKey)
+{
+	FPendingServerConfirm PendingConfirm;
+	if (PendingServerConfirms.RemoveAndCopyValue(PredictionKey, PendingConfirm))
+	{
+		FBEInputLatencyStats::Get().AddSample(EBEInputLatencyStage::ActivateToServerConfirm, PendingConfirm.Stamp, FPlatformTime::Seconds() - PendingConfirm.ActivateTime);
+	}
+}
+
+void UBEAbilitySystemComponent::HandleInputPredictionRejected(FPredictionKey::KeyType PredictionKey)
+{
+	PendingServerConfirms.Remove(PredictionKey);
 }
 
 void UBEAbilitySystemComponent::NotifyAbilityFailed(const FGameplayAbilitySpecHandle Handle, UGameplayAbility* Ability, const FGameplayTagContainer& FailureReason)
@@ -6,6 +6,7 @@
 #include "AbilitySystemComponent.h"
 
 #include "Ability/BEGameplayAbility.h"
+#include "Performance/BEInputLatencyStats.h"
 
 #include "Containers/Array.h"
 #include "Engine/EngineTypes.h"
@@ -76,6 +77,9 @@ public:
 	/** Looks at ability tags and gathers additional required and blocking tags */
 	void GetAdditionalActivationTagRequirements(const FGameplayTagContainer& AbilityTags, FGameplayTagContainer& OutActivationRequired, FGameplayTagContainer& OutActivationBlocked) const;
 
+	/** Abilities key the activation tags they expanded on the mapping and its version */
+	const UBEAbilityTagRelationshipMapping* GetTagRelationshipMapping() const { return TagRelationshipMapping; }
+
 protected:
 
 	void TryActivateAbilitiesOnSpawn();
@@ -94,6 +98,9 @@ protected:
 	void ClientNotifyAbilityFailed(const UGameplayAbility* Ability, const FGameplayTagContainer& FailureReason);
 
 	void HandleAbilityFailed(const UGameplayAbility* Ability, const FGameplayTagContainer& FailureReason);
+
+	void HandleInputPredictionCaughtUp(FPredictionKey::KeyType PredictionKey);
+	void HandleInputPredictionRejected(FPredictionKey::KeyType PredictionKey);
 protected:
 
 	// If set, this table is used to look up tag relationships for activate and cancel
@@ -109,6 +116,21 @@ protected:
 	// Handles to abilities that have their input held.
 	TArray<FGameplayAbilitySpecHandle> InputHeldSpecHandles;
 
+	// Input latency stamps of the abilities that had their input pressed this frame.
+	TMap<FGameplayAbilitySpecHandle, FBEInputLatencyStamp> InputPressedStamps;
+
+	// Stamp of the input press that is activating an ability right now, see ProcessAbilityInput.
+	FBEInputLatencyStamp ActivatingInputStamp;
+
+	struct FPendingServerConfirm
+	{
+		FBEInputLatencyStamp Stamp;
+		double ActivateTime = 0.0;
+	};
+
+	// Predicted activations from input presses waiting for the server to catch up with their prediction key.
+	TMap<FPredictionKey::KeyType, FPendingServerConfirm> PendingServerConfirms;
+
 	// Number of abilities running in each activation group.
 	int32 ActivationGroupCounts[(uint8)EBEAbilityActivationGroup::MAX];
 };
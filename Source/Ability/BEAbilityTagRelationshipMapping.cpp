@@ -48,6 +48,15 @@ void UBEAbilityTagRelationshipMapping::GetRequiredAndBlockedActivationTags(const
 	}
 }
 
+#if WITH_EDITOR
+void UBEAbilityTagRelationshipMapping::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	Version.fetch_add(1, std::memory_order_relaxed);
+}
+#endif
+
 bool UBEAbilityTagRelationshipMapping::IsAbilityCancelledByTag(const FGameplayTagContainer& AbilityTags, const FGameplayTag& ActionTag) const
 {
 	// Simple iteration for now
@@ -9,6 +9,8 @@
 #include "GameplayTagContainer.h"
 #include "UObject/UObjectGlobals.h"
 
+#include <atomic>
+
 #include "BEAbilityTagRelationshipMapping.generated.h"
 
 class UObject;
@@ -62,4 +64,14 @@ public:
 
 	/** Returns true if the specified ability tags are canceled by the passed in action tag */
 	bool IsAbilityCancelledByTag(const FGameplayTagContainer& AbilityTags, const FGameplayTag& ActionTag) const;
+
+	/** Changes whenever the relationships are edited, abilities key the activation tags they expanded through this mapping on it */
+	uint32 GetVersion() const { return Version.load(std::memory_order_relaxed); }
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+private:
+	std::atomic<uint32> Version{ 0 };
 };
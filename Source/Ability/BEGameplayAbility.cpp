@@ -6,6 +6,7 @@
 #include "Ability/BEAbilitySimpleFailureMessage.h"
 #include "Ability/Cost/BEAbilityCost.h"
 #include "Ability/BEAbilitySystemComponent.h"
+#include "Ability/BEAbilityTagRelationshipMapping.h"
 #include "Ability/BEAbilitySourceInterface.h"
 #include "Ability/BEGameplayEffectContext.h"
 #include "Player/BEPlayerController.h"
@@ -21,14 +22,76 @@
 #include "AbilitySystemLog.h"
 #include "AbilitySystemBlueprintLibrary.h"
 #include "AbilitySystemGlobals.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
 #include "HAL/PlatformStackWalk.h"
 #include "HAL/PlatformStackWalk.h"
+#include "HAL/PlatformTime.h"
 #include "GameFramework/GameplayMessageSubsystem.h"
 #include "GameFramework/PlayerState.h"
 #include "Physics/PhysicalMaterialWithTags.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(BEGameplayAbility)
 
+namespace BEGameplayAbilityCommands
+{
+	static void BenchmarkTagRequirements(const TArray<FString>& Args, UWorld* World)
+	{
+		if (World == nullptr)
+		{
+			return;
+		}
+
+		const int32 NumChecks = FMath::Clamp(Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 1000, 1, 1000000);
+
+		for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+		{
+			const APlayerController* PC = It->Get();
+			const UAbilitySystemComponent* ASC = PC ? UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(PC->GetPawn()) : nullptr;
+			if (!ASC || !PC->IsLocalController())
+			{
+				continue;
+			}
+
+			TArray<const UGameplayAbility*> Abilities;
+			for (const FGameplayAbilitySpec& Spec : ASC->GetActivatableAbilities())
+			{
+				const UGameplayAbility* Ability = Spec.GetPrimaryInstance() ? Spec.GetPrimaryInstance() : Spec.Ability.Get();
+				if (Ability)
+				{
+					Abilities.Add(Ability);
+				}
+			}
+
+			if (Abilities.IsEmpty())
+			{
+				continue;
+			}
+
+			int32 NumSatisfied = 0;
+			const double StartTime = FPlatformTime::Seconds();
+
+			for (int32 CheckIndex = 0; CheckIndex < NumChecks; ++CheckIndex)
+			{
+				if (Abilities[CheckIndex % Abilities.Num()]->DoesAbilitySatisfyTagRequirements(*ASC, nullptr, nullptr, nullptr))
+				{
+					++NumSatisfied;
+				}
+			}
+
+			const double ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+
+			UE_LOG(LogBEAbilitySystem, Display, TEXT("%s: %d activation tag checks over %d abilities in %.3f ms (%.3f us per check, %d satisfied)"),
+				*GetNameSafe(ASC->GetOwner()), NumChecks, Abilities.Num(), ElapsedSeconds * 1000.0, ElapsedSeconds * 1000000.0 / NumChecks, NumSatisfied);
+		}
+	}
+
+	static FAutoConsoleCommand CmdBenchmarkTagRequirements(
+		TEXT("BE.Ability.BenchmarkTagRequirements"),
+		TEXT("Runs activation tag requirement checks over the abilities of every local player's pawn and logs how long they took. Usage: BE.Ability.BenchmarkTagRequirements [NumChecks=1000]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(BenchmarkTagRequirements));
+}
+
 #define ENSURE_ABILITY_IS_INSTANTIATED_OR_RETURN(FunctionName, ReturnValue)																				\
 {																																						\
 	if (!ensure(IsInstantiated()))																														\
@@ -361,30 +424,18 @@ bool UBEGameplayAbility::DoesAbilitySatisfyTagRequirements(const UAbilitySystemC
 		bBlocked = true;
 	}
 
+	// Expand our ability tags to add additional required/blocked tags, cached per tag relationship mapping
 	const UBEAbilitySystemComponent* BEASC = Cast<UBEAbilitySystemComponent>(&AbilitySystemComponent);
-	static FGameplayTagContainer AllRequiredTags;
-	static FGameplayTagContainer AllBlockedTags;
+	const UBEAbilityTagRelationshipMapping* Mapping = BEASC ? BEASC->GetTagRelationshipMapping() : nullptr;
+	const TObjectKey<UBEAbilityTagRelationshipMapping> MappingKey(Mapping);
+	const uint32 MappingVersion = Mapping ? Mapping->GetVersion() : 0;
 
-	AllRequiredTags = ActivationRequiredTags;
-	AllBlockedTags = ActivationBlockedTags;
-
-	// Expand our ability tags to add additional required/blocked tags
-	if (BEASC)
+	// Check to see the required/blocked tags for this ability, straight against the tag counts of the ASC
+	auto CheckActivationTagRequirements = [&](const FActivationTagRequirements& Requirements)
 	{
-		BEASC->GetAdditionalActivationTagRequirements(AbilityTags, AllRequiredTags, AllBlockedTags);
-	}
-
-	// Check to see the required/blocked tags for this ability
-	if (AllBlockedTags.Num() || AllRequiredTags.Num())
-	{
-		static FGameplayTagContainer AbilitySystemComponentTags;
-		
-		AbilitySystemComponentTags.Reset();
-		AbilitySystemComponent.GetOwnedGameplayTags(AbilitySystemComponentTags);
-
-		if (AbilitySystemComponentTags.HasAny(AllBlockedTags))
+		if (Requirements.BlockedTags.Num() && AbilitySystemComponent.HasAnyMatchingGameplayTags(Requirements.BlockedTags))
 		{
-			if (OptionalRelevantTags && AbilitySystemComponentTags.HasTag(TAG_Status_Death))
+			if (OptionalRelevantTags && AbilitySystemComponent.HasMatchingGameplayTag(TAG_Status_Death))
 			{
 				// If player is dead and was rejected due to blocking tags, give that feedback
 				OptionalRelevantTags->AddTag(TAG_Ability_ActivateFail_IsDead);
@@ -393,10 +444,46 @@ bool UBEGameplayAbility::DoesAbilitySatisfyTagRequirements(const UAbilitySystemC
 			bBlocked = true;
 		}
 
-		if (!AbilitySystemComponentTags.HasAll(AllRequiredTags))
+		if (Requirements.RequiredTags.Num() && !AbilitySystemComponent.HasAllMatchingGameplayTags(Requirements.RequiredTags))
 		{
 			bMissing = true;
 		}
+	};
+
+	bool bUsedCachedRequirements = false;
+	{
+		FReadScopeLock ReadLock(ActivationTagRequirementsLock);
+
+		for (const FActivationTagRequirements& Requirements : CachedActivationTagRequirements)
+		{
+			if ((Requirements.Mapping == MappingKey) && (Requirements.MappingVersion == MappingVersion))
+			{
+				CheckActivationTagRequirements(Requirements);
+				bUsedCachedRequirements = true;
+				break;
+			}
+		}
+	}
+
+	if (!bUsedCachedRequirements)
+	{
+		FActivationTagRequirements NewRequirements;
+		NewRequirements.RequiredTags = ActivationRequiredTags;
+		NewRequirements.BlockedTags = ActivationBlockedTags;
+		NewRequirements.Mapping = MappingKey;
+		NewRequirements.MappingVersion = MappingVersion;
+
+		if (BEASC)
+		{
+			BEASC->GetAdditionalActivationTagRequirements(AbilityTags, NewRequirements.RequiredTags, NewRequirements.BlockedTags);
+		}
+
+		CheckActivationTagRequirements(NewRequirements);
+
+		// Replaces the entry of an older version of the mapping
+		FWriteScopeLock WriteLock(ActivationTagRequirementsLock);
+		CachedActivationTagRequirements.RemoveAllSwap([&MappingKey](const FActivationTagRequirements& Requirements) { return Requirements.Mapping == MappingKey; });
+		CachedActivationTagRequirements.Add(MoveTemp(NewRequirements));
 	}
 
 	if (SourceTags != nullptr)
@@ -451,6 +538,16 @@ bool UBEGameplayAbility::DoesAbilitySatisfyTagRequirements(const UAbilitySystemC
 	return true;
 }
 
+#if WITH_EDITOR
+void UBEGameplayAbility::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	FWriteScopeLock WriteLock(ActivationTagRequirementsLock);
+	CachedActivationTagRequirements.Reset();
+}
+#endif
+
 void UBEGameplayAbility::OnPawnAvatarSet()
 {
 	K2_OnPawnAvatarSet();
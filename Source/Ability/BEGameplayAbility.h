@@ -12,6 +12,7 @@
 #include "GameplayEffectTypes.h"
 #include "GameplayTagContainer.h"
 #include "Templates/SubclassOf.h"
+#include "UObject/ObjectKey.h"
 #include "UObject/ObjectPtr.h"
 #include "UObject/UObjectGlobals.h"
 
@@ -27,6 +28,7 @@ class IBEAbilitySourceInterface;
 class UAnimMontage;
 class UBEAbilityCost;
 class UBEAbilitySystemComponent;
+class UBEAbilityTagRelationshipMapping;
 class UBECameraMode;
 class UBEPawnCameraComponent;
 class UObject;
@@ -200,4 +202,26 @@ protected:
 
 	// Current camera mode set by the ability.
 	TSubclassOf<UBECameraMode> ActiveCameraMode;
+
+private:
+	// Activation required/blocked tags expanded through a tag relationship mapping
+	struct FActivationTagRequirements
+	{
+		FGameplayTagContainer RequiredTags;
+		FGameplayTagContainer BlockedTags;
+
+		// Mapping the tags were expanded with (null for owners without one) and its UBEAbilityTagRelationshipMapping::GetVersion
+		TObjectKey<UBEAbilityTagRelationshipMapping> Mapping;
+		uint32 MappingVersion = 0;
+	};
+
+	// One entry per mapping, built on the first activation check against it. Non-instanced abilities are shared by every owner,
+	// which usually share a handful of mappings. Guarded by a lock so activation checks can be made off the game thread.
+	mutable TArray<FActivationTagRequirements, TInlineAllocator<2>> CachedActivationTagRequirements;
+	mutable FRWLock ActivationTagRequirementsLock;
+
+public:
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
 };
@@ -10,6 +10,7 @@
 #include "AbilitySystemGlobals.h"
 #include "HAL/IConsoleManager.h"
 #include "GameplayTagsManager.h"
+#include "UObject/UObjectHash.h"
 #include "UObject/UObjectThreadContext.h"
 #include "Async/Async.h"
 #include "Algo/Transform.h"
@@ -40,7 +41,39 @@ namespace BEGameplayCueManagerCvars
 		TEXT("Shows all assets that were loaded via BEGameplayCueManager and are currently in memory."),
 		FConsoleCommandWithArgsDelegate::CreateStatic(UBEGameplayCueManager::DumpGameplayCues));
 
-	static EBEEditorLoadMode LoadMode = EBEEditorLoadMode::LoadUpfront;
+	// Preload sets and eviction of preloaded cues only run in the preload modes
+	static int32 LoadMode = static_cast<int32>(EBEEditorLoadMode::PreloadAsCuesAreReferenced);
+	static FAutoConsoleVariableRef CVarLoadMode(
+		TEXT("BE.GameplayCue.LoadMode"),
+		LoadMode,
+		TEXT("How gameplay cues are loaded. 0: everything up front, 1: preload as cues are referenced outside of the editor, 2: preload as cues are referenced. Read when the cue manager is created, set it in an ini file."),
+		ECVF_ReadOnly);
+
+	static EBEEditorLoadMode GetLoadMode()
+	{
+		return static_cast<EBEEditorLoadMode>(FMath::Clamp(LoadMode, 0, static_cast<int32>(EBEEditorLoadMode::PreloadAsCuesAreReferenced)));
+	}
+
+	static float PreloadedCueBudgetMB = 0.0f;
+	static FAutoConsoleVariableRef CVarPreloadedCueBudgetMB(
+		TEXT("BE.GameplayCue.PreloadedCueBudgetMB"),
+		PreloadedCueBudgetMB,
+		TEXT("Estimated memory budget (in MB) for preloaded gameplay cues. When over budget, cues that have not been used recently are evicted. 0 disables eviction."),
+		ECVF_Default);
+
+	static float EvictAfterUnusedSeconds = 120.0f;
+	static FAutoConsoleVariableRef CVarEvictAfterUnusedSeconds(
+		TEXT("BE.GameplayCue.EvictAfterUnusedSeconds"),
+		EvictAfterUnusedSeconds,
+		TEXT("Preloaded gameplay cues that have not been used for at least this many seconds may be evicted when over BE.GameplayCue.PreloadedCueBudgetMB."),
+		ECVF_Default);
+
+	static float EvictionIntervalSeconds = 10.0f;
+	static FAutoConsoleVariableRef CVarEvictionIntervalSeconds(
+		TEXT("BE.GameplayCue.EvictionIntervalSeconds"),
+		EvictionIntervalSeconds,
+		TEXT("How often (in seconds) preloaded gameplay cues are checked against the memory budget. Takes effect when the cue manager is created."),
+		ECVF_Default);
 }
 
 const bool bPreloadEvenInEditor = true;
@@ -98,9 +131,83 @@ void UBEGameplayCueManager::LoadAlwaysLoadedCues()
 	}
 }
 
+TSharedPtr<FStreamableHandle> UBEGameplayCueManager::PreloadGameplayCueSet(const FGameplayTagContainer& CueTags, const UObject* OwningObject)
+{
+	// Dedicated servers don't play cues, and in the upfront mode everything is being loaded anyway
+	if (!ShouldDelayLoadGameplayCues() || CueTags.IsEmpty())
+	{
+		return nullptr;
+	}
+
+	switch (BEGameplayCueManagerCvars::GetLoadMode())
+	{
+	case EBEEditorLoadMode::LoadUpfront:
+		return nullptr;
+	case EBEEditorLoadMode::PreloadAsCuesAreReferenced_GameOnly:
+#if WITH_EDITOR
+		if (GIsEditor)
+		{
+			return nullptr;
+		}
+#endif
+		break;
+	case EBEEditorLoadMode::PreloadAsCuesAreReferenced:
+		break;
+	}
+
+	if (!RuntimeGameplayCueObjectLibrary.CueSet)
+	{
+		UE_LOG(LogBE, Warning, TEXT("UBEGameplayCueManager::PreloadGameplayCueSet called for %s but RuntimeGameplayCueObjectLibrary.CueSet was null. Skipping preload."), *GetPathNameSafe(OwningObject));
+		return nullptr;
+	}
+
+	// The owner is only used as a referencer key
+	UObject* MutableOwningObject = const_cast<UObject*>(OwningObject);
+
+	TArray<FSoftObjectPath> PathsToLoad;
+	for (const FGameplayTag& CueTag : CueTags)
+	{
+		int32* DataIdx = RuntimeGameplayCueObjectLibrary.CueSet->GameplayCueDataMap.Find(CueTag);
+		if (DataIdx && RuntimeGameplayCueObjectLibrary.CueSet->GameplayCueData.IsValidIndex(*DataIdx))
+		{
+			const FGameplayCueNotifyData& CueData = RuntimeGameplayCueObjectLibrary.CueSet->GameplayCueData[*DataIdx];
+
+			if (UClass* LoadedGameplayCueClass = FindObject<UClass>(nullptr, *CueData.GameplayCueNotifyObj.ToString()))
+			{
+				RegisterPreloadedCue(LoadedGameplayCueClass, MutableOwningObject);
+			}
+			else
+			{
+				PathsToLoad.AddUnique(CueData.GameplayCueNotifyObj);
+			}
+		}
+		else
+		{
+			UE_LOG(LogBE, Warning, TEXT("Gameplay cue preload set of %s contains tag %s which has no gameplay cue notify"), *GetPathNameSafe(OwningObject), *CueTag.ToString());
+		}
+	}
+
+	if (PathsToLoad.Num() == 0)
+	{
+		return nullptr;
+	}
+
+	// Loaded through the asset manager's streamable manager so callers can combine the handle with their own loads
+	TWeakObjectPtr<UObject> WeakOwner = MutableOwningObject;
+	return UAssetManager::GetStreamableManager().RequestAsyncLoad(PathsToLoad, FStreamableDelegate::CreateUObject(this, &ThisClass::OnPreloadCueSetComplete, PathsToLoad, WeakOwner), FStreamableManager::AsyncLoadHighPriority, false, false, TEXT("GameplayCuePreloadSet"));
+}
+
+void UBEGameplayCueManager::OnPreloadCueSetComplete(TArray<FSoftObjectPath> Paths, TWeakObjectPtr<UObject> OwningObject)
+{
+	for (const FSoftObjectPath& Path : Paths)
+	{
+		OnPreloadCueComplete(Path, OwningObject, /*bAlwaysLoadedCue=*/ false);
+	}
+}
+
 bool UBEGameplayCueManager::ShouldAsyncLoadRuntimeObjectLibraries() const
 {
-	switch (BEGameplayCueManagerCvars::LoadMode)
+	switch (BEGameplayCueManagerCvars::GetLoadMode())
 	{
 	case EBEEditorLoadMode::LoadUpfront:
 		return true;
@@ -129,6 +236,42 @@ bool UBEGameplayCueManager::ShouldAsyncLoadMissingGameplayCues() const
 	return true;
 }
 
+void UBEGameplayCueManager::HandleGameplayCue(AActor* TargetActor, FGameplayTag GameplayCueTag, EGameplayCueEvent::Type EventType, const FGameplayCueParameters& Parameters, EGameplayCueExecutionOptions Options)
+{
+	if (ShouldDelayLoadGameplayCues() && RuntimeGameplayCueObjectLibrary.CueSet)
+	{
+		int32* DataIdx = RuntimeGameplayCueObjectLibrary.CueSet->GameplayCueDataMap.Find(GameplayCueTag);
+		if (DataIdx && RuntimeGameplayCueObjectLibrary.CueSet->GameplayCueData.IsValidIndex(*DataIdx))
+		{
+			const FGameplayCueNotifyData& CueData = RuntimeGameplayCueObjectLibrary.CueSet->GameplayCueData[*DataIdx];
+
+			UClass* CueClass = CueData.LoadedGameplayCueClass;
+			if (!CueClass)
+			{
+				CueClass = FindObject<UClass>(nullptr, *CueData.GameplayCueNotifyObj.ToString());
+			}
+
+			if (CueClass)
+			{
+				if (double* LastUsedTime = PreloadedCueLastUsedTime.Find(CueClass))
+				{
+					*LastUsedTime = FPlatformTime::Seconds();
+				}
+			}
+			else
+			{
+				// The cue set will start an async load, but this invocation won't play
+				++NumMissedCues;
+				++MissedCueCounts.FindOrAdd(GameplayCueTag);
+
+				UE_LOG(LogBE, Verbose, TEXT("Gameplay cue %s was invoked before it was loaded"), *GameplayCueTag.ToString());
+			}
+		}
+	}
+
+	Super::HandleGameplayCue(TargetActor, GameplayCueTag, EventType, Parameters, Options);
+}
+
 void UBEGameplayCueManager::DumpGameplayCues(const TArray<FString>& Args)
 {
 	UBEGameplayCueManager* GCM = Cast<UBEGameplayCueManager>(UAbilitySystemGlobals::Get().GetGameplayCueManager());
@@ -176,11 +319,25 @@ void UBEGameplayCueManager::DumpGameplayCues(const TArray<FString>& Args)
 		}
 	}
 
+	UE_LOG(LogBE, Log, TEXT("=========== Dumping Gameplay Cues invoked before they were loaded ==========="));
+	for (const TPair<FGameplayTag, int32>& Pair : GCM->MissedCueCounts)
+	{
+		UE_LOG(LogBE, Log, TEXT("  %s (%d misses)"), *Pair.Key.ToString(), Pair.Value);
+	}
+
+	int64 PreloadedCueBytes = 0;
+	for (UClass* CueClass : GCM->PreloadedCues)
+	{
+		PreloadedCueBytes += GCM->PreloadedCueSizes.FindRef(CueClass);
+	}
+
 	UE_LOG(LogBE, Log, TEXT("=========== Gameplay Cue Notify summary ==========="));
 	UE_LOG(LogBE, Log, TEXT("  ... %d cues in always loaded list"), GCM->AlwaysLoadedCues.Num());
 	UE_LOG(LogBE, Log, TEXT("  ... %d cues in preloaded list"), GCM->PreloadedCues.Num());
 	UE_LOG(LogBE, Log, TEXT("  ... %d cues loaded on demand"), NumMissingCuesLoaded);
 	UE_LOG(LogBE, Log, TEXT("  ... %d cues in total"), GCM->AlwaysLoadedCues.Num() + GCM->PreloadedCues.Num() + NumMissingCuesLoaded);
+	UE_LOG(LogBE, Log, TEXT("  ... %d cue invocations missed because the cue was not loaded yet"), GCM->NumMissedCues);
+	UE_LOG(LogBE, Log, TEXT("  ... %.2f MB estimated for preloaded cues (budget %.2f MB)"), PreloadedCueBytes / (1024.0 * 1024.0), BEGameplayCueManagerCvars::PreloadedCueBudgetMB);
 }
 
 void UBEGameplayCueManager::OnGameplayTagLoaded(const FGameplayTag& Tag)
@@ -257,7 +414,7 @@ void UBEGameplayCueManager::ProcessLoadedTags()
 
 void UBEGameplayCueManager::ProcessTagToPreload(const FGameplayTag& Tag, UObject* OwningObject)
 {
-	switch (BEGameplayCueManagerCvars::LoadMode)
+	switch (BEGameplayCueManagerCvars::GetLoadMode())
 	{
 	case EBEEditorLoadMode::LoadUpfront:
 		return;
@@ -315,15 +472,58 @@ void UBEGameplayCueManager::RegisterPreloadedCue(UClass* LoadedGameplayCueClass,
 		AlwaysLoadedCues.Add(LoadedGameplayCueClass);
 		PreloadedCues.Remove(LoadedGameplayCueClass);
 		PreloadedCueReferencers.Remove(LoadedGameplayCueClass);
+		PreloadedCueLastUsedTime.Remove(LoadedGameplayCueClass);
+		PreloadedCueSizes.Remove(LoadedGameplayCueClass);
 	}
 	else if ((OwningObject != LoadedGameplayCueClass) && (OwningObject != LoadedGameplayCueClass->GetDefaultObject()) && !AlwaysLoadedCues.Contains(LoadedGameplayCueClass))
 	{
 		PreloadedCues.Add(LoadedGameplayCueClass);
 		TSet<FObjectKey>& ReferencerSet = PreloadedCueReferencers.FindOrAdd(LoadedGameplayCueClass);
 		ReferencerSet.Add(OwningObject);
+
+		// Freshly loaded cues count as used so they aren't evicted before they get a chance to play
+		PreloadedCueLastUsedTime.FindOrAdd(LoadedGameplayCueClass) = FPlatformTime::Seconds();
+		if (!PreloadedCueSizes.Contains(LoadedGameplayCueClass))
+		{
+			PreloadedCueSizes.Add(LoadedGameplayCueClass, EstimateGameplayCueSize(LoadedGameplayCueClass));
+		}
 	}
 }
 
+int64 UBEGameplayCueManager::EstimateGameplayCueSize(UClass* GameplayCueClass)
+{
+	UObject* CueCDO = GameplayCueClass->GetDefaultObject();
+
+	// The CDO itself is small, the memory is in the effects, sounds and meshes referenced by it, its components
+	// and the component templates of the class. Assets shared by several cues are counted for each of them.
+
+	TArray<UObject*> ObjectsToSearch;
+	ObjectsToSearch.Add(CueCDO);
+	GetObjectsWithOuter(CueCDO, ObjectsToSearch, /*bIncludeNestedObjects=*/ true);
+	GetObjectsWithOuter(GameplayCueClass, ObjectsToSearch, /*bIncludeNestedObjects=*/ true);
+
+	TArray<UObject*> ReferencedObjects;
+	FReferenceFinder ReferenceFinder(ReferencedObjects, /*LimitOuter=*/ nullptr, /*bRequireDirectOuter=*/ false, /*bShouldIgnoreArchetype=*/ true);
+
+	for (UObject* Object : ObjectsToSearch)
+	{
+		ReferenceFinder.FindReferences(Object);
+	}
+
+	int64 TotalBytes = CueCDO->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+
+	for (const UObject* Object : ReferencedObjects)
+	{
+		// Only count assets, classes (other cues, the native parents) are not part of what preloading the cue costs
+		if (Object && Object->IsAsset() && !Object->IsA<UClass>())
+		{
+			TotalBytes += Object->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+		}
+	}
+
+	return TotalBytes;
+}
+
 void UBEGameplayCueManager::HandlePostLoadMap(UWorld* NewWorld)
 {
 	if (RuntimeGameplayCueObjectLibrary.CueSet)
@@ -352,18 +552,95 @@ void UBEGameplayCueManager::HandlePostLoadMap(UWorld* NewWorld)
 		if (ReferencerSet.Num() == 0)
 		{
 			PreloadedCueReferencers.Remove(*CueIt);
+			PreloadedCueLastUsedTime.Remove(*CueIt);
+			PreloadedCueSizes.Remove(*CueIt);
 			CueIt.RemoveCurrent();
 		}
 	}
 }
 
+bool UBEGameplayCueManager::HandleEvictionTick(float DeltaTime)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_UBEGameplayCueManager_HandleEvictionTick);
+
+	EvictUnusedPreloadedCues();
+	return true;
+}
+
+void UBEGameplayCueManager::EvictUnusedPreloadedCues()
+{
+	const int64 BudgetBytes = static_cast<int64>(BEGameplayCueManagerCvars::PreloadedCueBudgetMB * 1024.0 * 1024.0);
+	if (BudgetBytes <= 0)
+	{
+		return;
+	}
+
+	int64 TotalBytes = 0;
+	for (UClass* CueClass : PreloadedCues)
+	{
+		TotalBytes += PreloadedCueSizes.FindRef(CueClass);
+	}
+
+	if (TotalBytes <= BudgetBytes)
+	{
+		return;
+	}
+
+	// Least recently used first, skipping anything used within the grace period
+	const double Now = FPlatformTime::Seconds();
+	TArray<TPair<double, UClass*>> Candidates;
+	for (UClass* CueClass : PreloadedCues)
+	{
+		const double LastUsedTime = PreloadedCueLastUsedTime.FindRef(CueClass);
+		if ((Now - LastUsedTime) >= BEGameplayCueManagerCvars::EvictAfterUnusedSeconds)
+		{
+			Candidates.Emplace(LastUsedTime, CueClass);
+		}
+	}
+
+	Candidates.Sort([](const TPair<double, UClass*>& A, const TPair<double, UClass*>& B) { return A.Key < B.Key; });
+
+	int32 NumEvicted = 0;
+	for (const TPair<double, UClass*>& Candidate : Candidates)
+	{
+		if (TotalBytes <= BudgetBytes)
+		{
+			break;
+		}
+
+		UClass* CueClass = Candidate.Value;
+
+		// Drop every strong reference we hold, the next GC will unload it and the next use will load it on demand
+		if (RuntimeGameplayCueObjectLibrary.CueSet)
+		{
+			RuntimeGameplayCueObjectLibrary.CueSet->RemoveLoadedClass(CueClass);
+		}
+
+		TotalBytes -= PreloadedCueSizes.FindRef(CueClass);
+
+		PreloadedCues.Remove(CueClass);
+		PreloadedCueReferencers.Remove(CueClass);
+		PreloadedCueLastUsedTime.Remove(CueClass);
+		PreloadedCueSizes.Remove(CueClass);
+
+		++NumEvicted;
+	}
+
+	if (NumEvicted > 0)
+	{
+		UE_LOG(LogBE, Log, TEXT("Evicted %d unused preloaded gameplay cues, %.2f MB estimated remaining (budget %.2f MB)"), NumEvicted, TotalBytes / (1024.0 * 1024.0), BEGameplayCueManagerCvars::PreloadedCueBudgetMB);
+	}
+}
+
 void UBEGameplayCueManager::UpdateDelayLoadDelegateListeners()
 {
 	UGameplayTagsManager::Get().OnGameplayTagLoadedDelegate.RemoveAll(this);
 	FCoreUObjectDelegates::GetPostGarbageCollect().RemoveAll(this);
 	FCoreUObjectDelegates::PostLoadMapWithWorld.RemoveAll(this);
+	FTSTicker::GetCoreTicker().RemoveTicker(EvictionTickHandle);
+	EvictionTickHandle.Reset();
 
-	switch (BEGameplayCueManagerCvars::LoadMode)
+	switch (BEGameplayCueManagerCvars::GetLoadMode())
 	{
 	case EBEEditorLoadMode::LoadUpfront:
 		return;
@@ -382,6 +659,11 @@ void UBEGameplayCueManager::UpdateDelayLoadDelegateListeners()
 	UGameplayTagsManager::Get().OnGameplayTagLoadedDelegate.AddUObject(this, &ThisClass::OnGameplayTagLoaded);
 	FCoreUObjectDelegates::GetPostGarbageCollect().AddUObject(this, &ThisClass::HandlePostGarbageCollect);
 	FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &ThisClass::HandlePostLoadMap);
+
+	if (ShouldDelayLoadGameplayCues())
+	{
+		EvictionTickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ThisClass::HandleEvictionTick), BEGameplayCueManagerCvars::EvictionIntervalSeconds);
+	}
 }
 
 bool UBEGameplayCueManager::ShouldDelayLoadGameplayCues() const
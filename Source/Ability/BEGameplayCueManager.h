@@ -8,6 +8,7 @@
 #include "Containers/Array.h"
 #include "Containers/Map.h"
 #include "Containers/Set.h"
+#include "Containers/Ticker.h"
 #include "GameplayTagContainer.h"
 #include "HAL/CriticalSection.h"
 #include "UObject/SoftObjectPath.h"
@@ -22,6 +23,7 @@ class UClass;
 class UObject;
 class UWorld;
 struct FObjectKey;
+struct FStreamableHandle;
 
 
 /**
@@ -44,6 +46,7 @@ public:
 	virtual bool ShouldAsyncLoadRuntimeObjectLibraries() const override;
 	virtual bool ShouldSyncLoadMissingGameplayCues() const override;
 	virtual bool ShouldAsyncLoadMissingGameplayCues() const override;
+	virtual void HandleGameplayCue(AActor* TargetActor, FGameplayTag GameplayCueTag, EGameplayCueEvent::Type EventType, const FGameplayCueParameters& Parameters, EGameplayCueExecutionOptions Options = EGameplayCueExecutionOptions::Default) override;
 	//~End of UGameplayCueManager interface
 
 	static void DumpGameplayCues(const TArray<FString>& Args);
@@ -51,6 +54,13 @@ public:
 	// When delay loading cues, this will load the cues that must be always loaded anyway
 	void LoadAlwaysLoadedCues();
 
+	// Starts loading the cues for the given tags on behalf of OwningObject, returning a handle if anything needs to stream in.
+	// The cues stay loaded while the owner is alive, unless they are evicted for being unused while over the preload budget.
+	TSharedPtr<FStreamableHandle> PreloadGameplayCueSet(const FGameplayTagContainer& CueTags, const UObject* OwningObject);
+
+	// Returns the number of cues that were invoked before they were loaded (and so didn't play)
+	int32 GetNumMissedCues() const { return NumMissedCues; }
+
 	// Updates the bundles for the singular gameplay cue primary asset
 	void RefreshGameplayCuePrimaryAsset();
 
@@ -64,6 +74,12 @@ private:
 	void HandlePostLoadMap(UWorld* NewWorld);
 	void UpdateDelayLoadDelegateListeners();
 	bool ShouldDelayLoadGameplayCues() const;
+	void OnPreloadCueSetComplete(TArray<FSoftObjectPath> Paths, TWeakObjectPtr<UObject> OwningObject);
+	bool HandleEvictionTick(float DeltaTime);
+	void EvictUnusedPreloadedCues();
+
+	// Estimated memory of a loaded cue class, including the assets it references
+	static int64 EstimateGameplayCueSize(UClass* GameplayCueClass);
 
 private:
 	struct FLoadedGameplayTagToProcessData
@@ -88,4 +104,16 @@ private:
 	TArray<FLoadedGameplayTagToProcessData> LoadedGameplayTagsToProcess;
 	FCriticalSection LoadedGameplayTagsToProcessCS;
 	bool bProcessLoadedTagsAfterGC = false;
+
+	// Last time (FPlatformTime::Seconds) each preloaded cue was invoked or loaded, used to pick eviction candidates
+	TMap<FObjectKey, double> PreloadedCueLastUsedTime;
+
+	// Estimated memory of each preloaded cue and the assets it references, measured once when it is registered
+	TMap<FObjectKey, int64> PreloadedCueSizes;
+
+	// Cues invoked before they were loaded, by tag
+	TMap<FGameplayTag, int32> MissedCueCounts;
+	int32 NumMissedCues = 0;
+
+	FTSTicker::FDelegateHandle EvictionTickHandle;
 };
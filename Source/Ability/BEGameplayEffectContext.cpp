@@ -4,13 +4,26 @@
 #include "Ability/BEGameplayEffectContext.h"
 
 #include "Ability/BEAbilitySourceInterface.h"
+#include "Ability/Target/BEGameplayAbilityTargetData_SingleTargetHit.h"
+#include "Ability/Target/BEGameplayAbilityTargetDataNetSerializer.h"
+#include "BELogChannels.h"
+
 #include "Engine/HitResult.h"
+#include "Engine/NetSerialization.h"
+#include "HAL/IConsoleManager.h"
 #include "PhysicalMaterials/PhysicalMaterial.h"
 #include "Templates/Casts.h"
+#include "UObject/CoreNet.h"
 #include "UObject/Object.h"
 
 #if UE_WITH_IRIS
 #include "Iris/ReplicationState/PropertyNetSerializerInfoRegistry.h"
+#include "Iris/ReplicationState/ReplicationStateDescriptorBuilder.h"
+#include "Iris/Serialization/NetBitStreamReader.h"
+#include "Iris/Serialization/NetBitStreamUtil.h"
+#include "Iris/Serialization/NetBitStreamWriter.h"
+#include "Iris/Serialization/NetSerializerDelegates.h"
+#include "Iris/Serialization/NetSerializers.h"
 #include "Serialization/GameplayEffectContextNetSerializer.h"
 #endif
 
@@ -30,10 +43,47 @@ FBEGameplayEffectContext* FBEGameplayEffectContext::ExtractEffectContext(struct
 
 bool FBEGameplayEffectContext::NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
 {
+	// The base context would send the hit result as a full FHitResult, keep it out of the base serialization and send it compactly below
+
+	TSharedPtr<FHitResult> SavedHitResult;
+	if (Ar.IsSaving())
+	{
+		SavedHitResult = MoveTemp(HitResult);
+	}
+
 	FGameplayEffectContext::NetSerialize(Ar, Map, bOutSuccess);
 
-	// Not serialized for post-activation use:
-	// CartridgeID
+	if (Ar.IsSaving())
+	{
+		HitResult = MoveTemp(SavedHitResult);
+	}
+
+	// Hit result, relative to its own trace start
+
+	uint8 bHasHitResult = HitResult.IsValid() ? 1 : 0;
+	Ar.SerializeBits(&bHasHitResult, 1);
+
+	if (bHasHitResult)
+	{
+		if (Ar.IsLoading() && !HitResult.IsValid())
+		{
+			HitResult = MakeShared<FHitResult>();
+		}
+
+		FVector TraceStart = HitResult->TraceStart;
+		bOutSuccess &= SerializePackedVector<10, 24>(TraceStart, Ar);
+		bOutSuccess &= BETargetDataSerialization::SerializeCompactHit(Ar, Map, *HitResult, TraceStart);
+	}
+	else if (Ar.IsLoading())
+	{
+		HitResult.Reset();
+	}
+
+	// Cartridge IDs are small and -1 means none, so they are sent offset by one as a packed int
+
+	uint32 PackedCartridgeID = static_cast<uint32>(CartridgeID + 1);
+	Ar.SerializeIntPacked(PackedCartridgeID);
+	CartridgeID = static_cast<int32>(PackedCartridgeID) - 1;
 
 	return true;
 }
@@ -41,12 +91,526 @@ bool FBEGameplayEffectContext::NetSerialize(FArchive& Ar, class UPackageMap* Map
 #if UE_WITH_IRIS
 namespace UE::Net
 {
-	// Forward to FGameplayEffectContextNetSerializer
-	// Note: If FBEGameplayEffectContext::NetSerialize() is modified, a custom NetSerializesr must be implemented as the current fallback will no longer be sufficient.
-	UE_NET_IMPLEMENT_FORWARDING_NETSERIALIZER_AND_REGISTRY_DELEGATES(BEGameplayEffectContext, FGameplayEffectContextNetSerializer);
+	/**
+	 * Native Iris serializer for FBEGameplayEffectContext, matching FBEGameplayEffectContext::NetSerialize().
+	 * Everything but the hit result is forwarded to FGameplayEffectContextNetSerializer,
+	 * the hit result is quantized through the FBEHitResultNetState descriptor and the cartridge ID is written as a packed int.
+	 */
+	struct FBEGameplayEffectContextNetSerializer
+	{
+		static const uint32 Version = 0;
+
+		static constexpr bool bIsForwardingSerializer = true;
+		static constexpr bool bHasCustomNetReference = true;
+		static constexpr bool bHasDynamicState = true;
+
+		struct FQuantizedType
+		{
+			alignas(16) uint8 ContextState[512];
+			alignas(16) uint8 HitState[256];
+			uint32 PackedCartridgeID;
+			uint32 PackedBoneIndex;
+			bool bHasHitResult;
+		};
+
+		typedef FBEGameplayEffectContext SourceType;
+		typedef FQuantizedType QuantizedType;
+		typedef FNetSerializerConfig ConfigType;
+
+		static const ConfigType DefaultConfig;
+
+		static void Serialize(FNetSerializationContext& Context, const FNetSerializeArgs& Args);
+		static void Deserialize(FNetSerializationContext& Context, const FNetDeserializeArgs& Args);
+
+		static void SerializeDelta(FNetSerializationContext& Context, const FNetSerializeDeltaArgs& Args);
+		static void DeserializeDelta(FNetSerializationContext& Context, const FNetDeserializeDeltaArgs& Args);
+
+		static void Quantize(FNetSerializationContext& Context, const FNetQuantizeArgs& Args);
+		static void Dequantize(FNetSerializationContext& Context, const FNetDequantizeArgs& Args);
+
+		static bool IsEqual(FNetSerializationContext& Context, const FNetIsEqualArgs& Args);
+		static bool Validate(FNetSerializationContext& Context, const FNetValidateArgs& Args);
+
+		static void CloneDynamicState(FNetSerializationContext& Context, const FNetCloneDynamicStateArgs& Args);
+		static void FreeDynamicState(FNetSerializationContext& Context, const FNetFreeDynamicStateArgs& Args);
+
+		static void CollectNetReferences(FNetSerializationContext& Context, const FNetCollectReferencesArgs& Args);
+
+	private:
+		static void SerializeHit(FNetSerializationContext& Context, const FNetSerializeArgs& Args, const QuantizedType& Value);
+		static void DeserializeHit(FNetSerializationContext& Context, const FNetDeserializeArgs& Args, QuantizedType& Target);
+
+		class FNetSerializerRegistryDelegates final : private UE::Net::FNetSerializerRegistryDelegates
+		{
+		public:
+			virtual ~FNetSerializerRegistryDelegates();
+
+		private:
+			virtual void OnPreFreezeNetSerializerRegistry() override;
+			virtual void OnPostFreezeNetSerializerRegistry() override;
+		};
+
+		static FBEGameplayEffectContextNetSerializer::FNetSerializerRegistryDelegates NetSerializerRegistryDelegates;
+
+		static const FNetSerializer* ContextNetSerializer;
+
+		static FStructNetSerializerConfig HitNetSerializerConfig;
+		static const FNetSerializer* HitNetSerializer;
+	};
+
+	UE_NET_DECLARE_SERIALIZER(FBEGameplayEffectContextNetSerializer, BECORE_API);
+	UE_NET_IMPLEMENT_SERIALIZER(FBEGameplayEffectContextNetSerializer);
+
+	const FBEGameplayEffectContextNetSerializer::ConfigType FBEGameplayEffectContextNetSerializer::DefaultConfig;
+	FBEGameplayEffectContextNetSerializer::FNetSerializerRegistryDelegates FBEGameplayEffectContextNetSerializer::NetSerializerRegistryDelegates;
+	const FNetSerializer* FBEGameplayEffectContextNetSerializer::ContextNetSerializer = &UE_NET_GET_SERIALIZER(FGameplayEffectContextNetSerializer);
+	FStructNetSerializerConfig FBEGameplayEffectContextNetSerializer::HitNetSerializerConfig;
+	const FNetSerializer* FBEGameplayEffectContextNetSerializer::HitNetSerializer = &UE_NET_GET_SERIALIZER(FStructNetSerializer);
+
+	static const FName PropertyNetSerializerRegistry_NAME_BEGameplayEffectContext("BEGameplayEffectContext");
+	UE_NET_IMPLEMENT_NAMED_STRUCT_NETSERIALIZER_INFO(PropertyNetSerializerRegistry_NAME_BEGameplayEffectContext, FBEGameplayEffectContextNetSerializer);
+
+	void FBEGameplayEffectContextNetSerializer::SerializeHit(FNetSerializationContext& Context, const FNetSerializeArgs& Args, const QuantizedType& Value)
+	{
+		FNetBitStreamWriter* Writer = Context.GetBitStreamWriter();
+		WritePackedUint32(Writer, Value.PackedCartridgeID);
+
+		if (Writer->WriteBool(Value.bHasHitResult))
+		{
+			WritePackedUint32(Writer, Value.PackedBoneIndex);
+
+			FNetSerializeArgs HitArgs = Args;
+			HitArgs.NetSerializerConfig = &HitNetSerializerConfig;
+			HitArgs.Source = NetSerializerValuePointer(&Value.HitState);
+			HitNetSerializer->Serialize(Context, HitArgs);
+		}
+	}
+
+	void FBEGameplayEffectContextNetSerializer::DeserializeHit(FNetSerializationContext& Context, const FNetDeserializeArgs& Args, QuantizedType& Target)
+	{
+		FNetBitStreamReader* Reader = Context.GetBitStreamReader();
+		Target.PackedCartridgeID = ReadPackedUint32(Reader);
+
+		Target.bHasHitResult = Reader->ReadBool();
+		if (Target.bHasHitResult)
+		{
+			Target.PackedBoneIndex = ReadPackedUint32(Reader);
+
+			FNetDeserializeArgs HitArgs = Args;
+			HitArgs.NetSerializerConfig = &HitNetSerializerConfig;
+			HitArgs.Target = NetSerializerValuePointer(&Target.HitState);
+			HitNetSerializer->Deserialize(Context, HitArgs);
+		}
+	}
+
+	void FBEGameplayEffectContextNetSerializer::Serialize(FNetSerializationContext& Context, const FNetSerializeArgs& Args)
+	{
+		const QuantizedType& Value = *reinterpret_cast<const QuantizedType*>(Args.Source);
+
+		FNetSerializeArgs ContextArgs = Args;
+		ContextArgs.NetSerializerConfig = ContextNetSerializer->DefaultConfig;
+		ContextArgs.Source = NetSerializerValuePointer(&Value.ContextState);
+		ContextNetSerializer->Serialize(Context, ContextArgs);
+
+		SerializeHit(Context, Args, Value);
+	}
+
+	void FBEGameplayEffectContextNetSerializer::Deserialize(FNetSerializationContext& Context, const FNetDeserializeArgs& Args)
+	{
+		QuantizedType& Target = *reinterpret_cast<QuantizedType*>(Args.Target);
+
+		FNetDeserializeArgs ContextArgs = Args;
+		ContextArgs.NetSerializerConfig = ContextNetSerializer->DefaultConfig;
+		ContextArgs.Target = NetSerializerValuePointer(&Target.ContextState);
+		ContextNetSerializer->Deserialize(Context, ContextArgs);
+
+		DeserializeHit(Context, Args, Target);
+	}
+
+	void FBEGameplayEffectContextNetSerializer::SerializeDelta(FNetSerializationContext& Context, const FNetSerializeDeltaArgs& Args)
+	{
+		const QuantizedType& Value = *reinterpret_cast<const QuantizedType*>(Args.Source);
+		const QuantizedType& PrevValue = *reinterpret_cast<const QuantizedType*>(Args.Prev);
+
+		FNetSerializeDeltaArgs ContextArgs = Args;
+		ContextArgs.NetSerializerConfig = ContextNetSerializer->DefaultConfig;
+		ContextArgs.Source = NetSerializerValuePointer(&Value.ContextState);
+		ContextArgs.Prev = NetSerializerValuePointer(&PrevValue.ContextState);
+		ContextNetSerializer->SerializeDelta(Context, ContextArgs);
+
+		// Effects from the same cartridge share the cartridge ID and usually the hit as well
+
+		FNetBitStreamWriter* Writer = Context.GetBitStreamWriter();
+		if (Writer->WriteBool(Value.PackedCartridgeID != PrevValue.PackedCartridgeID))
+		{
+			WritePackedUint32(Writer, Value.PackedCartridgeID);
+		}
+
+		if (Writer->WriteBool(Value.bHasHitResult))
+		{
+			WritePackedUint32(Writer, Value.PackedBoneIndex);
+
+			if (Writer->WriteBool(PrevValue.bHasHitResult))
+			{
+				FNetSerializeDeltaArgs HitArgs = Args;
+				HitArgs.NetSerializerConfig = &HitNetSerializerConfig;
+				HitArgs.Source = NetSerializerValuePointer(&Value.HitState);
+				HitArgs.Prev = NetSerializerValuePointer(&PrevValue.HitState);
+				HitNetSerializer->SerializeDelta(Context, HitArgs);
+			}
+			else
+			{
+				FNetSerializeArgs HitArgs = Args;
+				HitArgs.NetSerializerConfig = &HitNetSerializerConfig;
+				HitArgs.Source = NetSerializerValuePointer(&Value.HitState);
+				HitNetSerializer->Serialize(Context, HitArgs);
+			}
+		}
+	}
+
+	void FBEGameplayEffectContextNetSerializer::DeserializeDelta(FNetSerializationContext& Context, const FNetDeserializeDeltaArgs& Args)
+	{
+		QuantizedType& Target = *reinterpret_cast<QuantizedType*>(Args.Target);
+		const QuantizedType& PrevValue = *reinterpret_cast<const QuantizedType*>(Args.Prev);
+
+		FNetDeserializeDeltaArgs ContextArgs = Args;
+		ContextArgs.NetSerializerConfig = ContextNetSerializer->DefaultConfig;
+		ContextArgs.Target = NetSerializerValuePointer(&Target.ContextState);
+		ContextArgs.Prev = NetSerializerValuePointer(&PrevValue.ContextState);
+		ContextNetSerializer->DeserializeDelta(Context, ContextArgs);
+
+		FNetBitStreamReader* Reader = Context.GetBitStreamReader();
+		Target.PackedCartridgeID = Reader->ReadBool() ? ReadPackedUint32(Reader) : PrevValue.PackedCartridgeID;
+
+		Target.bHasHitResult = Reader->ReadBool();
+		if (Target.bHasHitResult)
+		{
+			Target.PackedBoneIndex = ReadPackedUint32(Reader);
+
+			if (Reader->ReadBool())
+			{
+				FNetDeserializeDeltaArgs HitArgs = Args;
+				HitArgs.NetSerializerConfig = &HitNetSerializerConfig;
+				HitArgs.Target = NetSerializerValuePointer(&Target.HitState);
+				HitArgs.Prev = NetSerializerValuePointer(&PrevValue.HitState);
+				HitNetSerializer->DeserializeDelta(Context, HitArgs);
+			}
+			else
+			{
+				FNetDeserializeArgs HitArgs = Args;
+				HitArgs.NetSerializerConfig = &HitNetSerializerConfig;
+				HitArgs.Target = NetSerializerValuePointer(&Target.HitState);
+				HitNetSerializer->Deserialize(Context, HitArgs);
+			}
+		}
+	}
+
+	void FBEGameplayEffectContextNetSerializer::Quantize(FNetSerializationContext& Context, const FNetQuantizeArgs& Args)
+	{
+		const SourceType& Source = *reinterpret_cast<const SourceType*>(Args.Source);
+		QuantizedType& Target = *reinterpret_cast<QuantizedType*>(Args.Target);
+
+		// The base serializer must not see the hit result, it is quantized separately below
+		SourceType ContextWithoutHit = Source;
+		ContextWithoutHit.HitResult.Reset();
+
+		FNetQuantizeArgs ContextArgs = Args;
+		ContextArgs.NetSerializerConfig = ContextNetSerializer->DefaultConfig;
+		ContextArgs.Source = NetSerializerValuePointer(static_cast<const FGameplayEffectContext*>(&ContextWithoutHit));
+		ContextArgs.Target = NetSerializerValuePointer(&Target.ContextState);
+		ContextNetSerializer->Quantize(Context, ContextArgs);
+
+		Target.PackedCartridgeID = static_cast<uint32>(Source.CartridgeID + 1);
+		Target.bHasHitResult = Source.HitResult.IsValid();
+		Target.PackedBoneIndex = 0;
+
+		if (Target.bHasHitResult)
+		{
+			FBEHitResultNetState HitState;
+			BETargetDataSerialization::HitResultToNetState(*Source.HitResult, HitState, Target.PackedBoneIndex);
+
+			FNetQuantizeArgs HitArgs = Args;
+			HitArgs.NetSerializerConfig = &HitNetSerializerConfig;
+			HitArgs.Source = NetSerializerValuePointer(&HitState);
+			HitArgs.Target = NetSerializerValuePointer(&Target.HitState);
+			HitNetSerializer->Quantize(Context, HitArgs);
+		}
+	}
+
+	void FBEGameplayEffectContextNetSerializer::Dequantize(FNetSerializationContext& Context, const FNetDequantizeArgs& Args)
+	{
+		const QuantizedType& Source = *reinterpret_cast<const QuantizedType*>(Args.Source);
+		SourceType& Target = *reinterpret_cast<SourceType*>(Args.Target);
+
+		FNetDequantizeArgs ContextArgs = Args;
+		ContextArgs.NetSerializerConfig = ContextNetSerializer->DefaultConfig;
+		ContextArgs.Source = NetSerializerValuePointer(&Source.ContextState);
+		ContextArgs.Target = NetSerializerValuePointer(static_cast<FGameplayEffectContext*>(&Target));
+		ContextNetSerializer->Dequantize(Context, ContextArgs);
+
+		Target.CartridgeID = static_cast<int32>(Source.PackedCartridgeID) - 1;
+
+		if (Source.bHasHitResult)
+		{
+			FBEHitResultNetState HitState;
+
+			FNetDequantizeArgs HitArgs = Args;
+			HitArgs.NetSerializerConfig = &HitNetSerializerConfig;
+			HitArgs.Source = NetSerializerValuePointer(&Source.HitState);
+			HitArgs.Target = NetSerializerValuePointer(&HitState);
+			HitNetSerializer->Dequantize(Context, HitArgs);
+
+			if (!Target.HitResult.IsValid())
+			{
+				Target.HitResult = MakeShared<FHitResult>();
+			}
+
+			BETargetDataSerialization::NetStateToHitResult(HitState, Source.PackedBoneIndex, *Target.HitResult);
+		}
+		else
+		{
+			Target.HitResult.Reset();
+		}
+	}
+
+	bool FBEGameplayEffectContextNetSerializer::IsEqual(FNetSerializationContext& Context, const FNetIsEqualArgs& Args)
+	{
+		if (Args.bStateIsQuantized)
+		{
+			const QuantizedType& Value0 = *reinterpret_cast<const QuantizedType*>(Args.Source0);
+			const QuantizedType& Value1 = *reinterpret_cast<const QuantizedType*>(Args.Source1);
+
+			if ((Value0.PackedCartridgeID != Value1.PackedCartridgeID) || (Value0.bHasHitResult != Value1.bHasHitResult))
+			{
+				return false;
+			}
+
+			if (Value0.bHasHitResult)
+			{
+				if (Value0.PackedBoneIndex != Value1.PackedBoneIndex)
+				{
+					return false;
+				}
+
+				FNetIsEqualArgs HitArgs = Args;
+				HitArgs.NetSerializerConfig = &HitNetSerializerConfig;
+				HitArgs.Source0 = NetSerializerValuePointer(&Value0.HitState);
+				HitArgs.Source1 = NetSerializerValuePointer(&Value1.HitState);
+				if (!HitNetSerializer->IsEqual(Context, HitArgs))
+				{
+					return false;
+				}
+			}
+
+			FNetIsEqualArgs ContextArgs = Args;
+			ContextArgs.NetSerializerConfig = ContextNetSerializer->DefaultConfig;
+			ContextArgs.Source0 = NetSerializerValuePointer(&Value0.ContextState);
+			ContextArgs.Source1 = NetSerializerValuePointer(&Value1.ContextState);
+			return ContextNetSerializer->IsEqual(Context, ContextArgs);
+		}
+		else
+		{
+			const SourceType& Value0 = *reinterpret_cast<const SourceType*>(Args.Source0);
+			const SourceType& Value1 = *reinterpret_cast<const SourceType*>(Args.Source1);
+
+			if (Value0.CartridgeID != Value1.CartridgeID)
+			{
+				return false;
+			}
+
+			// The base serializer compares the hit results as well
+			FNetIsEqualArgs ContextArgs = Args;
+			ContextArgs.NetSerializerConfig = ContextNetSerializer->DefaultConfig;
+			return ContextNetSerializer->IsEqual(Context, ContextArgs);
+		}
+	}
+
+	bool FBEGameplayEffectContextNetSerializer::Validate(FNetSerializationContext& Context, const FNetValidateArgs& Args)
+	{
+		const SourceType& Source = *reinterpret_cast<const SourceType*>(Args.Source);
+
+		FNetValidateArgs ContextArgs = Args;
+		ContextArgs.NetSerializerConfig = ContextNetSerializer->DefaultConfig;
+		if (!ContextNetSerializer->Validate(Context, ContextArgs))
+		{
+			return false;
+		}
+
+		if (Source.HitResult.IsValid())
+		{
+			FBEHitResultNetState HitState;
+			uint32 PackedBoneIndex = 0;
+			BETargetDataSerialization::HitResultToNetState(*Source.HitResult, HitState, PackedBoneIndex);
+
+			FNetValidateArgs HitArgs = Args;
+			HitArgs.NetSerializerConfig = &HitNetSerializerConfig;
+			HitArgs.Source = NetSerializerValuePointer(&HitState);
+			return HitNetSerializer->Validate(Context, HitArgs);
+		}
+
+		return true;
+	}
+
+	void FBEGameplayEffectContextNetSerializer::CloneDynamicState(FNetSerializationContext& Context, const FNetCloneDynamicStateArgs& Args)
+	{
+		// Only the base context state owns allocations, the hit state is inline
+		const QuantizedType& Source = *reinterpret_cast<const QuantizedType*>(Args.Source);
+		QuantizedType& Target = *reinterpret_cast<QuantizedType*>(Args.Target);
+
+		FNetCloneDynamicStateArgs ContextArgs = Args;
+		ContextArgs.NetSerializerConfig = ContextNetSerializer->DefaultConfig;
+		ContextArgs.Source = NetSerializerValuePointer(&Source.ContextState);
+		ContextArgs.Target = NetSerializerValuePointer(&Target.ContextState);
+		ContextNetSerializer->CloneDynamicState(Context, ContextArgs);
+	}
+
+	void FBEGameplayEffectContextNetSerializer::FreeDynamicState(FNetSerializationContext& Context, const FNetFreeDynamicStateArgs& Args)
+	{
+		QuantizedType& Value = *reinterpret_cast<QuantizedType*>(Args.Source);
+
+		FNetFreeDynamicStateArgs ContextArgs = Args;
+		ContextArgs.NetSerializerConfig = ContextNetSerializer->DefaultConfig;
+		ContextArgs.Source = NetSerializerValuePointer(&Value.ContextState);
+		ContextNetSerializer->FreeDynamicState(Context, ContextArgs);
+	}
+
+	void FBEGameplayEffectContextNetSerializer::CollectNetReferences(FNetSerializationContext& Context, const FNetCollectReferencesArgs& Args)
+	{
+		const QuantizedType& Value = *reinterpret_cast<const QuantizedType*>(Args.Source);
+
+		FNetCollectReferencesArgs ContextArgs = Args;
+		ContextArgs.NetSerializerConfig = ContextNetSerializer->DefaultConfig;
+		ContextArgs.Source = NetSerializerValuePointer(&Value.ContextState);
+		ContextNetSerializer->CollectNetReferences(Context, ContextArgs);
+
+		if (Value.bHasHitResult)
+		{
+			FNetCollectReferencesArgs HitArgs = Args;
+			HitArgs.NetSerializerConfig = &HitNetSerializerConfig;
+			HitArgs.Source = NetSerializerValuePointer(&Value.HitState);
+			HitNetSerializer->CollectNetReferences(Context, HitArgs);
+		}
+	}
+
+	FBEGameplayEffectContextNetSerializer::FNetSerializerRegistryDelegates::~FNetSerializerRegistryDelegates()
+	{
+		UE_NET_UNREGISTER_NETSERIALIZER_INFO(PropertyNetSerializerRegistry_NAME_BEGameplayEffectContext);
+	}
+
+	void FBEGameplayEffectContextNetSerializer::FNetSerializerRegistryDelegates::OnPreFreezeNetSerializerRegistry()
+	{
+		UE_NET_REGISTER_NETSERIALIZER_INFO(PropertyNetSerializerRegistry_NAME_BEGameplayEffectContext);
+	}
+
+	void FBEGameplayEffectContextNetSerializer::FNetSerializerRegistryDelegates::OnPostFreezeNetSerializerRegistry()
+	{
+		// The base context state is stored inline, make sure it fits
+		checkf((ContextNetSerializer->QuantizedTypeSize <= sizeof(FQuantizedType::ContextState)) && (ContextNetSerializer->QuantizedTypeAlignment <= alignof(FQuantizedType)),
+			TEXT("FBEGameplayEffectContextNetSerializer::FQuantizedType::ContextState is too small (%u bytes, alignment %u) for the quantized base context (%u bytes, alignment %u)"),
+			uint32(sizeof(FQuantizedType::ContextState)), uint32(alignof(FQuantizedType)), uint32(ContextNetSerializer->QuantizedTypeSize), uint32(ContextNetSerializer->QuantizedTypeAlignment));
+
+		FReplicationStateDescriptorBuilder::FParameters Params;
+		HitNetSerializerConfig.StateDescriptor = FReplicationStateDescriptorBuilder::CreateDescriptorForStruct(FBEHitResultNetState::StaticStruct(), Params);
+
+		const FReplicationStateDescriptor* Descriptor = HitNetSerializerConfig.StateDescriptor.GetReference();
+		check(Descriptor != nullptr);
+
+		checkf((Descriptor->InternalSize <= sizeof(FQuantizedType::HitState)) && (Descriptor->InternalAlignment <= alignof(FQuantizedType)),
+			TEXT("FBEGameplayEffectContextNetSerializer::FQuantizedType::HitState is too small (%u bytes, alignment %u) for the quantized hit state (%u bytes, alignment %u)"),
+			uint32(sizeof(FQuantizedType::HitState)), uint32(alignof(FQuantizedType)), uint32(Descriptor->InternalSize), uint32(Descriptor->InternalAlignment));
+
+		check(!EnumHasAnyFlags(Descriptor->Traits, EReplicationStateTraits::HasDynamicState));
+	}
 }
 #endif
 
+
+//////////////////////////////////////////////////////////////////////
+
+namespace BEEffectContextSerialization
+{
+	static bool HitsMatch(const FHitResult& A, const FHitResult& B)
+	{
+		return A.ImpactPoint.Equals(B.ImpactPoint, 0.1)
+			&& A.Location.Equals(B.Location, 0.1)
+			&& A.TraceStart.Equals(B.TraceStart, 0.1)
+			&& A.TraceEnd.Equals(B.TraceEnd, 0.1)
+			&& A.ImpactNormal.Equals(B.ImpactNormal, 0.001)
+			&& A.Normal.Equals(B.Normal, 0.001)
+			&& (A.bBlockingHit == B.bBlockingHit)
+			&& (A.bStartPenetrating == B.bStartPenetrating)
+			&& FMath::IsNearlyEqual(A.Distance, B.Distance, 0.2f);
+	}
+
+	/**
+	 * Checks that the legacy NetSerialize path and the hit conversion used by the Iris serializer agree.
+	 * The Iris quantization itself needs a running replication system, so only the conversion to and from FBEHitResultNetState is covered here.
+	 */
+	static void CheckSerializationParity(const TArray<FString>& Args)
+	{
+		UPackageMap* PackageMap = NewObject<UPackageMap>();
+
+		FHitResult Hit;
+		Hit.bBlockingHit = true;
+		Hit.TraceStart = FVector(12345.6, -6543.2, 180.0);
+		Hit.TraceEnd = Hit.TraceStart + FVector(10000.0, 0.0, 0.0);
+		Hit.ImpactPoint = Hit.TraceStart + FVector(1530.25, 12.5, -4.0);
+		Hit.Location = Hit.ImpactPoint + FVector(-2.0, 0.0, 0.0);
+		Hit.ImpactNormal = FVector(-1.0, 0.1, 0.05).GetSafeNormal();
+		Hit.Normal = FVector(-1.0, 0.0, 0.0);
+		Hit.Distance = static_cast<float>(FVector::Dist(Hit.TraceStart, Hit.Location));
+		Hit.Time = static_cast<float>(Hit.Distance / 10000.0);
+
+		FBEGameplayEffectContext SentContext;
+		SentContext.AddHitResult(Hit);
+		SentContext.AddOrigin(Hit.TraceStart);
+		SentContext.CartridgeID = 42;
+
+		// Legacy path
+
+		bool bSuccess = true;
+
+		FNetBitWriter Writer(PackageMap, 8192);
+		SentContext.NetSerialize(Writer, PackageMap, bSuccess);
+
+		FNetBitReader Reader(PackageMap, Writer.GetData(), Writer.GetNumBits());
+		FBEGameplayEffectContext ReceivedContext;
+		ReceivedContext.NetSerialize(Reader, PackageMap, bSuccess);
+
+		const bool bLegacyOk = bSuccess && !Reader.IsError()
+			&& (ReceivedContext.CartridgeID == SentContext.CartridgeID)
+			&& (ReceivedContext.GetHitResult() != nullptr) && HitsMatch(Hit, *ReceivedContext.GetHitResult())
+			&& ReceivedContext.HasOrigin() && ReceivedContext.GetOrigin().Equals(SentContext.GetOrigin(), 0.1);
+
+		// Iris hit conversion
+
+		FBEHitResultNetState HitState;
+		uint32 PackedBoneIndex = 0;
+		BETargetDataSerialization::HitResultToNetState(Hit, HitState, PackedBoneIndex);
+
+		FHitResult ConvertedHit;
+		BETargetDataSerialization::NetStateToHitResult(HitState, PackedBoneIndex, ConvertedHit);
+
+		const bool bIrisOk = (PackedBoneIndex == 0) && HitsMatch(Hit, ConvertedHit)
+			&& (ReceivedContext.GetHitResult() != nullptr) && HitsMatch(*ReceivedContext.GetHitResult(), ConvertedHit);
+
+		// Size of the base encoding, which sends the full FHitResult
+
+		FNetBitWriter BaseWriter(PackageMap, 8192);
+		SentContext.FGameplayEffectContext::NetSerialize(BaseWriter, PackageMap, bSuccess);
+
+		UE_LOG(LogBEAbilitySystem, Display, TEXT("Effect context serialization parity:"));
+		UE_LOG(LogBEAbilitySystem, Display, TEXT("  Legacy NetSerialize round trip : %s (%lld bytes, base context encoding %lld bytes)"),
+			bLegacyOk ? TEXT("ok") : TEXT("FAILED"), FMath::DivideAndRoundUp<int64>(Writer.GetNumBits(), 8), FMath::DivideAndRoundUp<int64>(BaseWriter.GetNumBits(), 8));
+		UE_LOG(LogBEAbilitySystem, Display, TEXT("  Iris hit state conversion      : %s"), bIrisOk ? TEXT("ok") : TEXT("FAILED"));
+	}
+
+	static FAutoConsoleCommand CmdCheckSerializationParity(
+		TEXT("BE.EffectContext.CheckSerializationParity"),
+		TEXT("Round trips a sample effect context through NetSerialize and the hit conversion used by the Iris serializer and reports whether they agree."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(CheckSerializationParity));
+}
+
 void FBEGameplayEffectContext::SetAbilitySource(const IBEAbilitySourceInterface* InObject, float InSourceLevel)
 {
 	AbilitySourceObject = MakeWeakObjectPtr(Cast<const UObject>(InObject));
@@ -17,6 +17,7 @@ class FArchive;
 class IBEAbilitySourceInterface;
 class UObject;
 class UPhysicalMaterial;
+namespace UE::Net { struct FBEGameplayEffectContextNetSerializer; }
 
 
 USTRUCT()
@@ -60,7 +61,7 @@ struct FBEGameplayEffectContext : public FGameplayEffectContext
 		return FBEGameplayEffectContext::StaticStruct();
 	}
 
-	/** Overridden to serialize new fields */
+	/** Overridden to serialize new fields and send the hit result in the compact target data encoding */
 	virtual bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess) override;
 
 	/** Returns the physical material from the hit result if there is one */
@@ -75,6 +76,8 @@ protected:
 	/** Ability Source object (should implement IBEAbilitySourceInterface). NOT replicated currently */
 	UPROPERTY()
 	TWeakObjectPtr<const UObject> AbilitySourceObject;
+
+	friend struct UE::Net::FBEGameplayEffectContextNetSerializer;
 };
 
 template<>
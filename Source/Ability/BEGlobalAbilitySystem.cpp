@@ -9,6 +9,8 @@
 #include "GameplayAbilitySpec.h"
 #include "GameplayEffect.h"
 #include "GameplayEffectTypes.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
 #include "Misc/AssertionMacros.h"
 #include "Templates/ChooseClass.h"
 #include "Templates/Tuple.h"
@@ -17,6 +19,36 @@
 #include UE_INLINE_GENERATED_CPP_BY_NAME(BEGlobalAbilitySystem)
 
 
+namespace BE::GlobalAbilitySystem
+{
+	float BudgetMs = 0.5f;
+	static FAutoConsoleVariableRef CVarBudgetMs(TEXT("BE.GlobalAbilitySystem.BudgetMs"), BudgetMs, TEXT("Time (in ms) per frame spent giving queued global abilities and effects to ASCs. 0 or less gives them out all at once."), ECVF_Default);
+
+	bool bShareTagOnlyEffects = false;
+	static FAutoConsoleVariableRef CVarShareTagOnlyEffects(TEXT("BE.GlobalAbilitySystem.ShareTagOnlyEffects"), bShareTagOnlyEffects, TEXT("Should global effects that only grant tags be added as loose (minimal replication) tags instead of being applied to each ASC?"), ECVF_Default);
+
+	/** True for infinite effects that do nothing but grant tags */
+	static bool IsTagOnlyEffect(const UGameplayEffect& Effect)
+	{
+		return (Effect.DurationPolicy == EGameplayEffectDurationType::Infinite)
+			&& (Effect.InheritableOwnedTagsContainer.CombinedTags.Num() > 0)
+			&& Effect.Modifiers.IsEmpty()
+			&& Effect.Executions.IsEmpty()
+			&& Effect.ConditionalGameplayEffects.IsEmpty()
+			&& Effect.GameplayCues.IsEmpty()
+			&& Effect.GrantedAbilities.IsEmpty()
+			&& (Effect.Period.GetValueAtLevel(1.0f) <= 0.0f)
+			&& (Effect.StackingType == EGameplayEffectStackingType::None)
+			&& Effect.ApplicationTagRequirements.IsEmpty()
+			&& Effect.OngoingTagRequirements.IsEmpty()
+			&& Effect.RemovalTagRequirements.IsEmpty()
+			&& Effect.GrantedApplicationImmunityTags.IsEmpty()
+			&& (Effect.RemoveGameplayEffectsWithTags.CombinedTags.Num() == 0)
+			&& (Effect.InheritableBlockedAbilityTagsContainer.CombinedTags.Num() == 0);
+	}
+}
+
+
 void FGlobalAppliedAbilityList::AddToASC(TSubclassOf<UGameplayAbility> Ability, UBEAbilitySystemComponent* ASC)
 {
 	if (FGameplayAbilitySpecHandle* SpecHandle = Handles.Find(ASC))
@@ -53,13 +85,34 @@ void FGlobalAppliedAbilityList::RemoveFromAll()
 
 
 
+void FGlobalAppliedEffectList::Initialize(TSubclassOf<UGameplayEffect> Effect)
+{
+	const UGameplayEffect* GameplayEffectCDO = Effect->GetDefaultObject<UGameplayEffect>();
+
+	bShareTags = BE::GlobalAbilitySystem::bShareTagOnlyEffects && BE::GlobalAbilitySystem::IsTagOnlyEffect(*GameplayEffectCDO);
+	SharedTags = bShareTags ? GameplayEffectCDO->InheritableOwnedTagsContainer.CombinedTags : FGameplayTagContainer();
+}
+
+bool FGlobalAppliedEffectList::IsAppliedToASC(UBEAbilitySystemComponent* ASC) const
+{
+	return bShareTags ? SharedTagASCs.Contains(ASC) : Handles.Contains(ASC);
+}
+
 void FGlobalAppliedEffectList::AddToASC(TSubclassOf<UGameplayEffect> Effect, UBEAbilitySystemComponent* ASC)
 {
-	if (FActiveGameplayEffectHandle* EffectHandle = Handles.Find(ASC))
+	if (IsAppliedToASC(ASC))
 	{
 		RemoveFromASC(ASC);
 	}
 
+	if (bShareTags)
+	{
+		ASC->AddLooseGameplayTags(SharedTags);
+		ASC->AddMinimalReplicationGameplayTags(SharedTags);
+		SharedTagASCs.Add(ASC);
+		return;
+	}
+
 	const UGameplayEffect* GameplayEffectCDO = Effect->GetDefaultObject<UGameplayEffect>();
 	const FActiveGameplayEffectHandle GameplayEffectHandle = ASC->ApplyGameplayEffectToSelf(GameplayEffectCDO, /*Level=*/ 1, ASC->MakeEffectContext());
 	Handles.Add(ASC, GameplayEffectHandle);
@@ -67,6 +120,12 @@ void FGlobalAppliedEffectList::AddToASC(TSubclassOf<UGameplayEffect> Effect, UBE
 
 void FGlobalAppliedEffectList::RemoveFromASC(UBEAbilitySystemComponent* ASC)
 {
+	if (SharedTagASCs.Remove(ASC) > 0)
+	{
+		ASC->RemoveLooseGameplayTags(SharedTags);
+		ASC->RemoveMinimalReplicationGameplayTags(SharedTags);
+	}
+
 	if (FActiveGameplayEffectHandle* EffectHandle = Handles.Find(ASC))
 	{
 		ASC->RemoveActiveGameplayEffect(*EffectHandle);
@@ -76,6 +135,16 @@ void FGlobalAppliedEffectList::RemoveFromASC(UBEAbilitySystemComponent* ASC)
 
 void FGlobalAppliedEffectList::RemoveFromAll()
 {
+	for (UBEAbilitySystemComponent* ASC : SharedTagASCs)
+	{
+		if (ASC != nullptr)
+		{
+			ASC->RemoveLooseGameplayTags(SharedTags);
+			ASC->RemoveMinimalReplicationGameplayTags(SharedTags);
+		}
+	}
+	SharedTagASCs.Empty();
+
 	for (auto& KVP : Handles)
 	{
 		if (KVP.Key != nullptr)
@@ -90,14 +159,29 @@ UBEGlobalAbilitySystem::UBEGlobalAbilitySystem()
 {
 }
 
+void UBEGlobalAbilitySystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (PendingApplicationsHead < PendingApplications.Num())
+	{
+		ProcessPendingApplications(BE::GlobalAbilitySystem::BudgetMs * 0.001);
+	}
+}
+
+TStatId UBEGlobalAbilitySystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UBEGlobalAbilitySystem, STATGROUP_Tickables);
+}
+
 void UBEGlobalAbilitySystem::ApplyAbilityToAll(TSubclassOf<UGameplayAbility> Ability)
 {
 	if ((Ability.Get() != nullptr) && (!AppliedAbilities.Contains(Ability)))
 	{
-		FGlobalAppliedAbilityList& Entry = AppliedAbilities.Add(Ability);		
+		AppliedAbilities.Add(Ability);
 		for (UBEAbilitySystemComponent* ASC : RegisteredASCs)
 		{
-			Entry.AddToASC(Ability, ASC);
+			QueueApplication(ASC, Ability, nullptr);
 		}
 	}
 }
@@ -107,15 +191,18 @@ void UBEGlobalAbilitySystem::ApplyEffectToAll(TSubclassOf<UGameplayEffect> Effec
 	if ((Effect.Get() != nullptr) && (!AppliedEffects.Contains(Effect)))
 	{
 		FGlobalAppliedEffectList& Entry = AppliedEffects.Add(Effect);
+		Entry.Initialize(Effect);
+
 		for (UBEAbilitySystemComponent* ASC : RegisteredASCs)
 		{
-			Entry.AddToASC(Effect, ASC);
+			QueueApplication(ASC, nullptr, Effect);
 		}
 	}
 }
 
 void UBEGlobalAbilitySystem::RemoveAbilityFromAll(TSubclassOf<UGameplayAbility> Ability)
 {
+	// Applications still in the queue are dropped when they come up, see ApplyPendingApplication
 	if ((Ability.Get() != nullptr) && AppliedAbilities.Contains(Ability))
 	{
 		FGlobalAppliedAbilityList& Entry = AppliedAbilities[Ability];
@@ -138,16 +225,17 @@ void UBEGlobalAbilitySystem::RegisterASC(UBEAbilitySystemComponent* ASC)
 {
 	check(ASC);
 
+	// Registering again (e.g. for a new avatar) gives everything out again, like the first time
 	for (auto& Entry : AppliedAbilities)
 	{
-		Entry.Value.AddToASC(Entry.Key, ASC);
+		QueueApplication(ASC, Entry.Key, nullptr);
 	}
 	for (auto& Entry : AppliedEffects)
 	{
-		Entry.Value.AddToASC(Entry.Key, ASC);
+		QueueApplication(ASC, nullptr, Entry.Key);
 	}
 
-	RegisteredASCs.AddUnique(ASC);
+	RegisteredASCs.Add(ASC);
 }
 
 void UBEGlobalAbilitySystem::UnregisterASC(UBEAbilitySystemComponent* ASC)
@@ -164,3 +252,72 @@ void UBEGlobalAbilitySystem::UnregisterASC(UBEAbilitySystemComponent* ASC)
 
 	RegisteredASCs.Remove(ASC);
 }
+
+void UBEGlobalAbilitySystem::FlushPendingApplications()
+{
+	ProcessPendingApplications(0.0);
+}
+
+void UBEGlobalAbilitySystem::QueueApplication(UBEAbilitySystemComponent* ASC, TSubclassOf<UGameplayAbility> Ability, TSubclassOf<UGameplayEffect> Effect)
+{
+	FPendingGlobalApplication& Pending = PendingApplications.AddDefaulted_GetRef();
+	Pending.ASC = ASC;
+	Pending.Ability = Ability;
+	Pending.Effect = Effect;
+}
+
+void UBEGlobalAbilitySystem::ProcessPendingApplications(double TimeLimitSeconds)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_BEGlobalAbilitySystem_ProcessPendingApplications);
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	while (PendingApplicationsHead < PendingApplications.Num())
+	{
+		// Copy, applying can queue more (e.g. an ability that registers another ASC)
+		const FPendingGlobalApplication Pending = PendingApplications[PendingApplicationsHead++];
+		ApplyPendingApplication(Pending);
+
+		if ((TimeLimitSeconds > 0.0) && ((FPlatformTime::Seconds() - StartTime) > TimeLimitSeconds))
+		{
+			break;
+		}
+	}
+
+	// Compact once the queue has drained, or once the given out entries make up most of it
+	if (PendingApplicationsHead >= PendingApplications.Num())
+	{
+		PendingApplications.Reset();
+		PendingApplicationsHead = 0;
+	}
+	else if (PendingApplicationsHead > (PendingApplications.Num() / 2))
+	{
+		PendingApplications.RemoveAt(0, PendingApplicationsHead, /*bAllowShrinking=*/ false);
+		PendingApplicationsHead = 0;
+	}
+}
+
+void UBEGlobalAbilitySystem::ApplyPendingApplication(const FPendingGlobalApplication& Pending)
+{
+	// The ASC may have unregistered, or the ability/effect been removed, while this was queued
+	UBEAbilitySystemComponent* ASC = Pending.ASC.Get();
+	if (!ASC || !RegisteredASCs.Contains(ASC))
+	{
+		return;
+	}
+
+	if (Pending.Ability)
+	{
+		if (FGlobalAppliedAbilityList* Entry = AppliedAbilities.Find(Pending.Ability))
+		{
+			Entry->AddToASC(Pending.Ability, ASC);
+		}
+	}
+	else if (Pending.Effect)
+	{
+		if (FGlobalAppliedEffectList* Entry = AppliedEffects.Find(Pending.Effect))
+		{
+			Entry->AddToASC(Pending.Effect, ASC);
+		}
+	}
+}
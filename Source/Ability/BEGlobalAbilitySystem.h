@@ -7,8 +7,10 @@
 
 #include "Containers/Array.h"
 #include "Containers/Map.h"
+#include "Containers/Set.h"
 #include "Containers/SparseArray.h"
 #include "GameplayAbilitySpec.h"
+#include "GameplayTagContainer.h"
 #include "Templates/SubclassOf.h"
 #include "UObject/UObjectGlobals.h"
 
@@ -44,19 +46,57 @@ struct FGlobalAppliedEffectList
 	UPROPERTY()
 	TMap<UBEAbilitySystemComponent*, FActiveGameplayEffectHandle> Handles;
 
+	// Effects that only grant tags are shared: their tags are added to each ASC as loose tags instead of applying an effect
+	UPROPERTY()
+	TSet<TObjectPtr<UBEAbilitySystemComponent>> SharedTagASCs;
+
+	UPROPERTY()
+	FGameplayTagContainer SharedTags;
+
+	bool bShareTags = false;
+
+	void Initialize(TSubclassOf<UGameplayEffect> Effect);
+	bool IsAppliedToASC(UBEAbilitySystemComponent* ASC) const;
 	void AddToASC(TSubclassOf<UGameplayEffect> Effect, UBEAbilitySystemComponent* ASC);
 	void RemoveFromASC(UBEAbilitySystemComponent* ASC);
 	void RemoveFromAll();
 };
 
+/** A global ability or effect waiting to be given to an ASC */
+USTRUCT()
+struct FPendingGlobalApplication
+{
+	GENERATED_BODY()
+
+	TWeakObjectPtr<UBEAbilitySystemComponent> ASC;
+
+	UPROPERTY()
+	TSubclassOf<UGameplayAbility> Ability;
+
+	UPROPERTY()
+	TSubclassOf<UGameplayEffect> Effect;
+};
+
+/**
+ * UBEGlobalAbilitySystem
+ *
+ *	Gives abilities and effects to every registered ASC.
+ *	Applications are queued and given out over several frames within a time budget (BE.GlobalAbilitySystem.BudgetMs),
+ *	removals happen right away.
+ */
 UCLASS()
-class UBEGlobalAbilitySystem : public UWorldSubsystem
+class UBEGlobalAbilitySystem : public UTickableWorldSubsystem
 {
 	GENERATED_BODY()
 
 public:
 	UBEGlobalAbilitySystem();
 
+	//~FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	//~End of FTickableGameObject interface
+
 	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category="BE")
 	void ApplyAbilityToAll(TSubclassOf<UGameplayAbility> Ability);
 
@@ -75,6 +115,17 @@ public:
 	/** Removes an ASC from the global system, along with any active global effects/abilities. */
 	void UnregisterASC(UBEAbilitySystemComponent* ASC);
 
+	/** Gives out every queued application right away */
+	void FlushPendingApplications();
+
+private:
+	void QueueApplication(UBEAbilitySystemComponent* ASC, TSubclassOf<UGameplayAbility> Ability, TSubclassOf<UGameplayEffect> Effect);
+
+	/** Gives out queued applications until the time limit is reached, at least one is always given out. A limit of 0 or less gives out all of them. */
+	void ProcessPendingApplications(double TimeLimitSeconds);
+
+	void ApplyPendingApplication(const FPendingGlobalApplication& Pending);
+
 private:
 	UPROPERTY()
 	TMap<TSubclassOf<UGameplayAbility>, FGlobalAppliedAbilityList> AppliedAbilities;
@@ -83,5 +134,11 @@ private:
 	TMap<TSubclassOf<UGameplayEffect>, FGlobalAppliedEffectList> AppliedEffects;
 
 	UPROPERTY()
-	TArray<TObjectPtr<UBEAbilitySystemComponent>> RegisteredASCs;
+	TSet<TObjectPtr<UBEAbilitySystemComponent>> RegisteredASCs;
+
+	// FIFO, entries before PendingApplicationsHead have been given out
+	UPROPERTY()
+	TArray<FPendingGlobalApplication> PendingApplications;
+
+	int32 PendingApplicationsHead = 0;
 };
@@ -0,0 +1,336 @@
+// Copyright Eigi Chin
+
+#include "BEGameplayAbilityTargetDataNetSerializer.h"
+
+#include "Ability/Target/BEGameplayAbilityTargetData_SingleTargetHit.h"
+
+#include "Components/PrimitiveComponent.h"
+#include "Components/SkinnedMeshComponent.h"
+#include "PhysicalMaterials/PhysicalMaterial.h"
+
+#if UE_WITH_IRIS
+#include "Iris/ReplicationState/PropertyNetSerializerInfoRegistry.h"
+#include "Iris/ReplicationState/ReplicationStateDescriptorBuilder.h"
+#include "Iris/Serialization/NetBitStreamReader.h"
+#include "Iris/Serialization/NetBitStreamUtil.h"
+#include "Iris/Serialization/NetBitStreamWriter.h"
+#include "Iris/Serialization/NetSerializerDelegates.h"
+#include "Iris/Serialization/NetSerializers.h"
+#endif
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(BEGameplayAbilityTargetDataNetSerializer)
+
+
+//////////////////////////////////////////////////////////////////////
+
+namespace BETargetDataSerialization
+{
+	void HitResultToNetState(const FHitResult& Hit, FBEHitResultNetState& OutState, uint32& OutPackedBoneIndex)
+	{
+		OutState.Actor = Hit.GetActor();
+		OutState.Component = Hit.GetComponent();
+		OutState.PhysMaterial = Hit.PhysMaterial.Get();
+
+		OutState.TraceStart = Hit.TraceStart;
+		OutState.TraceEndOffset = Hit.TraceEnd - Hit.TraceStart;
+		OutState.ImpactPointOffset = Hit.ImpactPoint - Hit.TraceStart;
+		OutState.LocationOffset = Hit.Location - Hit.ImpactPoint;
+		OutState.ImpactNormal = Hit.ImpactNormal;
+		OutState.Normal = Hit.Normal;
+
+		OutState.bBlockingHit = Hit.bBlockingHit;
+		OutState.bStartPenetrating = Hit.bStartPenetrating;
+
+		int32 BoneIndex = INDEX_NONE;
+		if (Hit.BoneName != NAME_None)
+		{
+			if (const USkinnedMeshComponent* SkinnedComponent = Cast<USkinnedMeshComponent>(Hit.GetComponent()))
+			{
+				BoneIndex = SkinnedComponent->GetBoneIndex(Hit.BoneName);
+			}
+		}
+
+		OutPackedBoneIndex = static_cast<uint32>(BoneIndex + 1);
+	}
+
+	void NetStateToHitResult(const FBEHitResultNetState& State, uint32 PackedBoneIndex, FHitResult& OutHit)
+	{
+		OutHit.HitObjectHandle = FActorInstanceHandle(State.Actor.Get());
+		OutHit.Component = State.Component.Get();
+		OutHit.PhysMaterial = State.PhysMaterial.Get();
+
+		OutHit.TraceStart = State.TraceStart;
+		OutHit.TraceEnd = State.TraceStart + State.TraceEndOffset;
+		OutHit.ImpactPoint = State.TraceStart + State.ImpactPointOffset;
+		OutHit.Location = OutHit.ImpactPoint + State.LocationOffset;
+		OutHit.ImpactNormal = State.ImpactNormal;
+		OutHit.Normal = State.Normal;
+
+		OutHit.bBlockingHit = State.bBlockingHit;
+		OutHit.bStartPenetrating = State.bStartPenetrating;
+
+		const USkinnedMeshComponent* SkinnedComponent = Cast<USkinnedMeshComponent>(State.Component.Get());
+		OutHit.BoneName = (SkinnedComponent && (PackedBoneIndex > 0)) ? SkinnedComponent->GetBoneName(static_cast<int32>(PackedBoneIndex) - 1) : NAME_None;
+
+		RebuildDerivedHitFields(OutHit);
+	}
+}
+
+
+
+#if UE_WITH_IRIS
+namespace UE::Net
+{
+	/**
+	 * Native Iris serializer for FBEGameplayAbilityTargetData_SingleTargetHit.
+	 * The hit is quantized through the FBEHitResultNetState descriptor,
+	 * the cartridge ID and bone index are written as packed ints next to it.
+	 */
+	struct FBESingleTargetHitNetSerializer
+	{
+		static const uint32 Version = 0;
+
+		static constexpr bool bIsForwardingSerializer = true;
+		static constexpr bool bHasCustomNetReference = true;
+
+		struct FQuantizedType
+		{
+			alignas(16) uint8 HitState[256];
+			uint32 PackedCartridgeID;
+			uint32 PackedBoneIndex;
+		};
+
+		typedef FBEGameplayAbilityTargetData_SingleTargetHit SourceType;
+		typedef FQuantizedType QuantizedType;
+		typedef FNetSerializerConfig ConfigType;
+
+		static const ConfigType DefaultConfig;
+
+		static void Serialize(FNetSerializationContext& Context, const FNetSerializeArgs& Args);
+		static void Deserialize(FNetSerializationContext& Context, const FNetDeserializeArgs& Args);
+
+		static void SerializeDelta(FNetSerializationContext& Context, const FNetSerializeDeltaArgs& Args);
+		static void DeserializeDelta(FNetSerializationContext& Context, const FNetDeserializeDeltaArgs& Args);
+
+		static void Quantize(FNetSerializationContext& Context, const FNetQuantizeArgs& Args);
+		static void Dequantize(FNetSerializationContext& Context, const FNetDequantizeArgs& Args);
+
+		static bool IsEqual(FNetSerializationContext& Context, const FNetIsEqualArgs& Args);
+		static bool Validate(FNetSerializationContext& Context, const FNetValidateArgs& Args);
+
+		static void CollectNetReferences(FNetSerializationContext& Context, const FNetCollectReferencesArgs& Args);
+
+	private:
+		static void SourceToState(const SourceType& Source, FBEHitResultNetState& OutState, uint32& OutPackedBoneIndex);
+		static void StateToSource(const FBEHitResultNetState& State, uint32 PackedBoneIndex, SourceType& OutSource);
+
+		class FNetSerializerRegistryDelegates final : private UE::Net::FNetSerializerRegistryDelegates
+		{
+		public:
+			virtual ~FNetSerializerRegistryDelegates();
+
+		private:
+			virtual void OnPreFreezeNetSerializerRegistry() override;
+			virtual void OnPostFreezeNetSerializerRegistry() override;
+		};
+
+		static FBESingleTargetHitNetSerializer::FNetSerializerRegistryDelegates NetSerializerRegistryDelegates;
+
+		static FStructNetSerializerConfig StructNetSerializerConfig;
+		static const FNetSerializer* StructNetSerializer;
+	};
+
+	UE_NET_DECLARE_SERIALIZER(FBESingleTargetHitNetSerializer, BECORE_API);
+	UE_NET_IMPLEMENT_SERIALIZER(FBESingleTargetHitNetSerializer);
+
+	const FBESingleTargetHitNetSerializer::ConfigType FBESingleTargetHitNetSerializer::DefaultConfig;
+	FBESingleTargetHitNetSerializer::FNetSerializerRegistryDelegates FBESingleTargetHitNetSerializer::NetSerializerRegistryDelegates;
+	FStructNetSerializerConfig FBESingleTargetHitNetSerializer::StructNetSerializerConfig;
+	const FNetSerializer* FBESingleTargetHitNetSerializer::StructNetSerializer = &UE_NET_GET_SERIALIZER(FStructNetSerializer);
+
+	static const FName PropertyNetSerializerRegistry_NAME_BEGameplayAbilityTargetData_SingleTargetHit("BEGameplayAbilityTargetData_SingleTargetHit");
+	UE_NET_IMPLEMENT_NAMED_STRUCT_NETSERIALIZER_INFO(PropertyNetSerializerRegistry_NAME_BEGameplayAbilityTargetData_SingleTargetHit, FBESingleTargetHitNetSerializer);
+
+	void FBESingleTargetHitNetSerializer::SourceToState(const SourceType& Source, FBEHitResultNetState& OutState, uint32& OutPackedBoneIndex)
+	{
+		BETargetDataSerialization::HitResultToNetState(Source.HitResult, OutState, OutPackedBoneIndex);
+	}
+
+	void FBESingleTargetHitNetSerializer::StateToSource(const FBEHitResultNetState& State, uint32 PackedBoneIndex, SourceType& OutSource)
+	{
+		BETargetDataSerialization::NetStateToHitResult(State, PackedBoneIndex, OutSource.HitResult);
+	}
+
+	void FBESingleTargetHitNetSerializer::Serialize(FNetSerializationContext& Context, const FNetSerializeArgs& Args)
+	{
+		const QuantizedType& Value = *reinterpret_cast<const QuantizedType*>(Args.Source);
+
+		FNetBitStreamWriter* Writer = Context.GetBitStreamWriter();
+		WritePackedUint32(Writer, Value.PackedCartridgeID);
+		WritePackedUint32(Writer, Value.PackedBoneIndex);
+
+		FNetSerializeArgs StructArgs = Args;
+		StructArgs.NetSerializerConfig = &StructNetSerializerConfig;
+		StructArgs.Source = NetSerializerValuePointer(&Value.HitState);
+		StructNetSerializer->Serialize(Context, StructArgs);
+	}
+
+	void FBESingleTargetHitNetSerializer::Deserialize(FNetSerializationContext& Context, const FNetDeserializeArgs& Args)
+	{
+		QuantizedType& Target = *reinterpret_cast<QuantizedType*>(Args.Target);
+
+		FNetBitStreamReader* Reader = Context.GetBitStreamReader();
+		Target.PackedCartridgeID = ReadPackedUint32(Reader);
+		Target.PackedBoneIndex = ReadPackedUint32(Reader);
+
+		FNetDeserializeArgs StructArgs = Args;
+		StructArgs.NetSerializerConfig = &StructNetSerializerConfig;
+		StructArgs.Target = NetSerializerValuePointer(&Target.HitState);
+		StructNetSerializer->Deserialize(Context, StructArgs);
+	}
+
+	void FBESingleTargetHitNetSerializer::SerializeDelta(FNetSerializationContext& Context, const FNetSerializeDeltaArgs& Args)
+	{
+		// Target data is sent through RPCs and never delta compressed
+		Serialize(Context, Args);
+	}
+
+	void FBESingleTargetHitNetSerializer::DeserializeDelta(FNetSerializationContext& Context, const FNetDeserializeDeltaArgs& Args)
+	{
+		Deserialize(Context, Args);
+	}
+
+	void FBESingleTargetHitNetSerializer::Quantize(FNetSerializationContext& Context, const FNetQuantizeArgs& Args)
+	{
+		const SourceType& Source = *reinterpret_cast<const SourceType*>(Args.Source);
+		QuantizedType& Target = *reinterpret_cast<QuantizedType*>(Args.Target);
+
+		FBEHitResultNetState State;
+		SourceToState(Source, State, Target.PackedBoneIndex);
+		Target.PackedCartridgeID = static_cast<uint32>(Source.CartridgeID + 1);
+
+		FNetQuantizeArgs StructArgs = Args;
+		StructArgs.NetSerializerConfig = &StructNetSerializerConfig;
+		StructArgs.Source = NetSerializerValuePointer(&State);
+		StructArgs.Target = NetSerializerValuePointer(&Target.HitState);
+		StructNetSerializer->Quantize(Context, StructArgs);
+	}
+
+	void FBESingleTargetHitNetSerializer::Dequantize(FNetSerializationContext& Context, const FNetDequantizeArgs& Args)
+	{
+		const QuantizedType& Source = *reinterpret_cast<const QuantizedType*>(Args.Source);
+		SourceType& Target = *reinterpret_cast<SourceType*>(Args.Target);
+
+		FBEHitResultNetState State;
+
+		FNetDequantizeArgs StructArgs = Args;
+		StructArgs.NetSerializerConfig = &StructNetSerializerConfig;
+		StructArgs.Source = NetSerializerValuePointer(&Source.HitState);
+		StructArgs.Target = NetSerializerValuePointer(&State);
+		StructNetSerializer->Dequantize(Context, StructArgs);
+
+		StateToSource(State, Source.PackedBoneIndex, Target);
+		Target.CartridgeID = static_cast<int32>(Source.PackedCartridgeID) - 1;
+	}
+
+	bool FBESingleTargetHitNetSerializer::IsEqual(FNetSerializationContext& Context, const FNetIsEqualArgs& Args)
+	{
+		if (Args.bStateIsQuantized)
+		{
+			const QuantizedType& Value0 = *reinterpret_cast<const QuantizedType*>(Args.Source0);
+			const QuantizedType& Value1 = *reinterpret_cast<const QuantizedType*>(Args.Source1);
+
+			if ((Value0.PackedCartridgeID != Value1.PackedCartridgeID) || (Value0.PackedBoneIndex != Value1.PackedBoneIndex))
+			{
+				return false;
+			}
+
+			FNetIsEqualArgs StructArgs = Args;
+			StructArgs.NetSerializerConfig = &StructNetSerializerConfig;
+			StructArgs.Source0 = NetSerializerValuePointer(&Value0.HitState);
+			StructArgs.Source1 = NetSerializerValuePointer(&Value1.HitState);
+			return StructNetSerializer->IsEqual(Context, StructArgs);
+		}
+		else
+		{
+			const SourceType& Value0 = *reinterpret_cast<const SourceType*>(Args.Source0);
+			const SourceType& Value1 = *reinterpret_cast<const SourceType*>(Args.Source1);
+
+			if (Value0.CartridgeID != Value1.CartridgeID)
+			{
+				return false;
+			}
+
+			FBEHitResultNetState State0;
+			FBEHitResultNetState State1;
+			uint32 PackedBoneIndex0 = 0;
+			uint32 PackedBoneIndex1 = 0;
+			SourceToState(Value0, State0, PackedBoneIndex0);
+			SourceToState(Value1, State1, PackedBoneIndex1);
+
+			if (PackedBoneIndex0 != PackedBoneIndex1)
+			{
+				return false;
+			}
+
+			FNetIsEqualArgs StructArgs = Args;
+			StructArgs.NetSerializerConfig = &StructNetSerializerConfig;
+			StructArgs.Source0 = NetSerializerValuePointer(&State0);
+			StructArgs.Source1 = NetSerializerValuePointer(&State1);
+			return StructNetSerializer->IsEqual(Context, StructArgs);
+		}
+	}
+
+	bool FBESingleTargetHitNetSerializer::Validate(FNetSerializationContext& Context, const FNetValidateArgs& Args)
+	{
+		const SourceType& Source = *reinterpret_cast<const SourceType*>(Args.Source);
+
+		FBEHitResultNetState State;
+		uint32 PackedBoneIndex = 0;
+		SourceToState(Source, State, PackedBoneIndex);
+
+		FNetValidateArgs StructArgs = Args;
+		StructArgs.NetSerializerConfig = &StructNetSerializerConfig;
+		StructArgs.Source = NetSerializerValuePointer(&State);
+		return StructNetSerializer->Validate(Context, StructArgs);
+	}
+
+	void FBESingleTargetHitNetSerializer::CollectNetReferences(FNetSerializationContext& Context, const FNetCollectReferencesArgs& Args)
+	{
+		const QuantizedType& Value = *reinterpret_cast<const QuantizedType*>(Args.Source);
+
+		FNetCollectReferencesArgs StructArgs = Args;
+		StructArgs.NetSerializerConfig = &StructNetSerializerConfig;
+		StructArgs.Source = NetSerializerValuePointer(&Value.HitState);
+		StructNetSerializer->CollectNetReferences(Context, StructArgs);
+	}
+
+	FBESingleTargetHitNetSerializer::FNetSerializerRegistryDelegates::~FNetSerializerRegistryDelegates()
+	{
+		UE_NET_UNREGISTER_NETSERIALIZER_INFO(PropertyNetSerializerRegistry_NAME_BEGameplayAbilityTargetData_SingleTargetHit);
+	}
+
+	void FBESingleTargetHitNetSerializer::FNetSerializerRegistryDelegates::OnPreFreezeNetSerializerRegistry()
+	{
+		UE_NET_REGISTER_NETSERIALIZER_INFO(PropertyNetSerializerRegistry_NAME_BEGameplayAbilityTargetData_SingleTargetHit);
+	}
+
+	void FBESingleTargetHitNetSerializer::FNetSerializerRegistryDelegates::OnPostFreezeNetSerializerRegistry()
+	{
+		// The registry must be frozen before descriptors for structs using registered serializers (vectors, object references) can be built
+		FReplicationStateDescriptorBuilder::FParameters Params;
+		StructNetSerializerConfig.StateDescriptor = FReplicationStateDescriptorBuilder::CreateDescriptorForStruct(FBEHitResultNetState::StaticStruct(), Params);
+
+		const FReplicationStateDescriptor* Descriptor = StructNetSerializerConfig.StateDescriptor.GetReference();
+		check(Descriptor != nullptr);
+
+		// The quantized hit state is stored inline, make sure it fits
+		checkf((Descriptor->InternalSize <= sizeof(FQuantizedType::HitState)) && (Descriptor->InternalAlignment <= alignof(FQuantizedType)),
+			TEXT("FBESingleTargetHitNetSerializer::FQuantizedType::HitState is too small (%u bytes, alignment %u) for the quantized hit state (%u bytes, alignment %u)"),
+			uint32(sizeof(FQuantizedType::HitState)), uint32(alignof(FQuantizedType)), uint32(Descriptor->InternalSize), uint32(Descriptor->InternalAlignment));
+
+		// The inline state can't own dynamic allocations
+		check(!EnumHasAnyFlags(Descriptor->Traits, EReplicationStateTraits::HasDynamicState));
+	}
+}
+#endif
@@ -0,0 +1,65 @@
+// Copyright Eigi Chin
+
+#pragma once
+
+#include "Engine/NetSerialization.h"
+
+#include "UObject/ObjectPtr.h"
+
+#include "BEGameplayAbilityTargetDataNetSerializer.generated.h"
+
+class AActor;
+class UPhysicalMaterial;
+class UPrimitiveComponent;
+
+
+/**
+ * Replicated members of the compact hit encoding, used to build the Iris state descriptors of the BE hit target data and effect context serializers.
+ * Mirrors BETargetDataSerialization::SerializeCompactHit, except that bones without a skeleton index are not sent
+ * since FName needs dynamic state, which the inline quantized state can't hold.
+ */
+USTRUCT()
+struct FBEHitResultNetState
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TObjectPtr<AActor> Actor = nullptr;
+
+	UPROPERTY()
+	TObjectPtr<UPrimitiveComponent> Component = nullptr;
+
+	UPROPERTY()
+	TObjectPtr<UPhysicalMaterial> PhysMaterial = nullptr;
+
+	UPROPERTY()
+	FVector_NetQuantize10 TraceStart = FVector::ZeroVector;
+
+	UPROPERTY()
+	FVector_NetQuantize10 TraceEndOffset = FVector::ZeroVector;
+
+	UPROPERTY()
+	FVector_NetQuantize10 ImpactPointOffset = FVector::ZeroVector;
+
+	UPROPERTY()
+	FVector_NetQuantize10 LocationOffset = FVector::ZeroVector;
+
+	UPROPERTY()
+	FVector_NetQuantizeNormal ImpactNormal = FVector::ZeroVector;
+
+	UPROPERTY()
+	FVector_NetQuantizeNormal Normal = FVector::ZeroVector;
+
+	UPROPERTY()
+	bool bBlockingHit = false;
+
+	UPROPERTY()
+	bool bStartPenetrating = false;
+};
+
+namespace BETargetDataSerialization
+{
+	// Converts between a hit result and its replicated state. Bone index 0 means no bone index was sent.
+	void HitResultToNetState(const FHitResult& Hit, FBEHitResultNetState& OutState, uint32& OutPackedBoneIndex);
+	void NetStateToHitResult(const FBEHitResultNetState& State, uint32 PackedBoneIndex, FHitResult& OutHit);
+}
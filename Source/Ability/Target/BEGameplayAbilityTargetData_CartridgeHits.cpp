@@ -0,0 +1,221 @@
+// Copyright Eigi Chin
+
+#include "BEGameplayAbilityTargetData_CartridgeHits.h"
+
+#include "Ability/BEGameplayEffectContext.h"
+#include "Ability/Target/BEGameplayAbilityTargetData_SingleTargetHit.h"
+#include "BELogChannels.h"
+
+#include "Engine/NetSerialization.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+#include "Serialization/Archive.h"
+#include "UObject/CoreNet.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(BEGameplayAbilityTargetData_CartridgeHits)
+
+
+//////////////////////////////////////////////////////////////////////
+
+namespace BETargetDataSerialization
+{
+	// Upper bound for hits received in a single cartridge, protects the server against bogus counts
+	static constexpr uint32 MaxCartridgeHits = 64;
+}
+
+TArray<TWeakObjectPtr<AActor>> FBEGameplayAbilityTargetData_CartridgeHits::GetActors() const
+{
+	TArray<TWeakObjectPtr<AActor>> Actors;
+
+	for (const FHitResult& Hit : HitResults)
+	{
+		if (AActor* HitActor = Hit.HitObjectHandle.FetchActor())
+		{
+			Actors.AddUnique(HitActor);
+		}
+	}
+
+	return Actors;
+}
+
+void FBEGameplayAbilityTargetData_CartridgeHits::AddTargetDataToContext(FGameplayEffectContextHandle& Context, bool bIncludeActorArray) const
+{
+	FGameplayAbilityTargetData::AddTargetDataToContext(Context, bIncludeActorArray);
+
+	// Add game-specific data
+	if (FBEGameplayEffectContext* TypedContext = FBEGameplayEffectContext::ExtractEffectContext(Context))
+	{
+		TypedContext->CartridgeID = CartridgeID;
+	}
+}
+
+bool FBEGameplayAbilityTargetData_CartridgeHits::NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
+{
+	// Shared header
+
+	bOutSuccess = SerializePackedVector<10, 24>(TraceStart, Ar);
+
+	uint32 PackedCartridgeID = static_cast<uint32>(CartridgeID + 1);
+	Ar.SerializeIntPacked(PackedCartridgeID);
+	CartridgeID = static_cast<int32>(PackedCartridgeID) - 1;
+
+	// Only sent when set, used by the server to rewind the hitboxes (see UBELagCompensationSubsystem)
+	uint8 bHasClientTimestamp = (ClientTimestamp >= 0.0) ? 1 : 0;
+	Ar.SerializeBits(&bHasClientTimestamp, 1);
+
+	if (bHasClientTimestamp)
+	{
+		Ar << ClientTimestamp;
+	}
+	else
+	{
+		ClientTimestamp = -1.0;
+	}
+
+	uint32 NumHits = static_cast<uint32>(HitResults.Num());
+	Ar.SerializeIntPacked(NumHits);
+
+	if (Ar.IsLoading())
+	{
+		if (NumHits > BETargetDataSerialization::MaxCartridgeHits)
+		{
+			Ar.SetError();
+			bOutSuccess = false;
+			return false;
+		}
+
+		HitResults.SetNum(NumHits);
+	}
+
+	// Hits relative to the shared trace start
+
+	for (FHitResult& Hit : HitResults)
+	{
+		bOutSuccess &= BETargetDataSerialization::SerializeCompactHit(Ar, Map, Hit, TraceStart);
+	}
+
+	return true;
+}
+
+
+//////////////////////////////////////////////////////////////////////
+
+namespace BETargetDataSerialization
+{
+	static void BuildTestHits(int32 NumHits, const FVector& TraceStart, TArray<FHitResult>& OutHits)
+	{
+		FRandomStream RandomStream(1234);
+
+		const FVector AimDirection = FVector(1.0, 0.2, -0.05).GetSafeNormal();
+
+		for (int32 Index = 0; Index < NumHits; ++Index)
+		{
+			const FVector Direction = RandomStream.VRandCone(AimDirection, FMath::DegreesToRadians(6.0f));
+			const double Distance = RandomStream.FRandRange(500.0f, 3000.0f);
+
+			FHitResult& Hit = OutHits.AddDefaulted_GetRef();
+			Hit.bBlockingHit = true;
+			Hit.TraceStart = TraceStart;
+			Hit.TraceEnd = TraceStart + Direction * 10000.0;
+			Hit.ImpactPoint = TraceStart + Direction * Distance;
+			Hit.Location = Hit.ImpactPoint;
+			Hit.ImpactNormal = (-Direction + RandomStream.VRand() * 0.3).GetSafeNormal();
+			Hit.Normal = Hit.ImpactNormal;
+			Hit.Distance = static_cast<float>(Distance);
+			Hit.Time = static_cast<float>(Distance / 10000.0);
+		}
+	}
+
+	static bool HitsMatch(const FHitResult& A, const FHitResult& B)
+	{
+		return A.ImpactPoint.Equals(B.ImpactPoint, 0.1)
+			&& A.Location.Equals(B.Location, 0.1)
+			&& A.TraceEnd.Equals(B.TraceEnd, 0.1)
+			&& A.ImpactNormal.Equals(B.ImpactNormal, 0.001)
+			&& (A.bBlockingHit == B.bBlockingHit)
+			&& FMath::IsNearlyEqual(A.Distance, B.Distance, 0.2f);
+	}
+
+	static void MeasureHitSerialization(const TArray<FString>& Args)
+	{
+		const int32 NumPellets = FMath::Clamp(Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 12, 1, static_cast<int32>(MaxCartridgeHits));
+		const FVector TraceStart(12345.6, -6543.2, 180.0);
+
+		// The base package map doesn't write object references, they cost the same in every encoding so only the hit data is compared
+		UPackageMap* PackageMap = NewObject<UPackageMap>();
+		bool bSuccess = true;
+
+		TArray<FHitResult> Hits;
+		BuildTestHits(NumPellets, TraceStart, Hits);
+
+		// Previous encoding: one full FHitResult plus a raw int32 per pellet
+
+		int64 LegacyBits = 0;
+		for (FHitResult& Hit : Hits)
+		{
+			FNetBitWriter Writer(PackageMap, 8192);
+			Hit.NetSerialize(Writer, PackageMap, bSuccess);
+
+			int32 CartridgeID = 7;
+			Writer << CartridgeID;
+
+			LegacyBits += Writer.GetNumBits();
+		}
+
+		// Compact single hits, one per pellet
+
+		int64 SingleBits = 0;
+		bool bSingleRoundTrip = true;
+		for (const FHitResult& Hit : Hits)
+		{
+			FBEGameplayAbilityTargetData_SingleTargetHit TargetData;
+			TargetData.HitResult = Hit;
+			TargetData.CartridgeID = 7;
+
+			FNetBitWriter Writer(PackageMap, 8192);
+			TargetData.NetSerialize(Writer, PackageMap, bSuccess);
+			SingleBits += Writer.GetNumBits();
+
+			FNetBitReader Reader(PackageMap, Writer.GetData(), Writer.GetNumBits());
+			FBEGameplayAbilityTargetData_SingleTargetHit Received;
+			Received.NetSerialize(Reader, PackageMap, bSuccess);
+
+			bSingleRoundTrip &= !Reader.IsError() && (Received.CartridgeID == TargetData.CartridgeID) && HitsMatch(Hit, Received.HitResult);
+		}
+
+		// Compact cartridge, one header shared by all pellets
+
+		int64 CartridgeBits = 0;
+		bool bCartridgeRoundTrip = true;
+		{
+			FBEGameplayAbilityTargetData_CartridgeHits TargetData;
+			TargetData.TraceStart = TraceStart;
+			TargetData.HitResults = Hits;
+			TargetData.CartridgeID = 7;
+
+			FNetBitWriter Writer(PackageMap, 8192);
+			TargetData.NetSerialize(Writer, PackageMap, bSuccess);
+			CartridgeBits = Writer.GetNumBits();
+
+			FNetBitReader Reader(PackageMap, Writer.GetData(), Writer.GetNumBits());
+			FBEGameplayAbilityTargetData_CartridgeHits Received;
+			Received.NetSerialize(Reader, PackageMap, bSuccess);
+
+			bCartridgeRoundTrip &= !Reader.IsError() && (Received.CartridgeID == TargetData.CartridgeID) && (Received.HitResults.Num() == Hits.Num());
+			for (int32 Index = 0; bCartridgeRoundTrip && (Index < Hits.Num()); ++Index)
+			{
+				bCartridgeRoundTrip &= HitsMatch(Hits[Index], Received.HitResults[Index]);
+			}
+		}
+
+		UE_LOG(LogBEAbilitySystem, Display, TEXT("Hit target data serialization, %d pellets per shot:"), NumPellets);
+		UE_LOG(LogBEAbilitySystem, Display, TEXT("  FHitResult + int32 per pellet : %6lld bytes per shot"), FMath::DivideAndRoundUp<int64>(LegacyBits, 8));
+		UE_LOG(LogBEAbilitySystem, Display, TEXT("  Compact single hit per pellet : %6lld bytes per shot (round trip %s)"), FMath::DivideAndRoundUp<int64>(SingleBits, 8), bSingleRoundTrip ? TEXT("ok") : TEXT("FAILED"));
+		UE_LOG(LogBEAbilitySystem, Display, TEXT("  Compact cartridge             : %6lld bytes per shot (round trip %s)"), FMath::DivideAndRoundUp<int64>(CartridgeBits, 8), bCartridgeRoundTrip ? TEXT("ok") : TEXT("FAILED"));
+	}
+
+	static FAutoConsoleCommand CmdMeasureHitSerialization(
+		TEXT("BE.TargetData.MeasureHitSerialization"),
+		TEXT("Round trips sample hit target data through the compact encodings and compares bytes per shot with the full FHitResult encoding. Usage: BE.TargetData.MeasureHitSerialization [NumPellets=12]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(MeasureHitSerialization));
+}
@@ -0,0 +1,70 @@
+// Copyright Eigi Chin
+
+#pragma once
+
+#include "Abilities/GameplayAbilityTargetTypes.h"
+
+#include "HAL/Platform.h"
+#include "UObject/Class.h"
+
+#include "BEGameplayAbilityTargetData_CartridgeHits.generated.h"
+
+class FArchive;
+struct FGameplayEffectContextHandle;
+
+
+/**
+ * Target data for every bullet of a single cartridge (e.g. the pellets of a shotgun blast).
+ * The trace start and cartridge ID are sent once and each hit uses the compact encoding relative to the shared trace start,
+ * instead of sending one FBEGameplayAbilityTargetData_SingleTargetHit with a full header per pellet.
+ */
+USTRUCT()
+struct FBEGameplayAbilityTargetData_CartridgeHits : public FGameplayAbilityTargetData
+{
+	GENERATED_BODY()
+
+	FBEGameplayAbilityTargetData_CartridgeHits()
+		: CartridgeID(-1)
+	{ }
+
+	//~FGameplayAbilityTargetData interface
+	virtual TArray<TWeakObjectPtr<AActor>> GetActors() const override;
+	virtual bool HasHitResult() const override { return HitResults.Num() > 0; }
+	virtual const FHitResult* GetHitResult() const override { return HitResults.Num() > 0 ? &HitResults[0] : nullptr; }
+	virtual bool HasOrigin() const override { return true; }
+	virtual FTransform GetOrigin() const override { return FTransform(TraceStart); }
+	virtual void AddTargetDataToContext(FGameplayEffectContextHandle& Context, bool bIncludeActorArray) const override;
+	//~End of FGameplayAbilityTargetData interface
+
+	/** Trace start shared by all hits, the hits' own TraceStart is overwritten with it when received */
+	UPROPERTY()
+	FVector TraceStart = FVector::ZeroVector;
+
+	/** One hit per bullet of the cartridge */
+	UPROPERTY()
+	TArray<FHitResult> HitResults;
+
+	/** ID to allow the identification of multiple bullets that were part of the same cartridge */
+	UPROPERTY()
+	int32 CartridgeID;
+
+	/** Server world time of the state the shooter saw when firing (see UBELagCompensationSubsystem::GetClientViewTime), negative if not set */
+	UPROPERTY()
+	double ClientTimestamp = -1.0;
+
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
+	virtual UScriptStruct* GetScriptStruct() const override
+	{
+		return FBEGameplayAbilityTargetData_CartridgeHits::StaticStruct();
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FBEGameplayAbilityTargetData_CartridgeHits> : public TStructOpsTypeTraitsBase2<FBEGameplayAbilityTargetData_CartridgeHits>
+{
+	enum
+	{
+		WithNetSerializer = true	// For now this is REQUIRED for FGameplayAbilityTargetDataHandle net serialization to work
+	};
+};
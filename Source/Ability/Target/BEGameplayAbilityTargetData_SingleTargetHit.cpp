@@ -4,11 +4,169 @@
 #include "BEGameplayAbilityTargetData_SingleTargetHit.h"
 
 #include "Ability/BEGameplayEffectContext.h"
+#include "Components/SkinnedMeshComponent.h"
+#include "Engine/NetSerialization.h"
+#include "PhysicalMaterials/PhysicalMaterial.h"
 #include "Serialization/Archive.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(BEGameplayAbilityTargetData_SingleTargetHit)
 
 
+//////////////////////////////////////////////////////////////////////
+
+namespace BETargetDataSerialization
+{
+	enum ECompactHitFlags : uint16
+	{
+		BlockingHit			= 1 << 0,
+		StartPenetrating	= 1 << 1,
+		HasActor			= 1 << 2,
+		HasComponent		= 1 << 3,
+		HasPhysMaterial		= 1 << 4,
+		HasBoneIndex		= 1 << 5,
+		HasBoneName			= 1 << 6,
+		LocationDiffers		= 1 << 7,
+		NormalDiffers		= 1 << 8,
+	};
+
+	static constexpr int32 NumCompactHitFlags = 9;
+
+	bool SerializeCompactHit(FArchive& Ar, UPackageMap* Map, FHitResult& Hit, const FVector& TraceStart)
+	{
+		bool bOutSuccess = true;
+
+		uint16 Flags = 0;
+		UObject* HitActor = nullptr;
+		UObject* HitComponent = nullptr;
+		UObject* HitPhysMaterial = nullptr;
+		int32 BoneIndex = INDEX_NONE;
+
+		if (Ar.IsSaving())
+		{
+			HitActor = Hit.GetActor();
+			HitComponent = Hit.GetComponent();
+			HitPhysMaterial = Hit.PhysMaterial.Get();
+
+			Flags |= Hit.bBlockingHit ? BlockingHit : 0;
+			Flags |= Hit.bStartPenetrating ? StartPenetrating : 0;
+			Flags |= HitActor ? HasActor : 0;
+			Flags |= HitComponent ? HasComponent : 0;
+			Flags |= HitPhysMaterial ? HasPhysMaterial : 0;
+
+			if (Hit.BoneName != NAME_None)
+			{
+				if (const USkinnedMeshComponent* SkinnedComponent = Cast<USkinnedMeshComponent>(HitComponent))
+				{
+					BoneIndex = SkinnedComponent->GetBoneIndex(Hit.BoneName);
+				}
+
+				Flags |= (BoneIndex != INDEX_NONE) ? HasBoneIndex : HasBoneName;
+			}
+
+			Flags |= !Hit.Location.Equals(Hit.ImpactPoint, 0.1) ? LocationDiffers : 0;
+			Flags |= !Hit.Normal.Equals(Hit.ImpactNormal, 0.01) ? NormalDiffers : 0;
+		}
+
+		Ar.SerializeBits(&Flags, NumCompactHitFlags);
+
+		// Object references
+
+		if (Flags & HasActor)
+		{
+			Ar << HitActor;
+		}
+
+		if (Flags & HasComponent)
+		{
+			Ar << HitComponent;
+		}
+
+		if (Flags & HasPhysMaterial)
+		{
+			Ar << HitPhysMaterial;
+		}
+
+		// Positions, relative to the trace start so they quantize to few bits
+
+		FVector ImpactPointOffset = Hit.ImpactPoint - TraceStart;
+		bOutSuccess &= SerializePackedVector<10, 24>(ImpactPointOffset, Ar);
+
+		FVector TraceEndOffset = Hit.TraceEnd - TraceStart;
+		bOutSuccess &= SerializePackedVector<10, 24>(TraceEndOffset, Ar);
+
+		FVector LocationOffset = Hit.Location - Hit.ImpactPoint;
+		if (Flags & LocationDiffers)
+		{
+			bOutSuccess &= SerializePackedVector<10, 24>(LocationOffset, Ar);
+		}
+
+		// Normals
+
+		FVector ImpactNormal = Hit.ImpactNormal;
+		bOutSuccess &= SerializeFixedVector<1, 16>(ImpactNormal, Ar);
+
+		FVector Normal = Hit.Normal;
+		if (Flags & NormalDiffers)
+		{
+			bOutSuccess &= SerializeFixedVector<1, 16>(Normal, Ar);
+		}
+
+		// Bone
+
+		if (Flags & HasBoneIndex)
+		{
+			uint32 PackedBoneIndex = static_cast<uint32>(BoneIndex);
+			Ar.SerializeIntPacked(PackedBoneIndex);
+			BoneIndex = static_cast<int32>(PackedBoneIndex);
+		}
+		else if (Flags & HasBoneName)
+		{
+			Ar << Hit.BoneName;
+		}
+
+		if (Ar.IsLoading())
+		{
+			Hit.bBlockingHit = (Flags & BlockingHit) != 0;
+			Hit.bStartPenetrating = (Flags & StartPenetrating) != 0;
+
+			Hit.HitObjectHandle = FActorInstanceHandle(Cast<AActor>(HitActor));
+			Hit.Component = Cast<UPrimitiveComponent>(HitComponent);
+			Hit.PhysMaterial = Cast<UPhysicalMaterial>(HitPhysMaterial);
+
+			Hit.TraceStart = TraceStart;
+			Hit.TraceEnd = TraceStart + TraceEndOffset;
+			Hit.ImpactPoint = TraceStart + ImpactPointOffset;
+			Hit.Location = (Flags & LocationDiffers) ? (Hit.ImpactPoint + LocationOffset) : Hit.ImpactPoint;
+
+			Hit.ImpactNormal = ImpactNormal;
+			Hit.Normal = (Flags & NormalDiffers) ? Normal : ImpactNormal;
+
+			if (Flags & HasBoneIndex)
+			{
+				const USkinnedMeshComponent* SkinnedComponent = Cast<USkinnedMeshComponent>(HitComponent);
+				Hit.BoneName = SkinnedComponent ? SkinnedComponent->GetBoneName(BoneIndex) : NAME_None;
+			}
+			else if (!(Flags & HasBoneName))
+			{
+				Hit.BoneName = NAME_None;
+			}
+
+			RebuildDerivedHitFields(Hit);
+		}
+
+		return bOutSuccess;
+	}
+
+	void RebuildDerivedHitFields(FHitResult& Hit)
+	{
+		const double TraceLength = FVector::Dist(Hit.TraceStart, Hit.TraceEnd);
+
+		Hit.Distance = static_cast<float>(FVector::Dist(Hit.TraceStart, Hit.Location));
+		Hit.Time = (TraceLength > UE_KINDA_SMALL_NUMBER) ? static_cast<float>(FMath::Clamp(Hit.Distance / TraceLength, 0.0, 1.0)) : 0.0f;
+	}
+}
+
+
 //////////////////////////////////////////////////////////////////////
 
 void FBEGameplayAbilityTargetData_SingleTargetHit::AddTargetDataToContext(FGameplayEffectContextHandle& Context, bool bIncludeActorArray) const
@@ -24,9 +182,18 @@ void FBEGameplayAbilityTargetData_SingleTargetHit::AddTargetDataToContext(FGamep
 
 bool FBEGameplayAbilityTargetData_SingleTargetHit::NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
 {
-	FGameplayAbilityTargetData_SingleTargetHit::NetSerialize(Ar, Map, bOutSuccess);
+	// The trace start is the only absolute position, everything else in the hit is sent relative to it
+
+	FVector TraceStart = HitResult.TraceStart;
+	bOutSuccess = SerializePackedVector<10, 24>(TraceStart, Ar);
+
+	bOutSuccess &= BETargetDataSerialization::SerializeCompactHit(Ar, Map, HitResult, TraceStart);
+
+	// Cartridge IDs are small and -1 means none, so they are sent offset by one as a packed int
 
-	Ar << CartridgeID;
+	uint32 PackedCartridgeID = static_cast<uint32>(CartridgeID + 1);
+	Ar.SerializeIntPacked(PackedCartridgeID);
+	CartridgeID = static_cast<int32>(PackedCartridgeID) - 1;
 
 	return true;
 }
@@ -11,9 +11,27 @@
 #include "BEGameplayAbilityTargetData_SingleTargetHit.generated.h"
 
 class FArchive;
+class UPackageMap;
 struct FGameplayEffectContextHandle;
 
 
+/**
+ * Compact hit result encoding shared by the BE hit target data types.
+ *
+ * Only what hit confirmation and impact effects need is sent: impact point, location and trace end are quantized relative to the trace start,
+ * the impact normal is quantized to 16 bits per component, and bones are sent as an index into the hit component's skeleton when possible.
+ * Time and Distance are rebuilt from the trace on load. FaceIndex, Item, ElementIndex, MyItem and PenetrationDepth are not sent.
+ */
+namespace BETargetDataSerialization
+{
+	// Serializes the hit without its trace start, which the caller sends (or shares between pellets) itself
+	bool SerializeCompactHit(FArchive& Ar, UPackageMap* Map, FHitResult& Hit, const FVector& TraceStart);
+
+	// Rebuilds the hit fields that are derived from the trace
+	void RebuildDerivedHitFields(FHitResult& Hit);
+}
+
+
 /** Game-specific additions to SingleTargetHit tracking */
 USTRUCT()
 struct FBEGameplayAbilityTargetData_SingleTargetHit : public FGameplayAbilityTargetData_SingleTargetHit
@@ -46,4 +64,3 @@ struct TStructOpsTypeTraits<FBEGameplayAbilityTargetData_SingleTargetHit> : publ
 		WithNetSerializer = true	// For now this is REQUIRED for FGameplayAbilityTargetDataHandle net serialization to work
 	};
 };
-
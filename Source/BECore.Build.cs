@@ -76,6 +76,7 @@ public class BECore : ModuleRules
                 "AudioModulation",
                 "EngineSettings",
                 "DTLSHandlerComponent",
+                "Json",
             }
 			);
 		
@@ -11,6 +11,7 @@ DEFINE_LOG_CATEGORY(LogBEEquipmentSystem);
 DEFINE_LOG_CATEGORY(LogBEInventorySystem);
 DEFINE_LOG_CATEGORY(LogBEWeaponSystem);
 DEFINE_LOG_CATEGORY(LogBETeams);
+DEFINE_LOG_CATEGORY(LogBERepGraph);
 
 FString GetClientServerContextString(UObject* ContextObject)
 {
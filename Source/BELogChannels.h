@@ -13,5 +13,6 @@ BECORE_API DECLARE_LOG_CATEGORY_EXTERN(LogBEEquipmentSystem, Log, All);
 BECORE_API DECLARE_LOG_CATEGORY_EXTERN(LogBEInventorySystem, Log, All);
 BECORE_API DECLARE_LOG_CATEGORY_EXTERN(LogBEWeaponSystem, Log, All);
 BECORE_API DECLARE_LOG_CATEGORY_EXTERN(LogBETeams, Log, All);
+BECORE_API DECLARE_LOG_CATEGORY_EXTERN(LogBERepGraph, Log, All);
 
 BECORE_API FString GetClientServerContextString(UObject* ContextObject = nullptr);
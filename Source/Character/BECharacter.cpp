@@ -9,6 +9,8 @@
 #include "Ability/BEAbilitySystemComponent.h"
 #include "Player/BEPlayerController.h"
 #include "Player/BEPlayerState.h"
+#include "Performance/BESignificanceSubsystem.h"
+#include "Physics/BELagCompensationSubsystem.h"
 #include "BELogChannels.h"
 #include "GameplayTag/BETags_Status.h"
 
@@ -203,6 +205,36 @@ void ABECharacter::UninitAndDestroy()
 }
 
 
+void ABECharacter::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (UBESignificanceSubsystem* SignificanceSubsystem = GetWorld()->GetSubsystem<UBESignificanceSubsystem>())
+	{
+		SignificanceSubsystem->RegisterCharacter(this);
+	}
+
+	if (UBELagCompensationSubsystem* LagCompensationSubsystem = GetWorld()->GetSubsystem<UBELagCompensationSubsystem>())
+	{
+		LagCompensationSubsystem->RegisterCharacter(this);
+	}
+}
+
+void ABECharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UBESignificanceSubsystem* SignificanceSubsystem = GetWorld()->GetSubsystem<UBESignificanceSubsystem>())
+	{
+		SignificanceSubsystem->UnregisterCharacter(this);
+	}
+
+	if (UBELagCompensationSubsystem* LagCompensationSubsystem = GetWorld()->GetSubsystem<UBELagCompensationSubsystem>())
+	{
+		LagCompensationSubsystem->UnregisterCharacter(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void ABECharacter::PossessedBy(AController* NewController)
 {
 	const FGenericTeamId OldTeamID = MyTeamID;
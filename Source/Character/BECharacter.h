@@ -87,6 +87,9 @@ public:
 
 
 protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	virtual void PossessedBy(AController* NewController) override;
 	virtual void UnPossessed() override;
 
@@ -8,6 +8,7 @@
 #include "Containers/Array.h"
 #include "Templates/SubclassOf.h"
 #include "UObject/UObjectGlobals.h"
+#include "GameplayTagContainer.h"
 
 #include "BEPawnData.generated.h"
 
@@ -67,4 +68,10 @@ public:
 	// 適応する AnimLayer
 	UPROPERTY(EditDefaultsOnly, Category = "Animation")
 	TSubclassOf<UAnimInstance> DefaultFPPAnimLayer;
+
+	// Experience の読み込み中に事前に読み込んでおく GameplayCue
+	// 初めて使用されたときに再生されなかったりヒッチが発生するのを防ぐ
+	// Experience の DefaultPawnData に設定されている場合のみ読み込まれる
+	UPROPERTY(EditDefaultsOnly, Category = "Loading", meta = (Categories = "GameplayCue"))
+	FGameplayTagContainer GameplayCuesToPreload;
 };
@@ -157,10 +157,14 @@ UBEEquipmentInstance* FBEEquipmentList::AddEntry(const UBEItemData* ItemData, FG
 	NewEntry.ItemData	= ItemData;
 	NewEntry.Instance	= NewObject<UBEEquipmentInstance>(OwnerComponent->GetOwner(), InstanceType);
 	NewEntry.Instance->OnEquiped(ItemData);
-	
-	for (auto& Stats : Fragment->InitialEquipmentStats)
+
+	// 初期値を共有しない場合のみサーバーで StatTags にコピーする (クライアントには StatTags として同期される)
+	if (!Fragment->bShareInitialEquipmentStats)
 	{
-		NewEntry.Instance->AddStatTagStack(Stats.Key, Stats.Value);
+		for (auto& Stats : Fragment->InitialEquipmentStats)
+		{
+			NewEntry.Instance->AddStatTagStack(Stats.Key, Stats.Value);
+		}
 	}
 
 	for (TObjectPtr<const UBEAbilitySet> AbilitySet : Fragment->AbilitySetsToGrantOnEquip)
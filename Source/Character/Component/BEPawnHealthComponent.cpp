@@ -29,6 +29,7 @@
 #include "GameFramework/GameplayMessageSubsystem.h"
 #include "GameFramework/PlayerState.h"
 #include "Engine/World.h"
+#include "Misc/CoreDelegates.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(BEPawnHealthComponent)
 
@@ -63,6 +64,8 @@ UBEPawnHealthComponent::UBEPawnHealthComponent(const FObjectInitializer& ObjectI
 	DefaultMaxShield = 50;
 	DefaultHealth	 = 100;
 	DefaultShield	 = 50;
+
+	bCoalesceAttributeChanges = false;
 }
 
 void UBEPawnHealthComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
@@ -111,6 +114,8 @@ void UBEPawnHealthComponent::BeginPlay()
 
 void UBEPawnHealthComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
+	FlushAttributeChanges();
+
 	UninitializeFromAbilitySystem();
 	UnregisterInitStateFeature();
 
@@ -183,6 +188,7 @@ void UBEPawnHealthComponent::InitializeWithAbilitySystem(UBEAbilitySystemCompone
 void UBEPawnHealthComponent::UninitializeFromAbilitySystem()
 {
 	ClearGameplayTags();
+	ClearPendingAttributeChanges();
 
 	if (HealthSet)
 	{
@@ -342,6 +348,9 @@ void UBEPawnHealthComponent::StartDeath()
 		return;
 	}
 
+	// Death の通知より前に、まとめている変更を通知する
+	FlushAttributeChanges();
+
 	DeathState = EBEDeathState::DeathStarted;
 
 	if (AbilitySystemComponent)
@@ -381,24 +390,124 @@ void UBEPawnHealthComponent::FinishDeath()
 
 void UBEPawnHealthComponent::HandleHealthChanged(const FOnAttributeChangeData& ChangeData)
 {
+	if (bCoalesceAttributeChanges)
+	{
+		QueueAttributeChange(EPendingAttribute::Health, ChangeData);
+
+		// 致死ダメージはすぐに通知する
+		if (ChangeData.NewValue <= 0.0f)
+		{
+			FlushAttributeChanges();
+		}
+		return;
+	}
+
 	OnHealthChanged.Broadcast(this, ChangeData.OldValue, ChangeData.NewValue, GetInstigatorFromAttrChangeData(ChangeData));
 }
 
 void UBEPawnHealthComponent::HandleShieldChanged(const FOnAttributeChangeData& ChangeData)
 {
+	if (bCoalesceAttributeChanges)
+	{
+		QueueAttributeChange(EPendingAttribute::Shield, ChangeData);
+		return;
+	}
+
 	OnShieldChanged.Broadcast(this, ChangeData.OldValue, ChangeData.NewValue, GetInstigatorFromAttrChangeData(ChangeData));
 }
 
 void UBEPawnHealthComponent::HandleMaxHealthChanged(const FOnAttributeChangeData& ChangeData)
 {
+	if (bCoalesceAttributeChanges)
+	{
+		QueueAttributeChange(EPendingAttribute::MaxHealth, ChangeData);
+		return;
+	}
+
 	OnMaxHealthChanged.Broadcast(this, ChangeData.OldValue, ChangeData.NewValue, GetInstigatorFromAttrChangeData(ChangeData));
 }
 
 void UBEPawnHealthComponent::HandleMaxShieldChanged(const FOnAttributeChangeData& ChangeData)
 {
+	if (bCoalesceAttributeChanges)
+	{
+		QueueAttributeChange(EPendingAttribute::MaxShield, ChangeData);
+		return;
+	}
+
 	OnMaxShieldChanged.Broadcast(this, ChangeData.OldValue, ChangeData.NewValue, GetInstigatorFromAttrChangeData(ChangeData));
 }
 
+void UBEPawnHealthComponent::QueueAttributeChange(EPendingAttribute Attribute, const FOnAttributeChangeData& ChangeData)
+{
+	FPendingAttributeChange& Change = PendingAttributeChanges[(int32)Attribute];
+
+	if (!Change.bPending)
+	{
+		Change.bPending = true;
+		Change.OldValue = ChangeData.OldValue;
+		Change.Instigator.Reset();
+	}
+
+	Change.NewValue = ChangeData.NewValue;
+
+	if (APawn* Instigator = GetInstigatorFromAttrChangeData(ChangeData))
+	{
+		Change.Instigator = Instigator;
+	}
+
+	if (!EndFrameHandle.IsValid())
+	{
+		EndFrameHandle = FCoreDelegates::OnEndFrame.AddUObject(this, &ThisClass::HandleEndFrame);
+	}
+}
+
+void UBEPawnHealthComponent::ClearPendingAttributeChanges()
+{
+	FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+	EndFrameHandle.Reset();
+
+	for (FPendingAttributeChange& Change : PendingAttributeChanges)
+	{
+		Change.bPending = false;
+	}
+}
+
+void UBEPawnHealthComponent::FlushAttributeChanges()
+{
+	if (!EndFrameHandle.IsValid())
+	{
+		return;
+	}
+
+	// リスナーが通知中に Attribute を変更した場合は次の通知にまとめられる
+
+	FPendingAttributeChange Changes[(int32)EPendingAttribute::Count];
+	for (int32 Index = 0; Index < (int32)EPendingAttribute::Count; ++Index)
+	{
+		Changes[Index] = PendingAttributeChanges[Index];
+	}
+
+	ClearPendingAttributeChanges();
+
+	FBEHealth_AttributeChanged* const Delegates[] = { &OnHealthChanged, &OnShieldChanged, &OnMaxHealthChanged, &OnMaxShieldChanged };
+	static_assert(UE_ARRAY_COUNT(Delegates) == (int32)EPendingAttribute::Count, "Every pending attribute needs a delegate");
+
+	for (int32 Index = 0; Index < (int32)EPendingAttribute::Count; ++Index)
+	{
+		const FPendingAttributeChange& Change = Changes[Index];
+		if (Change.bPending)
+		{
+			Delegates[Index]->Broadcast(this, Change.OldValue, Change.NewValue, Change.Instigator.Get());
+		}
+	}
+}
+
+void UBEPawnHealthComponent::HandleEndFrame()
+{
+	FlushAttributeChanges();
+}
+
 void UBEPawnHealthComponent::HandleOutOfHealth(AActor* DamageInstigator, AActor* DamageCauser, const FGameplayEffectSpec& DamageEffectSpec, float DamageMagnitude)
 {
 #if WITH_SERVER_CODE
@@ -100,6 +100,11 @@ public:
 	UPROPERTY(Category = "BE|Health", EditAnywhere, BlueprintReadOnly)
 	float DefaultShield;
 
+	// 同じフレーム内の Health, Shield, MaxHealth, MaxShield の変更をまとめて、フレームの最後に一度だけ通知するか
+	// 致死ダメージと Death の通知はまとめずにすぐに通知する
+	UPROPERTY(Category = "BE|Health", EditAnywhere, BlueprintReadOnly)
+	bool bCoalesceAttributeChanges;
+
 public:
 	// 現在の Health を取得
 	UFUNCTION(BlueprintCallable, Category = "BE|Health")
@@ -180,6 +185,38 @@ protected:
 	UFUNCTION()
 	virtual void OnRep_DeathState(EBEDeathState OldDeathState);
 
+public:
+	// まとめている Attribute の変更をすぐに通知する
+	void FlushAttributeChanges();
+
+private:
+	enum class EPendingAttribute : uint8
+	{
+		Health,
+		Shield,
+		MaxHealth,
+		MaxShield,
+
+		Count
+	};
+
+	// フレーム内でまとめた Attribute の変更。OldValue は最初の変更前の値、NewValue と Instigator は最後の変更のもの
+	struct FPendingAttributeChange
+	{
+		bool bPending = false;
+		float OldValue = 0.0f;
+		float NewValue = 0.0f;
+		TWeakObjectPtr<APawn> Instigator;
+	};
+
+	void QueueAttributeChange(EPendingAttribute Attribute, const FOnAttributeChangeData& ChangeData);
+	void ClearPendingAttributeChanges();
+	void HandleEndFrame();
+
+	FPendingAttributeChange PendingAttributeChanges[(int32)EPendingAttribute::Count];
+
+	FDelegateHandle EndFrameHandle;
+
 
 public:
 	UFUNCTION(BlueprintPure, Category = "Character")
@@ -11,6 +11,7 @@
 #include "Ability/BEAbilitySystemComponent.h"
 #include "Input/BEInputConfig.h"
 #include "Input/BEInputComponent.h"
+#include "Input/BEInputReplaySubsystem.h"
 #include "GameSetting/BEGameDeviceSettings.h"
 #include "System/BEAssetManager.h"
 #include "BELogChannels.h"
@@ -252,6 +253,8 @@ void UBEPawnPlayableComponent::InitializePlayerInput(UInputComponent* PlayerInpu
 
 	Subsystem->ClearAllMappings();
 
+	ResetBoundInputConfigs(Cast<UBEInputComponent>(PlayerInputComponent));
+
 	if (const UBEPawnBasicComponent* CharacterBasic = UBEPawnBasicComponent::FindPawnBasicComponent(Pawn))
 	{
 		if (const UBEPawnData* PawnData = CharacterBasic->GetPawnData())
@@ -261,7 +264,7 @@ void UBEPawnPlayableComponent::InitializePlayerInput(UInputComponent* PlayerInpu
 				UBEInputComponent* BEIC = CastChecked<UBEInputComponent>(PlayerInputComponent);
 				BEIC->AddInputMappings(InputConfig, Subsystem);
 
-				TArray<uint32> BindHandles;
+				TArray<uint32>& BindHandles = BoundInputConfigs.Add(InputConfig);
 				BEIC->BindAbilityActions(InputConfig, this, &ThisClass::Input_AbilityInputTagPressed, &ThisClass::Input_AbilityInputTagReleased, /*out*/ BindHandles);
 
 				BEIC->BindNativeAction(InputConfig, TAG_Input_Move_KM, ETriggerEvent::Triggered, this, &ThisClass::Input_Move, /*bLogIfNotFound=*/ false);
@@ -283,10 +286,8 @@ void UBEPawnPlayableComponent::InitializePlayerInput(UInputComponent* PlayerInpu
 
 void UBEPawnPlayableComponent::AddAdditionalInputConfig(const UBEInputConfig* InputConfig)
 {
-	TArray<uint32> BindHandles;
-
 	const APawn* Pawn = GetPawn<APawn>();
-	if (!Pawn)
+	if (!Pawn || !InputConfig)
 	{
 		return;
 	}
@@ -303,15 +304,53 @@ void UBEPawnPlayableComponent::AddAdditionalInputConfig(const UBEInputConfig* In
 	UEnhancedInputLocalPlayerSubsystem* Subsystem = LP->GetSubsystem<UEnhancedInputLocalPlayerSubsystem>();
 	check(Subsystem);
 
+	if (BoundInputComponent != BEIC)
+	{
+		ResetBoundInputConfigs(BEIC);
+	}
+
+	// すでにバインド済みの InputConfig は再バインドしない
+	if (BoundInputConfigs.Contains(InputConfig))
+	{
+		return;
+	}
+
 	if (const UBEPawnBasicComponent* CharacterBasic = UBEPawnBasicComponent::FindPawnBasicComponent(Pawn))
 	{
+		TArray<uint32>& BindHandles = BoundInputConfigs.Add(InputConfig);
 		BEIC->BindAbilityActions(InputConfig, this, &ThisClass::Input_AbilityInputTagPressed, &ThisClass::Input_AbilityInputTagReleased, /*out*/ BindHandles);
 	}
 }
 
 void UBEPawnPlayableComponent::RemoveAdditionalInputConfig(const UBEInputConfig* InputConfig)
 {
-	
+	if (!InputConfig)
+	{
+		return;
+	}
+
+	// PawnData の InputConfig は Pawn が破棄されるまで残す
+	const UBEPawnBasicComponent* CharacterBasic = UBEPawnBasicComponent::FindPawnBasicComponent(GetPawn<APawn>());
+	const UBEPawnData* PawnData = CharacterBasic ? CharacterBasic->GetPawnData() : nullptr;
+	if (PawnData && (PawnData->InputConfig == InputConfig))
+	{
+		return;
+	}
+
+	TArray<uint32> BindHandles;
+	if (BoundInputConfigs.RemoveAndCopyValue(InputConfig, BindHandles))
+	{
+		if (UBEInputComponent* BEIC = BoundInputComponent.Get())
+		{
+			BEIC->RemoveBinds(BindHandles);
+		}
+	}
+}
+
+void UBEPawnPlayableComponent::ResetBoundInputConfigs(UBEInputComponent* InputComponent)
+{
+	BoundInputConfigs.Reset();
+	BoundInputComponent = InputComponent;
 }
 
 bool UBEPawnPlayableComponent::IsReadyToBindInputs() const
@@ -319,8 +358,55 @@ bool UBEPawnPlayableComponent::IsReadyToBindInputs() const
 	return bReadyToBindInputs;
 }
 
+void UBEPawnPlayableComponent::InjectReplayedInput(const FBEReplayedInput& Input)
+{
+	TGuardValue<bool> InjectingGuard(bInjectingReplayedInput, true);
+
+	switch (Input.Type)
+	{
+	case EBEReplayedInputType::Move:
+		Input_Move(FInputActionValue(FVector2D(Input.Value)));
+		break;
+	case EBEReplayedInputType::LookMouse:
+		Input_LookMouse(FInputActionValue(FVector2D(Input.Value)));
+		break;
+	case EBEReplayedInputType::LookStick:
+		Input_LookStick(FInputActionValue(FVector2D(Input.Value)));
+		break;
+	case EBEReplayedInputType::AbilityPressed:
+		Input_AbilityInputTagPressed(Input.InputTag);
+		break;
+	case EBEReplayedInputType::AbilityReleased:
+		Input_AbilityInputTagReleased(Input.InputTag);
+		break;
+	default:
+		break;
+	}
+}
+
+bool UBEPawnPlayableComponent::ShouldHandleInput(const FBEReplayedInput& Input) const
+{
+	if (bInjectingReplayedInput)
+	{
+		return true;
+	}
+
+	const APawn* Pawn = GetPawn<APawn>();
+	if (UBEInputReplaySubsystem* ReplaySubsystem = UBEInputReplaySubsystem::Get(Pawn ? Pawn->GetController<APlayerController>() : nullptr))
+	{
+		return ReplaySubsystem->HandleLiveInput(Input);
+	}
+
+	return true;
+}
+
 void UBEPawnPlayableComponent::Input_AbilityInputTagPressed(FGameplayTag InputTag)
 {
+	if (!ShouldHandleInput(FBEReplayedInput::MakeTag(EBEReplayedInputType::AbilityPressed, InputTag)))
+	{
+		return;
+	}
+
 	if (const APawn* Pawn = GetPawn<APawn>())
 	{
 		if (const UBEPawnBasicComponent* CharacterBasic = UBEPawnBasicComponent::FindPawnBasicComponent(Pawn))
@@ -335,6 +421,11 @@ void UBEPawnPlayableComponent::Input_AbilityInputTagPressed(FGameplayTag InputTa
 
 void UBEPawnPlayableComponent::Input_AbilityInputTagReleased(FGameplayTag InputTag)
 {
+	if (!ShouldHandleInput(FBEReplayedInput::MakeTag(EBEReplayedInputType::AbilityReleased, InputTag)))
+	{
+		return;
+	}
+
 	const APawn* Pawn = GetPawn<APawn>();
 	if (!Pawn)
 	{
@@ -352,6 +443,11 @@ void UBEPawnPlayableComponent::Input_AbilityInputTagReleased(FGameplayTag InputT
 
 void UBEPawnPlayableComponent::Input_Move(const FInputActionValue& InputActionValue)
 {
+	if (!ShouldHandleInput(FBEReplayedInput::MakeAxis(EBEReplayedInputType::Move, InputActionValue.Get<FVector2D>())))
+	{
+		return;
+	}
+
 	APawn* Pawn = GetPawn<APawn>();
 	AController* Controller = Pawn ? Pawn->GetController() : nullptr;
 	
@@ -376,6 +472,11 @@ void UBEPawnPlayableComponent::Input_Move(const FInputActionValue& InputActionVa
 
 void UBEPawnPlayableComponent::Input_LookMouse(const FInputActionValue& InputActionValue)
 {
+	if (!ShouldHandleInput(FBEReplayedInput::MakeAxis(EBEReplayedInputType::LookMouse, InputActionValue.Get<FVector2D>())))
+	{
+		return;
+	}
+
 	APawn* Pawn = GetPawn<APawn>();
 
 	if (!Pawn)
@@ -398,6 +499,11 @@ void UBEPawnPlayableComponent::Input_LookMouse(const FInputActionValue& InputAct
 
 void UBEPawnPlayableComponent::Input_LookStick(const FInputActionValue& InputActionValue)
 {
+	if (!ShouldHandleInput(FBEReplayedInput::MakeAxis(EBEReplayedInputType::LookStick, InputActionValue.Get<FVector2D>())))
+	{
+		return;
+	}
+
 	APawn* Pawn = GetPawn<APawn>();
 
 	if (!Pawn)
@@ -20,11 +20,13 @@
 class UGameFrameworkComponentManager;
 class UInputComponent;
 class UBEInputConfig;
+class UBEInputComponent;
 class APawn;
 class UObject;
 struct FActorInitStateChangedParams;
 struct FGameplayTag;
 struct FInputActionValue;
+struct FBEReplayedInput;
 
 
 /**
@@ -72,6 +74,9 @@ public:
 	// プレイヤーの入力バインドの準備が完了しているか
 	bool IsReadyToBindInputs() const;
 
+	// UBEInputReplaySubsystem で記録された入力を UBEInputComponent のバインドと同じハンドラに流す
+	void InjectReplayedInput(const FBEReplayedInput& Input);
+
 protected:
 	void Input_AbilityInputTagPressed(FGameplayTag InputTag);
 	void Input_AbilityInputTagReleased(FGameplayTag InputTag);
@@ -80,10 +85,26 @@ protected:
 	void Input_LookMouse(const FInputActionValue& InputActionValue);
 	void Input_LookStick(const FInputActionValue& InputActionValue);
 
+	// 入力を処理するべきか。入力の記録中は記録し、再生中は実際の入力を無視する
+	bool ShouldHandleInput(const FBEReplayedInput& Input) const;
+
 protected:
 	// プレイヤーの入力バインドの準備が完了しているか
 	// PlayerController 以外の場合は true になることはない
 	bool bReadyToBindInputs;
+
+	// InjectReplayedInput から入力ハンドラを呼び出している最中か
+	bool bInjectingReplayedInput = false;
+
+private:
+	// InputConfig ごとの Ability Input のバインドハンドル (PawnData の InputConfig と追加の InputConfig を含む)
+	// 同じ InputConfig が複数回追加されても再バインドせず、削除時はその InputConfig のバインドのみを取り除く
+	TMap<TWeakObjectPtr<const UBEInputConfig>, TArray<uint32>> BoundInputConfigs;
+
+	// BoundInputConfigs のバインド先。Possess し直して InputComponent が作り直された場合はバインドも無効になる
+	TWeakObjectPtr<UBEInputComponent> BoundInputComponent;
+
+	void ResetBoundInputConfigs(UBEInputComponent* InputComponent);
 	
 
 public:
@@ -56,6 +56,11 @@ void UBEContextEffectComponent::AnimMotionEffect_Implementation(const FName Bone
 	const bool bHitSuccess, const FHitResult HitResult, FGameplayTagContainer Contexts,
 	FVector VFXScale, float AudioVolume, float AudioPitch)
 {
+	if (bEffectsCulled)
+	{
+		return;
+	}
+
 	// Prep Components
 	TArray<UAudioComponent*> AudioComponentsToAdd;
 	TArray<UNiagaraComponent*> NiagaraComponentsToAdd;
@@ -55,7 +55,13 @@ public:
 	UFUNCTION(BlueprintCallable)
 	void UpdateLibraries(TSet<TSoftObjectPtr<UBEContextEffectsLibrary>> NewContextEffectsLibraries);
 
+	// Culled components ignore motion effects, set by the significance subsystem for far away or hidden characters
+	void SetEffectsCulled(bool bCulled) { bEffectsCulled = bCulled; }
+	bool AreEffectsCulled() const { return bEffectsCulled; }
+
 private:
+	bool bEffectsCulled = false;
+
 	UPROPERTY(Transient)
 	FGameplayTagContainer CurrentContexts;
 
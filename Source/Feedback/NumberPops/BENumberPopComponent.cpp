@@ -6,3 +6,34 @@ UBENumberPopComponent::UBENumberPopComponent(const FObjectInitializer& ObjectIni
 	: Super(ObjectInitializer)
 {
 }
+
+int32 BENumberPops::ExtractDigits(int32 Number, TStaticArray<uint8, MaxDigits>& OutDigits)
+{
+	// Widen first, the absolute value of MIN_int32 doesn't fit in an int32
+	uint64 Value = static_cast<uint64>(FMath::Abs(static_cast<int64>(Number)));
+
+	int32 NumDigits = 1;
+	for (uint64 Remaining = Value / 10; Remaining > 0; Remaining /= 10)
+	{
+		++NumDigits;
+	}
+
+	// Too long to display, clamp to the largest displayable number
+	if (NumDigits > MaxDigits)
+	{
+		for (int32 DigitIndex = 0; DigitIndex < MaxDigits; ++DigitIndex)
+		{
+			OutDigits[DigitIndex] = 9;
+		}
+
+		return MaxDigits;
+	}
+
+	for (int32 DigitIndex = NumDigits - 1; DigitIndex >= 0; --DigitIndex)
+	{
+		OutDigits[DigitIndex] = static_cast<uint8>(Value % 10);
+		Value /= 10;
+	}
+
+	return NumDigits;
+}
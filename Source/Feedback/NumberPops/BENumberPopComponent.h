@@ -4,10 +4,24 @@
 
 #include "CoreMinimal.h"
 #include "Components/ControllerComponent.h"
+#include "Containers/StaticArray.h"
 #include "GameplayTagContainer.h"
 
 #include "BENumberPopComponent.generated.h"
 
+namespace BENumberPops
+{
+	// Most digits a number pop can display, larger numbers are shown as all nines
+	static constexpr int32 MaxDigits = 9;
+
+	/**
+	 * Writes the base 10 digits of the absolute value of Number into OutDigits, most significant first, without allocating.
+	 * Returns the number of digits written (at least 1, a zero is shown as one digit).
+	 * Values with more than MaxDigits digits are clamped: 1000000000 and above (or below -999999999) are written as 999999999.
+	 */
+	int32 ExtractDigits(int32 Number, TStaticArray<uint8, MaxDigits>& OutDigits);
+}
+
 USTRUCT(BlueprintType)
 struct FBENumberPopRequest
 {
@@ -52,4 +66,7 @@ public:
 	/** Adds a damage number to the damage number list for visualization */
 	UFUNCTION(BlueprintCallable, Category = Foo)
 	virtual void AddNumberPop(const FBENumberPopRequest& NewRequest) {}
+
+	/** Returns false if the request would be dropped, e.g. when no style provides a mesh for its tags */
+	virtual bool CanDisplayNumberPop(const FBENumberPopRequest& Request) const { return true; }
 };
@@ -0,0 +1,348 @@
+// Copyright Eigi Chin
+
+#include "BENumberPopComponent_Instanced.h"
+#include "BEDamagePopStyle.h"
+#include "BELogChannels.h"
+
+#include "Camera/PlayerCameraManager.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/CollisionProfile.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "GameplayTagAssetInterface.h"
+#include "GameplayTagsManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "TimerManager.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(BENumberPopComponent_Instanced)
+
+
+UBENumberPopComponent_Instanced::UBENumberPopComponent_Instanced(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+}
+
+void UBENumberPopComponent_Instanced::AddNumberPop(const FBENumberPopRequest& NewRequest)
+{
+	// Drop requests for remote players on the floor
+	// (this prevents multiple pops from showing up for the host of a listen server)
+	APlayerController* PC = GetController<APlayerController>();
+	if (PC && !PC->IsLocalController())
+	{
+		return;
+	}
+
+	UStaticMesh* MeshToUse = DetermineStaticMesh(NewRequest);
+	if (MeshToUse == nullptr)
+	{
+		return;
+	}
+
+	UWorld* LocalWorld = GetWorld();
+	check(LocalWorld);
+
+	FBENumberPopBatch& Batch = FindOrCreateBatch(MeshToUse);
+	if (Batch.Component == nullptr)
+	{
+		return;
+	}
+
+	// Take the oldest slot, replacing its pop if it is still live
+
+	const int32 Slot = Batch.NextSlot;
+	Batch.NextSlot = (Batch.NextSlot + 1) % Batch.ReleaseTimes.Num();
+
+	if (Batch.ReleaseTimes[Slot] <= 0.0f)
+	{
+		++Batch.NumLive;
+	}
+	Batch.ReleaseTimes[Slot] = LocalWorld->GetTimeSeconds() + ComponentLifespan;
+
+	// Position, facing the camera and scaled up with the distance so far pops stay readable
+
+	FTransform CameraTransform;
+	FVector NumberLocation(NewRequest.WorldLocation);
+	if (PC && PC->PlayerCameraManager)
+	{
+		CameraTransform = FTransform(PC->PlayerCameraManager->GetCameraRotation(), PC->PlayerCameraManager->GetCameraLocation());
+
+		const float RandomMagnitude = 5.0f;
+		NumberLocation += FMath::RandPointInBox(FBox(FVector(-RandomMagnitude), FVector(RandomMagnitude)));
+	}
+
+	const float DistanceFromCameraToNumber = (CameraTransform.GetLocation() - NumberLocation).Size();
+	const float DistanceScale = (DistanceFromCameraBeforeDoublingSize == 0.0f) ? 1.0f : FMath::Max(DistanceFromCameraToNumber / DistanceFromCameraBeforeDoublingSize, 1.0f);
+	const float HitSizeMultiplier = NewRequest.bIsCriticalDamage ? CriticalHitSizeMultiplier : 1.0f;
+
+	const FTransform InstanceTransform(CameraTransform.GetRotation(), NumberLocation, FVector(DistanceScale * HitSizeMultiplier));
+	Batch.Component->UpdateInstanceTransform(Slot, InstanceTransform, /*bWorldSpace=*/ true, /*bMarkRenderStateDirty=*/ false, /*bTeleport=*/ true);
+
+	// Custom data
+
+	TStaticArray<uint8, BENumberPops::MaxDigits> Digits;
+	const int32 NumDigits = BENumberPops::ExtractDigits(NewRequest.NumberToDisplay, Digits);
+	const FLinearColor Color = DetermineColor(NewRequest);
+
+	UInstancedStaticMeshComponent* Component = Batch.Component;
+	Component->SetCustomDataValue(Slot, BENumberPopInstanceData::NumDigits, static_cast<float>(NumDigits));
+
+	for (int32 DigitIndex = 0; DigitIndex < BENumberPops::MaxDigits; ++DigitIndex)
+	{
+		Component->SetCustomDataValue(Slot, BENumberPopInstanceData::FirstDigit + DigitIndex, (DigitIndex < NumDigits) ? static_cast<float>(Digits[DigitIndex]) : 0.0f);
+	}
+
+	Component->SetCustomDataValue(Slot, BENumberPopInstanceData::ColorR, Color.R);
+	Component->SetCustomDataValue(Slot, BENumberPopInstanceData::ColorG, Color.G);
+	Component->SetCustomDataValue(Slot, BENumberPopInstanceData::ColorB, Color.B);
+	Component->SetCustomDataValue(Slot, BENumberPopInstanceData::SpawnTime, LocalWorld->GetTimeSeconds());
+	Component->SetCustomDataValue(Slot, BENumberPopInstanceData::Lifespan, ComponentLifespan);
+	Component->SetCustomDataValue(Slot, BENumberPopInstanceData::IsCriticalHit, NewRequest.bIsCriticalDamage ? 1.0f : 0.0f);
+
+	// Only the last write marks the render state dirty, the engine sends it once at the end of the frame for every pop of this batch
+	Component->SetCustomDataValue(Slot, BENumberPopInstanceData::RandomSeed, FMath::FRand(), /*bMarkRenderStateDirty=*/ true);
+
+	if (!LocalWorld->GetTimerManager().IsTimerActive(ReleaseTimerHandle))
+	{
+		LocalWorld->GetTimerManager().SetTimer(ReleaseTimerHandle, this, &ThisClass::ReleaseExpiredInstances, ComponentLifespan);
+	}
+}
+
+void UBENumberPopComponent_Instanced::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UWorld* LocalWorld = GetWorld())
+	{
+		LocalWorld->GetTimerManager().ClearTimer(ReleaseTimerHandle);
+	}
+
+	for (TPair<TObjectPtr<UStaticMesh>, FBENumberPopBatch>& Pair : Batches)
+	{
+		if (Pair.Value.Component)
+		{
+			Pair.Value.Component->DestroyComponent();
+		}
+	}
+
+	Batches.Reset();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+FBENumberPopBatch& UBENumberPopComponent_Instanced::FindOrCreateBatch(UStaticMesh* Mesh)
+{
+	FBENumberPopBatch& Batch = Batches.FindOrAdd(Mesh);
+	if (Batch.Component)
+	{
+		return Batch;
+	}
+
+	UInstancedStaticMeshComponent* NewComponent = NewObject<UInstancedStaticMeshComponent>(GetOwner());
+	NewComponent->SetCollisionProfileName(UCollisionProfile::NoCollision_ProfileName);
+	NewComponent->SetStaticMesh(Mesh);
+	NewComponent->SetCastShadow(false);
+	NewComponent->SetNumCustomDataFloats(BENumberPopInstanceData::Count);
+
+	// Used to allow post-processes to opt out of affecting the number pop digits
+	NewComponent->SetRenderCustomDepth(true);
+	NewComponent->SetCustomDepthStencilValue(123);
+
+	// The digits travel a great distance from their original bounds due to
+	// world position offset (WPO) animation in the material, so expand bounds
+	NewComponent->SetBoundsScale(2000.0f);
+
+	NewComponent->RegisterComponent();
+	NewComponent->SetWorldTransform(FTransform::Identity);
+
+	// Every slot exists up front, free slots are scaled to zero
+	const int32 NumSlots = FMath::Max(MaxLivePopsPerMesh, 1);
+
+	TArray<FTransform> HiddenTransforms;
+	HiddenTransforms.Init(FTransform(FQuat::Identity, FVector::ZeroVector, FVector::ZeroVector), NumSlots);
+	NewComponent->AddInstances(HiddenTransforms, /*bShouldReturnIndices=*/ false, /*bWorldSpace=*/ true);
+
+	Batch.Component = NewComponent;
+	Batch.ReleaseTimes.Init(0.0f, NumSlots);
+	Batch.NextSlot = 0;
+	Batch.NumLive = 0;
+
+	return Batch;
+}
+
+void UBENumberPopComponent_Instanced::ReleaseExpiredInstances()
+{
+	UWorld* LocalWorld = GetWorld();
+	check(LocalWorld);
+
+	const float CurrentTime = LocalWorld->GetTimeSeconds();
+	const FTransform HiddenTransform(FQuat::Identity, FVector::ZeroVector, FVector::ZeroVector);
+
+	float NextReleaseTime = TNumericLimits<float>::Max();
+
+	for (TPair<TObjectPtr<UStaticMesh>, FBENumberPopBatch>& Pair : Batches)
+	{
+		FBENumberPopBatch& Batch = Pair.Value;
+		if ((Batch.Component == nullptr) || (Batch.NumLive == 0))
+		{
+			continue;
+		}
+
+		for (int32 Slot = 0; Slot < Batch.ReleaseTimes.Num(); ++Slot)
+		{
+			float& ReleaseTime = Batch.ReleaseTimes[Slot];
+			if (ReleaseTime <= 0.0f)
+			{
+				continue;
+			}
+
+			if (CurrentTime >= ReleaseTime)
+			{
+				Batch.Component->UpdateInstanceTransform(Slot, HiddenTransform, /*bWorldSpace=*/ true, /*bMarkRenderStateDirty=*/ true, /*bTeleport=*/ true);
+				ReleaseTime = 0.0f;
+				--Batch.NumLive;
+			}
+			else
+			{
+				NextReleaseTime = FMath::Min(NextReleaseTime, ReleaseTime);
+			}
+		}
+	}
+
+	// If we still have live pops animating, set the timer to release the next one
+	if (NextReleaseTime < TNumericLimits<float>::Max())
+	{
+		LocalWorld->GetTimerManager().SetTimer(ReleaseTimerHandle, this, &ThisClass::ReleaseExpiredInstances, FMath::Max(NextReleaseTime - CurrentTime, UE_KINDA_SMALL_NUMBER));
+	}
+}
+
+bool UBENumberPopComponent_Instanced::CanDisplayNumberPop(const FBENumberPopRequest& Request) const
+{
+	return DetermineStaticMesh(Request) != nullptr;
+}
+
+FLinearColor UBENumberPopComponent_Instanced::DetermineColor(const FBENumberPopRequest& Request) const
+{
+	for (UBEDamagePopStyle* Style : Styles)
+	{
+		if ((Style != nullptr) && Style->bOverrideColor)
+		{
+			if (Style->MatchPattern.Matches(Request.TargetTags))
+			{
+				return Request.bIsCriticalDamage ? Style->CriticalColor : Style->Color;
+			}
+		}
+	}
+
+	return FLinearColor::White;
+}
+
+UStaticMesh* UBENumberPopComponent_Instanced::DetermineStaticMesh(const FBENumberPopRequest& Request) const
+{
+	for (UBEDamagePopStyle* Style : Styles)
+	{
+		if ((Style != nullptr) && Style->bOverrideMesh)
+		{
+			if (Style->MatchPattern.Matches(Request.TargetTags))
+			{
+				return Style->TextMesh;
+			}
+		}
+	}
+
+	return nullptr;
+}
+
+
+//////////////////////////////////////////////////////////////////////
+
+namespace BENumberPops
+{
+	// Tags of a pawn that could be hit, styles pick their mesh by the target tags so empty tags may display nothing
+	static FGameplayTagContainer GetStressTestTargetTags(UWorld* World, const APlayerController* Viewer)
+	{
+		FGameplayTagContainer TargetTags;
+
+		for (TActorIterator<APawn> It(World); It; ++It)
+		{
+			const IGameplayTagAssetInterface* TagInterface = Cast<IGameplayTagAssetInterface>(*It);
+			if (TagInterface && (*It != Viewer->GetPawn()))
+			{
+				TagInterface->GetOwnedGameplayTags(TargetTags);
+				return TargetTags;
+			}
+		}
+
+		// Nobody else around, the viewer's own pawn has the same kind of tags
+		if (const IGameplayTagAssetInterface* TagInterface = Cast<IGameplayTagAssetInterface>(Viewer->GetPawn()))
+		{
+			TagInterface->GetOwnedGameplayTags(TargetTags);
+		}
+
+		return TargetTags;
+	}
+
+	static void RunStressTest(const TArray<FString>& Args, UWorld* World)
+	{
+		const int32 NumPops = FMath::Clamp(Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 1000, 1, 100000);
+		const FGameplayTag ExplicitTargetTag = (Args.Num() > 1) ? UGameplayTagsManager::Get().RequestGameplayTag(FName(*Args[1]), /*ErrorIfNotFound=*/ false) : FGameplayTag();
+
+		for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+		{
+			APlayerController* PC = It->Get();
+			if (!PC || !PC->IsLocalController())
+			{
+				continue;
+			}
+
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+			TInlineComponentArray<UBENumberPopComponent*> PopComponents(PC);
+			for (UBENumberPopComponent* PopComponent : PopComponents)
+			{
+				FRandomStream RandomStream(1234);
+
+				FBENumberPopRequest Request;
+				Request.TargetTags = ExplicitTargetTag.IsValid() ? FGameplayTagContainer(ExplicitTargetTag) : GetStressTestTargetTags(World, PC);
+
+				if (!PopComponent->CanDisplayNumberPop(Request))
+				{
+					UE_LOG(LogBE, Warning, TEXT("%s: No style displays pops for target tags [%s], skipped. Pass a target tag matched by a style."),
+						*GetNameSafe(PopComponent->GetClass()), *Request.TargetTags.ToStringSimple());
+					continue;
+				}
+
+				const double StartTime = FPlatformTime::Seconds();
+
+				for (int32 Index = 0; Index < NumPops; ++Index)
+				{
+					Request.WorldLocation = ViewLocation + ViewRotation.RotateVector(FVector(RandomStream.FRandRange(500.0f, 3000.0f), RandomStream.FRandRange(-800.0f, 800.0f), RandomStream.FRandRange(-300.0f, 300.0f)));
+					Request.NumberToDisplay = RandomStream.RandRange(1, 250);
+					Request.bIsCriticalDamage = RandomStream.FRand() < 0.2f;
+
+					PopComponent->AddNumberPop(Request);
+				}
+
+				const double ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+
+				UE_LOG(LogBE, Display, TEXT("%s: %d pops in %.3f ms, %.2f us per pop, %.0f pops per second"),
+					*GetNameSafe(PopComponent->GetClass()), NumPops, ElapsedSeconds * 1000.0, ElapsedSeconds * 1000000.0 / NumPops,
+					(ElapsedSeconds > 0.0) ? (NumPops / ElapsedSeconds) : 0.0);
+			}
+		}
+	}
+
+	static FAutoConsoleCommandWithWorldAndArgs CmdStressTest(
+		TEXT("BE.NumberPops.Stress"),
+		TEXT("Adds sample number pops in front of every local player through each of its number pop components and logs the cost per pop and pops per second. Usage: BE.NumberPops.Stress [NumPops=1000] [TargetTag=<tags of a pawn in the world>]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(
+			[](const TArray<FString>& Args, UWorld* World)
+			{
+				if (World)
+				{
+					RunStressTest(Args, World);
+				}
+			}));
+}
@@ -0,0 +1,116 @@
+// Copyright Eigi Chin
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BENumberPopComponent.h"
+
+#include "BENumberPopComponent_Instanced.generated.h"
+
+class UBEDamagePopStyle;
+class UInstancedStaticMeshComponent;
+class UStaticMesh;
+
+/**
+ * Per instance custom data written for every number pop, the text material reads it with PerInstanceCustomData
+ */
+namespace BENumberPopInstanceData
+{
+	enum : int32
+	{
+		NumDigits = 0,
+
+		// BENumberPops::MaxDigits values, most significant digit first, unused digits are 0
+		FirstDigit,
+
+		ColorR = FirstDigit + BENumberPops::MaxDigits,
+		ColorG,
+		ColorB,
+
+		// World time (UWorld::GetTimeSeconds) the pop was spawned at, drives the material animation with the same clock as the release
+		SpawnTime,
+		Lifespan,
+		IsCriticalHit,
+
+		// [0, 1], lets the material vary the animation per pop
+		RandomSeed,
+
+		Count
+	};
+}
+
+USTRUCT()
+struct FBENumberPopBatch
+{
+	GENERATED_BODY()
+
+	/** Every live pop drawn with this batch's mesh is an instance of this component */
+	UPROPERTY(transient)
+	TObjectPtr<UInstancedStaticMeshComponent> Component = nullptr;
+
+	/** World time each instance slot is released at, 0 when the slot is free. Sized once to the slot count. */
+	TArray<float> ReleaseTimes;
+
+	/** Slots are reused in spawn order, so the next slot is always the oldest one */
+	int32 NextSlot = 0;
+
+	int32 NumLive = 0;
+};
+
+
+/**
+ * UBENumberPopComponent_Instanced
+ *
+ *	Batched number pop renderer. All live pops that use the same mesh are instances of one instanced static mesh component,
+ *	with the digits, color and timing in per instance custom data (see BENumberPopInstanceData).
+ *	Instances are preallocated, so adding and releasing pops doesn't register components, create MIDs or allocate.
+ */
+UCLASS(Blueprintable)
+class UBENumberPopComponent_Instanced : public UBENumberPopComponent
+{
+	GENERATED_BODY()
+
+public:
+
+	UBENumberPopComponent_Instanced(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+	//~UBENumberPopComponent interface
+	virtual void AddNumberPop(const FBENumberPopRequest& NewRequest) override;
+	virtual bool CanDisplayNumberPop(const FBENumberPopRequest& Request) const override;
+	//~End of UBENumberPopComponent interface
+
+	//~UActorComponent interface
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	//~End of UActorComponent interface
+
+protected:
+	FLinearColor DetermineColor(const FBENumberPopRequest& Request) const;
+	UStaticMesh* DetermineStaticMesh(const FBENumberPopRequest& Request) const;
+
+	FBENumberPopBatch& FindOrCreateBatch(UStaticMesh* Mesh);
+
+	/** Hides the instances that have exceeded their lifespan */
+	void ReleaseExpiredInstances();
+
+	/** Style patterns to attempt to apply to the incoming number pops */
+	UPROPERTY(EditDefaultsOnly, Category = "Number Pop|Style")
+	TArray<TObjectPtr<UBEDamagePopStyle>> Styles;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Number Pop|Style")
+	float ComponentLifespan = 1.0f;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Number Pop|Style")
+	float DistanceFromCameraBeforeDoublingSize = 1024.0f;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Number Pop|Style")
+	float CriticalHitSizeMultiplier = 1.7f;
+
+	/** Instances preallocated per mesh, the oldest pop is replaced when more are live */
+	UPROPERTY(EditDefaultsOnly, Category = "Number Pop|Batching", meta = (ClampMin = 1))
+	int32 MaxLivePopsPerMesh = 128;
+
+	UPROPERTY(Transient)
+	TMap<TObjectPtr<UStaticMesh>, FBENumberPopBatch> Batches;
+
+	FTimerHandle ReleaseTimerHandle;
+};
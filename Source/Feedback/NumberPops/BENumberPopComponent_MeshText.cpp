@@ -50,26 +50,16 @@ void UBENumberPopComponent_MeshText::AddNumberPop(const FBENumberPopRequest& New
 
 	// Prepare the DamageNumberArray with the digits from the damage.
 	{
-		int32 LocalDamage = NewRequest.NumberToDisplay;
-		PreparedNumberInfo.DamageNumberArray.Empty();
+		TStaticArray<uint8, BENumberPops::MaxDigits> Digits;
+		const int32 NumDigits = BENumberPops::ExtractDigits(NewRequest.NumberToDisplay, Digits);
 
-		if (LocalDamage == 0)
-		{
-			// We want to just show a zero
-			PreparedNumberInfo.DamageNumberArray.Insert(0, 0);
-		}
-		else
+		// Insert a zero to reserve space for + or -. Used by the blueprint
+		PreparedNumberInfo.DamageNumberArray.Add(0);
+
+		for (int32 DigitIndex = 0; DigitIndex < NumDigits; ++DigitIndex)
 		{
-			// Parse the base10 number into an array
-			while (LocalDamage > 0)
-			{
-				PreparedNumberInfo.DamageNumberArray.Insert(LocalDamage % 10, 0);
-				LocalDamage /= 10;
-			}
+			PreparedNumberInfo.DamageNumberArray.Add(Digits[DigitIndex]);
 		}
-
-		// Insert a zero to reserve space for + or -. Used by the blueprint
-		PreparedNumberInfo.DamageNumberArray.Insert(0, 0);
 	}
 
 	// Grab a component from the pool for this number or create one
@@ -116,7 +106,7 @@ void UBENumberPopComponent_MeshText::AddNumberPop(const FBENumberPopRequest& New
 		// Add to the "live" list
 		UWorld* LocalWorld = GetWorld();
 		check(LocalWorld);
-		LiveComponents.Emplace(ComponentToUse, &ComponentPool, LocalWorld->GetTimeSeconds() + ComponentLifespan);
+		LiveComponents.Emplace(ComponentToUse, MeshToUse, LocalWorld->GetTimeSeconds() + ComponentLifespan);
 
 		// Assign struct pointers
 		PreparedNumberInfo.StaticMeshComponent = ComponentToUse;
@@ -173,10 +163,10 @@ void UBENumberPopComponent_MeshText::ReleaseNextComponents()
 			{
 				LiveComp.Component->UnregisterComponent();
 
-				if (ensure(LiveComp.Pool))
+				if (FPooledNumberPopComponentList* Pool = PooledComponentMap.Find(LiveComp.PoolMesh))
 				{
 					// Return this component to the pool
-					LiveComp.Pool->Components.Push(LiveComp.Component);
+					Pool->Components.Push(LiveComp.Component);
 				}
 				else
 				{
@@ -193,8 +183,8 @@ void UBENumberPopComponent_MeshText::ReleaseNextComponents()
 		}
 	}
 
-	// Actually remove it from the live components array
-	LiveComponents.RemoveAt(0, NumReleased);
+	// Actually remove it from the live components array, keeping the allocation for the next pops
+	LiveComponents.RemoveAt(0, NumReleased, false);
 
 	// If we still have live components animating, set the timer to remove the next one
 	if (LiveComponents.Num() > 0)
@@ -204,6 +194,11 @@ void UBENumberPopComponent_MeshText::ReleaseNextComponents()
 	}
 }
 
+bool UBENumberPopComponent_MeshText::CanDisplayNumberPop(const FBENumberPopRequest& Request) const
+{
+	return DetermineStaticMesh(Request) != nullptr;
+}
+
 FLinearColor UBENumberPopComponent_MeshText::DetermineColor(const FBENumberPopRequest& Request) const
 {
 	for (UBEDamagePopStyle* Style : Styles)
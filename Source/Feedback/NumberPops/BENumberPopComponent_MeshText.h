@@ -27,8 +27,9 @@ struct FLiveNumberPopEntry
 	UPROPERTY(transient)
 	UStaticMeshComponent* Component = nullptr;
 
-	/** The pool this component will go into when released */
-	FPooledNumberPopComponentList* Pool = nullptr;
+	/** Key of the pool in PooledComponentMap this component will go into when released (a pointer into the map would dangle when it rehashes) */
+	UPROPERTY(transient)
+	TObjectPtr<UStaticMesh> PoolMesh = nullptr;
 
 	/** The world time that this component will be released to the pool */
 	float ReleaseTime = 0.0f;
@@ -36,8 +37,8 @@ struct FLiveNumberPopEntry
 	FLiveNumberPopEntry()
 	{}
 
-	FLiveNumberPopEntry(UStaticMeshComponent* InComponent, FPooledNumberPopComponentList* InPool, float InReleaseTime)
-		: Component(InComponent), Pool(InPool), ReleaseTime(InReleaseTime)
+	FLiveNumberPopEntry(UStaticMeshComponent* InComponent, UStaticMesh* InPoolMesh, float InReleaseTime)
+		: Component(InComponent), PoolMesh(InPoolMesh), ReleaseTime(InReleaseTime)
 	{}
 };
 
@@ -46,9 +47,10 @@ struct FTempNumberPopInfo
 {
 	UStaticMeshComponent* StaticMeshComponent = nullptr;
 
-	TArray<UMaterialInstanceDynamic*> MeshMIDs;
+	TArray<UMaterialInstanceDynamic*, TInlineAllocator<4>> MeshMIDs;
 
-	TArray<int32> DamageNumberArray;
+	// Sign slot followed by the digits
+	TArray<int32, TInlineAllocator<BENumberPops::MaxDigits + 1>> DamageNumberArray;
 };
 
 
@@ -65,6 +67,7 @@ public:
 
 	//~UBENumberPopComponent interface
 	virtual void AddNumberPop(const FBENumberPopRequest& NewRequest) override;
+	virtual bool CanDisplayNumberPop(const FBENumberPopRequest& Request) const override;
 	//~End of UBENumberPopComponent interface
 
 protected:
@@ -9,32 +9,32 @@
 #include "AbilitySystemComponent.h"
 #include "Containers/Array.h"
 #include "Engine/EngineBaseTypes.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "Misc/App.h"
+#include "Misc/CoreDelegates.h"
 #include "GameFramework/GameplayMessageSubsystem.h"
 #include "HAL/Platform.h"
 #include "Misc/AssertionMacros.h"
 #include "Net/UnrealNetwork.h"
+#include "TimerManager.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(BEGameState)
 
 class APlayerState;
 class FLifetimeProperty;
 
-extern ENGINE_API float GAverageFPS;
-
 
 ABEGameState::ABEGameState(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
-	PrimaryActorTick.bCanEverTick = true;
-	PrimaryActorTick.bStartWithTickEnabled = true;
+	PrimaryActorTick.bCanEverTick = false;
 
 	AbilitySystemComponent = ObjectInitializer.CreateDefaultSubobject<UBEAbilitySystemComponent>(this, TEXT("AbilitySystemComponent"));
 	AbilitySystemComponent->SetIsReplicated(true);
 	AbilitySystemComponent->SetReplicationMode(EGameplayEffectReplicationMode::Mixed);
 
 	ExperienceManagerComponent = CreateDefaultSubobject<UBEExperienceManagerComponent>(TEXT("ExperienceManagerComponent"));
-
-	ServerFPS = 0.0f;
 }
 
 void ABEGameState::PreInitializeComponents()
@@ -55,8 +55,25 @@ UAbilitySystemComponent* ABEGameState::GetAbilitySystemComponent() const
 	return AbilitySystemComponent;
 }
 
+void ABEGameState::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (HasAuthority())
+	{
+		EndFrameHandle = FCoreDelegates::OnEndFrame.AddUObject(this, &ThisClass::HandleEndFrame);
+		GetWorldTimerManager().SetTimer(ServerFrameStatsTimerHandle, this, &ThisClass::UpdateServerFrameStats, FBEServerFrameStatsTracker::GetUpdateInterval(), /*bLoop=*/ true);
+	}
+}
+
 void ABEGameState::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
+	FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+	EndFrameHandle.Reset();
+
+	GetWorldTimerManager().ClearTimer(ServerFrameStatsTimerHandle);
+	ServerFrameStatsTracker.Reset();
+
 	Super::EndPlay(EndPlayReason);
 }
 
@@ -76,17 +93,36 @@ void ABEGameState::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLife
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME(ThisClass, ServerFPS);
+	DOREPLIFETIME(ThisClass, ServerFrameStats);
+}
+
+float ABEGameState::GetServerFPS() const
+{
+	const double AverageDeltaTime = ServerFrameStats.GetAverageDeltaTime();
+	return (AverageDeltaTime > 0.0) ? static_cast<float>(1.0 / AverageDeltaTime) : 0.0f;
 }
 
-void ABEGameState::Tick(float DeltaSeconds)
+void ABEGameState::HandleEndFrame()
 {
-	Super::Tick(DeltaSeconds);
+	// The idle time is the wait for the tick rate, what is left is the time the server worked on the frame
+	const double DeltaTime = FApp::GetDeltaTime();
+	ServerFrameStatsTracker.AddFrame(DeltaTime, FMath::Max(DeltaTime - FApp::GetIdleTime(), 0.0));
+}
 
-	if (GetLocalRole() == ROLE_Authority)
+void ABEGameState::UpdateServerFrameStats()
+{
+	// Measure against the tick rate on dedicated servers, elsewhere the frame rate is not capped by the net driver
+	double TargetFrameTime = 0.0;
+	if (GetNetMode() == NM_DedicatedServer)
 	{
-		ServerFPS = GAverageFPS;
+		if (const UNetDriver* NetDriver = GetNetDriver())
+		{
+			const int32 MaxTickRate = NetDriver->GetNetServerMaxTickRate();
+			TargetFrameTime = (MaxTickRate > 0) ? (1.0 / MaxTickRate) : 0.0;
+		}
 	}
+
+	ServerFrameStatsTracker.Flush(TargetFrameTime, ServerFrameStats);
 }
 
 void ABEGameState::MulticastMessageToClients_Implementation(const FBEVerbMessage Message)
@@ -6,6 +6,7 @@
 #include "ModularGameState.h"
 
 #include "Message/BEVerbMessage.h"
+#include "Performance/BEServerFrameStats.h"
 
 #include "AbilitySystemInterface.h"
 #include "Engine/EngineTypes.h"
@@ -35,11 +36,15 @@ public:
 
 	ABEGameState(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
 
-	float GetServerFPS() const { return ServerFPS; }
+	float GetServerFPS() const;
+
+	// Server frame times over the last few seconds, updated at a low fixed rate
+	const FBEServerFrameStats& GetServerFrameStats() const { return ServerFrameStats; }
 
 	//~AActor interface
 	virtual void PreInitializeComponents() override;
 	virtual void PostInitializeComponents() override;
+	virtual void BeginPlay() override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	//~End of AActor interface
 
@@ -74,11 +79,15 @@ private:
 	TObjectPtr<UBEAbilitySystemComponent> AbilitySystemComponent;
 
 
-protected:
+private:
+	void HandleEndFrame();
+	void UpdateServerFrameStats();
 
-	virtual void Tick(float DeltaSeconds) override;
+	FBEServerFrameStatsTracker ServerFrameStatsTracker;
+	FDelegateHandle EndFrameHandle;
+	FTimerHandle ServerFrameStatsTimerHandle;
 
 protected:
 	UPROPERTY(Replicated)
-	float ServerFPS;
+	FBEServerFrameStats ServerFrameStats;
 };
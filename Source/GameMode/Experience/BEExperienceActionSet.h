@@ -41,4 +41,8 @@ public:
 	// List of Game Feature Plugins this experience wants to have active
 	UPROPERTY(EditAnywhere, Category="Feature Dependencies")
 	TArray<FString> GameFeaturesToEnable;
+
+	// List of primary assets to stream in while the experience loads, without blocking the experience from starting
+	UPROPERTY(EditAnywhere, Category="Loading")
+	TArray<FPrimaryAssetId> AssetsToPreload;
 };
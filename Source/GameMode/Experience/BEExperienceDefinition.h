@@ -5,6 +5,7 @@
 
 #include "CoreMinimal.h"
 #include "Engine/DataAsset.h"
+#include "GameplayTagContainer.h"
 #include "BEExperienceDefinition.generated.h"
 
 class UGameFeatureAction;
@@ -52,4 +53,12 @@ public:
 	// List of additional action sets to compose into this experience
 	UPROPERTY(EditDefaultsOnly, Category=Gameplay)
 	TArray<TObjectPtr<UBEExperienceActionSet>> ActionSets;
+
+	// List of primary assets to stream in while the experience loads, without blocking the experience from starting
+	UPROPERTY(EditDefaultsOnly, Category=Loading)
+	TArray<FPrimaryAssetId> AssetsToPreload;
+
+	// Gameplay cues loaded as part of the experience load, so their first use in a match doesn't miss or hitch
+	UPROPERTY(EditDefaultsOnly, Category=Loading, meta=(Categories="GameplayCue"))
+	FGameplayTagContainer GameplayCuesToPreload;
 };
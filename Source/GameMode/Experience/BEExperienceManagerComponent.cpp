@@ -9,9 +9,10 @@
 #include "GameFeaturesSubsystem.h"
 #include "System/BEAssetManager.h"
 #include "GameFeatureAction.h"
-#include "GameFeaturesSubsystemSettings.h"
 #include "TimerManager.h"
 #include "GameSetting/BEGameDeviceSettings.h"
+#include "Ability/BEGameplayCueManager.h"
+#include "Character/BEPawnData.h"
 #include "BELogChannels.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(BEExperienceManagerComponent)
@@ -20,7 +21,6 @@
 
 //@TODO: Async load the experience definition itself
 //@TODO: Handle failures explicitly (go into a 'completed but failed' state rather than check()-ing)
-//@TODO: Do the action phases at the appropriate times instead of all at once
 //@TODO: Support deactivating an experience and do the unloading actions
 //@TODO: Think about what deactivation/cleanup means for preloaded assets
 //@TODO: Handle deactivating game features, right now we 'leak' them enabled
@@ -45,6 +45,13 @@ namespace BEConsoleVariables
 		TEXT("A random amount of time between 0 and this value (in seconds) will be added as a delay of load completion of the experience (along with the fixed value BE.chaos.ExperienceDelayLoad.MinSecs)"),
 		ECVF_Default);
 
+	static float ExperienceActionActivationBudgetMs = 4.0f;
+	static FAutoConsoleVariableRef CVarExperienceActionActivationBudgetMs(
+		TEXT("BE.Experience.ActionActivationBudgetMs"),
+		ExperienceActionActivationBudgetMs,
+		TEXT("Time budget (in milliseconds) per frame for activating experience actions, remaining actions are activated on the next frame. 0 activates all actions in a single frame."),
+		ECVF_Default);
+
 	float GetExperienceLoadDelayDuration()
 	{
 		return FMath::Max(0.0f, ExperienceLoadRandomDelayMin + FMath::FRand() * ExperienceLoadRandomDelayRange);
@@ -138,6 +145,9 @@ void UBEExperienceManagerComponent::StartExperienceLoad()
 		*GetClientServerContextString(this));
 
 	LoadState = EBEExperienceLoadState::Loading;
+	LoadTimings = FBEExperienceLoadTimings();
+	LoadTimings.StartTime = FPlatformTime::Seconds();
+	bBundleLoadComplete = false;
 
 	UBEAssetManager& AssetManager = UBEAssetManager::Get();
 
@@ -157,34 +167,39 @@ void UBEExperienceManagerComponent::StartExperienceLoad()
 
 	TArray<FName> BundlesToLoad;
 	BundlesToLoad.Add(FBEBundles::Equipped);
+	UBEAssetManager::GetGameFeatureBundlesForNetMode(GetOwner()->GetNetMode(), BundlesToLoad);
 
-	//@TODO: Centralize this client/server stuff into the BEAssetManager
-	const ENetMode OwnerNetMode = GetOwner()->GetNetMode();
-	const bool bLoadClient = GIsEditor || (OwnerNetMode != NM_DedicatedServer);
-	const bool bLoadServer = GIsEditor || (OwnerNetMode != NM_Client);
-	if (bLoadClient)
-	{
-		BundlesToLoad.Add(UGameFeaturesSubsystemSettings::LoadStateClient);
-	}
-	if (bLoadServer)
-	{
-		BundlesToLoad.Add(UGameFeaturesSubsystemSettings::LoadStateServer);
-	}
+	// The experience definition and its action sets are hard referenced, so the plugin list is already known.
+	// Start loading the game feature plugins now so they overlap with the bundle streaming below.
+	StartGameFeaturePluginLoads();
 
 	const TSharedPtr<FStreamableHandle> BundleLoadHandle = AssetManager.ChangeBundleStateForPrimaryAssets(BundleAssetList.Array(), BundlesToLoad, {}, false, FStreamableDelegate(), FStreamableManager::AsyncLoadHighPriority);
 	const TSharedPtr<FStreamableHandle> RawLoadHandle = AssetManager.LoadAssetList(RawAssetList.Array(), FStreamableDelegate(), FStreamableManager::AsyncLoadHighPriority, TEXT("StartExperienceLoad()"));
+	const TSharedPtr<FStreamableHandle> CueLoadHandle = StartPreloadingGameplayCues();
+
+	// If several async loads are running, combine them
+	TArray<TSharedPtr<FStreamableHandle>> LoadHandles;
+	for (const TSharedPtr<FStreamableHandle>& LoadHandle : { BundleLoadHandle, RawLoadHandle, CueLoadHandle })
+	{
+		if (LoadHandle.IsValid())
+		{
+			LoadHandles.Add(LoadHandle);
+		}
+	}
 
-	// If both async loads are running, combine them
 	TSharedPtr<FStreamableHandle> Handle = nullptr;
-	if (BundleLoadHandle.IsValid() && RawLoadHandle.IsValid())
+	if (LoadHandles.Num() > 1)
 	{
-		Handle = AssetManager.GetStreamableManager().CreateCombinedHandle({ BundleLoadHandle, RawLoadHandle });
+		Handle = AssetManager.GetStreamableManager().CreateCombinedHandle(LoadHandles);
 	}
-	else
+	else if (LoadHandles.Num() == 1)
 	{
-		Handle = BundleLoadHandle.IsValid() ? BundleLoadHandle : RawLoadHandle;
+		Handle = LoadHandles[0];
 	}
 
+	// This set of assets gets preloaded, but we don't block the start of the experience based on it
+	StartPreloadingAssets(BundlesToLoad);
+
 	FStreamableDelegate OnAssetsLoadedDelegate = FStreamableDelegate::CreateUObject(this, &ThisClass::OnExperienceLoadComplete);
 	if (!Handle.IsValid() || Handle->HasLoadCompleted())
 	{
@@ -200,25 +215,12 @@ void UBEExperienceManagerComponent::StartExperienceLoad()
 			OnAssetsLoadedDelegate.ExecuteIfBound();
 		}));
 	}
-
-	//// This set of assets gets preloaded, but we don't block the start of the experience based on it
-	//TSet<FPrimaryAssetId> PreloadAssetList;
-	////@TODO: Determine assets to preload (but not blocking-ly)
-	//if (PreloadAssetList.Num() > 0)
-	//{
-	//	AssetManager.ChangeBundleStateForPrimaryAssets(PreloadAssetList.Array(), BundlesToLoad, {});
-	//}
 }
 
-void UBEExperienceManagerComponent::OnExperienceLoadComplete()
+void UBEExperienceManagerComponent::StartGameFeaturePluginLoads()
 {
-	check(LoadState == EBEExperienceLoadState::Loading);
 	check(CurrentExperience != nullptr);
 
-	UE_LOG(LogBEExperience, Log, TEXT("EXPERIENCE: OnExperienceLoadComplete(CurrentExperience = %s, %s)"),
-		*CurrentExperience->GetPrimaryAssetId().ToString(),
-		*GetClientServerContextString(this));
-
 	// find the URLs for our GameFeaturePlugins - filtering out dupes and ones that don't have a valid mapping
 	GameFeaturePluginURLs.Reset();
 
@@ -233,19 +235,9 @@ void UBEExperienceManagerComponent::OnExperienceLoadComplete()
 			}
 			else
 			{
-				ensureMsgf(false, TEXT("OnExperienceLoadComplete failed to find plugin URL from PluginName %s for experience %s - fix data, ignoring for this run"), *PluginName, *Context->GetPrimaryAssetId().ToString());
+				ensureMsgf(false, TEXT("StartGameFeaturePluginLoads failed to find plugin URL from PluginName %s for experience %s - fix data, ignoring for this run"), *PluginName, *Context->GetPrimaryAssetId().ToString());
 			}
 		}
-
-		// 		// Add in our extra plugin
-		// 		if (!CurrentPlaylistData->GameFeaturePluginToActivateUntilDownloadedContentIsPresent.IsEmpty())
-		// 		{
-		// 			FString PluginURL;
-		// 			if (UGameFeaturesSubsystem::Get().GetPluginURLByName(CurrentPlaylistData->GameFeaturePluginToActivateUntilDownloadedContentIsPresent, PluginURL))
-		// 			{
-		// 				GameFeaturePluginURLs.AddUnique(PluginURL);
-		// 			}
-		// 		}
 	};
 
 	CollectGameFeaturePluginURLs(CurrentExperience, CurrentExperience->GameFeaturesToEnable);
@@ -257,21 +249,70 @@ void UBEExperienceManagerComponent::OnExperienceLoadComplete()
 		}
 	}
 
-	// Load and activate the features	
+	// Load and activate the features
+	// Set the count before starting any load, as plugins that are already active complete synchronously
 	NumGameFeaturePluginsLoading = GameFeaturePluginURLs.Num();
-	if (NumGameFeaturePluginsLoading > 0)
+	for (const FString& PluginURL : GameFeaturePluginURLs)
 	{
-		LoadState = EBEExperienceLoadState::LoadingGameFeatures;
-		for (const FString& PluginURL : GameFeaturePluginURLs)
+		UBEExperienceManager::NotifyOfPluginActivation(PluginURL);
+		UGameFeaturesSubsystem::Get().LoadAndActivateGameFeaturePlugin(PluginURL, FGameFeaturePluginLoadComplete::CreateUObject(this, &ThisClass::OnGameFeaturePluginLoadComplete));
+	}
+}
+
+void UBEExperienceManagerComponent::StartPreloadingAssets(const TArray<FName>& BundlesToLoad)
+{
+	check(CurrentExperience != nullptr);
+
+	TSet<FPrimaryAssetId> PreloadAssetList;
+	PreloadAssetList.Append(CurrentExperience->AssetsToPreload);
+	for (const TObjectPtr<UBEExperienceActionSet>& ActionSet : CurrentExperience->ActionSets)
+	{
+		if (ActionSet != nullptr)
 		{
-			UBEExperienceManager::NotifyOfPluginActivation(PluginURL);
-			UGameFeaturesSubsystem::Get().LoadAndActivateGameFeaturePlugin(PluginURL, FGameFeaturePluginLoadComplete::CreateUObject(this, &ThisClass::OnGameFeaturePluginLoadComplete));
+			PreloadAssetList.Append(ActionSet->AssetsToPreload);
 		}
 	}
-	else
+
+	if (PreloadAssetList.Num() > 0)
+	{
+		UE_LOG(LogBEExperience, Log, TEXT("EXPERIENCE: Preloading %d assets without blocking (%s)"), PreloadAssetList.Num(), *GetClientServerContextString(this));
+
+		PreloadHandle = UBEAssetManager::Get().ChangeBundleStateForPrimaryAssets(PreloadAssetList.Array(), BundlesToLoad, {}, false, FStreamableDelegate(), FStreamableManager::DefaultAsyncLoadPriority);
+	}
+}
+
+TSharedPtr<FStreamableHandle> UBEExperienceManagerComponent::StartPreloadingGameplayCues()
+{
+	check(CurrentExperience != nullptr);
+
+	UBEGameplayCueManager* GCM = UBEGameplayCueManager::Get();
+	if (!GCM)
+	{
+		return nullptr;
+	}
+
+	FGameplayTagContainer CueTags = CurrentExperience->GameplayCuesToPreload;
+	if (CurrentExperience->DefaultPawnData != nullptr)
 	{
-		OnExperienceFullLoadCompleted();
+		CueTags.AppendTags(CurrentExperience->DefaultPawnData->GameplayCuesToPreload);
 	}
+
+	return GCM->PreloadGameplayCueSet(CueTags, CurrentExperience);
+}
+
+void UBEExperienceManagerComponent::OnExperienceLoadComplete()
+{
+	check(LoadState == EBEExperienceLoadState::Loading);
+	check(CurrentExperience != nullptr);
+
+	UE_LOG(LogBEExperience, Log, TEXT("EXPERIENCE: OnExperienceLoadComplete(CurrentExperience = %s, %s)"),
+		*CurrentExperience->GetPrimaryAssetId().ToString(),
+		*GetClientServerContextString(this));
+
+	bBundleLoadComplete = true;
+	LoadTimings.BundleLoadSeconds = FPlatformTime::Seconds() - LoadTimings.StartTime;
+
+	TryCompleteExperienceLoad();
 }
 
 void UBEExperienceManagerComponent::OnGameFeaturePluginLoadComplete(const UE::GameFeatures::FResult& Result)
@@ -281,8 +322,32 @@ void UBEExperienceManagerComponent::OnGameFeaturePluginLoadComplete(const UE::Ga
 
 	if (NumGameFeaturePluginsLoading == 0)
 	{
-		OnExperienceFullLoadCompleted();
+		LoadTimings.GameFeatureLoadSeconds = FPlatformTime::Seconds() - LoadTimings.StartTime;
+
+		TryCompleteExperienceLoad();
+	}
+}
+
+void UBEExperienceManagerComponent::TryCompleteExperienceLoad()
+{
+	// Plugins that were already active complete synchronously while the load is being started, ignore those until the bundles are done too
+	if ((LoadState != EBEExperienceLoadState::Loading) && (LoadState != EBEExperienceLoadState::LoadingGameFeatures))
+	{
+		return;
+	}
+
+	if (!bBundleLoadComplete)
+	{
+		return;
+	}
+
+	if (NumGameFeaturePluginsLoading > 0)
+	{
+		LoadState = EBEExperienceLoadState::LoadingGameFeatures;
+		return;
 	}
+
+	OnExperienceFullLoadCompleted();
 }
 
 void UBEExperienceManagerComponent::OnExperienceFullLoadCompleted()
@@ -306,6 +371,44 @@ void UBEExperienceManagerComponent::OnExperienceFullLoadCompleted()
 
 	LoadState = EBEExperienceLoadState::ExecutingActions;
 
+	// Gather the actions to execute, they are activated in order over one or more frames
+	ExperienceActions.Reset();
+	NumActionsActivated = 0;
+
+	auto GatherListOfActions = [this](const TArray<TObjectPtr<UGameFeatureAction>>& ActionList)
+	{
+		for (UGameFeatureAction* Action : ActionList)
+		{
+			if (Action != nullptr)
+			{
+				ExperienceActions.Add(Action);
+			}
+		}
+	};
+
+	GatherListOfActions(CurrentExperience->Actions);
+	for (const TObjectPtr<UBEExperienceActionSet>& ActionSet : CurrentExperience->ActionSets)
+	{
+		if (ActionSet != nullptr)
+		{
+			GatherListOfActions(ActionSet->Actions);
+		}
+	}
+
+	ActivatePendingActions();
+}
+
+void UBEExperienceManagerComponent::ActivatePendingActions()
+{
+	if (LoadState != EBEExperienceLoadState::ExecutingActions)
+	{
+		// The experience was torn down while we were waiting for the next frame
+		return;
+	}
+
+	const double SliceStartTime = FPlatformTime::Seconds();
+	const double BudgetSeconds = BEConsoleVariables::ExperienceActionActivationBudgetMs * 0.001;
+
 	// Execute the actions
 	FGameFeatureActivatingContext Context;
 
@@ -316,33 +419,55 @@ void UBEExperienceManagerComponent::OnExperienceFullLoadCompleted()
 		Context.SetRequiredWorldContextHandle(ExistingWorldContext->ContextHandle);
 	}
 
-	auto ActivateListOfActions = [&Context](const TArray<UGameFeatureAction*>& ActionList)
+	while (NumActionsActivated < ExperienceActions.Num())
 	{
-		for (UGameFeatureAction* Action : ActionList)
+		if (UGameFeatureAction* Action = ExperienceActions[NumActionsActivated])
 		{
-			if (Action != nullptr)
-			{
-				//@TODO: The fact that these don't take a world are potentially problematic in client-server PIE
-				// The current behavior matches systems like gameplay tags where loading and registering apply to the entire process,
-				// but actually applying the results to actors is restricted to a specific world
-				Action->OnGameFeatureRegistering();
-				Action->OnGameFeatureLoading();
-				Action->OnGameFeatureActivating(Context);
-			}
+			//@TODO: The fact that these don't take a world are potentially problematic in client-server PIE
+			// The current behavior matches systems like gameplay tags where loading and registering apply to the entire process,
+			// but actually applying the results to actors is restricted to a specific world
+			Action->OnGameFeatureRegistering();
+			Action->OnGameFeatureLoading();
+			Action->OnGameFeatureActivating(Context);
 		}
-	};
 
-	ActivateListOfActions(CurrentExperience->Actions);
-	for (const TObjectPtr<UBEExperienceActionSet>& ActionSet : CurrentExperience->ActionSets)
-	{
-		if (ActionSet != nullptr)
+		++NumActionsActivated;
+
+		// Always make progress of at least one action per frame
+		if ((BudgetSeconds > 0.0) && (FPlatformTime::Seconds() - SliceStartTime >= BudgetSeconds))
 		{
-			ActivateListOfActions(ActionSet->Actions);
+			break;
 		}
 	}
 
+	LoadTimings.ActionActivationSeconds += FPlatformTime::Seconds() - SliceStartTime;
+	++LoadTimings.ActionActivationFrames;
+
+	if (NumActionsActivated < ExperienceActions.Num())
+	{
+		GetWorld()->GetTimerManager().SetTimerForNextTick(this, &ThisClass::ActivatePendingActions);
+	}
+	else
+	{
+		OnAllActionsActivated();
+	}
+}
+
+void UBEExperienceManagerComponent::OnAllActionsActivated()
+{
 	LoadState = EBEExperienceLoadState::Loaded;
 
+	LoadTimings.TotalSeconds = FPlatformTime::Seconds() - LoadTimings.StartTime;
+
+	UE_LOG(LogBEExperience, Log, TEXT("EXPERIENCE: %s loaded in %.3fs (Bundles: %.3fs, GameFeatures: %.3fs, Actions: %.3fs over %d frames) (%s)"),
+		*CurrentExperience->GetPrimaryAssetId().ToString(),
+		LoadTimings.TotalSeconds,
+		LoadTimings.BundleLoadSeconds,
+		LoadTimings.GameFeatureLoadSeconds,
+		LoadTimings.ActionActivationSeconds,
+		LoadTimings.ActionActivationFrames,
+		*GetClientServerContextString(this));
+
 	OnExperienceLoaded_HighPriority.Broadcast(CurrentExperience);
 	OnExperienceLoaded_HighPriority.Clear();
 
@@ -390,8 +515,14 @@ void UBEExperienceManagerComponent::EndPlay(const EEndPlayReason::Type EndPlayRe
 		}
 	}
 
-	//@TODO: Ensure proper handling of a partially-loaded state too
-	if (LoadState == EBEExperienceLoadState::Loaded)
+	if (PreloadHandle.IsValid())
+	{
+		PreloadHandle->CancelHandle();
+		PreloadHandle.Reset();
+	}
+
+	// Actions may have been partially activated if we are torn down while time slicing them
+	if ((LoadState == EBEExperienceLoadState::Loaded) || (LoadState == EBEExperienceLoadState::ExecutingActions))
 	{
 		LoadState = EBEExperienceLoadState::Deactivating;
 
@@ -408,27 +539,18 @@ void UBEExperienceManagerComponent::EndPlay(const EEndPlayReason::Type EndPlayRe
 			Context.SetRequiredWorldContextHandle(ExistingWorldContext->ContextHandle);
 		}
 
-		auto DeactivateListOfActions = [&Context](const TArray<UGameFeatureAction*>& ActionList)
-		{
-			for (UGameFeatureAction* Action : ActionList)
-			{
-				if (Action)
-				{
-					Action->OnGameFeatureDeactivating(Context);
-					Action->OnGameFeatureUnregistering();
-				}
-			}
-		};
-
-		DeactivateListOfActions(CurrentExperience->Actions);
-		for (const TObjectPtr<UBEExperienceActionSet>& ActionSet : CurrentExperience->ActionSets)
+		for (int32 ActionIndex = 0; ActionIndex < NumActionsActivated; ++ActionIndex)
 		{
-			if (ActionSet != nullptr)
+			if (UGameFeatureAction* Action = ExperienceActions[ActionIndex])
 			{
-				DeactivateListOfActions(ActionSet->Actions);
+				Action->OnGameFeatureDeactivating(Context);
+				Action->OnGameFeatureUnregistering();
 			}
 		}
 
+		ExperienceActions.Reset();
+		NumActionsActivated = 0;
+
 		NumExpectedPausers = Context.GetNumPausers();
 
 		if (NumExpectedPausers > 0)
@@ -11,6 +11,8 @@
 #include "BEExperienceManagerComponent.generated.h"
 
 class UBEExperienceDefinition;
+class UGameFeatureAction;
+struct FStreamableHandle;
 
 DECLARE_MULTICAST_DELEGATE_OneParam(FOnBEExperienceLoaded, const UBEExperienceDefinition* /*Experience*/);
 
@@ -29,6 +31,33 @@ enum class EBEExperienceLoadState
 
 ////////////////////////////////////////////////////////////////////
 
+/**
+ * Wall-clock timings (in seconds) of each experience load phase.
+ * Bundle streaming and game feature loading run in parallel, so their sum can exceed the total.
+ */
+struct FBEExperienceLoadTimings
+{
+	// Time the load was started (FPlatformTime::Seconds)
+	double StartTime = 0.0;
+
+	// Time from load start until the experience bundles finished streaming
+	double BundleLoadSeconds = 0.0;
+
+	// Time from load start until all game feature plugins were loaded and activated
+	double GameFeatureLoadSeconds = 0.0;
+
+	// Time spent activating experience actions (game thread only, summed across frames)
+	double ActionActivationSeconds = 0.0;
+
+	// Number of frames the action activation was spread over
+	int32 ActionActivationFrames = 0;
+
+	// Time from load start until the experience was fully loaded
+	double TotalSeconds = 0.0;
+};
+
+////////////////////////////////////////////////////////////////////
+
 UCLASS()
 class UBEExperienceManagerComponent final : public UGameStateComponent, public ILoadingProcessInterface
 {
@@ -70,14 +99,23 @@ public:
 	// Returns true if the experience is fully loaded
 	bool IsExperienceLoaded() const;
 
+	// Returns the per-phase timings of the current (or last) experience load
+	const FBEExperienceLoadTimings& GetLoadTimings() const { return LoadTimings; }
+
 private:
 	UFUNCTION()
 		void OnRep_CurrentExperience();
 
 	void StartExperienceLoad();
+	void StartGameFeaturePluginLoads();
+	void StartPreloadingAssets(const TArray<FName>& BundlesToLoad);
+	TSharedPtr<FStreamableHandle> StartPreloadingGameplayCues();
 	void OnExperienceLoadComplete();
 	void OnGameFeaturePluginLoadComplete(const UE::GameFeatures::FResult& Result);
+	void TryCompleteExperienceLoad();
 	void OnExperienceFullLoadCompleted();
+	void ActivatePendingActions();
+	void OnAllActionsActivated();
 
 	void OnActionDeactivationCompleted();
 	void OnAllActionsDeactivated();
@@ -91,6 +129,21 @@ private:
 	int32 NumGameFeaturePluginsLoading = 0;
 	TArray<FString> GameFeaturePluginURLs;
 
+	// True once the experience bundles have finished streaming (plugins may still be loading)
+	bool bBundleLoadComplete = false;
+
+	// Handle for the non-blocking preload, kept so it can be released when the experience ends
+	TSharedPtr<FStreamableHandle> PreloadHandle;
+
+	// All actions of the experience and its action sets, in activation order
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UGameFeatureAction>> ExperienceActions;
+
+	// Number of entries in ExperienceActions that have been activated so far
+	int32 NumActionsActivated = 0;
+
+	FBEExperienceLoadTimings LoadTimings;
+
 	int32 NumObservedPausers = 0;
 	int32 NumExpectedPausers = 0;
 
@@ -68,6 +68,61 @@ void UBEGameSettingRegistry::AddPrefStatSettingsSection(UGameSettingCollection*
 				StatCategory_Performance->AddSetting(Setting);
 			}
 
+			//======================================
+			//	サーバーフレーム時間表示設定
+			//======================================
+			{
+				UBESettingValueDiscrete_PerfStat* Setting = NewObject<UBESettingValueDiscrete_PerfStat>();
+				Setting->SetStat(EBEDisplayablePerformanceStat::ServerFrameTime);
+				Setting->SetDisplayName(LOCTEXT("PerfStat_ServerFrameTime", "Server Frame Time"));
+				Setting->SetDescriptionRichText(LOCTEXT("PerfStatDescription_ServerFrameTime", "The average time the server spent on a frame over the last few seconds."));
+				StatCategory_Performance->AddSetting(Setting);
+			}
+
+			//======================================
+			//	サーバー最大フレーム時間表示設定
+			//======================================
+			{
+				UBESettingValueDiscrete_PerfStat* Setting = NewObject<UBESettingValueDiscrete_PerfStat>();
+				Setting->SetStat(EBEDisplayablePerformanceStat::ServerFrameTime_Worst);
+				Setting->SetDisplayName(LOCTEXT("PerfStat_ServerFrameTime_Worst", "Server Worst Frame Time"));
+				Setting->SetDescriptionRichText(LOCTEXT("PerfStatDescription_ServerFrameTime_Worst", "The longest server frame over the last few seconds, shows server hitches."));
+				StatCategory_Performance->AddSetting(Setting);
+			}
+
+			//======================================
+			//	サーバーティック負荷表示設定
+			//======================================
+			{
+				UBESettingValueDiscrete_PerfStat* Setting = NewObject<UBESettingValueDiscrete_PerfStat>();
+				Setting->SetStat(EBEDisplayablePerformanceStat::ServerTickBudgetUsage);
+				Setting->SetDisplayName(LOCTEXT("PerfStat_ServerTickBudgetUsage", "Server Tick Budget"));
+				Setting->SetDescriptionRichText(LOCTEXT("PerfStatDescription_ServerTickBudgetUsage", "How much of the server tick interval the average frame uses (%)."));
+				StatCategory_Performance->AddSetting(Setting);
+			}
+
+			//======================================
+			//	入力から発動までの遅延表示設定
+			//======================================
+			{
+				UBESettingValueDiscrete_PerfStat* Setting = NewObject<UBESettingValueDiscrete_PerfStat>();
+				Setting->SetStat(EBEDisplayablePerformanceStat::InputToActivate);
+				Setting->SetDisplayName(LOCTEXT("PerfStat_InputToActivate", "Input to Activate"));
+				Setting->SetDescriptionRichText(LOCTEXT("PerfStatDescription_InputToActivate", "The average time from pressing an ability input to the ability activating."));
+				StatCategory_Performance->AddSetting(Setting);
+			}
+
+			//======================================
+			//	発動からサーバー承認までの遅延表示設定
+			//======================================
+			{
+				UBESettingValueDiscrete_PerfStat* Setting = NewObject<UBESettingValueDiscrete_PerfStat>();
+				Setting->SetStat(EBEDisplayablePerformanceStat::ActivateToServerConfirm);
+				Setting->SetDisplayName(LOCTEXT("PerfStat_ActivateToServerConfirm", "Activate to Server Confirm"));
+				Setting->SetDescriptionRichText(LOCTEXT("PerfStatDescription_ActivateToServerConfirm", "The average time from a predicted ability activation to the server confirming it."));
+				StatCategory_Performance->AddSetting(Setting);
+			}
+
 			//======================================
 			//	フレーム時間表示設定
 			//======================================
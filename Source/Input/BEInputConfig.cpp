@@ -19,14 +19,45 @@ UBEInputConfig::UBEInputConfig(const FObjectInitializer& ObjectInitializer)
 {
 }
 
-const UInputAction* UBEInputConfig::FindNativeInputActionForTag(const FGameplayTag& InputTag, bool bLogNotFound) const
+void UBEInputConfig::PostLoad()
+{
+	Super::PostLoad();
+
+	RebuildInputActionMaps();
+}
+
+#if WITH_EDITOR
+void UBEInputConfig::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	RebuildInputActionMaps();
+}
+#endif
+
+void UBEInputConfig::RebuildInputActionMaps()
 {
-	for (const FBEInputAction& Action : NativeInputActions)
+	auto BuildMap = [](const TArray<FBEInputAction>& Actions, TMap<FGameplayTag, const UInputAction*>& OutMap)
 	{
-		if (Action.InputAction && (Action.InputTag == InputTag))
+		OutMap.Reset();
+		for (const FBEInputAction& Action : Actions)
 		{
-			return Action.InputAction;
+			if (Action.InputAction && !OutMap.Contains(Action.InputTag))
+			{
+				OutMap.Add(Action.InputTag, Action.InputAction);
+			}
 		}
+	};
+
+	BuildMap(NativeInputActions, NativeInputActionMap);
+	BuildMap(AbilityInputActions, AbilityInputActionMap);
+}
+
+const UInputAction* UBEInputConfig::FindNativeInputActionForTag(const FGameplayTag& InputTag, bool bLogNotFound) const
+{
+	if (const UInputAction* const* Action = NativeInputActionMap.Find(InputTag))
+	{
+		return *Action;
 	}
 
 	if (bLogNotFound)
@@ -39,12 +70,9 @@ const UInputAction* UBEInputConfig::FindNativeInputActionForTag(const FGameplayT
 
 const UInputAction* UBEInputConfig::FindAbilityInputActionForTag(const FGameplayTag& InputTag, bool bLogNotFound) const
 {
-	for (const FBEInputAction& Action : AbilityInputActions)
+	if (const UInputAction* const* Action = AbilityInputActionMap.Find(InputTag))
 	{
-		if (Action.InputAction && (Action.InputTag == InputTag))
-		{
-			return Action.InputAction;
-		}
+		return *Action;
 	}
 
 	if (bLogNotFound)
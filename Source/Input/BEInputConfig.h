@@ -6,6 +6,7 @@
 #include "Engine/DataAsset.h"
 
 #include "Containers/Array.h"
+#include "Containers/Map.h"
 #include "GameplayTagContainer.h"
 #include "UObject/UObjectGlobals.h"
 
@@ -49,6 +50,13 @@ public:
 
 	UBEInputConfig(const FObjectInitializer& ObjectInitializer);
 
+	//~UObject interface
+	virtual void PostLoad() override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+	//~End of UObject interface
+
 	UFUNCTION(BlueprintCallable, Category = "Pawn")
 	const UInputAction* FindNativeInputActionForTag(const FGameplayTag& InputTag, bool bLogNotFound = true) const;
 
@@ -63,4 +71,11 @@ public:
 	// List of input actions used by the owner.  These input actions are mapped to a gameplay tag and are automatically bound to abilities with matching input tags.
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Meta = (TitleProperty = "InputAction"))
 	TArray<FBEInputAction> AbilityInputActions;
+
+private:
+	void RebuildInputActionMaps();
+
+	// Input tag to input action lookups built from the lists above, the first action listed for a tag wins
+	TMap<FGameplayTag, const UInputAction*> NativeInputActionMap;
+	TMap<FGameplayTag, const UInputAction*> AbilityInputActionMap;
 };
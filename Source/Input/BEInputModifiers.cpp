@@ -8,12 +8,16 @@
 #include "GameSetting/BEGameSharedSettings.h"
 
 #include "EnhancedPlayerInput.h"
+#include "Engine/World.h"
 #include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
 #include "Logging/LogMacros.h"
 #include "Math/Vector2D.h"
 #include "Misc/AssertionMacros.h"
 #include "Templates/Casts.h"
 #include "UObject/Class.h"
+#include "UObject/Package.h"
 #include "UObject/UnrealType.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(BEInputModifiers)
@@ -42,42 +46,162 @@ namespace BEInputModifiersHelpers
 }
 
 //////////////////////////////////////////////////////////////////////
-// UBESettingBasedScalar
+// BEInputModifiersCommands
 
-FInputActionValue UBESettingBasedScalar::ModifyRaw_Implementation(const UEnhancedPlayerInput* PlayerInput, FInputActionValue CurrentValue, float DeltaTime)
+namespace BEInputModifiersCommands
 {
-	if (ensureMsgf(CurrentValue.GetValueType() != EInputActionValueType::Boolean, TEXT("Setting Based Scalar modifier doesn't support boolean values.")))
+	static void BenchmarkModifiers(const TArray<FString>& Args, UWorld* World)
 	{
-		if (UBELocalPlayer* LocalPlayer = BEInputModifiersHelpers::GetLocalPlayer(PlayerInput))
+		if (World == nullptr)
 		{
-			const UClass* SettingsClass = UBEGameSharedSettings::StaticClass();
-			UBEGameSharedSettings* SharedSettings = LocalPlayer->GetSharedSettings();
-			
-			const bool bHasCachedProperty = PropertyCache.Num() == 3;
-			
-			const FProperty* XAxisValue = bHasCachedProperty ? PropertyCache[0] : SettingsClass->FindPropertyByName(XAxisScalarSettingName);
-			const FProperty* YAxisValue = bHasCachedProperty ? PropertyCache[1] : SettingsClass->FindPropertyByName(YAxisScalarSettingName);
-			const FProperty* ZAxisValue = bHasCachedProperty ? PropertyCache[2] : SettingsClass->FindPropertyByName(ZAxisScalarSettingName);
+			return;
+		}
+
+		const int32 NumSamples = FMath::Clamp(Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 100000, 1, 10000000);
+
+		// The chain a look action typically uses
+		UBEInputModifierDeadZone* DeadZone = NewObject<UBEInputModifierDeadZone>(GetTransientPackage());
+		DeadZone->DeadzoneStick = EDeadzoneStick::LookStick;
+
+		UBESettingBasedScalar* Scalar = NewObject<UBESettingBasedScalar>(GetTransientPackage());
+		Scalar->XAxisScalarSettingName = TEXT("MouseSensitivityX");
+		Scalar->YAxisScalarSettingName = TEXT("MouseSensitivityY");
+
+		UBEInputModifierAimInversion* AimInversion = NewObject<UBEInputModifierAimInversion>(GetTransientPackage());
+
+		UInputModifier* Chain[] = { DeadZone, Scalar, AimInversion };
+
+		for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+		{
+			const APlayerController* PC = It->Get();
+			const UEnhancedPlayerInput* PlayerInput = PC ? Cast<UEnhancedPlayerInput>(PC->PlayerInput) : nullptr;
+			if (!PlayerInput || !BEInputModifiersHelpers::GetLocalPlayer(PlayerInput))
+			{
+				continue;
+			}
 
-			if (PropertyCache.IsEmpty())
+			FVector Checksum = FVector::ZeroVector;
+			const double StartTime = FPlatformTime::Seconds();
+
+			for (int32 SampleIndex = 0; SampleIndex < NumSamples; ++SampleIndex)
 			{
-				PropertyCache.Emplace(XAxisValue);
-				PropertyCache.Emplace(YAxisValue);
-				PropertyCache.Emplace(ZAxisValue);
+				const float Angle = SampleIndex * 0.01f;
+				FInputActionValue Value(FVector2D(FMath::Cos(Angle), FMath::Sin(Angle)) * (0.1f + 0.9f * (SampleIndex % 10) / 9.0f));
+
+				for (UInputModifier* Modifier : Chain)
+				{
+					Value = Modifier->ModifyRaw(PlayerInput, Value, 1.0f / 60.0f);
+				}
+
+				Checksum += Value.Get<FVector>();
 			}
 
+			const double ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+
+			UE_LOG(LogBEInputModifiers, Display, TEXT("%s: %d samples through %d modifiers in %.3f ms (%.1f ns per sample, checksum %s)"),
+				*GetNameSafe(PC), NumSamples, (int32)UE_ARRAY_COUNT(Chain), ElapsedSeconds * 1000.0, ElapsedSeconds * 1000000000.0 / NumSamples, *Checksum.ToString());
+		}
+	}
+
+	static FAutoConsoleCommand CmdBenchmarkModifiers(
+		TEXT("BE.Input.BenchmarkModifiers"),
+		TEXT("Runs axis samples through the settings driven dead zone, scalar and aim inversion modifiers for every local player and logs how long they took. Usage: BE.Input.BenchmarkModifiers [NumSamples=100000]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(BenchmarkModifiers));
+}
+
+//////////////////////////////////////////////////////////////////////
+// UBESettingsDrivenInputModifier
+
+void UBESettingsDrivenInputModifier::BeginDestroy()
+{
+	UnbindSettings();
+
+	Super::BeginDestroy();
+}
+
+#if WITH_EDITOR
+void UBESettingsDrivenInputModifier::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	InvalidateSettingsCache();
+}
+#endif
+
+bool UBESettingsDrivenInputModifier::UpdateSettingsCache(const UEnhancedPlayerInput* PlayerInput)
+{
+	if ((PlayerInput != nullptr) && (CachedPlayerInput.Get() == PlayerInput) && CachedSettings.IsValid())
+	{
+		return true;
+	}
+
+	UnbindSettings();
+
+	UBELocalPlayer* LocalPlayer = BEInputModifiersHelpers::GetLocalPlayer(PlayerInput);
+	UBEGameSharedSettings* Settings = LocalPlayer ? LocalPlayer->GetSharedSettings() : nullptr;
+	if (!Settings)
+	{
+		return false;
+	}
+
+	CachedPlayerInput = PlayerInput;
+	CachedSettings = Settings;
+	SettingChangedHandle = Settings->OnSettingChanged.AddUObject(this, &ThisClass::HandleSettingChanged);
+	SettingAppliedHandle = Settings->OnSettingApplied.AddUObject(this, &ThisClass::HandleSettingChanged);
+
+	CacheSettings(*Settings);
+
+	return true;
+}
+
+void UBESettingsDrivenInputModifier::InvalidateSettingsCache()
+{
+	UnbindSettings();
+}
+
+void UBESettingsDrivenInputModifier::HandleSettingChanged(UBEGameSharedSettings* Settings)
+{
+	if (Settings && (Settings == CachedSettings.Get()))
+	{
+		CacheSettings(*Settings);
+	}
+}
+
+void UBESettingsDrivenInputModifier::UnbindSettings()
+{
+	if (UBEGameSharedSettings* Settings = CachedSettings.Get())
+	{
+		Settings->OnSettingChanged.Remove(SettingChangedHandle);
+		Settings->OnSettingApplied.Remove(SettingAppliedHandle);
+	}
+
+	SettingChangedHandle.Reset();
+	SettingAppliedHandle.Reset();
+	CachedPlayerInput.Reset();
+	CachedSettings.Reset();
+}
+
+//////////////////////////////////////////////////////////////////////
+// UBESettingBasedScalar
+
+FInputActionValue UBESettingBasedScalar::ModifyRaw_Implementation(const UEnhancedPlayerInput* PlayerInput, FInputActionValue CurrentValue, float DeltaTime)
+{
+	if (ensureMsgf(CurrentValue.GetValueType() != EInputActionValueType::Boolean, TEXT("Setting Based Scalar modifier doesn't support boolean values.")))
+	{
+		if (UpdateSettingsCache(PlayerInput))
+		{
 			FVector ScalarToUse = FVector(1.0, 1.0, 1.0);
 
 			switch (CurrentValue.GetValueType())
 			{
 			case EInputActionValueType::Axis3D:
-				ScalarToUse.Z = ZAxisValue ? *ZAxisValue->ContainerPtrToValuePtr<double>(SharedSettings) : 1.0;
+				ScalarToUse.Z = CachedScalar.Z;
 				//[[fallthrough]];
 			case EInputActionValueType::Axis2D:
-				ScalarToUse.Y = YAxisValue ? *YAxisValue->ContainerPtrToValuePtr<double>(SharedSettings) : 1.0;
+				ScalarToUse.Y = CachedScalar.Y;
 				//[[fallthrough]];
 			case EInputActionValueType::Axis1D:
-				ScalarToUse.X = XAxisValue ? *XAxisValue->ContainerPtrToValuePtr<double>(SharedSettings) : 1.0;
+				ScalarToUse.X = CachedScalar.X;
 				break;
 			}
 
@@ -92,25 +216,41 @@ FInputActionValue UBESettingBasedScalar::ModifyRaw_Implementation(const UEnhance
 	return CurrentValue;	
 }
 
+void UBESettingBasedScalar::CacheSettings(const UBEGameSharedSettings& Settings)
+{
+	auto ReadSetting = [&Settings](FName SettingName) -> double
+	{
+		if (const FNumericProperty* Property = CastField<FNumericProperty>(UBEGameSharedSettings::StaticClass()->FindPropertyByName(SettingName)))
+		{
+			if (Property->IsFloatingPoint())
+			{
+				return Property->GetFloatingPointPropertyValue(Property->ContainerPtrToValuePtr<void>(&Settings));
+			}
+		}
+
+		return 1.0;
+	};
+
+	CachedScalar.X = ReadSetting(XAxisScalarSettingName);
+	CachedScalar.Y = ReadSetting(YAxisScalarSettingName);
+	CachedScalar.Z = ReadSetting(ZAxisScalarSettingName);
+}
+
 //////////////////////////////////////////////////////////////////////
 // UBEInputModifierDeadZone
 
 FInputActionValue UBEInputModifierDeadZone::ModifyRaw_Implementation(const UEnhancedPlayerInput* PlayerInput, FInputActionValue CurrentValue, float DeltaTime)
 {
 	EInputActionValueType ValueType = CurrentValue.GetValueType();
-	UBELocalPlayer* LocalPlayer = BEInputModifiersHelpers::GetLocalPlayer(PlayerInput);
-	if (ValueType == EInputActionValueType::Boolean || !LocalPlayer)
+	if (ValueType == EInputActionValueType::Boolean || !UpdateSettingsCache(PlayerInput))
 	{
 		return CurrentValue;
 	}
-	
-	UBEGameSharedSettings* Settings = LocalPlayer->GetSharedSettings();
-	ensure(Settings);
 
 	float LowerThreshold =
 		(DeadzoneStick == EDeadzoneStick::MoveStick) ? 
-		Settings->GetGamepadMoveStickDeadZone() :
-		Settings->GetGamepadLookStickDeadZone();
+		CachedMoveStickDeadZone :
+		CachedLookStickDeadZone;
 	
 	LowerThreshold = FMath::Clamp(LowerThreshold, 0.0f, 1.0f);
 	
@@ -147,6 +287,12 @@ FInputActionValue UBEInputModifierDeadZone::ModifyRaw_Implementation(const UEnha
 	return NewValue;
 }
 
+void UBEInputModifierDeadZone::CacheSettings(const UBEGameSharedSettings& Settings)
+{
+	CachedMoveStickDeadZone = Settings.GetGamepadMoveStickDeadZone();
+	CachedLookStickDeadZone = Settings.GetGamepadLookStickDeadZone();
+}
+
 FLinearColor UBEInputModifierDeadZone::GetVisualizationColor_Implementation(FInputActionValue SampleValue, FInputActionValue FinalValue) const
 {
 	// Taken from UInputModifierDeadZone::GetVisualizationColor_Implementation
@@ -163,20 +309,19 @@ FLinearColor UBEInputModifierDeadZone::GetVisualizationColor_Implementation(FInp
 FInputActionValue UBEInputModifierGamepadSensitivity::ModifyRaw_Implementation(const UEnhancedPlayerInput* PlayerInput, FInputActionValue CurrentValue, float DeltaTime)
 {
 	// You can't scale a boolean action type
-	UBELocalPlayer* LocalPlayer = BEInputModifiersHelpers::GetLocalPlayer(PlayerInput);
-	if (CurrentValue.GetValueType() == EInputActionValueType::Boolean || !LocalPlayer || !SensitivityLevelTable)
+	if (CurrentValue.GetValueType() == EInputActionValueType::Boolean || !SensitivityLevelTable || !UpdateSettingsCache(PlayerInput))
 	{
 		return CurrentValue;
 	}
-	
-	UBEGameSharedSettings* Settings = LocalPlayer->GetSharedSettings();
-	ensure(Settings);
 
-	const EBEGamepadSensitivity Sensitivity = (TargetingType == EBETargetingType::Normal) ? Settings->GetGamepadLookSensitivityPreset() : Settings->GetGamepadTargetingSensitivityPreset();
+	return CurrentValue.Get<FVector>() * CachedScalar;
+}
 
-	const float Scalar = SensitivityLevelTable->SensitivtyEnumToFloat(Sensitivity);
+void UBEInputModifierGamepadSensitivity::CacheSettings(const UBEGameSharedSettings& Settings)
+{
+	const EBEGamepadSensitivity Sensitivity = (TargetingType == EBETargetingType::Normal) ? Settings.GetGamepadLookSensitivityPreset() : Settings.GetGamepadTargetingSensitivityPreset();
 
-	return CurrentValue.Get<FVector>() * Scalar;
+	CachedScalar = SensitivityLevelTable ? SensitivityLevelTable->SensitivtyEnumToFloat(Sensitivity) : 1.0f;
 }
 
 //////////////////////////////////////////////////////////////////////
@@ -184,26 +329,17 @@ FInputActionValue UBEInputModifierGamepadSensitivity::ModifyRaw_Implementation(c
 
 FInputActionValue UBEInputModifierAimInversion::ModifyRaw_Implementation(const UEnhancedPlayerInput* PlayerInput, FInputActionValue CurrentValue, float DeltaTime)
 {
-	UBELocalPlayer* LocalPlayer = BEInputModifiersHelpers::GetLocalPlayer(PlayerInput);
-	if (!LocalPlayer)
+	if (!UpdateSettingsCache(PlayerInput))
 	{
 		return CurrentValue;
 	}
-	
-	UBEGameSharedSettings* Settings = LocalPlayer->GetSharedSettings();
-	ensure(Settings);
 
-	FVector NewValue = CurrentValue.Get<FVector>();
-	
-	if (Settings->GetInvertVerticalAxis())
-	{
-		NewValue.Y *= -1.0f;
-	}
-	
-	if (Settings->GetInvertHorizontalAxis())
-	{
-		NewValue.X *= -1.0f;
-	}
-	
-	return NewValue;
-}
\ No newline at end of file
+	return CurrentValue.Get<FVector>() * CachedAxisScale;
+}
+
+void UBEInputModifierAimInversion::CacheSettings(const UBEGameSharedSettings& Settings)
+{
+	CachedAxisScale.X = Settings.GetInvertHorizontalAxis() ? -1.0 : 1.0;
+	CachedAxisScale.Y = Settings.GetInvertVerticalAxis() ? -1.0 : 1.0;
+	CachedAxisScale.Z = 1.0;
+}
@@ -14,20 +14,63 @@
 #include "UObject/ObjectPtr.h"
 #include "UObject/UObjectGlobals.h"
 #include "UObject/UnrealNames.h"
+#include "UObject/WeakObjectPtrTemplates.h"
 
 #include "BEInputModifiers.generated.h"
 
 class FProperty;
 class UEnhancedPlayerInput;
+class UBEGameSharedSettings;
 class UBETargetingSensitivityData;
 class UObject;
 
 
+/**
+ * Base for modifiers driven by the BE Shared game settings.
+ * The settings values are copied into the modifier when the settings of the player change, so ModifyRaw only does math.
+ */
+UCLASS(Abstract, NotBlueprintable, MinimalAPI)
+class UBESettingsDrivenInputModifier : public UInputModifier
+{
+	GENERATED_BODY()
+
+public:
+	virtual void BeginDestroy() override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+protected:
+	/**
+	 * Makes sure the cached values are the ones of the player that owns PlayerInput.
+	 * Returns false if there are no settings for it. Modifiers are shared by every player using the input action or mapping context,
+	 * so split screen players take turns refreshing the cache.
+	 */
+	bool UpdateSettingsCache(const UEnhancedPlayerInput* PlayerInput);
+
+	/** Copies the values this modifier uses out of the settings */
+	virtual void CacheSettings(const UBEGameSharedSettings& Settings) {}
+
+	/** Forces the next UpdateSettingsCache to read the settings again */
+	void InvalidateSettingsCache();
+
+private:
+	void HandleSettingChanged(UBEGameSharedSettings* Settings);
+	void UnbindSettings();
+
+	TWeakObjectPtr<const UEnhancedPlayerInput> CachedPlayerInput;
+	TWeakObjectPtr<UBEGameSharedSettings> CachedSettings;
+	FDelegateHandle SettingChangedHandle;
+	FDelegateHandle SettingAppliedHandle;
+};
+
+
+
 /** 
 *  Scales input basedon a double property in the SharedUserSettings
 */
 UCLASS(NotBlueprintable, MinimalAPI, meta = (DisplayName = "Setting Based Scalar"))
-class UBESettingBasedScalar : public UInputModifier
+class UBESettingBasedScalar : public UBESettingsDrivenInputModifier
 {
 	GENERATED_BODY()
 
@@ -55,9 +98,10 @@ public:
 
 protected:
 	virtual FInputActionValue ModifyRaw_Implementation(const UEnhancedPlayerInput* PlayerInput, FInputActionValue CurrentValue, float DeltaTime) override;
+	virtual void CacheSettings(const UBEGameSharedSettings& Settings) override;
 
-	/** FProperty Cache that will be populated with any found FProperty's on the settings class so that we don't need to look them up each frame */
-	TArray<const FProperty*> PropertyCache;
+	/** Values of the named settings (1 when a name doesn't match a numeric setting), before clamping */
+	FVector CachedScalar = FVector::OneVector;
 };
 
 /** Represents which stick that this deadzone is for, either the move or the look stick */
@@ -75,7 +119,7 @@ enum class EDeadzoneStick : uint8
  * This is a deadzone input modifier that will have it's thresholds driven by what is in the BE Shared game settings. 
  */
 UCLASS(NotBlueprintable, MinimalAPI, meta = (DisplayName = "BE Settings Driven Dead Zone"))
-class UBEInputModifierDeadZone : public UInputModifier
+class UBEInputModifierDeadZone : public UBESettingsDrivenInputModifier
 {
 	GENERATED_BODY()
 
@@ -94,6 +138,10 @@ public:
 
 protected:
 	virtual FInputActionValue ModifyRaw_Implementation(const UEnhancedPlayerInput* PlayerInput, FInputActionValue CurrentValue, float DeltaTime) override;
+	virtual void CacheSettings(const UBEGameSharedSettings& Settings) override;
+
+	float CachedMoveStickDeadZone = 0.0f;
+	float CachedLookStickDeadZone = 0.0f;
 
 	// Visualize as black when unmodified. Red when blocked (with differing intensities to indicate axes)
 	// Mirrors visualization in https://www.gamasutra.com/blogs/JoshSutphin/20130416/190541/Doing_Thumbstick_Dead_Zones_Right.php.
@@ -113,7 +161,7 @@ enum class EBETargetingType : uint8
 
 /** Applies a scalar modifier based on the current gamepad settings in BE Shared game settings.  */
 UCLASS(NotBlueprintable, MinimalAPI, meta = (DisplayName = "BE Gamepad Sensitivity"))
-class UBEInputModifierGamepadSensitivity : public UInputModifier
+class UBEInputModifierGamepadSensitivity : public UBESettingsDrivenInputModifier
 {
 	GENERATED_BODY()
 public:
@@ -128,14 +176,21 @@ public:
 
 protected:
 	virtual FInputActionValue ModifyRaw_Implementation(const UEnhancedPlayerInput* PlayerInput, FInputActionValue CurrentValue, float DeltaTime) override;
+	virtual void CacheSettings(const UBEGameSharedSettings& Settings) override;
+
+	float CachedScalar = 1.0f;
 };
 
 /** Applies an inversion of axis values based on a setting in the BE Shared game settings */
 UCLASS(NotBlueprintable, MinimalAPI, meta = (DisplayName = "BE Aim Inversion Setting"))
-class UBEInputModifierAimInversion : public UInputModifier
+class UBEInputModifierAimInversion : public UBESettingsDrivenInputModifier
 {
 	GENERATED_BODY()
 	
 protected:
 	virtual FInputActionValue ModifyRaw_Implementation(const UEnhancedPlayerInput* PlayerInput, FInputActionValue CurrentValue, float DeltaTime) override;	
+	virtual void CacheSettings(const UBEGameSharedSettings& Settings) override;
+
+	// -1 for inverted axes, 1 otherwise
+	FVector CachedAxisScale = FVector::OneVector;
 };
\ No newline at end of file
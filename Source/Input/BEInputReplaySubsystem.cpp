@@ -0,0 +1,517 @@
+// Copyright Eigi Chin
+
+#include "BEInputReplaySubsystem.h"
+
+#include "Character/Component/BEPawnPlayableComponent.h"
+#include "BELogChannels.h"
+
+#include "Engine/LocalPlayer.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(BEInputReplaySubsystem)
+
+
+namespace BE::InputReplay
+{
+	static const uint32 FileMagic = 0x52494542; // 'BEIR'
+	static const uint32 FileVersion = 1;
+
+	static bool bUseFixedTimeStep = true;
+	static FAutoConsoleVariableRef CVarUseFixedTimeStep(TEXT("BE.InputReplay.FixedTimeStep"), bUseFixedTimeStep, TEXT("Should input replay playback run the engine with a fixed time step using the recorded delta times?"), ECVF_Default);
+
+	static UBEInputReplaySubsystem* FindReplaySubsystem(UWorld* World)
+	{
+		for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+		{
+			if (UBEInputReplaySubsystem* ReplaySubsystem = UBEInputReplaySubsystem::Get(It->Get()))
+			{
+				return ReplaySubsystem;
+			}
+		}
+
+		UE_LOG(LogBE, Warning, TEXT("BE.InputReplay: No local player found"));
+		return nullptr;
+	}
+
+	static void Record(const TArray<FString>& Args, UWorld* World)
+	{
+		if (UBEInputReplaySubsystem* ReplaySubsystem = FindReplaySubsystem(World))
+		{
+			ReplaySubsystem->StartRecording();
+		}
+	}
+
+	static void Stop(const TArray<FString>& Args, UWorld* World)
+	{
+		if (UBEInputReplaySubsystem* ReplaySubsystem = FindReplaySubsystem(World))
+		{
+			if (ReplaySubsystem->IsRecording())
+			{
+				const FString Name = (Args.Num() > 0) ? Args[0] : FString::Printf(TEXT("InputReplay_%s"), *FDateTime::Now().ToString());
+				ReplaySubsystem->StopRecording(UBEInputReplaySubsystem::GetReplayFilename(Name));
+			}
+			else
+			{
+				ReplaySubsystem->StopPlayback();
+			}
+		}
+	}
+
+	static void Play(const TArray<FString>& Args, UWorld* World)
+	{
+		if (Args.Num() < 1)
+		{
+			UE_LOG(LogBE, Warning, TEXT("BE.InputReplay.Play: Usage: BE.InputReplay.Play <File>"));
+			return;
+		}
+
+		if (UBEInputReplaySubsystem* ReplaySubsystem = FindReplaySubsystem(World))
+		{
+			ReplaySubsystem->StartPlayback(UBEInputReplaySubsystem::GetReplayFilename(Args[0]));
+		}
+	}
+
+	static FAutoConsoleCommand CmdRecord(
+		TEXT("BE.InputReplay.Record"),
+		TEXT("Starts recording the input of the first local player."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(Record));
+
+	static FAutoConsoleCommand CmdStop(
+		TEXT("BE.InputReplay.Stop"),
+		TEXT("Stops recording and saves the replay, or stops the playback. Usage: BE.InputReplay.Stop [File]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(Stop));
+
+	static FAutoConsoleCommand CmdPlay(
+		TEXT("BE.InputReplay.Play"),
+		TEXT("Plays back a recorded input replay on the first local player. Usage: BE.InputReplay.Play <File>"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(Play));
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// FBEReplayedInput
+
+FBEReplayedInput FBEReplayedInput::MakeAxis(EBEReplayedInputType InType, const FVector2D& InValue)
+{
+	FBEReplayedInput Input;
+	Input.Type = InType;
+	Input.Value = FVector2f(InValue);
+	return Input;
+}
+
+FBEReplayedInput FBEReplayedInput::MakeTag(EBEReplayedInputType InType, const FGameplayTag& InTag)
+{
+	FBEReplayedInput Input;
+	Input.Type = InType;
+	Input.InputTag = InTag;
+	return Input;
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// FBEInputReplayData
+
+bool FBEInputReplayData::SaveToFile(const FString& Filename) const
+{
+	// Tags are written once in a table and referenced by index
+
+	TArray<FGameplayTag> TagTable;
+	for (const FBEReplayedInput& Input : Inputs)
+	{
+		if (!Input.IsAxis())
+		{
+			TagTable.AddUnique(Input.InputTag);
+		}
+	}
+
+	TArray<uint8> Bytes;
+	FMemoryWriter Ar(Bytes);
+
+	uint32 Magic = BE::InputReplay::FileMagic;
+	uint32 Version = BE::InputReplay::FileVersion;
+	Ar << Magic;
+	Ar << Version;
+
+	int32 NumTags = TagTable.Num();
+	Ar << NumTags;
+	for (const FGameplayTag& Tag : TagTable)
+	{
+		FString TagName = Tag.ToString();
+		Ar << TagName;
+	}
+
+	int32 NumFrames = Frames.Num();
+	Ar << NumFrames;
+	for (const FFrame& Frame : Frames)
+	{
+		float DeltaTime = Frame.DeltaTime;
+		uint32 NumInputs = Frame.NumInputs;
+		Ar << DeltaTime;
+		Ar.SerializeIntPacked(NumInputs);
+
+		for (int32 InputIndex = Frame.FirstInput; InputIndex < Frame.FirstInput + Frame.NumInputs; ++InputIndex)
+		{
+			const FBEReplayedInput& Input = Inputs[InputIndex];
+
+			uint8 Type = (uint8)Input.Type;
+			Ar << Type;
+
+			if (Input.IsAxis())
+			{
+				FVector2f Value = Input.Value;
+				Ar << Value.X;
+				Ar << Value.Y;
+			}
+			else
+			{
+				uint32 TagIndex = (uint32)TagTable.IndexOfByKey(Input.InputTag);
+				Ar.SerializeIntPacked(TagIndex);
+			}
+		}
+	}
+
+	return FFileHelper::SaveArrayToFile(Bytes, *Filename);
+}
+
+bool FBEInputReplayData::LoadFromFile(const FString& Filename)
+{
+	Reset();
+
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *Filename))
+	{
+		UE_LOG(LogBE, Warning, TEXT("InputReplay: Failed to read [%s]"), *Filename);
+		return false;
+	}
+
+	FMemoryReader Ar(Bytes);
+
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	Ar << Magic;
+	Ar << Version;
+
+	if ((Magic != BE::InputReplay::FileMagic) || (Version != BE::InputReplay::FileVersion))
+	{
+		UE_LOG(LogBE, Warning, TEXT("InputReplay: [%s] is not an input replay of version %u"), *Filename, BE::InputReplay::FileVersion);
+		return false;
+	}
+
+	int32 NumTags = 0;
+	Ar << NumTags;
+
+	TArray<FGameplayTag> TagTable;
+	for (int32 TagIndex = 0; (TagIndex < NumTags) && !Ar.IsError(); ++TagIndex)
+	{
+		FString TagName;
+		Ar << TagName;
+
+		// Unknown tags are kept as empty tags so the frames still line up
+		TagTable.Add(FGameplayTag::RequestGameplayTag(FName(*TagName), /*ErrorIfNotFound=*/ false));
+	}
+
+	int32 NumFrames = 0;
+	Ar << NumFrames;
+
+	for (int32 FrameIndex = 0; (FrameIndex < NumFrames) && !Ar.IsError(); ++FrameIndex)
+	{
+		FFrame& Frame = Frames.AddDefaulted_GetRef();
+		Frame.FirstInput = Inputs.Num();
+
+		uint32 NumInputs = 0;
+		Ar << Frame.DeltaTime;
+		Ar.SerializeIntPacked(NumInputs);
+
+		for (uint32 InputIndex = 0; (InputIndex < NumInputs) && !Ar.IsError(); ++InputIndex)
+		{
+			FBEReplayedInput& Input = Inputs.AddDefaulted_GetRef();
+
+			uint8 Type = 0;
+			Ar << Type;
+			Input.Type = (EBEReplayedInputType)FMath::Min<uint8>(Type, (uint8)EBEReplayedInputType::Count);
+
+			if (Input.IsAxis())
+			{
+				Ar << Input.Value.X;
+				Ar << Input.Value.Y;
+			}
+			else
+			{
+				uint32 TagIndex = 0;
+				Ar.SerializeIntPacked(TagIndex);
+				Input.InputTag = TagTable.IsValidIndex((int32)TagIndex) ? TagTable[(int32)TagIndex] : FGameplayTag();
+			}
+		}
+
+		Frame.NumInputs = Inputs.Num() - Frame.FirstInput;
+	}
+
+	if (Ar.IsError())
+	{
+		UE_LOG(LogBE, Warning, TEXT("InputReplay: [%s] is truncated or corrupt"), *Filename);
+		Reset();
+		return false;
+	}
+
+	return true;
+}
+
+void FBEInputReplayData::Reset()
+{
+	Frames.Reset();
+	Inputs.Reset();
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// UBEInputReplaySubsystem
+
+void UBEInputReplaySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// Headless playback, e.g. -BEInputReplay=<File> -BEInputReplayExit
+
+	const TCHAR* CommandLine = FCommandLine::Get();
+
+	FString ReplayName;
+	if (FParse::Value(CommandLine, TEXT("BEInputReplay="), ReplayName))
+	{
+		bExitWhenPlaybackFinishes = FParse::Param(CommandLine, TEXT("BEInputReplayExit"));
+		StartPlayback(GetReplayFilename(ReplayName));
+	}
+}
+
+void UBEInputReplaySubsystem::Deinitialize()
+{
+	StopPlayback();
+
+	bRecording = false;
+	Data.Reset();
+
+	Super::Deinitialize();
+}
+
+UBEInputReplaySubsystem* UBEInputReplaySubsystem::Get(const APlayerController* PlayerController)
+{
+	return PlayerController ? ULocalPlayer::GetSubsystem<UBEInputReplaySubsystem>(PlayerController->GetLocalPlayer()) : nullptr;
+}
+
+void UBEInputReplaySubsystem::StartRecording()
+{
+	StopPlayback();
+
+	Data.Reset();
+	RecordingFrameFirstInput = 0;
+	bWaitingForPawn = true;
+	bRecording = true;
+
+	UE_LOG(LogBE, Log, TEXT("InputReplay: Recording started"));
+}
+
+bool UBEInputReplaySubsystem::StopRecording(const FString& Filename)
+{
+	if (!bRecording)
+	{
+		return false;
+	}
+
+	bRecording = false;
+
+	const bool bSaved = Data.SaveToFile(Filename);
+
+	UE_LOG(LogBE, Log, TEXT("InputReplay: Recorded %d frames (%d inputs) %s [%s]"),
+		Data.Frames.Num(), Data.Inputs.Num(), bSaved ? TEXT("to") : TEXT("but failed to save"), *Filename);
+
+	Data.Reset();
+	return bSaved;
+}
+
+bool UBEInputReplaySubsystem::StartPlayback(const FString& Filename)
+{
+	bRecording = false;
+	StopPlayback();
+
+	if (!Data.LoadFromFile(Filename))
+	{
+		return false;
+	}
+
+	PlaybackFrame = 0;
+	bWaitingForPawn = true;
+	bPlayingBack = true;
+
+	UE_LOG(LogBE, Log, TEXT("InputReplay: Playing back %d frames from [%s]"), Data.Frames.Num(), *Filename);
+	return true;
+}
+
+void UBEInputReplaySubsystem::StopPlayback()
+{
+	if (!bPlayingBack)
+	{
+		return;
+	}
+
+	bPlayingBack = false;
+
+	if (!bWaitingForPawn && BE::InputReplay::bUseFixedTimeStep)
+	{
+		FApp::SetUseFixedTimeStep(bSavedUseFixedTimeStep);
+		FApp::SetFixedDeltaTime(SavedFixedDeltaTime);
+	}
+
+	Data.Reset();
+}
+
+FString UBEInputReplaySubsystem::GetReplayFilename(const FString& Name)
+{
+	if (!FPaths::IsRelative(Name))
+	{
+		return Name;
+	}
+
+	const FString Filename = FPaths::ProjectSavedDir() / TEXT("InputReplays") / Name;
+	return FPaths::GetExtension(Filename).IsEmpty() ? Filename + TEXT(".beinput") : Filename;
+}
+
+bool UBEInputReplaySubsystem::HandleLiveInput(const FBEReplayedInput& Input)
+{
+	if (bPlayingBack)
+	{
+		return false;
+	}
+
+	if (bRecording && !bWaitingForPawn)
+	{
+		Data.Inputs.Add(Input);
+	}
+
+	return true;
+}
+
+void UBEInputReplaySubsystem::PreProcessInput(APlayerController* PlayerController, float DeltaTime)
+{
+	if (!bPlayingBack)
+	{
+		return;
+	}
+
+	if (bWaitingForPawn)
+	{
+		if (!IsPawnReady(PlayerController))
+		{
+			return;
+		}
+
+		bWaitingForPawn = false;
+
+		bSavedUseFixedTimeStep = FApp::UseFixedTimeStep();
+		SavedFixedDeltaTime = FApp::GetFixedDeltaTime();
+
+		PlaybackStartTime = FPlatformTime::Seconds();
+		LastPlaybackFrameTime = PlaybackStartTime;
+		WorstPlaybackFrameTime = 0.0;
+	}
+	else
+	{
+		const double Now = FPlatformTime::Seconds();
+		WorstPlaybackFrameTime = FMath::Max(WorstPlaybackFrameTime, Now - LastPlaybackFrameTime);
+		LastPlaybackFrameTime = Now;
+	}
+
+	if (!Data.Frames.IsValidIndex(PlaybackFrame))
+	{
+		FinishPlayback();
+		return;
+	}
+
+	const FBEInputReplayData::FFrame& Frame = Data.Frames[PlaybackFrame];
+
+	if (const APawn* Pawn = PlayerController->GetPawn())
+	{
+		if (UBEPawnPlayableComponent* PlayableComponent = UBEPawnPlayableComponent::FindCharacterPlayableComponent(Pawn))
+		{
+			for (int32 InputIndex = Frame.FirstInput; InputIndex < Frame.FirstInput + Frame.NumInputs; ++InputIndex)
+			{
+				PlayableComponent->InjectReplayedInput(Data.Inputs[InputIndex]);
+			}
+		}
+	}
+
+	++PlaybackFrame;
+
+	// The delta time set now is used by the next frame, which plays back the next recorded frame
+
+	if (BE::InputReplay::bUseFixedTimeStep && Data.Frames.IsValidIndex(PlaybackFrame))
+	{
+		FApp::SetUseFixedTimeStep(true);
+		FApp::SetFixedDeltaTime(Data.Frames[PlaybackFrame].DeltaTime);
+	}
+}
+
+void UBEInputReplaySubsystem::PostProcessInput(APlayerController* PlayerController, float DeltaTime)
+{
+	if (!bRecording)
+	{
+		return;
+	}
+
+	if (bWaitingForPawn)
+	{
+		if (!IsPawnReady(PlayerController))
+		{
+			// Input handled before the pawn was ready is not part of the replay
+			Data.Inputs.Reset();
+			return;
+		}
+
+		bWaitingForPawn = false;
+	}
+
+	FBEInputReplayData::FFrame& Frame = Data.Frames.AddDefaulted_GetRef();
+	Frame.DeltaTime = DeltaTime;
+	Frame.FirstInput = RecordingFrameFirstInput;
+	Frame.NumInputs = Data.Inputs.Num() - RecordingFrameFirstInput;
+
+	RecordingFrameFirstInput = Data.Inputs.Num();
+}
+
+void UBEInputReplaySubsystem::FinishPlayback()
+{
+	const int32 NumFrames = PlaybackFrame;
+	const double TotalTime = FPlatformTime::Seconds() - PlaybackStartTime;
+
+	// Keep this format stable, benchmark scripts parse it
+	UE_LOG(LogBE, Display, TEXT("InputReplay Finished Frames=%d TotalSec=%.3f AvgFrameMs=%.3f WorstFrameMs=%.3f"),
+		NumFrames,
+		TotalTime,
+		(NumFrames > 0) ? (TotalTime * 1000.0 / NumFrames) : 0.0,
+		WorstPlaybackFrameTime * 1000.0);
+
+	StopPlayback();
+
+	if (bExitWhenPlaybackFinishes)
+	{
+		FPlatformMisc::RequestExitWithStatus(false, 0);
+	}
+}
+
+bool UBEInputReplaySubsystem::IsPawnReady(const APlayerController* PlayerController)
+{
+	const APawn* Pawn = PlayerController ? PlayerController->GetPawn() : nullptr;
+	const UBEPawnPlayableComponent* PlayableComponent = UBEPawnPlayableComponent::FindCharacterPlayableComponent(Pawn);
+
+	return PlayableComponent && PlayableComponent->IsReadyToBindInputs();
+}
@@ -0,0 +1,153 @@
+// Copyright Eigi Chin
+
+#pragma once
+
+#include "Subsystems/LocalPlayerSubsystem.h"
+
+#include "Containers/Array.h"
+#include "Containers/UnrealString.h"
+#include "GameplayTagContainer.h"
+#include "Math/Vector2D.h"
+
+#include "BEInputReplaySubsystem.generated.h"
+
+class APlayerController;
+
+
+/**
+ * EBEReplayedInputType
+ *
+ *	Player input handled by UBEPawnPlayableComponent that can be recorded and played back
+ */
+enum class EBEReplayedInputType : uint8
+{
+	Move,
+	LookMouse,
+	LookStick,
+	AbilityPressed,
+	AbilityReleased,
+
+	Count
+};
+
+
+/**
+ * FBEReplayedInput
+ *
+ *	One input action value or ability input tag event
+ */
+struct FBEReplayedInput
+{
+public:
+	static FBEReplayedInput MakeAxis(EBEReplayedInputType InType, const FVector2D& InValue);
+	static FBEReplayedInput MakeTag(EBEReplayedInputType InType, const FGameplayTag& InTag);
+
+	bool IsAxis() const { return Type < EBEReplayedInputType::AbilityPressed; }
+
+public:
+	EBEReplayedInputType Type = EBEReplayedInputType::Move;
+
+	// Action value of axis inputs
+	FVector2f Value = FVector2f::ZeroVector;
+
+	// Input tag of ability inputs
+	FGameplayTag InputTag;
+};
+
+
+/**
+ * FBEInputReplayData
+ *
+ *	Recorded input of one local player, frame by frame.
+ *	Saved as a small binary file: a tag name table followed by the delta time and the inputs of every frame.
+ */
+struct FBEInputReplayData
+{
+public:
+	struct FFrame
+	{
+		float DeltaTime = 0.0f;
+		int32 FirstInput = 0;
+		int32 NumInputs = 0;
+	};
+
+	TArray<FFrame> Frames;
+	TArray<FBEReplayedInput> Inputs;
+
+public:
+	bool SaveToFile(const FString& Filename) const;
+	bool LoadFromFile(const FString& Filename);
+
+	void Reset();
+};
+
+
+/**
+ * UBEInputReplaySubsystem
+ *
+ *	Records the input a local player's pawn handles and plays it back in place of live input,
+ *	so the same session can be re-run as a repeatable benchmark (e.g. on a headless client with -BEInputReplay=<File>).
+ *	During playback the engine runs with a fixed time step using the recorded delta times.
+ */
+UCLASS()
+class BECORE_API UBEInputReplaySubsystem : public ULocalPlayerSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~USubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
+	static UBEInputReplaySubsystem* Get(const APlayerController* PlayerController);
+
+public:
+	void StartRecording();
+	bool StopRecording(const FString& Filename);
+	bool IsRecording() const { return bRecording; }
+
+	bool StartPlayback(const FString& Filename);
+	void StopPlayback();
+	bool IsPlayingBack() const { return bPlayingBack; }
+
+	// Resolves a replay name to a file in the saved directory, full paths are kept as is
+	static FString GetReplayFilename(const FString& Name);
+
+public:
+	// Called by UBEPawnPlayableComponent for live input, returns false if the input should be dropped
+	bool HandleLiveInput(const FBEReplayedInput& Input);
+
+	// Called by ABEPlayerController before the input of a frame is processed, feeds the inputs recorded for the frame
+	void PreProcessInput(APlayerController* PlayerController, float DeltaTime);
+
+	// Called by ABEPlayerController after the input of a frame is processed, closes the recorded frame
+	void PostProcessInput(APlayerController* PlayerController, float DeltaTime);
+
+private:
+	void FinishPlayback();
+
+	static bool IsPawnReady(const APlayerController* PlayerController);
+
+	FBEInputReplayData Data;
+
+	bool bRecording = false;
+	bool bPlayingBack = false;
+	bool bExitWhenPlaybackFinishes = false;
+
+	// Frames are only recorded and played back once the pawn can handle input, so loading does not shift the replay
+	bool bWaitingForPawn = false;
+
+	// Index of the first input of the frame being recorded
+	int32 RecordingFrameFirstInput = 0;
+
+	int32 PlaybackFrame = 0;
+
+	bool bSavedUseFixedTimeStep = false;
+	double SavedFixedDeltaTime = 0.0;
+
+	// Wall clock frame times of the playback
+	double PlaybackStartTime = 0.0;
+	double LastPlaybackFrameTime = 0.0;
+	double WorstPlaybackFrameTime = 0.0;
+};
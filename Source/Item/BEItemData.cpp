@@ -3,13 +3,43 @@
 #include "Item/BEItemData.h"
 
 #include "UObject/Class.h"
+#include "UObject/ObjectSaveContext.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(BEItemData)
 
 
 #define LOCTEXT_NAMESPACE "BEItem"
 
+void UBEItemData::PostLoad()
+{
+	Super::PostLoad();
+
+	// クック済みのアセットは保存時に作成した対応表をそのまま使う
+#if WITH_EDITOR
+	RebuildFragmentTable();
+#else
+	if (FragmentTable.IsEmpty() && !Fragments.IsEmpty())
+	{
+		RebuildFragmentTable();
+	}
+#endif
+}
+
+void UBEItemData::PreSave(FObjectPreSaveContext ObjectSaveContext)
+{
+	RebuildFragmentTable();
+
+	Super::PreSave(ObjectSaveContext);
+}
+
 #if WITH_EDITOR
+void UBEItemData::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	RebuildFragmentTable();
+}
+
 EDataValidationResult UBEItemData::IsDataValid(TArray<FText>& ValidationErrors)
 {
 	EDataValidationResult Result = CombineDataValidationResults(Super::IsDataValid(ValidationErrors), EDataValidationResult::Valid);
@@ -21,6 +51,22 @@ EDataValidationResult UBEItemData::IsDataValid(TArray<FText>& ValidationErrors)
 		{
 			EDataValidationResult ChildResult = Fragment->IsDataValid(ValidationErrors);
 			Result = CombineDataValidationResults(Result, ChildResult);
+
+			// 同じクラス、または親子関係にあるクラスの Fragment が複数あると FindFragmentByClass の結果が曖昧になる
+			for (int32 OtherIndex = 0; OtherIndex < EntryIndex; ++OtherIndex)
+			{
+				const UBEItemDataFragment* OtherFragment = Fragments[OtherIndex];
+				if (OtherFragment && (Fragment->IsA(OtherFragment->GetClass()) || OtherFragment->IsA(Fragment->GetClass())))
+				{
+					Result = EDataValidationResult::Invalid;
+					ValidationErrors.Add(FText::Format(LOCTEXT("FragmentIsAmbiguous", "Fragment {0} at index {1} overlaps with fragment {2} at index {3}, only one fragment of a type is supported."),
+						FText::AsCultureInvariant(GetNameSafe(Fragment->GetClass())),
+						FText::AsNumber(EntryIndex),
+						FText::AsCultureInvariant(GetNameSafe(OtherFragment->GetClass())),
+						FText::AsNumber(OtherIndex)
+					));
+				}
+			}
 		}
 		else
 		{
@@ -78,15 +124,46 @@ void UBEItemData::UpdateAssetBundleData()
 }
 #endif
 
+void UBEItemData::RebuildFragmentTable()
+{
+	FragmentTable.Reset();
+
+	for (UBEItemDataFragment* Fragment : Fragments)
+	{
+		if (!Fragment)
+		{
+			continue;
+		}
+
+		// 親クラスでも検索できるように UBEItemDataFragment までのすべてのクラスを登録する
+		for (UClass* Class = Fragment->GetClass(); Class && Class->IsChildOf(UBEItemDataFragment::StaticClass()); Class = Class->GetSuperClass())
+		{
+			if (!FragmentTable.Contains(Class))
+			{
+				FragmentTable.Add(Class, Fragment);
+			}
+		}
+	}
+}
+
 const UBEItemDataFragment* UBEItemData::FindFragmentByClass(TSubclassOf<UBEItemDataFragment> FragmentClass) const
 {
 	if (FragmentClass != nullptr)
 	{
-		for (UBEItemDataFragment* Fragment : Fragments)
+		if (const TObjectPtr<UBEItemDataFragment>* Fragment = FragmentTable.Find(FragmentClass))
+		{
+			return *Fragment;
+		}
+
+		// NewObject や DuplicateObject で実行時に作成したものは PostLoad を経由せず対応表が空なので、Fragments を直接検索する
+		if (FragmentTable.IsEmpty())
 		{
-			if (Fragment && Fragment->IsA(FragmentClass))
+			for (UBEItemDataFragment* Fragment : Fragments)
 			{
-				return Fragment;
+				if (Fragment && Fragment->IsA(FragmentClass))
+				{
+					return Fragment;
+				}
 			}
 		}
 	}
@@ -5,6 +5,7 @@
 #include "Engine/DataAsset.h"
 
 #include "Containers/Array.h"
+#include "Containers/Map.h"
 #include "Internationalization/Text.h"
 #include "Templates/SubclassOf.h"
 #include "UObject/ObjectPtr.h"
@@ -43,10 +44,15 @@ class UBEItemData : public UPrimaryDataAsset
 
 public:
 	UBEItemData() {}
-	
-#if WITH_EDITOR //~UObject interface
+
+	//~UObject interface
+	virtual void PostLoad() override;
+	virtual void PreSave(FObjectPreSaveContext ObjectSaveContext) override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
 	virtual EDataValidationResult IsDataValid(TArray<FText>& ValidationErrors) override;
-#endif //~End of UObject interface
+#endif
+	//~End of UObject interface
 	
 #if WITH_EDITORONLY_DATA //~UPrimaryDataAsset interface
 	virtual void UpdateAssetBundleData() override;
@@ -61,12 +67,29 @@ public:
 	UPROPERTY(EditDefaultsOnly, Category= "Inventory", Instanced)
 	TArray<TObjectPtr<UBEItemDataFragment>> Fragments;
 
+private:
+	// Fragment のクラスとその親クラスから Fragment への対応表
+	// Fragments から PostLoad と保存時に作成され、クック時にアセットに含まれる
+	// 空の場合 FindFragmentByClass は Fragments を線形に検索する
+	UPROPERTY()
+	TMap<TSubclassOf<UBEItemDataFragment>, TObjectPtr<UBEItemDataFragment>> FragmentTable;
+
+	void RebuildFragmentTable();
+
 public:
+	// 指定したクラスの Fragment を返す。同じクラスの Fragment が複数ある場合は Fragments の先頭に近いものを返す
 	const UBEItemDataFragment* FindFragmentByClass(TSubclassOf<UBEItemDataFragment> FragmentClass) const;
 
 	template <typename ResultClass>
 	const ResultClass* FindFragmentByClass() const
 	{
-		return (ResultClass*)FindFragmentByClass(ResultClass::StaticClass());
+		static_assert(TIsDerivedFrom<ResultClass, UBEItemDataFragment>::Value, "ResultClass must derive from UBEItemDataFragment");
+		return static_cast<const ResultClass*>(FindFragmentByClass(ResultClass::StaticClass()));
+	}
+
+	template <typename ResultClass>
+	bool HasFragmentByClass() const
+	{
+		return FindFragmentByClass<ResultClass>() != nullptr;
 	}
 };
@@ -14,10 +14,14 @@
 #include "Engine/EngineTypes.h"
 #include "GameFramework/Character.h"
 #include "GameFramework/Pawn.h"
+#include "HAL/IConsoleManager.h"
 #include "Math/Transform.h"
 #include "Misc/AssertionMacros.h"
 #include "Net/UnrealNetwork.h"
+#include "Serialization/BitWriter.h"
 #include "Templates/Casts.h"
+#include "UObject/CoreNet.h"
+#include "UObject/UObjectIterator.h"
 
 #if UE_WITH_IRIS
 #include "Iris/ReplicationSystem/ReplicationFragmentUtil.h"
@@ -29,6 +33,96 @@ class FLifetimeProperty;
 class UClass;
 
 
+namespace BEEquipmentInstanceCommands
+{
+	static int64 MeasureStatTagBits(const FGameplayTagStackContainer& StatTags, UPackageMap* PackageMap)
+	{
+		FNetBitWriter Writer(PackageMap, 8192);
+		StatTags.SerializeAllStacksForMeasurement(Writer, PackageMap);
+		return Writer.GetNumBits();
+	}
+
+	static void DumpStatTagReplication(UWorld* World)
+	{
+		if (World == nullptr)
+		{
+			return;
+		}
+
+		UPackageMap* PackageMap = NewObject<UPackageMap>();
+
+		int32 NumInstances = 0;
+		int32 NumReplicatedStacks = 0;
+		int32 NumCopiedStacks = 0;
+		int32 NumSharedStacks = 0;
+		int64 ReplicatedBits = 0;
+		int64 CopiedBits = 0;
+		int64 SharedBits = 0;
+
+		for (TObjectIterator<UBEEquipmentInstance> It; It; ++It)
+		{
+			const UBEEquipmentInstance* Instance = *It;
+			if ((Instance->GetWorld() != World) || Instance->HasAnyFlags(RF_ClassDefaultObject))
+			{
+				continue;
+			}
+
+			++NumInstances;
+
+			const FGameplayTagStackContainer& ReplicatedStatTags = Instance->GetReplicatedStatTags();
+			NumReplicatedStacks += ReplicatedStatTags.GetNumStacks();
+			ReplicatedBits += MeasureStatTagBits(ReplicatedStatTags, PackageMap);
+
+			const TMap<FGameplayTag, int32>* InitialStats = nullptr;
+			if (const UBEItemData* ItemData = Instance->GetItemData())
+			{
+				if (const UBEItemDataFragment_Equippable* Fragment = ItemData->FindFragmentByClass<UBEItemDataFragment_Equippable>())
+				{
+					InitialStats = &Fragment->InitialEquipmentStats;
+				}
+			}
+
+			TArray<FGameplayTag> Tags;
+			ReplicatedStatTags.GetTags(Tags);
+			if (InitialStats)
+			{
+				for (const auto& KVP : *InitialStats)
+				{
+					Tags.AddUnique(KVP.Key);
+				}
+			}
+
+			// Rebuild the same stats with both settings of bShareInitialEquipmentStats
+			FGameplayTagStackContainer CopiedStatTags;
+			FGameplayTagStackContainer SharedStatTags;
+			for (const FGameplayTag& Tag : Tags)
+			{
+				const int32 Count = Instance->GetStatTagStackCount(Tag);
+				const int32 InitialCount = InitialStats ? FMath::Max(InitialStats->FindRef(Tag), 0) : 0;
+
+				CopiedStatTags.SetStackCount(Tag, Count);
+				SharedStatTags.SetStackCount(Tag, Count - InitialCount);
+			}
+
+			NumCopiedStacks += CopiedStatTags.GetNumStacks();
+			NumSharedStacks += SharedStatTags.GetNumStacks();
+			CopiedBits += MeasureStatTagBits(CopiedStatTags, PackageMap);
+			SharedBits += MeasureStatTagBits(SharedStatTags, PackageMap);
+		}
+
+		UE_LOG(LogBEEquipmentSystem, Display, TEXT("Stat tags of %d equipment instances, as sent to a new connection:"), NumInstances);
+		UE_LOG(LogBEEquipmentSystem, Display, TEXT("  Current settings              : %5d stacks %8lld bytes"), NumReplicatedStacks, FMath::DivideAndRoundUp<int64>(ReplicatedBits, 8));
+		UE_LOG(LogBEEquipmentSystem, Display, TEXT("  Initial stats copied (false)  : %5d stacks %8lld bytes"), NumCopiedStacks, FMath::DivideAndRoundUp<int64>(CopiedBits, 8));
+		UE_LOG(LogBEEquipmentSystem, Display, TEXT("  Initial stats shared (true)   : %5d stacks %8lld bytes"), NumSharedStacks, FMath::DivideAndRoundUp<int64>(SharedBits, 8));
+	}
+
+	static FAutoConsoleCommandWithWorld CmdDumpStatTagReplication(
+		TEXT("BE.Equipment.DumpStatTagReplication"),
+		TEXT("Serializes the stat tags of the equipment instances in the world with both settings of bShareInitialEquipmentStats and logs the bytes sent to a new connection. Run it on the server after players join."),
+		FConsoleCommandWithWorldDelegate::CreateStatic(DumpStatTagReplication));
+}
+
+
 UBEEquipmentInstance::UBEEquipmentInstance(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
@@ -90,24 +184,70 @@ void UBEEquipmentInstance::OnRep_ItemData()
 
 void UBEEquipmentInstance::AddStatTagStack(FGameplayTag Tag, int32 StackCount)
 {
-	StatTags.AddStack(Tag, StackCount);
+	if (const TMap<FGameplayTag, int32>* InitialStats = GetSharedInitialStats())
+	{
+		if (StackCount > 0)
+		{
+			const int32 NewCount = GetStatTagStackCount(Tag) + StackCount;
+			StatTags.SetStackCount(Tag, NewCount - FMath::Max(InitialStats->FindRef(Tag), 0));
+		}
+	}
+	else
+	{
+		StatTags.AddStack(Tag, StackCount);
+	}
 }
 
 void UBEEquipmentInstance::RemoveStatTagStack(FGameplayTag Tag, int32 StackCount)
 {
-	StatTags.RemoveStack(Tag, StackCount);
+	if (const TMap<FGameplayTag, int32>* InitialStats = GetSharedInitialStats())
+	{
+		if (StackCount > 0)
+		{
+			const int32 NewCount = FMath::Max(GetStatTagStackCount(Tag) - StackCount, 0);
+			StatTags.SetStackCount(Tag, NewCount - FMath::Max(InitialStats->FindRef(Tag), 0));
+		}
+	}
+	else
+	{
+		StatTags.RemoveStack(Tag, StackCount);
+	}
 }
 
 int32 UBEEquipmentInstance::GetStatTagStackCount(FGameplayTag Tag) const
 {
+	if (const TMap<FGameplayTag, int32>* InitialStats = GetSharedInitialStats())
+	{
+		return FMath::Max(FMath::Max(InitialStats->FindRef(Tag), 0) + StatTags.GetStackCount(Tag), 0);
+	}
+
 	return StatTags.GetStackCount(Tag);
 }
 
 bool UBEEquipmentInstance::HasStatTag(FGameplayTag Tag) const
 {
+	if (GetSharedInitialStats())
+	{
+		return GetStatTagStackCount(Tag) > 0;
+	}
+
 	return StatTags.ContainsTag(Tag);
 }
 
+const TMap<FGameplayTag, int32>* UBEEquipmentInstance::GetSharedInitialStats() const
+{
+	// ItemData が同期されるまでは差分のみを返す
+	if (const UBEItemDataFragment_Equippable* Fragment = ItemData ? ItemData->FindFragmentByClass<UBEItemDataFragment_Equippable>() : nullptr)
+	{
+		if (Fragment->bShareInitialEquipmentStats)
+		{
+			return &Fragment->InitialEquipmentStats;
+		}
+	}
+
+	return nullptr;
+}
+
 
 void UBEEquipmentInstance::SpawnEquipmentMeshes(const TArray<FBEEquipmentMeshToSpawn>& InMeshesToSpawn)
 {
@@ -13,6 +13,7 @@
 #include "BEEquipmentInstance.generated.h"
 
 class UBEItemData;
+class UBEItemDataFragment_Equippable;
 class UAnimInstance;
 class USkeletalMesh;
 class USkeletalMeshComponent;
@@ -78,7 +79,7 @@ public:
 	 * OnEquiped
 	 *
 	 * この Equipment が EquipmentManagerComponent によって作成されたときに呼び出される。
-	 * この Equipment と ItemData の関連付けと StatTag の初期化を行う
+	 * この Equipment と ItemData の関連付けを行う。サーバーとクライアントの双方で呼び出される
 	 */
 	virtual void OnEquiped(const UBEItemData* InItemData);
 
@@ -138,7 +139,23 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Equipment")
 	bool HasStatTag(FGameplayTag Tag) const;
 
+	/**
+	 * GetReplicatedStatTags
+	 *
+	 * 同期されている StatTags を返す (初期値を共有している場合は初期値からの差分)
+	 */
+	const FGameplayTagStackContainer& GetReplicatedStatTags() const { return StatTags; }
+
+protected:
+	/**
+	 * GetSharedInitialStats
+	 *
+	 * ItemData の InitialEquipmentStats を共有している場合はそれを返す (共有していない場合は nullptr を返す)
+	 */
+	const TMap<FGameplayTag, int32>* GetSharedInitialStats() const;
+
 private:
+	// ItemData の InitialEquipmentStats を共有している場合は初期値からの差分を保持する (負の値もとりうる)
 	UPROPERTY(Replicated)
 	FGameplayTagStackContainer StatTags;
 
@@ -54,6 +54,11 @@ public:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Item")
 	TMap<FGameplayTag, int32> InitialEquipmentStats;
 
+	// InitialEquipmentStats を Equipment ごとにコピーせず、サーバーとクライアントの双方でこの ItemData から参照する
+	// Equipment には初期値からの差分のみが保持・同期される
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Item")
+	bool bShareInitialEquipmentStats = false;
+
 	// Equipment が Active になったときにスポーンする
 	// 装備品の見た目となる SkeletalMesh の定義
 	// 設定しない場合は何もスポーンしない。
@@ -0,0 +1,217 @@
+// Copyright Eigi Chin
+
+#include "BEInputLatencyStats.h"
+
+#include "BELogChannels.h"
+
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(BEInputLatencyStats)
+
+CSV_DEFINE_CATEGORY(BEInputLatency, true);
+
+
+namespace BE::InputLatency
+{
+	bool bLogSamples = false;
+	static FAutoConsoleVariableRef CVarLogSamples(TEXT("BE.InputLatency.LogSamples"), bLogSamples, TEXT("Should every input latency sample be logged with its input id and frame?"), ECVF_Default);
+
+	// Lower bounds of the histogram buckets (in ms)
+	static const float HistogramBucketMinTimesMs[FBEInputLatencyStats::NumHistogramBuckets] = { 0.0f, 8.0f, 16.7f, 33.3f, 50.0f, 100.0f, 200.0f, 500.0f };
+
+	static uint32 NextInputId = 1;
+
+	static void DumpStats(const TArray<FString>& Args)
+	{
+		const FBEInputLatencyStats& Stats = FBEInputLatencyStats::Get();
+
+		for (int32 StageIndex = 0; StageIndex < (int32)EBEInputLatencyStage::Count; ++StageIndex)
+		{
+			const EBEInputLatencyStage Stage = (EBEInputLatencyStage)StageIndex;
+
+			TArray<uint32> BucketCounts;
+			Stats.GetHistogram(Stage, BucketCounts);
+
+			FString HistogramString;
+			for (int32 BucketIndex = 0; BucketIndex < BucketCounts.Num(); ++BucketIndex)
+			{
+				HistogramString += FString::Printf(TEXT(" %.1fms=%u"), FBEInputLatencyStats::GetHistogramBucketMinTime(BucketIndex) * 1000.0, BucketCounts[BucketIndex]);
+			}
+
+			// Keep this format stable, latency regression tests parse it
+			UE_LOG(LogBE, Display, TEXT("InputLatency Stage=%s Samples=%llu AvgMs=%.2f P50Ms=%.2f P95Ms=%.2f MaxMs=%.2f Histogram:%s"),
+				FBEInputLatencyStats::GetStageName(Stage),
+				Stats.GetNumSamples(Stage),
+				Stats.GetRecentAverage(Stage) * 1000.0,
+				Stats.GetRecentPercentile(Stage, 0.5f) * 1000.0,
+				Stats.GetRecentPercentile(Stage, 0.95f) * 1000.0,
+				Stats.GetMaxLatency(Stage) * 1000.0,
+				*HistogramString);
+		}
+	}
+
+	static FAutoConsoleCommand CmdDumpStats(
+		TEXT("BE.InputLatency.Dump"),
+		TEXT("Logs the input latency stats of each stage (input to activate, activate to server confirm) in a stable format for regression tests."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(DumpStats));
+
+	static FAutoConsoleCommand CmdResetStats(
+		TEXT("BE.InputLatency.Reset"),
+		TEXT("Clears the collected input latency stats."),
+		FConsoleCommandDelegate::CreateLambda([]() { FBEInputLatencyStats::Get().Reset(); }));
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// FBEInputLatencyStamp
+
+FBEInputLatencyStamp FBEInputLatencyStamp::Make()
+{
+	FBEInputLatencyStamp Stamp;
+	Stamp.InputId = BE::InputLatency::NextInputId++;
+	Stamp.Frame = GFrameCounter;
+	Stamp.Time = FPlatformTime::Seconds();
+
+	// 0 is reserved for invalid stamps
+	if (BE::InputLatency::NextInputId == 0)
+	{
+		BE::InputLatency::NextInputId = 1;
+	}
+
+	return Stamp;
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// FBEInputLatencyStats
+
+FBEInputLatencyStats& FBEInputLatencyStats::Get()
+{
+	static FBEInputLatencyStats Instance;
+	return Instance;
+}
+
+void FBEInputLatencyStats::AddSample(EBEInputLatencyStage Stage, const FBEInputLatencyStamp& Stamp, double Latency)
+{
+	check(Stage < EBEInputLatencyStage::Count);
+
+	FStageData& Data = Stages[(int32)Stage];
+
+	int32 BucketIndex = NumHistogramBuckets - 1;
+	while ((BucketIndex > 0) && ((Latency * 1000.0) < BE::InputLatency::HistogramBucketMinTimesMs[BucketIndex]))
+	{
+		--BucketIndex;
+	}
+
+	Data.HistogramCounts[BucketIndex]++;
+	Data.NumSamples++;
+	Data.MaxLatency = FMath::Max(Data.MaxLatency, Latency);
+
+	if (Data.RecentSamples.Num() < NumRecentSamples)
+	{
+		Data.RecentSamples.Add(static_cast<float>(Latency));
+	}
+	else
+	{
+		Data.RecentSamples[Data.NextRecentSample] = static_cast<float>(Latency);
+	}
+	Data.NextRecentSample = (Data.NextRecentSample + 1) % NumRecentSamples;
+
+	switch (Stage)
+	{
+	case EBEInputLatencyStage::InputToActivate:
+		CSV_CUSTOM_STAT(BEInputLatency, InputToActivateMs, static_cast<float>(Latency * 1000.0), ECsvCustomStatOp::Max);
+		break;
+	case EBEInputLatencyStage::ActivateToServerConfirm:
+		CSV_CUSTOM_STAT(BEInputLatency, ActivateToServerConfirmMs, static_cast<float>(Latency * 1000.0), ECsvCustomStatOp::Max);
+		break;
+	default:
+		break;
+	}
+
+	if (BE::InputLatency::bLogSamples)
+	{
+		UE_LOG(LogBE, Log, TEXT("InputLatency Input=%u Frame=%llu (+%llu) Stage=%s Ms=%.2f"),
+			Stamp.InputId, Stamp.Frame, GFrameCounter - Stamp.Frame, GetStageName(Stage), Latency * 1000.0);
+	}
+}
+
+double FBEInputLatencyStats::GetRecentAverage(EBEInputLatencyStage Stage) const
+{
+	const FStageData& Data = Stages[(int32)Stage];
+
+	if (Data.RecentSamples.IsEmpty())
+	{
+		return 0.0;
+	}
+
+	double Total = 0.0;
+	for (const float Sample : Data.RecentSamples)
+	{
+		Total += Sample;
+	}
+
+	return Total / Data.RecentSamples.Num();
+}
+
+double FBEInputLatencyStats::GetRecentPercentile(EBEInputLatencyStage Stage, float Percentile) const
+{
+	const FStageData& Data = Stages[(int32)Stage];
+
+	if (Data.RecentSamples.IsEmpty())
+	{
+		return 0.0;
+	}
+
+	TArray<float, TInlineAllocator<NumRecentSamples>> SortedSamples(Data.RecentSamples);
+	SortedSamples.Sort();
+
+	const int32 Index = FMath::Clamp(FMath::CeilToInt(Percentile * SortedSamples.Num()) - 1, 0, SortedSamples.Num() - 1);
+	return SortedSamples[Index];
+}
+
+double FBEInputLatencyStats::GetMaxLatency(EBEInputLatencyStage Stage) const
+{
+	return Stages[(int32)Stage].MaxLatency;
+}
+
+uint64 FBEInputLatencyStats::GetNumSamples(EBEInputLatencyStage Stage) const
+{
+	return Stages[(int32)Stage].NumSamples;
+}
+
+void FBEInputLatencyStats::GetHistogram(EBEInputLatencyStage Stage, TArray<uint32>& OutBucketCounts) const
+{
+	OutBucketCounts.Reset(NumHistogramBuckets);
+	OutBucketCounts.Append(Stages[(int32)Stage].HistogramCounts, NumHistogramBuckets);
+}
+
+double FBEInputLatencyStats::GetHistogramBucketMinTime(int32 BucketIndex)
+{
+	return BE::InputLatency::HistogramBucketMinTimesMs[BucketIndex] * 0.001;
+}
+
+const TCHAR* FBEInputLatencyStats::GetStageName(EBEInputLatencyStage Stage)
+{
+	switch (Stage)
+	{
+	case EBEInputLatencyStage::InputToActivate:
+		return TEXT("InputToActivate");
+	case EBEInputLatencyStage::ActivateToServerConfirm:
+		return TEXT("ActivateToServerConfirm");
+	default:
+		break;
+	}
+
+	return TEXT("Unknown");
+}
+
+void FBEInputLatencyStats::Reset()
+{
+	for (FStageData& Data : Stages)
+	{
+		Data = FStageData();
+	}
+}
@@ -0,0 +1,103 @@
+// Copyright Eigi Chin
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "BEInputLatencyStats.generated.h"
+
+
+/**
+ * EBEInputLatencyStage
+ *
+ *	Measured parts of the path from an ability input press to its activation being confirmed by the server
+ */
+UENUM(BlueprintType)
+enum class EBEInputLatencyStage : uint8
+{
+	// From the input action firing the ability input tag to the ability activating locally
+	InputToActivate,
+
+	// From the local (predicted) activation to the server catching up with its prediction key
+	ActivateToServerConfirm,
+
+	Count UMETA(Hidden)
+};
+
+
+/**
+ * FBEInputLatencyStamp
+ *
+ *	Identifies one ability input press and when it happened, carried from the input binding to the activation.
+ */
+struct FBEInputLatencyStamp
+{
+public:
+	// Stamps a press happening now
+	static FBEInputLatencyStamp Make();
+
+	bool IsValid() const { return InputId != 0; }
+
+public:
+	uint32 InputId = 0;
+
+	// GFrameCounter of the frame the input was processed in
+	uint64 Frame = 0;
+
+	// FPlatformTime::Seconds() when the input was processed
+	double Time = 0.0;
+};
+
+
+/**
+ * FBEInputLatencyStats
+ *
+ *	Collects input latency samples of the local players in this process for display and regression tests.
+ *	Only used on the game thread.
+ */
+class BECORE_API FBEInputLatencyStats
+{
+public:
+	static constexpr int32 NumHistogramBuckets = 8;
+	static constexpr int32 NumRecentSamples = 128;
+
+	static FBEInputLatencyStats& Get();
+
+	void AddSample(EBEInputLatencyStage Stage, const FBEInputLatencyStamp& Stamp, double Latency);
+
+	// Average of the recent samples (in seconds), 0 when there are none
+	double GetRecentAverage(EBEInputLatencyStage Stage) const;
+
+	// Percentile (0 - 1) of the recent samples (in seconds), 0 when there are none
+	double GetRecentPercentile(EBEInputLatencyStage Stage, float Percentile) const;
+
+	// Worst sample since the last reset (in seconds)
+	double GetMaxLatency(EBEInputLatencyStage Stage) const;
+
+	// Number of samples since the last reset
+	uint64 GetNumSamples(EBEInputLatencyStage Stage) const;
+
+	// Number of samples in each histogram bucket since the last reset
+	void GetHistogram(EBEInputLatencyStage Stage, TArray<uint32>& OutBucketCounts) const;
+
+	// Shortest latency that falls in a histogram bucket (in seconds)
+	static double GetHistogramBucketMinTime(int32 BucketIndex);
+
+	static const TCHAR* GetStageName(EBEInputLatencyStage Stage);
+
+	void Reset();
+
+private:
+	struct FStageData
+	{
+		uint32 HistogramCounts[NumHistogramBuckets] = {};
+		uint64 NumSamples = 0;
+		double MaxLatency = 0.0;
+
+		// Ring buffer of the latest samples (in seconds)
+		TArray<float> RecentSamples;
+		int32 NextRecentSample = 0;
+	};
+
+	FStageData Stages[(int32)EBEInputLatencyStage::Count];
+};
@@ -31,6 +31,7 @@ void FBEPerformanceStatCache::ProcessFrame(const FFrameData& FrameData)
 {
 	CachedData = FrameData;
 	CachedServerFPS = 0.0f;
+	CachedServerFrameStats = FBEServerFrameStats();
 	CachedPingMS = 0.0f;
 	CachedPacketLossIncomingPercent = 0.0f;
 	CachedPacketLossOutgoingPercent = 0.0f;
@@ -39,11 +40,16 @@ void FBEPerformanceStatCache::ProcessFrame(const FFrameData& FrameData)
 	CachedPacketSizeIncoming = 0.0f;
 	CachedPacketSizeOutgoing = 0.0f;
 
+	const FBEInputLatencyStats& InputLatencyStats = FBEInputLatencyStats::Get();
+	CachedInputToActivate = InputLatencyStats.GetRecentAverage(EBEInputLatencyStage::InputToActivate);
+	CachedActivateToServerConfirm = InputLatencyStats.GetRecentAverage(EBEInputLatencyStage::ActivateToServerConfirm);
+
 	if (UWorld* World = MySubsystem->GetGameInstance()->GetWorld())
 	{
 		if (const ABEGameState* GameState = World->GetGameState<ABEGameState>())
 		{
 			CachedServerFPS = GameState->GetServerFPS();
+			CachedServerFrameStats = GameState->GetServerFrameStats();
 		}
 
 		if (APlayerController* LocalPC = GEngine->GetFirstLocalPlayerController(World))
@@ -76,7 +82,7 @@ void FBEPerformanceStatCache::StopCharting()
 
 double FBEPerformanceStatCache::GetCachedStat(EBEDisplayablePerformanceStat Stat) const
 {
-	static_assert((int32)EBEDisplayablePerformanceStat::Count == 15, "Need to update this function to deal with new performance stats");
+	static_assert((int32)EBEDisplayablePerformanceStat::Count == 20, "Need to update this function to deal with new performance stats");
 	switch (Stat)
 	{
 	case EBEDisplayablePerformanceStat::ClientFPS:
@@ -109,6 +115,16 @@ double FBEPerformanceStatCache::GetCachedStat(EBEDisplayablePerformanceStat Stat
 		return CachedPacketSizeIncoming;
 	case EBEDisplayablePerformanceStat::PacketSize_Outgoing:
 		return CachedPacketSizeOutgoing;
+	case EBEDisplayablePerformanceStat::ServerFrameTime:
+		return CachedServerFrameStats.GetAverageFrameTime();
+	case EBEDisplayablePerformanceStat::ServerFrameTime_Worst:
+		return CachedServerFrameStats.GetWorstFrameTime();
+	case EBEDisplayablePerformanceStat::ServerTickBudgetUsage:
+		return CachedServerFrameStats.GetTickBudgetUsage();
+	case EBEDisplayablePerformanceStat::InputToActivate:
+		return CachedInputToActivate;
+	case EBEDisplayablePerformanceStat::ActivateToServerConfirm:
+		return CachedActivateToServerConfirm;
 	}
 
 	return 0.0f;
@@ -133,3 +149,37 @@ double UBEPerformanceStatSubsystem::GetCachedStat(EBEDisplayablePerformanceStat
 {
 	return Tracker->GetCachedStat(Stat);
 }
+
+void UBEPerformanceStatSubsystem::GetServerFrameTimeHistogram(TArray<float>& OutBucketFractions, TArray<float>& OutBucketMinTimes) const
+{
+	const FBEServerFrameStats& ServerFrameStats = Tracker->GetCachedServerFrameStats();
+
+	OutBucketFractions.Reset(FBEServerFrameStats::NumHistogramBuckets);
+	OutBucketMinTimes.Reset(FBEServerFrameStats::NumHistogramBuckets);
+
+	for (int32 BucketIndex = 0; BucketIndex < FBEServerFrameStats::NumHistogramBuckets; ++BucketIndex)
+	{
+		OutBucketFractions.Add(ServerFrameStats.GetHistogramBucketFraction(BucketIndex));
+		OutBucketMinTimes.Add(static_cast<float>(FBEServerFrameStats::GetHistogramBucketMinTime(BucketIndex)));
+	}
+}
+
+void UBEPerformanceStatSubsystem::GetInputLatencyHistogram(EBEInputLatencyStage Stage, TArray<int32>& OutBucketCounts, TArray<float>& OutBucketMinTimes) const
+{
+	OutBucketCounts.Reset(FBEInputLatencyStats::NumHistogramBuckets);
+	OutBucketMinTimes.Reset(FBEInputLatencyStats::NumHistogramBuckets);
+
+	if (Stage >= EBEInputLatencyStage::Count)
+	{
+		return;
+	}
+
+	TArray<uint32> BucketCounts;
+	FBEInputLatencyStats::Get().GetHistogram(Stage, BucketCounts);
+
+	for (int32 BucketIndex = 0; BucketIndex < BucketCounts.Num(); ++BucketIndex)
+	{
+		OutBucketCounts.Add(static_cast<int32>(FMath::Min<uint32>(BucketCounts[BucketIndex], MAX_int32)));
+		OutBucketMinTimes.Add(static_cast<float>(FBEInputLatencyStats::GetHistogramBucketMinTime(BucketIndex)));
+	}
+}
@@ -5,6 +5,8 @@
 
 #include "ChartCreation.h"
 #include "BEPerformanceStatTypes.h"
+#include "BEServerFrameStats.h"
+#include "BEInputLatencyStats.h"
 #include "Subsystems/GameInstanceSubsystem.h"
 #include "Templates/SharedPointer.h"
 #include "UObject/UObjectGlobals.h"
@@ -36,11 +38,14 @@ public:
 
 	double GetCachedStat(EBEDisplayablePerformanceStat Stat) const;
 
+	const FBEServerFrameStats& GetCachedServerFrameStats() const { return CachedServerFrameStats; }
+
 protected:
 	IPerformanceDataConsumer::FFrameData CachedData;
 	UBEPerformanceStatSubsystem* MySubsystem;
 
 	float CachedServerFPS = 0.0f;
+	FBEServerFrameStats CachedServerFrameStats;
 	float CachedPingMS = 0.0f;
 	float CachedPacketLossIncomingPercent = 0.0f;
 	float CachedPacketLossOutgoingPercent = 0.0f;
@@ -48,6 +53,8 @@ protected:
 	float CachedPacketRateOutgoing = 0.0f;
 	float CachedPacketSizeIncoming = 0.0f;
 	float CachedPacketSizeOutgoing = 0.0f;
+	double CachedInputToActivate = 0.0;
+	double CachedActivateToServerConfirm = 0.0;
 };
 
 //////////////////////////////////////////////////////////////////////
@@ -62,6 +69,14 @@ public:
 	UFUNCTION(BlueprintCallable)
 	double GetCachedStat(EBEDisplayablePerformanceStat Stat) const;
 
+	// Returns the share of server frames (0 - 1) and the shortest frame time (in seconds) of each server frame time histogram bucket
+	UFUNCTION(BlueprintCallable)
+	void GetServerFrameTimeHistogram(TArray<float>& OutBucketFractions, TArray<float>& OutBucketMinTimes) const;
+
+	// Returns the number of samples and the shortest latency (in seconds) of each input latency histogram bucket of a stage
+	UFUNCTION(BlueprintCallable)
+	void GetInputLatencyHistogram(EBEInputLatencyStage Stage, TArray<int32>& OutBucketCounts, TArray<float>& OutBucketMinTimes) const;
+
 	//~USubsystem interface
 	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
 	virtual void Deinitialize() override;
@@ -78,6 +78,21 @@ enum class EBEDisplayablePerformanceStat : uint8
 	// The avg. size (in bytes) of packets sent
 	PacketSize_Outgoing,
 
+	// server frame time averaged over the last few seconds, without idle time (in seconds)
+	ServerFrameTime,
+
+	// worst server frame time in the last few seconds (in seconds)
+	ServerFrameTime_Worst,
+
+	// share of the server tick interval used by the average frame (%)
+	ServerTickBudgetUsage,
+
+	// time from an ability input press to the ability activating, averaged over recent presses (in seconds)
+	InputToActivate,
+
+	// time from a predicted ability activation to the server confirming it, averaged over recent activations (in seconds)
+	ActivateToServerConfirm,
+
 	// New stats should go above here
 	Count UMETA(Hidden)
 };
@@ -0,0 +1,129 @@
+// Copyright Eigi Chin
+
+#include "BEServerFrameStats.h"
+
+#include "HAL/IConsoleManager.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(BEServerFrameStats)
+
+
+namespace BE::ServerFrameStats
+{
+	float UpdateInterval = 1.0f;
+	static FAutoConsoleVariableRef CVarUpdateInterval(TEXT("BE.ServerFrameStats.UpdateInterval"), UpdateInterval, TEXT("How often (in seconds) the server frame time stats are replicated to clients."), ECVF_Default);
+
+	float WindowSeconds = 5.0f;
+	static FAutoConsoleVariableRef CVarWindowSeconds(TEXT("BE.ServerFrameStats.WindowSeconds"), WindowSeconds, TEXT("Length (in seconds) of the window the server frame time stats cover."), ECVF_Default);
+
+	// Lower bounds of the histogram buckets (in ms)
+	static const float HistogramBucketMinTimesMs[FBEServerFrameStats::NumHistogramBuckets] = { 0.0f, 4.0f, 8.0f, 16.7f, 33.3f, 50.0f, 100.0f, 250.0f };
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// FBEServerFrameStats
+
+double FBEServerFrameStats::GetHistogramBucketMinTime(int32 BucketIndex)
+{
+	return BE::ServerFrameStats::HistogramBucketMinTimesMs[BucketIndex] * 0.001;
+}
+
+int32 FBEServerFrameStats::GetHistogramBucket(double FrameTime)
+{
+	const double FrameTimeMs = FrameTime * 1000.0;
+
+	int32 BucketIndex = NumHistogramBuckets - 1;
+	while ((BucketIndex > 0) && (FrameTimeMs < BE::ServerFrameStats::HistogramBucketMinTimesMs[BucketIndex]))
+	{
+		--BucketIndex;
+	}
+
+	return BucketIndex;
+}
+
+uint16 FBEServerFrameStats::QuantizeTime(double Seconds)
+{
+	return static_cast<uint16>(FMath::Clamp(FMath::RoundToInt(Seconds * 10000.0), 0, (int32)MAX_uint16));
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// FBEServerFrameStatsTracker
+
+float FBEServerFrameStatsTracker::GetUpdateInterval()
+{
+	return FMath::Max(BE::ServerFrameStats::UpdateInterval, 0.1f);
+}
+
+void FBEServerFrameStatsTracker::AddFrame(double DeltaTime, double FrameTime)
+{
+	CurrentInterval.TotalFrameTime += FrameTime;
+	CurrentInterval.TotalDeltaTime += DeltaTime;
+	CurrentInterval.WorstFrameTime = FMath::Max(CurrentInterval.WorstFrameTime, FrameTime);
+	CurrentInterval.NumFrames++;
+	CurrentInterval.HistogramCounts[FBEServerFrameStats::GetHistogramBucket(FrameTime)]++;
+}
+
+void FBEServerFrameStatsTracker::Flush(double TargetFrameTime, FBEServerFrameStats& OutStats)
+{
+	// Close the current interval
+
+	const int32 NumIntervalsInWindow = FMath::Clamp(FMath::CeilToInt(BE::ServerFrameStats::WindowSeconds / GetUpdateInterval()), 1, 120);
+	if (Intervals.Num() != NumIntervalsInWindow)
+	{
+		Intervals.SetNum(NumIntervalsInWindow);
+		NextIntervalIndex = 0;
+	}
+
+	Intervals[NextIntervalIndex] = CurrentInterval;
+	NextIntervalIndex = (NextIntervalIndex + 1) % Intervals.Num();
+	CurrentInterval = FInterval();
+
+	// Summarize the window
+
+	FInterval Window;
+	for (const FInterval& Interval : Intervals)
+	{
+		Window.TotalFrameTime += Interval.TotalFrameTime;
+		Window.TotalDeltaTime += Interval.TotalDeltaTime;
+		Window.WorstFrameTime = FMath::Max(Window.WorstFrameTime, Interval.WorstFrameTime);
+		Window.NumFrames += Interval.NumFrames;
+
+		for (int32 BucketIndex = 0; BucketIndex < FBEServerFrameStats::NumHistogramBuckets; ++BucketIndex)
+		{
+			Window.HistogramCounts[BucketIndex] += Interval.HistogramCounts[BucketIndex];
+		}
+	}
+
+	OutStats = FBEServerFrameStats();
+
+	if (Window.NumFrames == 0)
+	{
+		return;
+	}
+
+	const double AverageFrameTime = Window.TotalFrameTime / Window.NumFrames;
+	const double AverageDeltaTime = Window.TotalDeltaTime / Window.NumFrames;
+	const double BudgetFrameTime = (TargetFrameTime > 0.0) ? TargetFrameTime : AverageDeltaTime;
+
+	OutStats.AverageFrameTime = FBEServerFrameStats::QuantizeTime(AverageFrameTime);
+	OutStats.WorstFrameTime = FBEServerFrameStats::QuantizeTime(Window.WorstFrameTime);
+	OutStats.AverageDeltaTime = FBEServerFrameStats::QuantizeTime(AverageDeltaTime);
+	OutStats.TickBudgetUsage = (BudgetFrameTime > 0.0) ? static_cast<uint8>(FMath::Clamp(FMath::RoundToInt(100.0 * AverageFrameTime / BudgetFrameTime), 0, 255)) : 0;
+
+	for (int32 BucketIndex = 0; BucketIndex < FBEServerFrameStats::NumHistogramBuckets; ++BucketIndex)
+	{
+		const uint32 Count = Window.HistogramCounts[BucketIndex];
+
+		// Keep a single hitch visible instead of rounding it away
+		const int32 QuantizedShare = FMath::RoundToInt(255.0 * Count / Window.NumFrames);
+		OutStats.Histogram[BucketIndex] = static_cast<uint8>(FMath::Clamp((Count > 0) ? FMath::Max(QuantizedShare, 1) : 0, 0, 255));
+	}
+}
+
+void FBEServerFrameStatsTracker::Reset()
+{
+	CurrentInterval = FInterval();
+	Intervals.Reset();
+	NextIntervalIndex = 0;
+}
@@ -0,0 +1,104 @@
+// Copyright Eigi Chin
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "BEServerFrameStats.generated.h"
+
+
+/**
+ * FBEServerFrameStats
+ *
+ *	Server frame times over the last few seconds, quantized for replication.
+ *	Frame times are the time the server spent working in a frame, without the idle time waiting for the tick rate.
+ */
+USTRUCT(BlueprintType)
+struct FBEServerFrameStats
+{
+	GENERATED_BODY()
+
+public:
+	static constexpr int32 NumHistogramBuckets = 8;
+
+	// Average frame time (in seconds)
+	double GetAverageFrameTime() const { return DequantizeTime(AverageFrameTime); }
+
+	// Worst frame time (in seconds)
+	double GetWorstFrameTime() const { return DequantizeTime(WorstFrameTime); }
+
+	// Average time between frames, including idle time (in seconds)
+	double GetAverageDeltaTime() const { return DequantizeTime(AverageDeltaTime); }
+
+	// Average frame time relative to the server tick interval (in %)
+	float GetTickBudgetUsage() const { return TickBudgetUsage; }
+
+	// Share of the frames that fell in a histogram bucket (0 - 1)
+	float GetHistogramBucketFraction(int32 BucketIndex) const { return Histogram[BucketIndex] / 255.0f; }
+
+	// Shortest frame time that falls in a histogram bucket (in seconds)
+	static double GetHistogramBucketMinTime(int32 BucketIndex);
+
+	// Histogram bucket a frame time falls in
+	static int32 GetHistogramBucket(double FrameTime);
+
+	static uint16 QuantizeTime(double Seconds);
+	static double DequantizeTime(uint16 QuantizedTime) { return QuantizedTime * 0.0001; }
+
+public:
+	// In units of 0.1 ms
+
+	UPROPERTY()
+	uint16 AverageFrameTime = 0;
+
+	UPROPERTY()
+	uint16 WorstFrameTime = 0;
+
+	UPROPERTY()
+	uint16 AverageDeltaTime = 0;
+
+	// In %, saturates at 255
+	UPROPERTY()
+	uint8 TickBudgetUsage = 0;
+
+	// Share of the frames in each bucket, 255 is all of them
+	UPROPERTY()
+	uint8 Histogram[NumHistogramBuckets] = {};
+};
+
+
+/**
+ * FBEServerFrameStatsTracker
+ *
+ *	Collects frame times on the server and summarizes them into FBEServerFrameStats at a fixed interval.
+ */
+class FBEServerFrameStatsTracker
+{
+public:
+	// How often Flush should be called (in seconds)
+	static float GetUpdateInterval();
+
+	void AddFrame(double DeltaTime, double FrameTime);
+
+	// Closes the current interval and writes the stats of the window to OutStats.
+	// TargetFrameTime is the server tick interval, 0 to measure the budget against the average delta time.
+	void Flush(double TargetFrameTime, FBEServerFrameStats& OutStats);
+
+	void Reset();
+
+private:
+	struct FInterval
+	{
+		double TotalFrameTime = 0.0;
+		double TotalDeltaTime = 0.0;
+		double WorstFrameTime = 0.0;
+		int32 NumFrames = 0;
+		uint32 HistogramCounts[FBEServerFrameStats::NumHistogramBuckets] = {};
+	};
+
+	FInterval CurrentInterval;
+
+	// Ring buffer of the closed intervals in the window
+	TArray<FInterval> Intervals;
+	int32 NextIntervalIndex = 0;
+};
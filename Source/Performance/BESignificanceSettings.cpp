@@ -0,0 +1,46 @@
+// Copyright Eigi Chin
+
+#include "BESignificanceSettings.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(BESignificanceSettings)
+
+
+UBESignificanceSettings::UBESignificanceSettings()
+{
+	CategoryName = TEXT("Game");
+
+	FBESignificanceBucket& High = Buckets.AddDefaulted_GetRef();
+	High.Name = TEXT("High");
+	High.MinSignificance = 0.6f;
+	High.DebugColor = FColor::Green;
+
+	FBESignificanceBucket& Medium = Buckets.AddDefaulted_GetRef();
+	Medium.Name = TEXT("Medium");
+	Medium.MinSignificance = 0.3f;
+	Medium.AnimationTickInterval = 1.0f / 30.0f;
+	Medium.bEnableUpdateRateOptimizations = true;
+	Medium.SimulatedMovementTickInterval = 1.0f / 30.0f;
+	Medium.DebugColor = FColor::Yellow;
+
+	FBESignificanceBucket& Low = Buckets.AddDefaulted_GetRef();
+	Low.Name = TEXT("Low");
+	Low.MinSignificance = 0.1f;
+	Low.AnimationTickInterval = 1.0f / 15.0f;
+	Low.bEnableUpdateRateOptimizations = true;
+	Low.VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered;
+	Low.SimulatedMovementTickInterval = 1.0f / 15.0f;
+	Low.bCullContextEffects = true;
+	Low.bTickEquipmentMeshes = false;
+	Low.DebugColor = FColor::Orange;
+
+	FBESignificanceBucket& Minimal = Buckets.AddDefaulted_GetRef();
+	Minimal.Name = TEXT("Minimal");
+	Minimal.MinSignificance = 0.0f;
+	Minimal.AnimationTickInterval = 0.25f;
+	Minimal.bEnableUpdateRateOptimizations = true;
+	Minimal.VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickMontagesWhenNotRendered;
+	Minimal.SimulatedMovementTickInterval = 0.1f;
+	Minimal.bCullContextEffects = true;
+	Minimal.bTickEquipmentMeshes = false;
+	Minimal.DebugColor = FColor::Red;
+}
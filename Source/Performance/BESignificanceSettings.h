@@ -0,0 +1,115 @@
+// Copyright Eigi Chin
+
+#pragma once
+
+#include "Engine/DeveloperSettingsBackedByCVars.h"
+
+#include "Components/SkinnedMeshComponent.h"
+#include "Containers/Array.h"
+#include "GameplayTagContainer.h"
+#include "Math/Color.h"
+#include "UObject/NameTypes.h"
+
+#include "BESignificanceSettings.generated.h"
+
+
+/**
+ * FBESignificanceBucket
+ *
+ *	Update rates applied to every character whose significance falls into the bucket.
+ *	Each value can only lower the rates authored on the character, the default values keep them as authored.
+ */
+USTRUCT()
+struct FBESignificanceBucket
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, Category = "Significance")
+	FName Name;
+
+	// Lowest significance [0, 1] that falls into this bucket
+	UPROPERTY(EditAnywhere, Category = "Significance", meta = (ClampMin = 0.0, ClampMax = 1.0))
+	float MinSignificance = 0.0f;
+
+	// Tick interval of the character meshes, the authored interval is kept if it is longer
+	UPROPERTY(EditAnywhere, Category = "Animation", meta = (ForceUnits = s, ClampMin = 0.0))
+	float AnimationTickInterval = 0.0f;
+
+	// Lets the engine skip animation frames (URO) on top of the tick interval, meshes authored with URO keep it
+	UPROPERTY(EditAnywhere, Category = "Animation")
+	bool bEnableUpdateRateOptimizations = false;
+
+	// AlwaysTickPoseAndRefreshBones keeps the authored option
+	UPROPERTY(EditAnywhere, Category = "Animation")
+	EVisibilityBasedAnimTickOption VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+
+	// Tick interval of the movement component on simulated proxies, the authored interval is kept if it is longer
+	UPROPERTY(EditAnywhere, Category = "Movement", meta = (ForceUnits = s, ClampMin = 0.0))
+	float SimulatedMovementTickInterval = 0.0f;
+
+	// Skips context effects (footsteps, etc.) triggered by anim notifies
+	UPROPERTY(EditAnywhere, Category = "Effects")
+	bool bCullContextEffects = false;
+
+	// Whether the equipment meshes attached to the character keep ticking, meshes authored without tick never tick
+	UPROPERTY(EditAnywhere, Category = "Equipment")
+	bool bTickEquipmentMeshes = true;
+
+	UPROPERTY(EditAnywhere, Category = "Debug")
+	FColor DebugColor = FColor::Green;
+};
+
+
+/**
+ * UBESignificanceSettings
+ *
+ *	Settings for the character significance scoring of UBESignificanceSubsystem
+ */
+UCLASS(config = Game, defaultconfig, meta = (DisplayName = "BE Significance"))
+class UBESignificanceSettings : public UDeveloperSettingsBackedByCVars
+{
+	GENERATED_BODY()
+
+public:
+	UBESignificanceSettings();
+
+public:
+	UPROPERTY(config, EditAnywhere, Category = Significance, meta = (ConsoleVariable = "BE.Significance.Enable"))
+	bool bEnableSignificance = true;
+
+	// How often the significance of every character is evaluated
+	UPROPERTY(config, EditAnywhere, Category = Significance, meta = (ForceUnits = s, ClampMin = 0.0, ConsoleVariable = "BE.Significance.UpdateInterval"))
+	float UpdateInterval = 0.25f;
+
+	// Distance at which the distance part of the significance reaches 0
+	UPROPERTY(config, EditAnywhere, Category = Scoring, meta = (ForceUnits = cm, ClampMin = 1.0, ConsoleVariable = "BE.Significance.MaxDistance"))
+	float MaxDistance = 8000.0f;
+
+	// Half angle of the view cone, characters outside of it are scaled by OffscreenScale
+	UPROPERTY(config, EditAnywhere, Category = Scoring, meta = (ForceUnits = deg, ClampMin = 0.0, ClampMax = 180.0, ConsoleVariable = "BE.Significance.ViewConeHalfAngle"))
+	float ViewConeHalfAngle = 55.0f;
+
+	UPROPERTY(config, EditAnywhere, Category = Scoring, meta = (ClampMin = 0.0, ClampMax = 1.0, ConsoleVariable = "BE.Significance.OffscreenScale"))
+	float OffscreenScale = 0.35f;
+
+	// Scale applied to characters that were not rendered recently (occluded)
+	UPROPERTY(config, EditAnywhere, Category = Scoring, meta = (ClampMin = 0.0, ClampMax = 1.0, ConsoleVariable = "BE.Significance.NotRenderedScale"))
+	float NotRenderedScale = 0.5f;
+
+	// Added to characters on a different team than the viewer
+	UPROPERTY(config, EditAnywhere, Category = Scoring, meta = (ClampMin = 0.0, ClampMax = 1.0, ConsoleVariable = "BE.Significance.HostileBonus"))
+	float HostileBonus = 0.1f;
+
+	// Added to characters owning any of the CombatRelevantTags
+	UPROPERTY(config, EditAnywhere, Category = Scoring, meta = (ClampMin = 0.0, ClampMax = 1.0, ConsoleVariable = "BE.Significance.CombatBonus"))
+	float CombatBonus = 0.25f;
+
+	// Tags marking a character as in combat (e.g. firing, hit recently)
+	UPROPERTY(config, EditAnywhere, Category = Scoring)
+	FGameplayTagContainer CombatRelevantTags;
+
+	// Buckets from the most to the least significant, a character uses the first bucket whose MinSignificance it reaches
+	UPROPERTY(config, EditAnywhere, Category = Buckets)
+	TArray<FBESignificanceBucket> Buckets;
+};
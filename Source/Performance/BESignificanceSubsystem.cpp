@@ -0,0 +1,441 @@
+// Copyright Eigi Chin
+
+#include "BESignificanceSubsystem.h"
+
+#include "Performance/BESignificanceSettings.h"
+#include "Character/BECharacter.h"
+#include "Character/BEPawnMeshAssistInterface.h"
+#include "Feedback/ContextEffects/BEContextEffectComponent.h"
+#include "Team/BETeamSubsystem.h"
+#include "BELogChannels.h"
+
+#include "Components/SkeletalMeshComponent.h"
+#include "DrawDebugHelpers.h"
+#include "Engine/World.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(BESignificanceSubsystem)
+
+
+namespace BE::Significance
+{
+	int32 EnableSignificance = 1;
+	static FAutoConsoleVariableRef CVarEnableSignificance(TEXT("BE.Significance.Enable"), EnableSignificance, TEXT("Lowers the update rates of characters with a low significance"), ECVF_Default);
+
+	float UpdateInterval = 0.25f;
+	static FAutoConsoleVariableRef CVarUpdateInterval(TEXT("BE.Significance.UpdateInterval"), UpdateInterval, TEXT("How often (in seconds) the significance of every character is evaluated"), ECVF_Default);
+
+	float MaxDistance = 8000.0f;
+	static FAutoConsoleVariableRef CVarMaxDistance(TEXT("BE.Significance.MaxDistance"), MaxDistance, TEXT("Distance at which the distance part of the significance reaches 0"), ECVF_Default);
+
+	float ViewConeHalfAngle = 55.0f;
+	static FAutoConsoleVariableRef CVarViewConeHalfAngle(TEXT("BE.Significance.ViewConeHalfAngle"), ViewConeHalfAngle, TEXT("Half angle (in degrees) of the view cone"), ECVF_Default);
+
+	float OffscreenScale = 0.35f;
+	static FAutoConsoleVariableRef CVarOffscreenScale(TEXT("BE.Significance.OffscreenScale"), OffscreenScale, TEXT("Significance scale for characters outside of the view cone"), ECVF_Default);
+
+	float NotRenderedScale = 0.5f;
+	static FAutoConsoleVariableRef CVarNotRenderedScale(TEXT("BE.Significance.NotRenderedScale"), NotRenderedScale, TEXT("Significance scale for characters that were not rendered recently"), ECVF_Default);
+
+	float HostileBonus = 0.1f;
+	static FAutoConsoleVariableRef CVarHostileBonus(TEXT("BE.Significance.HostileBonus"), HostileBonus, TEXT("Significance added to characters on a different team than the viewer"), ECVF_Default);
+
+	float CombatBonus = 0.25f;
+	static FAutoConsoleVariableRef CVarCombatBonus(TEXT("BE.Significance.CombatBonus"), CombatBonus, TEXT("Significance added to characters owning a combat relevant tag"), ECVF_Default);
+
+	int32 DrawDebug = 0;
+	static FAutoConsoleVariableRef CVarDrawDebug(TEXT("BE.Significance.Debug"), DrawDebug, TEXT("Draws the significance and bucket of every character"), ECVF_Cheat);
+
+	static FAutoConsoleCommandWithWorld CmdLogBuckets(
+		TEXT("BE.Significance.LogBuckets"),
+		TEXT("Logs how many characters are in each significance bucket"),
+		FConsoleCommandWithWorldDelegate::CreateStatic(
+			[](UWorld* InWorld)
+			{
+				if (const UBESignificanceSubsystem* Subsystem = InWorld ? InWorld->GetSubsystem<UBESignificanceSubsystem>() : nullptr)
+				{
+					Subsystem->LogBuckets();
+				}
+			}));
+}
+
+
+bool UBESignificanceSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	// Nothing is rendered on dedicated servers, animation there is driven by the server's own settings
+	if (IsRunningDedicatedServer())
+	{
+		return false;
+	}
+
+	return Super::ShouldCreateSubsystem(Outer);
+}
+
+bool UBESignificanceSubsystem::DoesSupportWorldType(EWorldType::Type WorldType) const
+{
+	return (WorldType == EWorldType::Game) || (WorldType == EWorldType::PIE);
+}
+
+void UBESignificanceSubsystem::Deinitialize()
+{
+	for (const FManagedCharacter& Managed : ManagedCharacters)
+	{
+		RestoreOriginalSettings(Managed);
+	}
+
+	ManagedCharacters.Reset();
+
+	Super::Deinitialize();
+}
+
+TStatId UBESignificanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UBESignificanceSubsystem, STATGROUP_Tickables);
+}
+
+void UBESignificanceSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	TimeUntilUpdate -= DeltaTime;
+	if (TimeUntilUpdate <= 0.0f)
+	{
+		TimeUntilUpdate = BE::Significance::UpdateInterval;
+
+		UpdateSignificance();
+	}
+
+	if (BE::Significance::DrawDebug > 0)
+	{
+		DrawDebug();
+	}
+}
+
+
+void UBESignificanceSubsystem::RegisterCharacter(ABECharacter* Character)
+{
+	if (Character && !ManagedCharacters.ContainsByPredicate([Character](const FManagedCharacter& Managed) { return Managed.Character == Character; }))
+	{
+		FManagedCharacter& Managed = ManagedCharacters.AddDefaulted_GetRef();
+		Managed.Character = Character;
+
+		CaptureOriginalSettings(Managed);
+
+		// Evaluate the new character with the next tick
+		TimeUntilUpdate = 0.0f;
+	}
+}
+
+void UBESignificanceSubsystem::UnregisterCharacter(ABECharacter* Character)
+{
+	for (const FManagedCharacter& Managed : ManagedCharacters)
+	{
+		if (Managed.Character == Character)
+		{
+			RestoreOriginalSettings(Managed);
+		}
+	}
+
+	ManagedCharacters.RemoveAllSwap([Character](const FManagedCharacter& Managed) { return !Managed.Character.IsValid() || (Managed.Character == Character); });
+}
+
+float UBESignificanceSubsystem::GetCharacterSignificance(const ABECharacter* Character) const
+{
+	const FManagedCharacter* Managed = ManagedCharacters.FindByPredicate([Character](const FManagedCharacter& Entry) { return Entry.Character == Character; });
+	return Managed ? Managed->Significance : 1.0f;
+}
+
+FName UBESignificanceSubsystem::GetCharacterBucketName(const ABECharacter* Character) const
+{
+	const FManagedCharacter* Managed = ManagedCharacters.FindByPredicate([Character](const FManagedCharacter& Entry) { return Entry.Character == Character; });
+	const TArray<FBESignificanceBucket>& Buckets = GetDefault<UBESignificanceSettings>()->Buckets;
+
+	return (Managed && Buckets.IsValidIndex(Managed->BucketIndex)) ? Buckets[Managed->BucketIndex].Name : NAME_None;
+}
+
+
+void UBESignificanceSubsystem::UpdateSignificance()
+{
+	// Gather the local viewpoints, split screen has more than one
+
+	TArray<FViewer> Viewers;
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PC = It->Get();
+		if (PC && PC->IsLocalController())
+		{
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+			Viewers.Add({ ViewLocation, ViewRotation.Vector(), PC->GetPawn() });
+		}
+	}
+
+	const bool bEnabled = (BE::Significance::EnableSignificance > 0) && (Viewers.Num() > 0);
+
+	for (int32 Index = ManagedCharacters.Num() - 1; Index >= 0; --Index)
+	{
+		FManagedCharacter& Managed = ManagedCharacters[Index];
+
+		ABECharacter* Character = Managed.Character.Get();
+		if (!Character)
+		{
+			ManagedCharacters.RemoveAtSwap(Index);
+			continue;
+		}
+
+		// The local player's own character is always fully significant
+
+		if (!bEnabled || Character->IsLocallyControlled())
+		{
+			Managed.Significance = 1.0f;
+			ApplyBucket(Managed, INDEX_NONE);
+			continue;
+		}
+
+		Managed.Significance = CalculateSignificance(*Character, Viewers);
+		ApplyBucket(Managed, FindBucketIndex(Managed.Significance));
+	}
+}
+
+float UBESignificanceSubsystem::CalculateSignificance(const ABECharacter& Character, const TArray<FViewer>& Viewers) const
+{
+	const UBESignificanceSettings* Settings = GetDefault<UBESignificanceSettings>();
+	const UBETeamSubsystem* TeamSubsystem = GetWorld()->GetSubsystem<UBETeamSubsystem>();
+
+	const FVector Location = Character.GetActorLocation();
+	const float CosViewCone = FMath::Cos(FMath::DegreesToRadians(BE::Significance::ViewConeHalfAngle));
+	const bool bRecentlyRendered = Character.WasRecentlyRendered(0.5f);
+
+	float BestSignificance = 0.0f;
+
+	for (const FViewer& Viewer : Viewers)
+	{
+		const FVector ToCharacter = Location - Viewer.Location;
+		const float Distance = ToCharacter.Size();
+
+		float Significance = 1.0f - FMath::Clamp(Distance / FMath::Max(BE::Significance::MaxDistance, 1.0f), 0.0f, 1.0f);
+
+		const bool bInViewCone = (Distance < UE_KINDA_SMALL_NUMBER) || ((ToCharacter / Distance) | Viewer.Direction) >= CosViewCone;
+		Significance *= bInViewCone ? 1.0f : BE::Significance::OffscreenScale;
+
+		if (!bRecentlyRendered)
+		{
+			Significance *= BE::Significance::NotRenderedScale;
+		}
+
+		if (TeamSubsystem && Viewer.Pawn && (TeamSubsystem->CompareTeams(&Character, Viewer.Pawn) == EBETeamComparison::DifferentTeams))
+		{
+			Significance += BE::Significance::HostileBonus;
+		}
+
+		BestSignificance = FMath::Max(BestSignificance, Significance);
+	}
+
+	if (!Settings->CombatRelevantTags.IsEmpty() && Character.HasAnyMatchingGameplayTags(Settings->CombatRelevantTags))
+	{
+		BestSignificance += BE::Significance::CombatBonus;
+	}
+
+	return FMath::Clamp(BestSignificance, 0.0f, 1.0f);
+}
+
+int32 UBESignificanceSubsystem::FindBucketIndex(float Significance) const
+{
+	const TArray<FBESignificanceBucket>& Buckets = GetDefault<UBESignificanceSettings>()->Buckets;
+
+	for (int32 Index = 0; Index < Buckets.Num(); ++Index)
+	{
+		if (Significance >= Buckets[Index].MinSignificance)
+		{
+			return Index;
+		}
+	}
+
+	return Buckets.Num() - 1;
+}
+
+
+void UBESignificanceSubsystem::ApplyBucket(FManagedCharacter& Managed, int32 NewBucketIndex)
+{
+	ABECharacter* Character = Managed.Character.Get();
+	check(Character);
+
+	TInlineComponentArray<USkeletalMeshComponent*> MeshComponents(Character);
+	if ((Managed.BucketIndex == NewBucketIndex) && (Managed.NumAppliedMeshes == MeshComponents.Num()))
+	{
+		return;
+	}
+
+	const TArray<FBESignificanceBucket>& Buckets = GetDefault<UBESignificanceSettings>()->Buckets;
+
+	// Meshes added since the last time still have their authored settings
+
+	CaptureOriginalSettings(Managed);
+
+	if (Buckets.IsValidIndex(NewBucketIndex))
+	{
+		ApplyBucketSettings(Managed, Buckets[NewBucketIndex]);
+		Managed.BucketIndex = NewBucketIndex;
+	}
+	else
+	{
+		RestoreOriginalSettings(Managed);
+		Managed.BucketIndex = INDEX_NONE;
+	}
+
+	Managed.NumAppliedMeshes = MeshComponents.Num();
+}
+
+void UBESignificanceSubsystem::ApplyBucketSettings(const FManagedCharacter& Managed, const FBESignificanceBucket& Bucket) const
+{
+	ABECharacter* Character = Managed.Character.Get();
+	if (!Character)
+	{
+		return;
+	}
+
+	// Buckets only lower the authored settings, a bucket with the default values leaves the character as authored
+
+	TArray<USkeletalMeshComponent*> CharacterMeshes;
+	IBEPawnMeshAssistInterface::Execute_GetMeshes(Character, CharacterMeshes);
+
+	for (const FMeshSettings& Settings : Managed.OriginalMeshSettings)
+	{
+		USkeletalMeshComponent* Mesh = Settings.Mesh.Get();
+		if (!Mesh)
+		{
+			continue;
+		}
+
+		Mesh->SetComponentTickInterval(FMath::Max(Settings.TickInterval, Bucket.AnimationTickInterval));
+
+		if (CharacterMeshes.Contains(Mesh))
+		{
+			Mesh->bEnableUpdateRateOptimizations = Settings.bEnableUpdateRateOptimizations || Bucket.bEnableUpdateRateOptimizations;
+			Mesh->VisibilityBasedAnimTickOption = (Bucket.VisibilityBasedAnimTickOption == EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones) ? Settings.VisibilityBasedAnimTickOption : Bucket.VisibilityBasedAnimTickOption;
+		}
+		else
+		{
+			// Equipment meshes are the other skeletal meshes owned by the character
+			Mesh->SetComponentTickEnabled(Settings.bTickEnabled && Bucket.bTickEquipmentMeshes);
+		}
+	}
+
+	// Movement smoothing of simulated proxies
+
+	if (UCharacterMovementComponent* MovementComponent = Character->GetCharacterMovement())
+	{
+		const bool bSimulatedProxy = (Character->GetLocalRole() == ROLE_SimulatedProxy);
+		MovementComponent->SetComponentTickInterval(bSimulatedProxy ? FMath::Max(Managed.OriginalMovementTickInterval, Bucket.SimulatedMovementTickInterval) : Managed.OriginalMovementTickInterval);
+	}
+
+	// Context effects
+
+	if (UBEContextEffectComponent* ContextEffectComponent = Character->FindComponentByClass<UBEContextEffectComponent>())
+	{
+		ContextEffectComponent->SetEffectsCulled(Managed.bOriginalEffectsCulled || Bucket.bCullContextEffects);
+	}
+}
+
+void UBESignificanceSubsystem::CaptureOriginalSettings(FManagedCharacter& Managed) const
+{
+	const ABECharacter* Character = Managed.Character.Get();
+	if (!Character)
+	{
+		return;
+	}
+
+	// Movement and context effects are captured once, when the character is registered
+
+	if (!Managed.bCapturedOriginalSettings)
+	{
+		Managed.bCapturedOriginalSettings = true;
+
+		if (const UCharacterMovementComponent* MovementComponent = Character->GetCharacterMovement())
+		{
+			Managed.OriginalMovementTickInterval = MovementComponent->GetComponentTickInterval();
+		}
+
+		if (const UBEContextEffectComponent* ContextEffectComponent = Character->FindComponentByClass<UBEContextEffectComponent>())
+		{
+			Managed.bOriginalEffectsCulled = ContextEffectComponent->AreEffectsCulled();
+		}
+	}
+
+	// Forget removed equipment meshes, capture the new ones
+
+	Managed.OriginalMeshSettings.RemoveAllSwap([](const FMeshSettings& Settings) { return !Settings.Mesh.IsValid(); });
+
+	TInlineComponentArray<USkeletalMeshComponent*> MeshComponents(Character);
+	for (USkeletalMeshComponent* Mesh : MeshComponents)
+	{
+		if (!Managed.OriginalMeshSettings.ContainsByPredicate([Mesh](const FMeshSettings& Settings) { return Settings.Mesh == Mesh; }))
+		{
+			FMeshSettings& Settings = Managed.OriginalMeshSettings.AddDefaulted_GetRef();
+			Settings.Mesh = Mesh;
+			Settings.TickInterval = Mesh->GetComponentTickInterval();
+			Settings.bTickEnabled = Mesh->IsComponentTickEnabled();
+			Settings.bEnableUpdateRateOptimizations = Mesh->bEnableUpdateRateOptimizations;
+			Settings.VisibilityBasedAnimTickOption = Mesh->VisibilityBasedAnimTickOption;
+		}
+	}
+}
+
+void UBESignificanceSubsystem::RestoreOriginalSettings(const FManagedCharacter& Managed) const
+{
+	static const FBESignificanceBucket FullRateBucket;
+	ApplyBucketSettings(Managed, FullRateBucket);
+}
+
+
+void UBESignificanceSubsystem::DrawDebug() const
+{
+#if ENABLE_DRAW_DEBUG
+	const TArray<FBESignificanceBucket>& Buckets = GetDefault<UBESignificanceSettings>()->Buckets;
+
+	for (const FManagedCharacter& Managed : ManagedCharacters)
+	{
+		if (const ABECharacter* Character = Managed.Character.Get())
+		{
+			const bool bHasBucket = Buckets.IsValidIndex(Managed.BucketIndex);
+			const FColor Color = bHasBucket ? Buckets[Managed.BucketIndex].DebugColor : FColor::White;
+			const FString Text = FString::Printf(TEXT("%s %.2f"), bHasBucket ? *Buckets[Managed.BucketIndex].Name.ToString() : TEXT("Full"), Managed.Significance);
+
+			DrawDebugString(GetWorld(), Character->GetActorLocation() + FVector(0.0, 0.0, 120.0), Text, nullptr, Color, 0.0f, true);
+		}
+	}
+#endif
+}
+
+void UBESignificanceSubsystem::LogBuckets() const
+{
+	const TArray<FBESignificanceBucket>& Buckets = GetDefault<UBESignificanceSettings>()->Buckets;
+
+	TArray<int32> Counts;
+	Counts.SetNumZeroed(Buckets.Num());
+	int32 NumFullRate = 0;
+
+	for (const FManagedCharacter& Managed : ManagedCharacters)
+	{
+		if (Counts.IsValidIndex(Managed.BucketIndex))
+		{
+			++Counts[Managed.BucketIndex];
+		}
+		else
+		{
+			++NumFullRate;
+		}
+	}
+
+	UE_LOG(LogBE, Display, TEXT("Significance buckets (%d characters):"), ManagedCharacters.Num());
+	UE_LOG(LogBE, Display, TEXT("  %-12s : %d"), TEXT("Full rate"), NumFullRate);
+
+	for (int32 Index = 0; Index < Buckets.Num(); ++Index)
+	{
+		UE_LOG(LogBE, Display, TEXT("  %-12s : %d (min %.2f)"), *Buckets[Index].Name.ToString(), Counts[Index], Buckets[Index].MinSignificance);
+	}
+}
@@ -0,0 +1,112 @@
+// Copyright Eigi Chin
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+
+#include "Containers/Array.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+#include "BESignificanceSubsystem.generated.h"
+
+class ABECharacter;
+class APawn;
+class USkeletalMeshComponent;
+struct FBESignificanceBucket;
+enum class EVisibilityBasedAnimTickOption : uint8;
+
+
+/**
+ * UBESignificanceSubsystem
+ *
+ *	Scores characters by distance, view cone, rendering, team and combat relevance for the local viewers,
+ *	and lowers the animation, simulated movement, context effect and equipment mesh update rates of the less significant ones.
+ *	Buckets are configured in UBESignificanceSettings. Locally controlled characters always run at full rate.
+ *	Buckets are applied relative to the settings authored on the character, which are restored when it is unregistered.
+ */
+UCLASS()
+class BECORE_API UBESignificanceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UBESignificanceSubsystem() {}
+
+	//~USubsystem interface
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
+	//~FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	//~End of FTickableGameObject interface
+
+protected:
+	virtual bool DoesSupportWorldType(EWorldType::Type WorldType) const override;
+
+public:
+	void RegisterCharacter(ABECharacter* Character);
+	void UnregisterCharacter(ABECharacter* Character);
+
+	// Returns the last evaluated significance of the character, 1 if it is not managed
+	float GetCharacterSignificance(const ABECharacter* Character) const;
+
+	// Returns the name of the bucket applied to the character, NAME_None if it runs at full rate
+	FName GetCharacterBucketName(const ABECharacter* Character) const;
+
+	void LogBuckets() const;
+
+private:
+	struct FMeshSettings
+	{
+		TWeakObjectPtr<USkeletalMeshComponent> Mesh;
+
+		float TickInterval = 0.0f;
+		bool bTickEnabled = true;
+		bool bEnableUpdateRateOptimizations = false;
+		EVisibilityBasedAnimTickOption VisibilityBasedAnimTickOption;
+	};
+
+	struct FManagedCharacter
+	{
+		TWeakObjectPtr<ABECharacter> Character;
+
+		float Significance = 1.0f;
+
+		// Index in UBESignificanceSettings::Buckets, INDEX_NONE runs at full rate
+		int32 BucketIndex = INDEX_NONE;
+
+		// Skeletal mesh count when the bucket was applied, equipment meshes added later need the bucket too
+		int32 NumAppliedMeshes = 0;
+
+		// Settings authored on the character before any bucket was applied, equipment meshes are added when they are first seen
+		TArray<FMeshSettings> OriginalMeshSettings;
+		float OriginalMovementTickInterval = 0.0f;
+		bool bOriginalEffectsCulled = false;
+		bool bCapturedOriginalSettings = false;
+	};
+
+	struct FViewer
+	{
+		FVector Location;
+		FVector Direction;
+		const APawn* Pawn;
+	};
+
+	void UpdateSignificance();
+	float CalculateSignificance(const ABECharacter& Character, const TArray<FViewer>& Viewers) const;
+	int32 FindBucketIndex(float Significance) const;
+
+	void ApplyBucket(FManagedCharacter& Managed, int32 NewBucketIndex);
+	void ApplyBucketSettings(const FManagedCharacter& Managed, const FBESignificanceBucket& Bucket) const;
+
+	void CaptureOriginalSettings(FManagedCharacter& Managed) const;
+	void RestoreOriginalSettings(const FManagedCharacter& Managed) const;
+
+	void DrawDebug() const;
+
+	TArray<FManagedCharacter> ManagedCharacters;
+
+	float TimeUntilUpdate = 0.0f;
+};
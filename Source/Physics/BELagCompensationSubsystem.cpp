@@ -0,0 +1,749 @@
+// Copyright Eigi Chin
+
+#include "BELagCompensationSubsystem.h"
+
+#include "Ability/Target/BEGameplayAbilityTargetData_CartridgeHits.h"
+#include "Character/BECharacter.h"
+#include "BELogChannels.h"
+
+#include "Abilities/GameplayAbilityTargetTypes.h"
+#include "Async/ParallelFor.h"
+#include "Components/CapsuleComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerState.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(BELagCompensationSubsystem)
+
+
+namespace BE::LagCompensation
+{
+	int32 NumSnapshots = 64;
+	static FAutoConsoleVariableRef CVarNumSnapshots(TEXT("BE.LagCompensation.NumSnapshots"), NumSnapshots, TEXT("Number of hitbox snapshots kept per character (applied when the world starts)"), ECVF_Default);
+
+	float SnapshotInterval = 0.0f;
+	static FAutoConsoleVariableRef CVarSnapshotInterval(TEXT("BE.LagCompensation.SnapshotInterval"), SnapshotInterval, TEXT("How often (in seconds) hitbox snapshots are taken, 0 takes one every server frame"), ECVF_Default);
+
+	float MaxRewindMs = 300.0f;
+	static FAutoConsoleVariableRef CVarMaxRewindMs(TEXT("BE.LagCompensation.MaxRewindMs"), MaxRewindMs, TEXT("Longest time (in ms) hits are rewound, shooters with a higher latency get their hits verified at this time"), ECVF_Default);
+
+	float InterpolationDelayMs = 50.0f;
+	static FAutoConsoleVariableRef CVarInterpolationDelayMs(TEXT("BE.LagCompensation.InterpolationDelayMs"), InterpolationDelayMs, TEXT("Time (in ms) simulated proxies lag behind the latest replicated state on clients"), ECVF_Default);
+
+	float Tolerance = 25.0f;
+	static FAutoConsoleVariableRef CVarTolerance(TEXT("BE.LagCompensation.Tolerance"), Tolerance, TEXT("Distance (in cm) an impact may lie outside of the rewound capsule or off the trace, covers limbs outside of the capsule"), ECVF_Default);
+
+	float MaxTraceStartOffset = 250.0f;
+	static FAutoConsoleVariableRef CVarMaxTraceStartOffset(TEXT("BE.LagCompensation.MaxTraceStartOffset"), MaxTraceStartOffset, TEXT("Distance (in cm) a trace may start away from the shooter's location on the server"), ECVF_Default);
+
+	bool bParallel = true;
+	static FAutoConsoleVariableRef CVarParallel(TEXT("BE.LagCompensation.Parallel"), bParallel, TEXT("Should large batches of hits be verified in parallel?"), ECVF_Default);
+
+	int32 ParallelMinHits = 32;
+	static FAutoConsoleVariableRef CVarParallelMinHits(TEXT("BE.LagCompensation.ParallelMinHits"), ParallelMinHits, TEXT("Smallest batch of hits that is verified in parallel"), ECVF_Default);
+
+	int32 ParallelBatchSize = 16;
+	static FAutoConsoleVariableRef CVarParallelBatchSize(TEXT("BE.LagCompensation.ParallelBatchSize"), ParallelBatchSize, TEXT("Minimum number of hits verified by each parallel task"), ECVF_Default);
+
+	// Hit with its target resolved to a history index, safe to verify off the game thread
+	struct FResolvedHit
+	{
+		int32 Target = INDEX_NONE;
+		FVector TraceStart;
+		FVector TraceEnd;
+		FVector ImpactPoint;
+		FVector ShooterLocation;
+		double RewindTime = 0.0;
+	};
+
+	// Console variables read once per batch
+	struct FVerifyParams
+	{
+		double Tolerance = 0.0;
+		double MaxTraceStartOffset = 0.0;
+		bool bParallel = false;
+
+		static FVerifyParams FromConsoleVariables(int32 NumHits)
+		{
+			FVerifyParams Params;
+			Params.Tolerance = FMath::Max(Tolerance, 0.0f);
+			Params.MaxTraceStartOffset = FMath::Max(MaxTraceStartOffset, 0.0f);
+			Params.bParallel = bParallel && (NumHits >= ParallelMinHits);
+			return Params;
+		}
+	};
+
+	static EBELagCompensationResult VerifyHit(const FBELagCompensationHistory& History, const FResolvedHit& Hit, const FVerifyParams& Params)
+	{
+		if (Hit.Target == INDEX_NONE)
+		{
+			return EBELagCompensationResult::NotTracked;
+		}
+
+		if (FVector::DistSquared(Hit.TraceStart, Hit.ShooterLocation) > FMath::Square(Params.MaxTraceStartOffset))
+		{
+			return EBELagCompensationResult::RejectedTraceStart;
+		}
+
+		int64 Older, Newer;
+		float Alpha;
+		FBELagCompensationHitbox Hitbox;
+		if (!History.FindSnapshots(Hit.RewindTime, Older, Newer, Alpha) || !History.GetHitbox(Hit.Target, Older, Newer, Alpha, Hitbox))
+		{
+			return EBELagCompensationResult::RejectedNoHistory;
+		}
+
+		if (FMath::PointDistToSegmentSquared(Hit.ImpactPoint, Hit.TraceStart, Hit.TraceEnd) > FMath::Square(Params.Tolerance))
+		{
+			return EBELagCompensationResult::RejectedTrace;
+		}
+
+		const FVector AxisExtent(0.0, 0.0, FMath::Max(Hitbox.HalfHeight - Hitbox.Radius, 0.0f));
+		if (FMath::PointDistToSegmentSquared(Hit.ImpactPoint, Hitbox.Center - AxisExtent, Hitbox.Center + AxisExtent) > FMath::Square(Hitbox.Radius + Params.Tolerance))
+		{
+			return EBELagCompensationResult::RejectedHitbox;
+		}
+
+		return EBELagCompensationResult::Confirmed;
+	}
+
+	static void VerifyResolvedHits(const FBELagCompensationHistory& History, TConstArrayView<FResolvedHit> Hits, TArrayView<EBELagCompensationResult> OutResults, const FVerifyParams& Params)
+	{
+		check(Hits.Num() == OutResults.Num());
+
+		// Verification only reads the history and writes its own result, the game thread waits for all of it
+
+		ParallelFor(TEXT("BELagCompensation.Verify"), Hits.Num(), FMath::Max(ParallelBatchSize, 1),
+			[&History, &Hits, &OutResults, &Params](int32 Index)
+			{
+				OutResults[Index] = VerifyHit(History, Hits[Index], Params);
+			},
+			Params.bParallel ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+	}
+
+	static void Benchmark(const TArray<FString>& Args)
+	{
+		const int32 NumShooters = FMath::Max((Args.Num() > 0) ? FCString::Atoi(*Args[0]) : 64, 2);
+		const int32 ShotsPerSecond = FMath::Max((Args.Num() > 1) ? FCString::Atoi(*Args[1]) : 15, 1);
+		const int32 Seconds = FMath::Max((Args.Num() > 2) ? FCString::Atoi(*Args[2]) : 5, 1);
+
+		static const int32 TickRate = 60;
+		static const float HalfHeight = 88.0f;
+		static const float Radius = 34.0f;
+
+		// Every shooter is also a target, moving in a circle around its spawn
+
+		FBELagCompensationHistory History;
+		History.Initialize(NumSnapshots);
+
+		TArray<FVector> Locations;
+		for (int32 Index = 0; Index < NumShooters; ++Index)
+		{
+			History.AddTarget();
+		}
+		Locations.SetNum(NumShooters);
+
+		auto GetLocation = [](int32 Index, double Time)
+		{
+			const FVector Spawn((Index % 8) * 800.0, (Index / 8) * 800.0, HalfHeight);
+			return Spawn + FVector(FMath::Cos(Time + Index), FMath::Sin(Time + Index), 0.0) * 200.0;
+		};
+
+		FRandomStream RandomStream(NumShooters);
+		TArray<FResolvedHit> Hits;
+		TArray<EBELagCompensationResult> SerialResults;
+		TArray<EBELagCompensationResult> ParallelResults;
+
+		double SerialTime = 0.0;
+		double ParallelTime = 0.0;
+		double WorstParallelBatchTime = 0.0;
+		int32 NumHits = 0;
+		int32 NumConfirmed = 0;
+		int32 NumMismatches = 0;
+		double ShotAccumulator = 0.0;
+
+		const int32 NumFrames = Seconds * TickRate;
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			const double Time = (double)Frame / TickRate;
+
+			History.AddSnapshot(Time);
+			for (int32 Index = 0; Index < NumShooters; ++Index)
+			{
+				Locations[Index] = GetLocation(Index, Time);
+				History.SetHitbox(Index, Locations[Index], HalfHeight, Radius);
+			}
+
+			// Full-auto fire from every shooter, batched per frame like the target data queued on the subsystem
+
+			ShotAccumulator += (double)NumShooters * ShotsPerSecond / TickRate;
+			const int32 NumShots = FMath::FloorToInt(ShotAccumulator);
+			ShotAccumulator -= NumShots;
+
+			Hits.Reset(NumShots);
+			for (int32 Shot = 0; Shot < NumShots; ++Shot)
+			{
+				const int32 Shooter = RandomStream.RandHelper(NumShooters);
+				const int32 Target = (Shooter + 1 + RandomStream.RandHelper(NumShooters - 1)) % NumShooters;
+				const double RewindTime = FMath::Max(Time - RandomStream.FRandRange(0.0f, 0.2f), 0.0);
+
+				// Aim at the capsule the shooter saw, one in ten shots claims a hit that misses
+
+				const FVector SeenLocation = GetLocation(Target, RewindTime);
+				const FVector ToShooter = (Locations[Shooter] - SeenLocation).GetSafeNormal2D();
+				FVector ImpactPoint = SeenLocation + ToShooter * Radius + FVector(0.0, 0.0, RandomStream.FRandRange(-HalfHeight, HalfHeight) * 0.5);
+
+				if (RandomStream.RandHelper(10) == 0)
+				{
+					ImpactPoint += FVector::CrossProduct(ToShooter, FVector::UpVector) * 100.0;
+				}
+
+				FResolvedHit& Hit = Hits.AddDefaulted_GetRef();
+				Hit.Target = Target;
+				Hit.ShooterLocation = Locations[Shooter];
+				Hit.TraceStart = Locations[Shooter];
+				Hit.TraceEnd = Hit.TraceStart + (ImpactPoint - Hit.TraceStart).GetSafeNormal() * 10000.0;
+				Hit.ImpactPoint = ImpactPoint;
+				Hit.RewindTime = RewindTime;
+			}
+
+			SerialResults.SetNumUninitialized(Hits.Num());
+			ParallelResults.SetNumUninitialized(Hits.Num());
+
+			FVerifyParams Params = FVerifyParams::FromConsoleVariables(Hits.Num());
+
+			Params.bParallel = false;
+			const double SerialStartTime = FPlatformTime::Seconds();
+			VerifyResolvedHits(History, Hits, SerialResults, Params);
+			SerialTime += FPlatformTime::Seconds() - SerialStartTime;
+
+			Params.bParallel = true;
+			const double ParallelStartTime = FPlatformTime::Seconds();
+			VerifyResolvedHits(History, Hits, ParallelResults, Params);
+			const double ParallelBatchTime = FPlatformTime::Seconds() - ParallelStartTime;
+			ParallelTime += ParallelBatchTime;
+			WorstParallelBatchTime = FMath::Max(WorstParallelBatchTime, ParallelBatchTime);
+
+			for (int32 Index = 0; Index < Hits.Num(); ++Index)
+			{
+				NumConfirmed += (ParallelResults[Index] == EBELagCompensationResult::Confirmed) ? 1 : 0;
+				NumMismatches += (ParallelResults[Index] != SerialResults[Index]) ? 1 : 0;
+			}
+			NumHits += Hits.Num();
+		}
+
+		// Keep this format stable, benchmark scripts parse it
+		UE_LOG(LogBE, Display, TEXT("LagCompensation Benchmark Shooters=%d ShotsPerSec=%d Frames=%d Hits=%d Confirmed=%d Mismatches=%d HistoryKB=%.1f SerialMs=%.3f ParallelMs=%.3f AvgBatchUs=%.2f WorstBatchUs=%.2f"),
+			NumShooters, ShotsPerSecond, NumFrames, NumHits, NumConfirmed, NumMismatches,
+			History.GetAllocatedSize() / 1024.0,
+			SerialTime * 1000.0,
+			ParallelTime * 1000.0,
+			ParallelTime * 1000000.0 / NumFrames,
+			WorstParallelBatchTime * 1000000.0);
+	}
+
+	static FAutoConsoleCommand CmdBenchmark(
+		TEXT("BE.LagCompensation.Benchmark"),
+		TEXT("Verifies synthetic full-auto hits against a synthetic hitbox history, serially and in parallel, and logs the timings. Usage: BE.LagCompensation.Benchmark [NumShooters=64] [ShotsPerSecond=15] [Seconds=5]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(Benchmark));
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// FBELagCompensationHistory
+
+void FBELagCompensationHistory::Initialize(int32 InNumSnapshots)
+{
+	NumSnapshots = FMath::Max(InNumSnapshots, 2);
+
+	Reset();
+}
+
+void FBELagCompensationHistory::Reset()
+{
+	NextSnapshot = 0;
+
+	SnapshotTimes.Reset();
+	SnapshotTimes.SetNumZeroed(NumSnapshots);
+
+	Centers.Reset();
+	HalfHeights.Reset();
+	Radii.Reset();
+
+	TargetFirstSnapshots.Reset();
+	FreeTargets.Reset();
+}
+
+int32 FBELagCompensationHistory::AddTarget()
+{
+	check(NumSnapshots > 0);
+
+	int32 Target;
+	if (FreeTargets.Num() > 0)
+	{
+		Target = FreeTargets.Pop(/*bAllowShrinking=*/ false);
+	}
+	else
+	{
+		Target = TargetFirstSnapshots.Add(INDEX_NONE);
+
+		Centers.AddZeroed(NumSnapshots);
+		HalfHeights.AddZeroed(NumSnapshots);
+		Radii.AddZeroed(NumSnapshots);
+	}
+
+	TargetFirstSnapshots[Target] = NextSnapshot;
+
+	return Target;
+}
+
+void FBELagCompensationHistory::RemoveTarget(int32 Target)
+{
+	if (TargetFirstSnapshots.IsValidIndex(Target) && (TargetFirstSnapshots[Target] != INDEX_NONE))
+	{
+		TargetFirstSnapshots[Target] = INDEX_NONE;
+		FreeTargets.Add(Target);
+	}
+}
+
+void FBELagCompensationHistory::AddSnapshot(double Time)
+{
+	SnapshotTimes[GetSlot(NextSnapshot)] = Time;
+	++NextSnapshot;
+}
+
+void FBELagCompensationHistory::SetHitbox(int32 Target, const FVector& Center, float HalfHeight, float Radius)
+{
+	check(NextSnapshot > 0);
+
+	const int32 Index = (Target * NumSnapshots) + GetSlot(NextSnapshot - 1);
+	Centers[Index] = FVector3f(Center);
+	HalfHeights[Index] = HalfHeight;
+	Radii[Index] = Radius;
+}
+
+bool FBELagCompensationHistory::FindSnapshots(double Time, int64& OutOlder, int64& OutNewer, float& OutAlpha) const
+{
+	if (NextSnapshot == 0)
+	{
+		return false;
+	}
+
+	const int64 Latest = NextSnapshot - 1;
+	const int64 Oldest = FMath::Max<int64>(NextSnapshot - NumSnapshots, 0);
+
+	if (Time >= SnapshotTimes[GetSlot(Latest)])
+	{
+		OutOlder = Latest;
+		OutNewer = Latest;
+		OutAlpha = 0.0f;
+		return true;
+	}
+
+	if (Time < SnapshotTimes[GetSlot(Oldest)])
+	{
+		return false;
+	}
+
+	// Snapshot times only grow, find the last snapshot at or before the time
+
+	int64 Low = Oldest;
+	int64 High = Latest;
+	while ((High - Low) > 1)
+	{
+		const int64 Middle = Low + ((High - Low) / 2);
+		if (SnapshotTimes[GetSlot(Middle)] <= Time)
+		{
+			Low = Middle;
+		}
+		else
+		{
+			High = Middle;
+		}
+	}
+
+	const double LowTime = SnapshotTimes[GetSlot(Low)];
+	const double HighTime = SnapshotTimes[GetSlot(High)];
+
+	OutOlder = Low;
+	OutNewer = High;
+	OutAlpha = (HighTime > LowTime) ? (float)((Time - LowTime) / (HighTime - LowTime)) : 0.0f;
+	return true;
+}
+
+bool FBELagCompensationHistory::GetHitbox(int32 Target, int64 Older, int64 Newer, float Alpha, FBELagCompensationHitbox& OutHitbox) const
+{
+	if (!TargetFirstSnapshots.IsValidIndex(Target))
+	{
+		return false;
+	}
+
+	const int64 FirstSnapshot = TargetFirstSnapshots[Target];
+	if ((FirstSnapshot == INDEX_NONE) || (Newer < FirstSnapshot))
+	{
+		return false;
+	}
+
+	// Tracked from between the snapshots on, use the first hitbox it has
+	if (Older < FirstSnapshot)
+	{
+		Older = Newer;
+		Alpha = 0.0f;
+	}
+
+	const int32 OlderIndex = (Target * NumSnapshots) + GetSlot(Older);
+	const int32 NewerIndex = (Target * NumSnapshots) + GetSlot(Newer);
+
+	OutHitbox.Center = FVector(FMath::Lerp(Centers[OlderIndex], Centers[NewerIndex], Alpha));
+	OutHitbox.HalfHeight = FMath::Lerp(HalfHeights[OlderIndex], HalfHeights[NewerIndex], Alpha);
+	OutHitbox.Radius = FMath::Lerp(Radii[OlderIndex], Radii[NewerIndex], Alpha);
+	return true;
+}
+
+SIZE_T FBELagCompensationHistory::GetAllocatedSize() const
+{
+	return SnapshotTimes.GetAllocatedSize()
+		+ Centers.GetAllocatedSize()
+		+ HalfHeights.GetAllocatedSize()
+		+ Radii.GetAllocatedSize()
+		+ TargetFirstSnapshots.GetAllocatedSize()
+		+ FreeTargets.GetAllocatedSize();
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// UBELagCompensationSubsystem
+
+void UBELagCompensationSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	History.Initialize(BE::LagCompensation::NumSnapshots);
+}
+
+void UBELagCompensationSubsystem::Deinitialize()
+{
+	History.Reset();
+	Targets.Reset();
+	TargetIndices.Reset();
+	QueuedTargetData.Reset();
+	QueuedRequests.Reset();
+
+	Super::Deinitialize();
+}
+
+bool UBELagCompensationSubsystem::DoesSupportWorldType(EWorldType::Type WorldType) const
+{
+	return (WorldType == EWorldType::Game) || (WorldType == EWorldType::PIE);
+}
+
+TStatId UBELagCompensationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UBELagCompensationSubsystem, STATGROUP_Tickables);
+}
+
+void UBELagCompensationSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// Verify against the snapshots of the previous frames, the shooters fired before this one
+
+	FlushQueuedTargetData();
+
+	if (TargetIndices.IsEmpty())
+	{
+		return;
+	}
+
+	TimeUntilSnapshot -= DeltaTime;
+	if (TimeUntilSnapshot <= 0.0f)
+	{
+		TimeUntilSnapshot = BE::LagCompensation::SnapshotInterval;
+
+		CaptureSnapshot();
+	}
+}
+
+void UBELagCompensationSubsystem::CaptureSnapshot()
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_BELagCompensation_CaptureSnapshot);
+
+	History.AddSnapshot(GetWorld()->GetTimeSeconds());
+
+	for (int32 Target = 0; Target < Targets.Num(); ++Target)
+	{
+		const ABECharacter* Character = Targets[Target].Get();
+		const UCapsuleComponent* Capsule = Character ? Character->GetCapsuleComponent() : nullptr;
+
+		if (Capsule)
+		{
+			History.SetHitbox(Target, Capsule->GetComponentLocation(), Capsule->GetScaledCapsuleHalfHeight(), Capsule->GetScaledCapsuleRadius());
+		}
+	}
+}
+
+
+void UBELagCompensationSubsystem::RegisterCharacter(ABECharacter* Character)
+{
+	const ENetMode NetMode = GetWorld()->GetNetMode();
+
+	// Only servers verify hits from remote shooters
+	if (!Character || ((NetMode != NM_DedicatedServer) && (NetMode != NM_ListenServer)) || TargetIndices.Contains(Character))
+	{
+		return;
+	}
+
+	const int32 Target = History.AddTarget();
+	if (!Targets.IsValidIndex(Target))
+	{
+		Targets.SetNum(Target + 1);
+	}
+
+	Targets[Target] = Character;
+	TargetIndices.Add(Character, Target);
+}
+
+void UBELagCompensationSubsystem::UnregisterCharacter(ABECharacter* Character)
+{
+	int32 Target;
+	if (TargetIndices.RemoveAndCopyValue(Character, Target))
+	{
+		History.RemoveTarget(Target);
+		Targets[Target].Reset();
+	}
+}
+
+double UBELagCompensationSubsystem::GetClientViewTime(const APlayerController* LocalPlayerController)
+{
+	const UWorld* World = LocalPlayerController ? LocalPlayerController->GetWorld() : nullptr;
+	const AGameStateBase* GameState = World ? World->GetGameState() : nullptr;
+	if (!GameState)
+	{
+		return -1.0;
+	}
+
+	double Latency = BE::LagCompensation::InterpolationDelayMs * 0.001;
+
+	if (const APlayerState* PlayerState = LocalPlayerController->GetPlayerState<APlayerState>())
+	{
+		// The replicated server time is already one way late, simulated proxies are another way late
+		Latency += PlayerState->GetPingInMilliseconds() * 0.001 * 0.5;
+	}
+
+	return FMath::Max(GameState->GetServerWorldTimeSeconds() - Latency, 0.0);
+}
+
+double UBELagCompensationSubsystem::GetRewindTime(const AController* Shooter, double ClientTimestamp) const
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+	const double MaxRewind = BE::LagCompensation::MaxRewindMs * 0.001;
+
+	// The timestamp comes from the client, never rewind further than the limit or into the future
+
+	if (ClientTimestamp >= 0.0)
+	{
+		return FMath::Clamp(ClientTimestamp, Now - MaxRewind, Now);
+	}
+
+	// Without a timestamp, the shooter fired one way late against proxies one way plus the interpolation delay late,
+	// which together are the full round trip
+
+	double Latency = BE::LagCompensation::InterpolationDelayMs * 0.001;
+
+	if (const APlayerState* PlayerState = Shooter ? Shooter->GetPlayerState<APlayerState>() : nullptr)
+	{
+		Latency += PlayerState->GetPingInMilliseconds() * 0.001;
+	}
+
+	return Now - FMath::Clamp(Latency, 0.0, MaxRewind);
+}
+
+void UBELagCompensationSubsystem::VerifyHits(TConstArrayView<FBELagCompensationHitRequest> Hits, TArray<EBELagCompensationResult>& OutResults) const
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_BELagCompensation_VerifyHits);
+
+	using namespace BE::LagCompensation;
+
+	// Resolve the targets on the game thread, the rest does not touch any UObject
+
+	TArray<FResolvedHit, TInlineAllocator<32>> ResolvedHits;
+	ResolvedHits.SetNum(Hits.Num());
+
+	for (int32 Index = 0; Index < Hits.Num(); ++Index)
+	{
+		const FBELagCompensationHitRequest& Request = Hits[Index];
+		FResolvedHit& Resolved = ResolvedHits[Index];
+
+		const int32* Target = Request.HitActor ? TargetIndices.Find(Request.HitActor) : nullptr;
+		Resolved.Target = Target ? *Target : INDEX_NONE;
+		Resolved.TraceStart = Request.TraceStart;
+		Resolved.TraceEnd = Request.TraceEnd;
+		Resolved.ImpactPoint = Request.ImpactPoint;
+		Resolved.ShooterLocation = Request.ShooterLocation;
+		Resolved.RewindTime = Request.RewindTime;
+	}
+
+	OutResults.SetNumUninitialized(Hits.Num());
+
+	VerifyResolvedHits(History, ResolvedHits, OutResults, FVerifyParams::FromConsoleVariables(Hits.Num()));
+}
+
+void UBELagCompensationSubsystem::QueueTargetData(const AController* Shooter, const FGameplayAbilityTargetDataHandle& TargetData, FBELagCompensationTargetDataVerified OnVerified)
+{
+	FQueuedTargetData& Queued = QueuedTargetData.AddDefaulted_GetRef();
+	Queued.TargetData = TargetData;
+	Queued.OnVerified = MoveTemp(OnVerified);
+	Queued.FirstRequest = QueuedRequests.Num();
+
+	GatherHitRequests(Shooter, TargetData, QueuedRequests);
+
+	Queued.NumRequests = QueuedRequests.Num() - Queued.FirstRequest;
+}
+
+void UBELagCompensationSubsystem::FlushQueuedTargetData()
+{
+	if (QueuedTargetData.IsEmpty())
+	{
+		return;
+	}
+
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_BELagCompensation_FlushQueuedTargetData);
+
+	// Callbacks may queue more target data, it is verified in the next flush
+
+	TArray<FQueuedTargetData> Queue = MoveTemp(QueuedTargetData);
+	TArray<FBELagCompensationHitRequest> Requests = MoveTemp(QueuedRequests);
+	QueuedTargetData.Reset();
+	QueuedRequests.Reset();
+
+	// Every shooter's hits in one batch
+
+	TArray<EBELagCompensationResult> Results;
+	VerifyHits(Requests, Results);
+
+	int32 NumRejected = 0;
+
+	for (FQueuedTargetData& Queued : Queue)
+	{
+		const int32 NumDataRejected = RemoveRejectedHits(Queued.TargetData, TConstArrayView<EBELagCompensationResult>(Results).Slice(Queued.FirstRequest, Queued.NumRequests));
+		NumRejected += NumDataRejected;
+
+		Queued.OnVerified.ExecuteIfBound(Queued.TargetData, NumDataRejected);
+	}
+
+	UE_CLOG(NumRejected > 0, LogBE, Verbose, TEXT("LagCompensation: Rejected %d of %d queued hits"), NumRejected, Requests.Num());
+}
+
+int32 UBELagCompensationSubsystem::VerifyTargetData(const AController* Shooter, FGameplayAbilityTargetDataHandle& TargetData) const
+{
+	TArray<FBELagCompensationHitRequest> Requests;
+	GatherHitRequests(Shooter, TargetData, Requests);
+
+	if (Requests.IsEmpty())
+	{
+		return 0;
+	}
+
+	TArray<EBELagCompensationResult> Results;
+	VerifyHits(Requests, Results);
+
+	const int32 NumRejected = RemoveRejectedHits(TargetData, Results);
+
+	UE_CLOG(NumRejected > 0, LogBE, Verbose, TEXT("LagCompensation: Rejected %d of %d hits from %s"), NumRejected, Requests.Num(), *GetNameSafe(Shooter));
+
+	return NumRejected;
+}
+
+void UBELagCompensationSubsystem::GatherHitRequests(const AController* Shooter, const FGameplayAbilityTargetDataHandle& TargetData, TArray<FBELagCompensationHitRequest>& OutRequests) const
+{
+	const double FallbackRewindTime = GetRewindTime(Shooter);
+	const APawn* ShooterPawn = Shooter ? Shooter->GetPawn() : nullptr;
+
+	auto AddRequest = [&OutRequests, ShooterPawn](const FHitResult& Hit, double RewindTime)
+	{
+		FBELagCompensationHitRequest& Request = OutRequests.AddDefaulted_GetRef();
+		Request.HitActor = Hit.HitObjectHandle.FetchActor();
+		Request.TraceStart = Hit.TraceStart;
+		Request.TraceEnd = Hit.TraceEnd;
+		Request.ImpactPoint = Hit.ImpactPoint;
+		Request.ShooterLocation = ShooterPawn ? ShooterPawn->GetPawnViewLocation() : Hit.TraceStart;
+		Request.RewindTime = RewindTime;
+	};
+
+	for (const TSharedPtr<FGameplayAbilityTargetData>& Data : TargetData.Data)
+	{
+		if (!Data.IsValid())
+		{
+			continue;
+		}
+
+		if (Data->GetScriptStruct()->IsChildOf(FBEGameplayAbilityTargetData_CartridgeHits::StaticStruct()))
+		{
+			const FBEGameplayAbilityTargetData_CartridgeHits* CartridgeHits = static_cast<const FBEGameplayAbilityTargetData_CartridgeHits*>(Data.Get());
+			const double RewindTime = (CartridgeHits->ClientTimestamp >= 0.0) ? GetRewindTime(Shooter, CartridgeHits->ClientTimestamp) : FallbackRewindTime;
+
+			for (const FHitResult& Hit : CartridgeHits->HitResults)
+			{
+				AddRequest(Hit, RewindTime);
+			}
+		}
+		else if (const FHitResult* Hit = Data->GetHitResult())
+		{
+			AddRequest(*Hit, FallbackRewindTime);
+		}
+	}
+}
+
+int32 UBELagCompensationSubsystem::RemoveRejectedHits(FGameplayAbilityTargetDataHandle& TargetData, TConstArrayView<EBELagCompensationResult> Results)
+{
+	auto IsRejected = [](EBELagCompensationResult Result)
+	{
+		return (Result != EBELagCompensationResult::Confirmed) && (Result != EBELagCompensationResult::NotTracked);
+	};
+
+	// Walk the hits in the same order they were gathered
+
+	int32 NumRejected = 0;
+	int32 ResultIndex = 0;
+
+	for (int32 DataIndex = 0; DataIndex < TargetData.Data.Num(); ++DataIndex)
+	{
+		const TSharedPtr<FGameplayAbilityTargetData>& Data = TargetData.Data[DataIndex];
+		if (!Data.IsValid())
+		{
+			continue;
+		}
+
+		if (Data->GetScriptStruct()->IsChildOf(FBEGameplayAbilityTargetData_CartridgeHits::StaticStruct()))
+		{
+			TArray<FHitResult>& HitResults = static_cast<FBEGameplayAbilityTargetData_CartridgeHits*>(Data.Get())->HitResults;
+
+			for (int32 HitIndex = 0; HitIndex < HitResults.Num(); ++HitIndex)
+			{
+				if (IsRejected(Results[ResultIndex++]))
+				{
+					HitResults.RemoveAt(HitIndex--, 1, /*bAllowShrinking=*/ false);
+					++NumRejected;
+				}
+			}
+		}
+		else if (Data->GetHitResult())
+		{
+			if (IsRejected(Results[ResultIndex++]))
+			{
+				TargetData.Data.RemoveAt(DataIndex--);
+				++NumRejected;
+			}
+		}
+	}
+
+	check(ResultIndex == Results.Num());
+
+	return NumRejected;
+}
@@ -0,0 +1,228 @@
+// Copyright Eigi Chin
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+
+#include "Containers/Array.h"
+#include "Containers/ArrayView.h"
+#include "Containers/Map.h"
+#include "Abilities/GameplayAbilityTargetTypes.h"
+#include "Delegates/Delegate.h"
+#include "Math/Vector.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+#include "BELagCompensationSubsystem.generated.h"
+
+class AActor;
+class AController;
+class APlayerController;
+class ABECharacter;
+
+// Called with the target data once its rejected hits have been removed
+DECLARE_DELEGATE_TwoParams(FBELagCompensationTargetDataVerified, const FGameplayAbilityTargetDataHandle& /*TargetData*/, int32 /*NumRejected*/);
+
+
+/**
+ * EBELagCompensationResult
+ *
+ *	Result of verifying a client hit against the rewound hitboxes
+ */
+UENUM()
+enum class EBELagCompensationResult : uint8
+{
+	// The impact lies on the hitbox of the target at the shooter's time
+	Confirmed,
+
+	// The hit actor is not a tracked character (world geometry, misses, etc.), nothing to verify
+	NotTracked,
+
+	// The shooter's time is older than the history or the target was not tracked yet
+	RejectedNoHistory,
+
+	// The trace does not start near the shooter
+	RejectedTraceStart,
+
+	// The impact does not lie on the trace
+	RejectedTrace,
+
+	// The impact does not lie on the hitbox of the target at the shooter's time
+	RejectedHitbox
+};
+
+
+/**
+ * FBELagCompensationHitRequest
+ *
+ *	One client hit to verify
+ */
+struct FBELagCompensationHitRequest
+{
+public:
+	const AActor* HitActor = nullptr;
+
+	FVector TraceStart = FVector::ZeroVector;
+	FVector TraceEnd = FVector::ZeroVector;
+	FVector ImpactPoint = FVector::ZeroVector;
+
+	// Location of the shooter on the server, the trace has to start near it
+	FVector ShooterLocation = FVector::ZeroVector;
+
+	// Server time of the world the shooter saw when firing (see UBELagCompensationSubsystem::GetRewindTime)
+	double RewindTime = 0.0;
+};
+
+
+/**
+ * FBELagCompensationHitbox
+ *
+ *	Upright capsule of a character at one point in time
+ */
+struct FBELagCompensationHitbox
+{
+public:
+	FVector Center = FVector::ZeroVector;
+	float HalfHeight = 0.0f;
+	float Radius = 0.0f;
+};
+
+
+/**
+ * FBELagCompensationHistory
+ *
+ *	Ring buffer of hitbox snapshots of every tracked target.
+ *	All targets are captured at the same times, so the snapshot times are shared and each hitbox field is kept in its own array
+ *	([Target * NumSnapshots + Slot]), which keeps a snapshot at 20 bytes per target.
+ *	Reading is thread safe as long as nothing is written at the same time.
+ */
+class BECORE_API FBELagCompensationHistory
+{
+public:
+	void Initialize(int32 InNumSnapshots);
+	void Reset();
+
+	// Returns the index of a new target, its hitboxes are valid from the next snapshot on
+	int32 AddTarget();
+	void RemoveTarget(int32 Target);
+
+	// Starts a new snapshot, the hitbox of every target has to be set for it
+	void AddSnapshot(double Time);
+	void SetHitbox(int32 Target, const FVector& Center, float HalfHeight, float Radius);
+
+	// Finds the snapshots around the time, false if the time is older than the history
+	bool FindSnapshots(double Time, int64& OutOlder, int64& OutNewer, float& OutAlpha) const;
+
+	// Interpolates the hitbox of the target between the snapshots, false if the target was not tracked at the time
+	bool GetHitbox(int32 Target, int64 Older, int64 Newer, float Alpha, FBELagCompensationHitbox& OutHitbox) const;
+
+	int32 GetNumSnapshots() const { return NumSnapshots; }
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	int32 GetSlot(int64 Snapshot) const { return (int32)(Snapshot % NumSnapshots); }
+
+	int32 NumSnapshots = 0;
+
+	// Number of snapshots taken so far, the latest one is NextSnapshot - 1
+	int64 NextSnapshot = 0;
+
+	TArray<double> SnapshotTimes;
+
+	TArray<FVector3f> Centers;
+	TArray<float> HalfHeights;
+	TArray<float> Radii;
+
+	// First snapshot of each target, INDEX_NONE for removed targets
+	TArray<int64> TargetFirstSnapshots;
+	TArray<int32> FreeTargets;
+};
+
+
+/**
+ * UBELagCompensationSubsystem
+ *
+ *	Keeps a history of the capsule of every character on the server and verifies client hits against the capsules
+ *	rewound to the time the shooter saw, instead of trusting the client or re-tracing the world.
+ *
+ *	Abilities queue the target data they receive from the client with QueueTargetData. The hits of every shooter queued during a frame
+ *	are verified together in the subsystem tick, in parallel when there are enough of them (BE.LagCompensation.ParallelMinHits),
+ *	and the abilities apply their effects from the callback. VerifyTargetData verifies right away for callers that cannot wait.
+ *
+ *	Clients set FBEGameplayAbilityTargetData_CartridgeHits::ClientTimestamp with GetClientViewTime when firing,
+ *	hits without it are rewound by the shooter's ping.
+ */
+UCLASS()
+class BECORE_API UBELagCompensationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UBELagCompensationSubsystem() {}
+
+	//~USubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
+	//~FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	//~End of FTickableGameObject interface
+
+protected:
+	virtual bool DoesSupportWorldType(EWorldType::Type WorldType) const override;
+
+public:
+	// Characters are only tracked on the server
+	void RegisterCharacter(ABECharacter* Character);
+	void UnregisterCharacter(ABECharacter* Character);
+
+	// Called on the client when firing, estimated server time of the state of the simulated proxies the local player sees
+	static double GetClientViewTime(const APlayerController* LocalPlayerController);
+
+	// Server time of the world the shooter saw when firing, from the timestamp sent by the client (negative if none) or else its ping
+	double GetRewindTime(const AController* Shooter, double ClientTimestamp = -1.0) const;
+
+	// Verifies every hit in one batch
+	void VerifyHits(TConstArrayView<FBELagCompensationHitRequest> Hits, TArray<EBELagCompensationResult>& OutResults) const;
+
+	// Queues the target data sent by the shooter, it is verified with the hits of every other shooter in this frame's tick
+	void QueueTargetData(const AController* Shooter, const FGameplayAbilityTargetDataHandle& TargetData, FBELagCompensationTargetDataVerified OnVerified);
+
+	// Verifies every queued hit now
+	void FlushQueuedTargetData();
+
+	// Verifies every hit of the target data sent by the shooter right away and removes the rejected ones, returns the number of removed hits
+	int32 VerifyTargetData(const AController* Shooter, FGameplayAbilityTargetDataHandle& TargetData) const;
+
+	const FBELagCompensationHistory& GetHistory() const { return History; }
+
+private:
+	void CaptureSnapshot();
+
+	// Adds a request for every hit of the target data
+	void GatherHitRequests(const AController* Shooter, const FGameplayAbilityTargetDataHandle& TargetData, TArray<FBELagCompensationHitRequest>& OutRequests) const;
+
+	// Removes the hits whose result is a rejection, the results are in the order of GatherHitRequests
+	static int32 RemoveRejectedHits(FGameplayAbilityTargetDataHandle& TargetData, TConstArrayView<EBELagCompensationResult> Results);
+
+	struct FQueuedTargetData
+	{
+		FGameplayAbilityTargetDataHandle TargetData;
+		FBELagCompensationTargetDataVerified OnVerified;
+		int32 FirstRequest = 0;
+		int32 NumRequests = 0;
+	};
+
+	TArray<FQueuedTargetData> QueuedTargetData;
+	TArray<FBELagCompensationHitRequest> QueuedRequests;
+
+	FBELagCompensationHistory History;
+
+	// Tracked characters by history target index
+	TArray<TWeakObjectPtr<ABECharacter>> Targets;
+	TMap<TObjectKey<AActor>, int32> TargetIndices;
+
+	float TimeUntilSnapshot = 0.0f;
+};
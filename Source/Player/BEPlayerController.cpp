@@ -13,6 +13,7 @@
 #include "BELocalPlayer.h"
 #include "GameSetting/BEGameSharedSettings.h"
 #include "Development/BEDeveloperCheatSettings.h"
+#include "Input/BEInputReplaySubsystem.h"
 
 #include "EngineUtils.h"
 #include "GameFramework/Pawn.h"
@@ -208,10 +209,20 @@ void ABEPlayerController::UpdateHiddenComponents(const FVector& ViewLocation, TS
 void ABEPlayerController::PreProcessInput(const float DeltaTime, const bool bGamePaused)
 {
 	Super::PreProcessInput(DeltaTime, bGamePaused);
+
+	if (UBEInputReplaySubsystem* ReplaySubsystem = UBEInputReplaySubsystem::Get(this))
+	{
+		ReplaySubsystem->PreProcessInput(this, DeltaTime);
+	}
 }
 
 void ABEPlayerController::PostProcessInput(const float DeltaTime, const bool bGamePaused)
 {
+	if (UBEInputReplaySubsystem* ReplaySubsystem = UBEInputReplaySubsystem::Get(this))
+	{
+		ReplaySubsystem->PostProcessInput(this, DeltaTime);
+	}
+
 	if (UBEAbilitySystemComponent* BEASC = GetBEAbilitySystemComponent())
 	{
 		BEASC->ProcessAbilityInput(DeltaTime, bGamePaused);
@@ -220,6 +231,34 @@ void ABEPlayerController::PostProcessInput(const float DeltaTime, const bool bGa
 	Super::PostProcessInput(DeltaTime, bGamePaused);
 }
 
+void ABEPlayerController::SetCinematicMode(bool bInCinematicMode, bool bHidePlayer, bool bAffectsHUD, bool bAffectsMovement, bool bAffectsTurning)
+{
+	Super::SetCinematicMode(bInCinematicMode, bHidePlayer, bAffectsHUD, bAffectsMovement, bAffectsTurning);
+
+	// The engine writes bShowHUD directly, sync the root layouts with it
+
+	if (bAffectsHUD)
+	{
+		if (ABEHUD* BEHUD = Cast<ABEHUD>(GetHUD()))
+		{
+			BEHUD->NotifyShowHUDChanged();
+		}
+	}
+}
+
+void ABEPlayerController::ClientSetCinematicMode_Implementation(bool bInCinematicMode, bool bAffectsMovement, bool bAffectsTurning, bool bAffectsHUD)
+{
+	Super::ClientSetCinematicMode_Implementation(bInCinematicMode, bAffectsMovement, bAffectsTurning, bAffectsHUD);
+
+	if (bAffectsHUD)
+	{
+		if (ABEHUD* BEHUD = Cast<ABEHUD>(GetHUD()))
+		{
+			BEHUD->NotifyShowHUDChanged();
+		}
+	}
+}
+
 
 void ABEPlayerController::OnSettingsChanged(UBEGameSharedSettings* Settings)
 {
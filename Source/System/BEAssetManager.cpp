@@ -3,12 +3,16 @@
 #include "BEAssetManager.h"
 #include "BELogChannels.h"
 #include "BEGameData.h"
+#include "BEAssetManagerBootProfile.h"
 #include "AbilitySystemGlobals.h"
 #include "Character/BEPawnData.h"
 #include "Stats/StatsMisc.h"
 #include "Engine/Engine.h"
 #include "Ability/BEGameplayCueManager.h"
 #include "Misc/ScopedSlowTask.h"
+#include "Algo/AllOf.h"
+#include "HAL/PlatformStackWalk.h"
+#include "GameFeaturesSubsystemSettings.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(BEAssetManager)
 
@@ -23,10 +27,34 @@ static FAutoConsoleCommand CVarDumpLoadedAssets(
 	FConsoleCommandDelegate::CreateStatic(UBEAssetManager::DumpLoadedAssets)
 );
 
+static FAutoConsoleCommand CVarDumpSyncLoads(
+	TEXT("BE.DumpSyncLoads"),
+	TEXT("Shows all synchronous loads done through GetAsset/GetSubclass while BE.TrackSyncLoads was enabled, with their call stacks."),
+	FConsoleCommandDelegate::CreateStatic(UBEAssetManager::DumpSyncLoads)
+);
+
+static FAutoConsoleCommand CVarResetSyncLoads(
+	TEXT("BE.ResetSyncLoads"),
+	TEXT("Clears the synchronous loads recorded for BE.DumpSyncLoads."),
+	FConsoleCommandDelegate::CreateStatic(UBEAssetManager::ResetSyncLoads)
+);
+
+namespace BEConsoleVariables
+{
+	static bool bTrackSyncLoads = false;
+	static FAutoConsoleVariableRef CVarTrackSyncLoads(
+		TEXT("BE.TrackSyncLoads"),
+		bTrackSyncLoads,
+		TEXT("When enabled, records every synchronous load done through GetAsset/GetSubclass along with its call stack and duration (see BE.DumpSyncLoads). Can also be enabled with -TrackSyncLoads."),
+		ECVF_Default);
+}
+
 //////////////////////////////////////////////////////////////////////
 
 #define STARTUP_JOB_WEIGHTED(JobFunc, JobWeight) StartupJobs.Add(FBEAssetManagerStartupJob(#JobFunc, [this](const FBEAssetManagerStartupJob& StartupJob, TSharedPtr<FStreamableHandle>& LoadHandle){JobFunc;}, JobWeight))
 #define STARTUP_JOB(JobFunc) STARTUP_JOB_WEIGHTED(JobFunc, 1.f)
+#define STARTUP_JOB_WEIGHTED_AFTER(JobFunc, JobWeight, ...) StartupJobs.Add(FBEAssetManagerStartupJob(#JobFunc, [this](const FBEAssetManagerStartupJob& StartupJob, TSharedPtr<FStreamableHandle>& LoadHandle){JobFunc;}, JobWeight, { __VA_ARGS__ }))
+#define STARTUP_JOB_AFTER(JobFunc, ...) STARTUP_JOB_WEIGHTED_AFTER(JobFunc, 1.f, __VA_ARGS__)
 
 //////////////////////////////////////////////////////////////////////
 
@@ -61,13 +89,50 @@ UObject* UBEAssetManager::SynchronousLoadAsset(const FSoftObjectPath& AssetPath)
 			LogTimePtr = MakeUnique<FScopeLogTime>(*FString::Printf(TEXT("Synchronously loaded asset [%s]"), *AssetPath.ToString()), nullptr, FScopeLogTime::ScopeLog_Seconds);
 		}
 
+		FBEAssetManagerBootProfile& BootProfile = FBEAssetManagerBootProfile::Get();
+		const double LoadStartTime = BootProfile.IsRecording() ? FPlatformTime::Seconds() : 0.0;
+
+		// Capture the caller before loading, the stack walk is slow so it is only done while tracking
+		const bool bTrackSyncLoad = ShouldTrackSyncLoads();
+		FBESyncLoadRecord SyncLoadRecord;
+		if (bTrackSyncLoad)
+		{
+			const int32 StackBufferSize = 16 * 1024;
+			ANSICHAR StackBuffer[StackBufferSize];
+			StackBuffer[0] = 0;
+
+			// Skip this function and the stack walk itself
+			FPlatformStackWalk::StackWalkAndDump(StackBuffer, StackBufferSize, 2);
+
+			SyncLoadRecord.AssetPath = AssetPath;
+			SyncLoadRecord.FrameNumber = GFrameCounter;
+			SyncLoadRecord.CallStack = ANSI_TO_TCHAR(StackBuffer);
+			SyncLoadRecord.LoadSeconds = FPlatformTime::Seconds();
+		}
+
+		UObject* LoadedAsset = nullptr;
 		if (UAssetManager::IsValid())
 		{
-			return UAssetManager::GetStreamableManager().LoadSynchronous(AssetPath, false);
+			LoadedAsset = UAssetManager::GetStreamableManager().LoadSynchronous(AssetPath, false);
+		}
+		else
+		{
+			// Use LoadObject if asset manager isn't ready yet.
+			LoadedAsset = AssetPath.TryLoad();
+		}
+
+		if (BootProfile.IsRecording())
+		{
+			BootProfile.RecordSyncLoad(AssetPath, FPlatformTime::Seconds() - LoadStartTime);
+		}
+
+		if (bTrackSyncLoad && UAssetManager::IsValid())
+		{
+			SyncLoadRecord.LoadSeconds = FPlatformTime::Seconds() - SyncLoadRecord.LoadSeconds;
+			Get().AddSyncLoadRecord(MoveTemp(SyncLoadRecord));
 		}
 
-		// Use LoadObject if asset manager isn't ready yet.
-		return AssetPath.TryLoad();
+		return LoadedAsset;
 	}
 
 	return nullptr;
@@ -79,6 +144,20 @@ bool UBEAssetManager::ShouldLogAssetLoads()
 	return bLogAssetLoads;
 }
 
+bool UBEAssetManager::ShouldTrackSyncLoads()
+{
+	static bool bTrackSyncLoadsFromCommandLine = FParse::Param(FCommandLine::Get(), TEXT("TrackSyncLoads"));
+	return bTrackSyncLoadsFromCommandLine || BEConsoleVariables::bTrackSyncLoads;
+}
+
+void UBEAssetManager::AddSyncLoadRecord(FBESyncLoadRecord&& Record)
+{
+	UE_LOG(LogBE, Warning, TEXT("Synchronous load of [%s] blocked for %.2f ms on frame %llu"), *Record.AssetPath.ToString(), Record.LoadSeconds * 1000.0, Record.FrameNumber);
+
+	FScopeLock SyncLoadRecordsLock(&SyncLoadRecordsCritical);
+	SyncLoadRecords.Add(MoveTemp(Record));
+}
+
 void UBEAssetManager::AddLoadedAsset(const UObject* Asset)
 {
 	if (ensureAlways(Asset))
@@ -101,6 +180,88 @@ void UBEAssetManager::DumpLoadedAssets()
 	UE_LOG(LogBE, Log, TEXT("========== Finish Dumping Loaded Assets =========="));
 }
 
+void UBEAssetManager::GetGameFeatureBundlesForNetMode(ENetMode NetMode, TArray<FName>& OutBundles)
+{
+	const bool bLoadClient = GIsEditor || (NetMode != NM_DedicatedServer);
+	const bool bLoadServer = GIsEditor || (NetMode != NM_Client);
+
+	if (bLoadClient)
+	{
+		OutBundles.AddUnique(UGameFeaturesSubsystemSettings::LoadStateClient);
+	}
+
+	if (bLoadServer)
+	{
+		OutBundles.AddUnique(UGameFeaturesSubsystemSettings::LoadStateServer);
+	}
+}
+
+void UBEAssetManager::DumpSyncLoads()
+{
+	UBEAssetManager& AssetManager = Get();
+
+	TArray<FBESyncLoadRecord> Records;
+	{
+		FScopeLock SyncLoadRecordsLock(&AssetManager.SyncLoadRecordsCritical);
+		Records = AssetManager.SyncLoadRecords;
+	}
+
+	// Group by asset so repeated loads of the same asset show up together
+	struct FSyncLoadSummary
+	{
+		int32 Count = 0;
+		double TotalSeconds = 0.0;
+		int32 WorstRecordIndex = INDEX_NONE;
+	};
+
+	TMap<FSoftObjectPath, FSyncLoadSummary> Summaries;
+	double TotalSeconds = 0.0;
+	for (int32 RecordIndex = 0; RecordIndex < Records.Num(); ++RecordIndex)
+	{
+		const FBESyncLoadRecord& Record = Records[RecordIndex];
+
+		FSyncLoadSummary& Summary = Summaries.FindOrAdd(Record.AssetPath);
+		Summary.Count++;
+		Summary.TotalSeconds += Record.LoadSeconds;
+		if ((Summary.WorstRecordIndex == INDEX_NONE) || (Records[Summary.WorstRecordIndex].LoadSeconds < Record.LoadSeconds))
+		{
+			Summary.WorstRecordIndex = RecordIndex;
+		}
+
+		TotalSeconds += Record.LoadSeconds;
+	}
+
+	Summaries.ValueSort([](const FSyncLoadSummary& A, const FSyncLoadSummary& B) { return A.TotalSeconds > B.TotalSeconds; });
+
+	UE_LOG(LogBE, Log, TEXT("========== Start Dumping Sync Loads =========="));
+
+	for (const TPair<FSoftObjectPath, FSyncLoadSummary>& Pair : Summaries)
+	{
+		const FSyncLoadSummary& Summary = Pair.Value;
+		const FBESyncLoadRecord& WorstRecord = Records[Summary.WorstRecordIndex];
+
+		UE_LOG(LogBE, Log, TEXT("  %s: %d loads, %.2f ms total, worst %.2f ms on frame %llu"), *Pair.Key.ToString(), Summary.Count, Summary.TotalSeconds * 1000.0, WorstRecord.LoadSeconds * 1000.0, WorstRecord.FrameNumber);
+
+		TArray<FString> StackLines;
+		WorstRecord.CallStack.ParseIntoArrayLines(StackLines);
+		for (const FString& StackLine : StackLines)
+		{
+			UE_LOG(LogBE, Log, TEXT("      %s"), *StackLine);
+		}
+	}
+
+	UE_LOG(LogBE, Log, TEXT("... %d sync loads of %d assets, %.2f ms total"), Records.Num(), Summaries.Num(), TotalSeconds * 1000.0);
+	UE_LOG(LogBE, Log, TEXT("========== Finish Dumping Sync Loads =========="));
+}
+
+void UBEAssetManager::ResetSyncLoads()
+{
+	UBEAssetManager& AssetManager = Get();
+
+	FScopeLock SyncLoadRecordsLock(&AssetManager.SyncLoadRecordsCritical);
+	AssetManager.SyncLoadRecords.Reset();
+}
+
 void UBEAssetManager::StartInitialLoading()
 {
 	SCOPED_BOOT_TIMING("UBEAssetManager::StartInitialLoading");
@@ -108,14 +269,14 @@ void UBEAssetManager::StartInitialLoading()
 	// This does all of the scanning, need to do this now even if loads are deferred
 	Super::StartInitialLoading();
 
-	STARTUP_JOB(InitializeAbilitySystem());
-	STARTUP_JOB(InitializeGameplayCueManager());
-
 	{
-		// Load base game data asset
-		STARTUP_JOB_WEIGHTED(GetGameData(), 25.f);
+		// Load base game data asset, started first so it streams in while the other jobs run
+		STARTUP_JOB_WEIGHTED(StartLoadingGameData(LoadHandle), 25.f);
 	}
 
+	STARTUP_JOB(InitializeAbilitySystem());
+	STARTUP_JOB_AFTER(InitializeGameplayCueManager(), TEXT("InitializeAbilitySystem()"));
+
 	// Run all the queued up startup jobs
 	DoAllStartupJobs();
 }
@@ -137,6 +298,11 @@ void UBEAssetManager::InitializeGameplayCueManager()
 }
 
 
+void UBEAssetManager::StartLoadingGameData(TSharedPtr<FStreamableHandle>& OutLoadHandle)
+{
+	OutLoadHandle = StartLoadingTypedGameData<UBEGameData>(BEGameDataPath);
+}
+
 const UBEGameData& UBEAssetManager::GetGameData()
 {
 	return GetOrLoadTypedGameData<UBEGameData>(BEGameDataPath);
@@ -163,8 +329,18 @@ UPrimaryDataAsset* UBEAssetManager::LoadGameDataOfClass(TSubclassOf<UPrimaryData
 		UE_LOG(LogBE, Log, TEXT("Loading GameData: %s ..."), *DataClassPath.ToString());
 		SCOPE_LOG_TIME_IN_SECONDS(TEXT("    ... GameData loaded!"), nullptr);
 
+		if (const TSharedPtr<FStreamableHandle>* PendingHandle = PendingGameDataLoads.Find(DataClass))
+		{
+			// A startup job already started loading this, finish it now
+			const TSharedPtr<FStreamableHandle> Handle = *PendingHandle;
+			Handle->WaitUntilComplete(0.0f, false);
+
+			OnGameDataLoaded(DataClass, DataClassPath, PrimaryAssetType);
+
+			return GameDataMap.FindRef(DataClass);
+		}
 		// This can be called recursively in the editor because it is called on demand from PostLoad so force a sync load for primary asset and async load the rest in that case
-		if (GIsEditor)
+		else if (GIsEditor)
 		{
 			Asset = DataClassPath.LoadSynchronous();
 			LoadPrimaryAssetsWithType(PrimaryAssetType);
@@ -195,60 +371,236 @@ UPrimaryDataAsset* UBEAssetManager::LoadGameDataOfClass(TSubclassOf<UPrimaryData
 	return Asset;
 }
 
+TSharedPtr<FStreamableHandle> UBEAssetManager::StartLoadingGameDataOfClass(TSubclassOf<UPrimaryDataAsset> DataClass, const TSoftObjectPtr<UPrimaryDataAsset>& DataClassPath, FPrimaryAssetType PrimaryAssetType)
+{
+	if (const TSharedPtr<FStreamableHandle>* PendingHandle = PendingGameDataLoads.Find(DataClass))
+	{
+		return *PendingHandle;
+	}
+
+	// The editor needs the sync path (see LoadGameDataOfClass), and failures are handled there as well
+	if (GIsEditor || DataClassPath.IsNull())
+	{
+		LoadGameDataOfClass(DataClass, DataClassPath, PrimaryAssetType);
+		return nullptr;
+	}
+
+	UE_LOG(LogBE, Log, TEXT("Async loading GameData: %s ..."), *DataClassPath.ToString());
+
+	TSharedPtr<FStreamableHandle> Handle = LoadPrimaryAssetsWithType(PrimaryAssetType, TArray<FName>(), FStreamableDelegate(), FStreamableManager::AsyncLoadHighPriority);
+	if (!Handle.IsValid() || Handle->HasLoadCompleted())
+	{
+		if (Handle.IsValid())
+		{
+			PendingGameDataLoads.Add(DataClass, Handle);
+		}
+
+		OnGameDataLoaded(DataClass, DataClassPath, PrimaryAssetType);
+		return nullptr;
+	}
+
+	PendingGameDataLoads.Add(DataClass, Handle);
+	Handle->BindCompleteDelegate(FStreamableDelegate::CreateUObject(this, &ThisClass::OnGameDataLoaded, DataClass, DataClassPath, PrimaryAssetType));
+
+	return Handle;
+}
+
+void UBEAssetManager::OnGameDataLoaded(TSubclassOf<UPrimaryDataAsset> DataClass, TSoftObjectPtr<UPrimaryDataAsset> DataClassPath, FPrimaryAssetType PrimaryAssetType)
+{
+	TSharedPtr<FStreamableHandle> Handle;
+	PendingGameDataLoads.RemoveAndCopyValue(DataClass, Handle);
+
+	// May have already been finished by a blocking LoadGameDataOfClass before the completion delegate fired
+	if (GameDataMap.Contains(DataClass))
+	{
+		return;
+	}
+
+	UPrimaryDataAsset* Asset = Handle.IsValid() ? Cast<UPrimaryDataAsset>(Handle->GetLoadedAsset()) : nullptr;
+	if (Asset)
+	{
+		UE_LOG(LogBE, Log, TEXT("    ... GameData %s loaded!"), *DataClassPath.ToString());
+
+		GameDataMap.Add(DataClass, Asset);
+	}
+	else
+	{
+		// It is not acceptable to fail to load any GameData asset. It will result in soft failures that are hard to diagnose.
+		UE_LOG(LogBE, Fatal, TEXT("Failed to load GameData asset at %s. Type %s. This is not recoverable and likely means you do not have the correct data to run %s."), *DataClassPath.ToString(), *PrimaryAssetType.ToString(), FApp::GetProjectName());
+	}
+}
+
 
 void UBEAssetManager::DoAllStartupJobs()
 {
 	SCOPED_BOOT_TIMING("UBEAssetManager::DoAllStartupJobs");
 	const double AllStartupJobsStartTime = FPlatformTime::Seconds();
 
-	if (IsRunningDedicatedServer())
+	FBEAssetManagerBootProfile::Get().BeginBoot();
+
+	const int32 NumJobs = StartupJobs.Num();
+
+	TMap<FString, int32> JobIndexByName;
+	for (int32 JobIndex = 0; JobIndex < NumJobs; ++JobIndex)
+	{
+		JobIndexByName.Add(StartupJobs[JobIndex].JobName, JobIndex);
+	}
+
+	// Resolve dependencies up front so a typo shows up immediately rather than as a job that never runs
+	TArray<TArray<int32>> JobDependencies;
+	JobDependencies.SetNum(NumJobs);
+	for (int32 JobIndex = 0; JobIndex < NumJobs; ++JobIndex)
 	{
-		// No need for periodic progress updates, just run the jobs
-		for (const FBEAssetManagerStartupJob& StartupJob : StartupJobs)
+		for (const FString& DependencyName : StartupJobs[JobIndex].Dependencies)
 		{
-			StartupJob.DoJob();
+			if (const int32* DependencyIndex = JobIndexByName.Find(DependencyName))
+			{
+				JobDependencies[JobIndex].Add(*DependencyIndex);
+			}
+			else
+			{
+				UE_LOG(LogBE, Error, TEXT("Startup job \"%s\" depends on unknown job \"%s\", ignoring the dependency"), *StartupJobs[JobIndex].JobName, *DependencyName);
+			}
 		}
 	}
-	else
+
+	enum class EJobState : uint8
+	{
+		Pending,
+		Loading,
+		Complete
+	};
+
+	TArray<EJobState> JobStates;
+	JobStates.Init(EJobState::Pending, NumJobs);
+
+	TArray<TSharedPtr<FStreamableHandle>> JobHandles;
+	JobHandles.SetNum(NumJobs);
+
+	// Progress is tracked per job since async loads of several jobs can be in flight at once
+	const bool bReportProgress = !IsRunningDedicatedServer();
+
+	float TotalJobValue = 0.0f;
+	for (const FBEAssetManagerStartupJob& StartupJob : StartupJobs)
+	{
+		TotalJobValue += StartupJob.JobWeight;
+	}
+
+	TArray<float> JobProgress;
+	JobProgress.Init(0.0f, NumJobs);
+
+	auto ReportProgress = [this, &JobProgress, TotalJobValue]()
 	{
-		if (StartupJobs.Num() > 0)
+		float AccumulatedJobValue = 0.0f;
+		for (int32 JobIndex = 0; JobIndex < JobProgress.Num(); ++JobIndex)
+		{
+			AccumulatedJobValue += JobProgress[JobIndex] * StartupJobs[JobIndex].JobWeight;
+		}
+
+		UpdateInitialGameContentLoadPercent(TotalJobValue > 0.0f ? AccumulatedJobValue / TotalJobValue : 1.0f);
+	};
+
+	auto CompleteJob = [&](int32 JobIndex)
+	{
+		StartupJobs[JobIndex].SubstepProgressDelegate.Unbind();
+		JobStates[JobIndex] = EJobState::Complete;
+		JobHandles[JobIndex].Reset();
+
+		if (bReportProgress)
 		{
-			float TotalJobValue = 0.0f;
-			for (const FBEAssetManagerStartupJob& StartupJob : StartupJobs)
+			JobProgress[JobIndex] = 1.0f;
+			ReportProgress();
+		}
+	};
+
+	auto IsHandleDone = [](const TSharedPtr<FStreamableHandle>& Handle)
+	{
+		return !Handle.IsValid() || Handle->HasLoadCompleted() || Handle->WasCanceled();
+	};
+
+	int32 NumCompleted = 0;
+	while (NumCompleted < NumJobs)
+	{
+		// Retire any loads that finished while other jobs were running
+		for (int32 JobIndex = 0; JobIndex < NumJobs; ++JobIndex)
+		{
+			if ((JobStates[JobIndex] == EJobState::Loading) && IsHandleDone(JobHandles[JobIndex]))
 			{
-				TotalJobValue += StartupJob.JobWeight;
+				StartupJobs[JobIndex].OnJobComplete(JobHandles[JobIndex]);
+				CompleteJob(JobIndex);
+				++NumCompleted;
 			}
+		}
 
-			float AccumulatedJobValue = 0.0f;
-			for (FBEAssetManagerStartupJob& StartupJob : StartupJobs)
+		// Start every job whose dependencies are satisfied, in the order they were added
+		bool bStartedAnyJob = false;
+		for (int32 JobIndex = 0; JobIndex < NumJobs; ++JobIndex)
+		{
+			if (JobStates[JobIndex] != EJobState::Pending)
 			{
-				const float JobValue = StartupJob.JobWeight;
-				StartupJob.SubstepProgressDelegate.BindLambda([This = this, AccumulatedJobValue, JobValue, TotalJobValue](float NewProgress)
-				{
-					const float SubstepAdjustment = FMath::Clamp(NewProgress, 0.0f, 1.0f) * JobValue;
-					const float OverallPercentWithSubstep = (AccumulatedJobValue + SubstepAdjustment) / TotalJobValue;
+				continue;
+			}
 
-					This->UpdateInitialGameContentLoadPercent(OverallPercentWithSubstep);
-				});
+			const bool bDependenciesComplete = Algo::AllOf(JobDependencies[JobIndex], [&JobStates](int32 DependencyIndex)
+			{
+				return JobStates[DependencyIndex] == EJobState::Complete;
+			});
 
-				StartupJob.DoJob();
+			if (!bDependenciesComplete)
+			{
+				continue;
+			}
 
-				StartupJob.SubstepProgressDelegate.Unbind();
+			FBEAssetManagerStartupJob& StartupJob = StartupJobs[JobIndex];
+			if (bReportProgress)
+			{
+				StartupJob.SubstepProgressDelegate.BindLambda([&JobProgress, &ReportProgress, JobIndex](float NewProgress)
+				{
+					JobProgress[JobIndex] = FMath::Clamp(NewProgress, 0.0f, 1.0f);
+					ReportProgress();
+				});
+			}
 
-				AccumulatedJobValue += JobValue;
+			bStartedAnyJob = true;
 
-				UpdateInitialGameContentLoadPercent(AccumulatedJobValue / TotalJobValue);
+			JobHandles[JobIndex] = StartupJob.DoJob();
+			if (JobHandles[JobIndex].IsValid())
+			{
+				JobStates[JobIndex] = EJobState::Loading;
+			}
+			else
+			{
+				CompleteJob(JobIndex);
+				++NumCompleted;
 			}
 		}
-		else
+
+		if (bStartedAnyJob || (NumCompleted == NumJobs))
+		{
+			continue;
+		}
+
+		// Nothing else can start, block on the oldest outstanding load (the others keep streaming meanwhile)
+		const int32 LoadingJobIndex = JobStates.IndexOfByKey(EJobState::Loading);
+		if (LoadingJobIndex == INDEX_NONE)
 		{
-			UpdateInitialGameContentLoadPercent(1.0f);
+			UE_LOG(LogBE, Error, TEXT("Startup jobs have a dependency cycle, %d jobs were not run"), NumJobs - NumCompleted);
+			break;
 		}
+
+		JobHandles[LoadingJobIndex]->WaitUntilComplete(0.0f, false);
+	}
+
+	if (bReportProgress && (NumJobs == 0))
+	{
+		UpdateInitialGameContentLoadPercent(1.0f);
 	}
 
 	StartupJobs.Empty();
 
 	UE_LOG(LogBE, Display, TEXT("All startup jobs took %.2f seconds to complete"), FPlatformTime::Seconds() - AllStartupJobsStartTime);
+
+	FBEAssetManagerBootProfile::Get().EndBoot();
 }
 
 void UBEAssetManager::UpdateInitialGameContentLoadPercent(float GameContentPercent)
@@ -21,6 +21,23 @@ struct FBEBundles
 
 ////////////////////////////////////////////////////////////
 
+/** A synchronous load done through GetAsset/GetSubclass while sync load tracking was enabled */
+struct FBESyncLoadRecord
+{
+	FSoftObjectPath AssetPath;
+
+	// Time the game thread was blocked by the load
+	double LoadSeconds = 0.0;
+
+	// Frame the load happened on
+	uint64 FrameNumber = 0;
+
+	// Human readable call stack of the caller
+	FString CallStack;
+};
+
+////////////////////////////////////////////////////////////
+
 /**
  * UBEAssetManager
  *
@@ -48,9 +65,26 @@ public:
 	template<typename AssetType>
 	static TSubclassOf<AssetType> GetSubclass(const TSoftClassPtr<AssetType>& AssetPointer, bool bKeepInMemory = true);
 
+	// Async version of GetAsset. Calls the callback immediately if the asset is already loaded, otherwise once the async load completes (with nullptr on failure).
+	template<typename AssetType>
+	static TSharedPtr<FStreamableHandle> GetAssetAsync(const TSoftObjectPtr<AssetType>& AssetPointer, TFunction<void(AssetType*)>&& Callback, bool bKeepInMemory = true);
+
+	// Async version of GetSubclass. Calls the callback immediately if the class is already loaded, otherwise once the async load completes (with nullptr on failure).
+	template<typename AssetType>
+	static TSharedPtr<FStreamableHandle> GetSubclassAsync(const TSoftClassPtr<AssetType>& AssetPointer, TFunction<void(TSubclassOf<AssetType>)>&& Callback, bool bKeepInMemory = true);
+
 	// Logs all assets currently loaded and tracked by the asset manager.
 	static void DumpLoadedAssets();
 
+	// Logs all synchronous loads recorded while sync load tracking was enabled, worst offenders first.
+	static void DumpSyncLoads();
+
+	// Clears the recorded synchronous loads.
+	static void ResetSyncLoads();
+
+	// Adds the game feature client/server bundle states that should be loaded for the given net mode.
+	static void GetGameFeatureBundlesForNetMode(ENetMode NetMode, TArray<FName>& OutBundles);
+
 	const UBEGameData& GetGameData();
 	const UBEPawnData* GetDefaultPawnData() const;
 
@@ -67,9 +101,25 @@ protected:
 		return *CastChecked<const GameDataClass>(LoadGameDataOfClass(GameDataClass::StaticClass(), DataPath, GameDataClass::StaticClass()->GetFName()));
 	}
 
+	template <typename GameDataClass>
+	TSharedPtr<FStreamableHandle> StartLoadingTypedGameData(const TSoftObjectPtr<GameDataClass>& DataPath)
+	{
+		if (GameDataMap.Contains(GameDataClass::StaticClass()))
+		{
+			return nullptr;
+		}
+
+		// Starts an async load, the game data is added to GameDataMap once it completes
+		return StartLoadingGameDataOfClass(GameDataClass::StaticClass(), DataPath, GameDataClass::StaticClass()->GetFName());
+	}
+
 
 	static UObject* SynchronousLoadAsset(const FSoftObjectPath& AssetPath);
 	static bool ShouldLogAssetLoads();
+	static bool ShouldTrackSyncLoads();
+
+	// Thread safe way of recording a synchronous load for DumpSyncLoads.
+	void AddSyncLoadRecord(FBESyncLoadRecord&& Record);
 
 	// Thread safe way of adding a loaded asset to keep in memory.
 	void AddLoadedAsset(const UObject* Asset);
@@ -82,6 +132,8 @@ protected:
 	//~End of UAssetManager interface
 
 	UPrimaryDataAsset* LoadGameDataOfClass(TSubclassOf<UPrimaryDataAsset> DataClass, const TSoftObjectPtr<UPrimaryDataAsset>& DataClassPath, FPrimaryAssetType PrimaryAssetType);
+	TSharedPtr<FStreamableHandle> StartLoadingGameDataOfClass(TSubclassOf<UPrimaryDataAsset> DataClass, const TSoftObjectPtr<UPrimaryDataAsset>& DataClassPath, FPrimaryAssetType PrimaryAssetType);
+	void OnGameDataLoaded(TSubclassOf<UPrimaryDataAsset> DataClass, TSoftObjectPtr<UPrimaryDataAsset> DataClassPath, FPrimaryAssetType PrimaryAssetType);
 
 protected:
 
@@ -93,18 +145,24 @@ protected:
 	UPROPERTY(Transient)
 		TMap<TObjectPtr<UClass>, TObjectPtr<UPrimaryDataAsset>> GameDataMap;
 
+	// Game data that is still being loaded asynchronously
+	TMap<TObjectPtr<UClass>, TSharedPtr<FStreamableHandle>> PendingGameDataLoads;
+
 	// Pawn data used when spawning player pawns if there isn't one set on the player state.
 	UPROPERTY(Config)
 		TSoftObjectPtr<UBEPawnData> DefaultPawnData;
 
 private:
-	// Flushes the StartupJobs array. Processes all startup work.
+	// Flushes the StartupJobs array. Processes all startup work, overlapping async loads with jobs that do not depend on them.
 	void DoAllStartupJobs();
 
 	// Sets up the ability system
 	void InitializeAbilitySystem();
 	void InitializeGameplayCueManager();
 
+	// Starts streaming in the base game data asset
+	void StartLoadingGameData(TSharedPtr<FStreamableHandle>& OutLoadHandle);
+
 	// Called periodically during loads, could be used to feed the status to a loading screen
 	void UpdateInitialGameContentLoadPercent(float GameContentPercent);
 
@@ -119,6 +177,12 @@ private:
 
 	// Used for a scope lock when modifying the list of load assets.
 	FCriticalSection LoadedAssetsCritical;
+
+	// Synchronous loads recorded while sync load tracking was enabled.
+	TArray<FBESyncLoadRecord> SyncLoadRecords;
+
+	// Used for a scope lock when modifying the list of sync load records.
+	FCriticalSection SyncLoadRecordsCritical;
 };
 
 
@@ -173,3 +237,79 @@ TSubclassOf<AssetType> UBEAssetManager::GetSubclass(const TSoftClassPtr<AssetTyp
 
 	return LoadedSubclass;
 }
+
+template<typename AssetType>
+TSharedPtr<FStreamableHandle> UBEAssetManager::GetAssetAsync(const TSoftObjectPtr<AssetType>& AssetPointer, TFunction<void(AssetType*)>&& Callback, bool bKeepInMemory)
+{
+	const FSoftObjectPath& AssetPath = AssetPointer.ToSoftObjectPath();
+
+	if (!AssetPath.IsValid())
+	{
+		Callback(nullptr);
+		return nullptr;
+	}
+
+	if (AssetType* LoadedAsset = AssetPointer.Get())
+	{
+		if (bKeepInMemory)
+		{
+			// Added to loaded asset list.
+			Get().AddLoadedAsset(Cast<UObject>(LoadedAsset));
+		}
+
+		Callback(LoadedAsset);
+		return nullptr;
+	}
+
+	return Get().GetStreamableManager().RequestAsyncLoad(AssetPath, FStreamableDelegate::CreateLambda([AssetPointer, Callback = MoveTemp(Callback), bKeepInMemory]()
+	{
+		AssetType* LoadedAsset = AssetPointer.Get();
+		ensureAlwaysMsgf(LoadedAsset, TEXT("Failed to async load asset [%s]"), *AssetPointer.ToString());
+
+		if (LoadedAsset && bKeepInMemory)
+		{
+			// Added to loaded asset list.
+			Get().AddLoadedAsset(Cast<UObject>(LoadedAsset));
+		}
+
+		Callback(LoadedAsset);
+	}));
+}
+
+template<typename AssetType>
+TSharedPtr<FStreamableHandle> UBEAssetManager::GetSubclassAsync(const TSoftClassPtr<AssetType>& AssetPointer, TFunction<void(TSubclassOf<AssetType>)>&& Callback, bool bKeepInMemory)
+{
+	const FSoftObjectPath& AssetPath = AssetPointer.ToSoftObjectPath();
+
+	if (!AssetPath.IsValid())
+	{
+		Callback(nullptr);
+		return nullptr;
+	}
+
+	if (TSubclassOf<AssetType> LoadedSubclass = AssetPointer.Get())
+	{
+		if (bKeepInMemory)
+		{
+			// Added to loaded asset list.
+			Get().AddLoadedAsset(Cast<UObject>(LoadedSubclass));
+		}
+
+		Callback(LoadedSubclass);
+		return nullptr;
+	}
+
+	return Get().GetStreamableManager().RequestAsyncLoad(AssetPath, FStreamableDelegate::CreateLambda([AssetPointer, Callback = MoveTemp(Callback), bKeepInMemory]()
+	{
+		TSubclassOf<AssetType> LoadedSubclass = AssetPointer.Get();
+		ensureAlwaysMsgf(LoadedSubclass, TEXT("Failed to async load asset class [%s]"), *AssetPointer.ToString());
+
+		if (LoadedSubclass && bKeepInMemory)
+		{
+			// Added to loaded asset list.
+			Get().AddLoadedAsset(Cast<UObject>(LoadedSubclass));
+		}
+
+		Callback(LoadedSubclass);
+	}));
+}
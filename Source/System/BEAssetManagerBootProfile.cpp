@@ -0,0 +1,263 @@
+// Copyright Eigi Chin
+
+#include "BEAssetManagerBootProfile.h"
+
+#include "BELogChannels.h"
+
+#include "CoreGlobals.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectIterator.h"
+
+
+//////////////////////////////////////////////////////////////////////
+
+namespace BEBootProfile
+{
+	// Returns the number of bytes the process has read so far, or 0 if the platform doesn't expose it
+	static int64 GetProcessBytesRead()
+	{
+#if PLATFORM_LINUX
+		// rchar counts every read() the process did, including page cache hits, which is what boot time depends on
+		FString IOStats;
+		if (FFileHelper::LoadFileToString(IOStats, TEXT("/proc/self/io")))
+		{
+			int64 BytesRead = 0;
+			if (FParse::Value(*IOStats, TEXT("rchar:"), BytesRead))
+			{
+				return BytesRead;
+			}
+		}
+#endif
+		return 0;
+	}
+
+	static int32 GetNumLoadedPackages()
+	{
+		int32 NumPackages = 0;
+		for (TObjectIterator<UPackage> It; It; ++It)
+		{
+			++NumPackages;
+		}
+		return NumPackages;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////
+
+FBEAssetManagerBootProfile& FBEAssetManagerBootProfile::Get()
+{
+	static FBEAssetManagerBootProfile Profile;
+	return Profile;
+}
+
+FBEAssetManagerBootProfile::FBEAssetManagerBootProfile()
+{
+	const TCHAR* CommandLine = FCommandLine::Get();
+
+	FString PathFromCommandLine;
+	if (FParse::Value(CommandLine, TEXT("BootProfile="), PathFromCommandLine))
+	{
+		bEnabled = true;
+		OutputPath = PathFromCommandLine;
+	}
+	else if (FParse::Param(CommandLine, TEXT("BootProfile")))
+	{
+		bEnabled = true;
+		OutputPath = FPaths::ProfilingDir() / TEXT("BootProfile.json");
+	}
+
+	FParse::Value(CommandLine, TEXT("BootProfileMaxSeconds="), MaxSeconds);
+	FParse::Value(CommandLine, TEXT("BootProfileMaxSyncLoads="), MaxSyncLoads);
+	bExitWhenDone = FParse::Param(CommandLine, TEXT("BootProfileExit"));
+}
+
+FBEAssetManagerBootProfile::FCounters FBEAssetManagerBootProfile::SampleCounters() const
+{
+	FCounters Counters;
+	Counters.Packages = BEBootProfile::GetNumLoadedPackages();
+	Counters.BytesRead = BEBootProfile::GetProcessBytesRead();
+	Counters.SyncLoads = SyncLoads.Num();
+	return Counters;
+}
+
+void FBEAssetManagerBootProfile::BeginBoot()
+{
+	if (!bEnabled)
+	{
+		return;
+	}
+
+	bRecording = true;
+	Jobs.Reset();
+	JobStartCounters.Reset();
+	SyncLoads.Reset();
+	CurrentJobName.Reset();
+
+	BootStartTime = FPlatformTime::Seconds();
+	BootStartCounters = SampleCounters();
+}
+
+void FBEAssetManagerBootProfile::BeginJob(const FString& JobName)
+{
+	if (!bRecording)
+	{
+		return;
+	}
+
+	FBEStartupJobProfile& Job = Jobs.AddDefaulted_GetRef();
+	Job.JobName = JobName;
+	Job.StartSeconds = FPlatformTime::Seconds() - BootStartTime;
+
+	JobStartCounters.Add(SampleCounters());
+
+	CurrentJobName = JobName;
+}
+
+void FBEAssetManagerBootProfile::ClearCurrentJob()
+{
+	CurrentJobName.Reset();
+}
+
+void FBEAssetManagerBootProfile::EndJob(const FString& JobName)
+{
+	if (!bRecording)
+	{
+		return;
+	}
+
+	const int32 JobIndex = Jobs.IndexOfByPredicate([&JobName](const FBEStartupJobProfile& Job) { return Job.JobName == JobName; });
+	if (JobIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	const FCounters EndCounters = SampleCounters();
+	const FCounters& StartCounters = JobStartCounters[JobIndex];
+
+	FBEStartupJobProfile& Job = Jobs[JobIndex];
+	Job.WallSeconds = (FPlatformTime::Seconds() - BootStartTime) - Job.StartSeconds;
+	Job.PackagesLoaded = EndCounters.Packages - StartCounters.Packages;
+	Job.BytesRead = EndCounters.BytesRead - StartCounters.BytesRead;
+	Job.SyncLoads = EndCounters.SyncLoads - StartCounters.SyncLoads;
+}
+
+void FBEAssetManagerBootProfile::RecordSyncLoad(const FSoftObjectPath& AssetPath, double Seconds)
+{
+	if (!bRecording)
+	{
+		return;
+	}
+
+	FBEBootSyncLoad& SyncLoad = SyncLoads.AddDefaulted_GetRef();
+	SyncLoad.AssetPath = AssetPath;
+	SyncLoad.Seconds = Seconds;
+	SyncLoad.JobName = CurrentJobName;
+}
+
+void FBEAssetManagerBootProfile::EndBoot()
+{
+	if (!bRecording)
+	{
+		return;
+	}
+
+	bRecording = false;
+
+	const double TotalSeconds = FPlatformTime::Seconds() - BootStartTime;
+	const bool bPassed = CheckThresholds(TotalSeconds);
+
+	WriteProfile(TotalSeconds, bPassed);
+
+	if (bExitWhenDone)
+	{
+		UE_LOG(LogBE, Display, TEXT("Boot profile complete (%s), exiting as requested by -BootProfileExit"), bPassed ? TEXT("passed") : TEXT("failed"));
+		FPlatformMisc::RequestExitWithStatus(false, bPassed ? 0 : 1);
+	}
+}
+
+bool FBEAssetManagerBootProfile::CheckThresholds(double TotalSeconds) const
+{
+	bool bPassed = true;
+
+	if ((MaxSeconds > 0.0) && (TotalSeconds > MaxSeconds))
+	{
+		UE_LOG(LogBE, Error, TEXT("Boot profile: startup jobs took %.2f seconds, exceeding the limit of %.2f seconds"), TotalSeconds, MaxSeconds);
+		bPassed = false;
+	}
+
+	if ((MaxSyncLoads >= 0) && (SyncLoads.Num() > MaxSyncLoads))
+	{
+		UE_LOG(LogBE, Error, TEXT("Boot profile: %d synchronous loads during boot, exceeding the limit of %d"), SyncLoads.Num(), MaxSyncLoads);
+		for (const FBEBootSyncLoad& SyncLoad : SyncLoads)
+		{
+			UE_LOG(LogBE, Error, TEXT("    %s (%.3f seconds, job \"%s\")"), *SyncLoad.AssetPath.ToString(), SyncLoad.Seconds, *SyncLoad.JobName);
+		}
+		bPassed = false;
+	}
+
+	return bPassed;
+}
+
+void FBEAssetManagerBootProfile::WriteProfile(double TotalSeconds, bool bPassed) const
+{
+	const FCounters EndCounters = SampleCounters();
+
+	TSharedRef<FJsonObject> RootObject = MakeShared<FJsonObject>();
+	RootObject->SetStringField(TEXT("project"), FApp::GetProjectName());
+	RootObject->SetBoolField(TEXT("dedicatedServer"), IsRunningDedicatedServer());
+	RootObject->SetNumberField(TEXT("totalSeconds"), TotalSeconds);
+	RootObject->SetNumberField(TEXT("packagesLoaded"), EndCounters.Packages - BootStartCounters.Packages);
+	RootObject->SetNumberField(TEXT("bytesRead"), static_cast<double>(EndCounters.BytesRead - BootStartCounters.BytesRead));
+	RootObject->SetNumberField(TEXT("syncLoads"), SyncLoads.Num());
+	RootObject->SetBoolField(TEXT("passed"), bPassed);
+
+	TArray<TSharedPtr<FJsonValue>> JobValues;
+	for (const FBEStartupJobProfile& Job : Jobs)
+	{
+		TSharedRef<FJsonObject> JobObject = MakeShared<FJsonObject>();
+		JobObject->SetStringField(TEXT("name"), Job.JobName);
+		JobObject->SetNumberField(TEXT("startSeconds"), Job.StartSeconds);
+		JobObject->SetNumberField(TEXT("wallSeconds"), Job.WallSeconds);
+		JobObject->SetNumberField(TEXT("packagesLoaded"), Job.PackagesLoaded);
+		JobObject->SetNumberField(TEXT("bytesRead"), static_cast<double>(Job.BytesRead));
+		JobObject->SetNumberField(TEXT("syncLoads"), Job.SyncLoads);
+		JobValues.Add(MakeShared<FJsonValueObject>(JobObject));
+	}
+	RootObject->SetArrayField(TEXT("jobs"), JobValues);
+
+	TArray<TSharedPtr<FJsonValue>> SyncLoadValues;
+	for (const FBEBootSyncLoad& SyncLoad : SyncLoads)
+	{
+		TSharedRef<FJsonObject> SyncLoadObject = MakeShared<FJsonObject>();
+		SyncLoadObject->SetStringField(TEXT("asset"), SyncLoad.AssetPath.ToString());
+		SyncLoadObject->SetNumberField(TEXT("seconds"), SyncLoad.Seconds);
+		SyncLoadObject->SetStringField(TEXT("job"), SyncLoad.JobName);
+		SyncLoadValues.Add(MakeShared<FJsonValueObject>(SyncLoadObject));
+	}
+	RootObject->SetArrayField(TEXT("syncLoadList"), SyncLoadValues);
+
+	FString JsonString;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonString);
+	FJsonSerializer::Serialize(RootObject, Writer);
+
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(OutputPath), true);
+
+	if (FFileHelper::SaveStringToFile(JsonString, *OutputPath))
+	{
+		UE_LOG(LogBE, Display, TEXT("Boot profile written to %s"), *IFileManager::Get().ConvertToAbsolutePathForExternalAppForWrite(*OutputPath));
+	}
+	else
+	{
+		UE_LOG(LogBE, Error, TEXT("Failed to write boot profile to %s"), *OutputPath);
+	}
+}
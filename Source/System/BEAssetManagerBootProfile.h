@@ -0,0 +1,100 @@
+// Copyright Eigi Chin
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/UnrealString.h"
+#include "UObject/SoftObjectPath.h"
+
+
+/** Measurements of a single startup job */
+struct FBEStartupJobProfile
+{
+	FString JobName;
+
+	// Seconds since the start of the boot profile
+	double StartSeconds = 0.0;
+
+	// Wall time from job start until the job and its async load completed
+	double WallSeconds = 0.0;
+
+	// Packages that finished loading while the job was running (concurrent jobs share these counts)
+	int32 PackagesLoaded = 0;
+
+	// Bytes read by the process while the job was running (only available on platforms exposing process IO counters)
+	int64 BytesRead = 0;
+
+	// Synchronous loads done through UBEAssetManager while the job was running
+	int32 SyncLoads = 0;
+};
+
+/** A synchronous load done through UBEAssetManager during boot */
+struct FBEBootSyncLoad
+{
+	FSoftObjectPath AssetPath;
+	double Seconds = 0.0;
+	FString JobName;
+};
+
+/**
+ * FBEAssetManagerBootProfile
+ *
+ *	Records a structured profile of the asset manager startup jobs and writes it as JSON.
+ *
+ *	-BootProfile[=Path]				Enables the profile, written to Saved/Profiling/BootProfile.json by default.
+ *	-BootProfileMaxSeconds=N		Fails the profile if all startup jobs take longer than N seconds.
+ *	-BootProfileMaxSyncLoads=N		Fails the profile if more than N synchronous loads were done during boot.
+ *	-BootProfileExit				Exits once the profile is written, with a non-zero exit code if it failed.
+ */
+class FBEAssetManagerBootProfile
+{
+public:
+	static FBEAssetManagerBootProfile& Get();
+
+	bool IsEnabled() const { return bEnabled; }
+	bool IsRecording() const { return bRecording; }
+
+	void BeginBoot();
+	void EndBoot();
+
+	// Starts measuring a job, sync loads are attributed to it until ClearCurrentJob is called
+	void BeginJob(const FString& JobName);
+	void ClearCurrentJob();
+	void EndJob(const FString& JobName);
+
+	void RecordSyncLoad(const FSoftObjectPath& AssetPath, double Seconds);
+
+private:
+	FBEAssetManagerBootProfile();
+
+	struct FCounters
+	{
+		int32 Packages = 0;
+		int64 BytesRead = 0;
+		int32 SyncLoads = 0;
+	};
+
+	FCounters SampleCounters() const;
+
+	bool CheckThresholds(double TotalSeconds) const;
+	void WriteProfile(double TotalSeconds, bool bPassed) const;
+
+private:
+	bool bEnabled = false;
+	bool bRecording = false;
+
+	double BootStartTime = 0.0;
+	FCounters BootStartCounters;
+
+	// Job currently running its synchronous part, sync loads are attributed to it
+	FString CurrentJobName;
+
+	TArray<FBEStartupJobProfile> Jobs;
+	TArray<FCounters> JobStartCounters;
+	TArray<FBEBootSyncLoad> SyncLoads;
+
+	FString OutputPath;
+	double MaxSeconds = 0.0;
+	int32 MaxSyncLoads = INDEX_NONE;
+	bool bExitWhenDone = false;
+};
@@ -3,6 +3,7 @@
 
 #include "BEAssetManagerStartupJob.h"
 
+#include "BEAssetManagerBootProfile.h"
 #include "BELogChannels.h"
 
 #include "HAL/Platform.h"
@@ -13,20 +14,39 @@
 
 TSharedPtr<FStreamableHandle> FBEAssetManagerStartupJob::DoJob() const
 {
-	const double JobStartTime = FPlatformTime::Seconds();
+	StartTime = FPlatformTime::Seconds();
 
 	TSharedPtr<FStreamableHandle> Handle;
 	UE_LOG(LogBE, Display, TEXT("Startup job \"%s\" starting"), *JobName);
+
+	FBEAssetManagerBootProfile& BootProfile = FBEAssetManagerBootProfile::Get();
+	BootProfile.BeginJob(JobName);
 	JobFunc(*this, Handle);
+	BootProfile.ClearCurrentJob();
 
-	if (Handle.IsValid())
+	if (Handle.IsValid() && !Handle->HasLoadCompleted())
 	{
+		// Leave the load streaming in the background, the caller decides when it needs to wait on it
 		Handle->BindUpdateDelegate(FStreamableUpdateDelegate::CreateRaw(this, &FBEAssetManagerStartupJob::UpdateSubstepProgressFromStreamable));
-		Handle->WaitUntilComplete(0.0f, false);
+
+		UE_LOG(LogBE, Display, TEXT("Startup job \"%s\" started an async load after %.2f seconds"), *JobName, FPlatformTime::Seconds() - StartTime);
+
+		return Handle;
+	}
+
+	OnJobComplete(Handle);
+
+	return nullptr;
+}
+
+void FBEAssetManagerStartupJob::OnJobComplete(const TSharedPtr<FStreamableHandle>& Handle) const
+{
+	if (Handle.IsValid())
+	{
 		Handle->BindUpdateDelegate(FStreamableUpdateDelegate());
 	}
 
-	UE_LOG(LogBE, Display, TEXT("Startup job \"%s\" took %.2f seconds to complete"), *JobName, FPlatformTime::Seconds() - JobStartTime);
+	FBEAssetManagerBootProfile::Get().EndJob(JobName);
 
-	return Handle;
+	UE_LOG(LogBE, Display, TEXT("Startup job \"%s\" took %.2f seconds to complete"), *JobName, FPlatformTime::Seconds() - StartTime);
 }
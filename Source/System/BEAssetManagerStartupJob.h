@@ -13,14 +13,21 @@
 DECLARE_DELEGATE_OneParam(FBEAssetManagerStartupJobSubstepProgress, float /*NewProgress*/);
 
 
-/** Handles reporting progress from streamable handles */
+/**
+ * Handles reporting progress from streamable handles
+ *
+ * Jobs may start an async load by filling in the handle, the load keeps streaming while other jobs run.
+ * Jobs listed in Dependencies (by job name) must be fully complete, including their loads, before this job starts.
+ */
 struct FBEAssetManagerStartupJob
 {
 	FBEAssetManagerStartupJobSubstepProgress SubstepProgressDelegate;
 	TFunction<void(const FBEAssetManagerStartupJob&, TSharedPtr<FStreamableHandle>&)> JobFunc;
 	FString JobName;
 	float JobWeight;
+	TArray<FString> Dependencies;
 	mutable double LastUpdate = 0;
+	mutable double StartTime = 0;
 
 	/** Simple job that is all synchronous */
 	FBEAssetManagerStartupJob(const FString& InJobName, const TFunction<void(const FBEAssetManagerStartupJob&, TSharedPtr<FStreamableHandle>&)>& InJobFunc, float InJobWeight)
@@ -29,9 +36,20 @@ struct FBEAssetManagerStartupJob
 		, JobWeight(InJobWeight)
 	{}
 
-	/** Perform actual loading, will return a handle if it created one */
+	/** Job that only starts once all of the named jobs have completed */
+	FBEAssetManagerStartupJob(const FString& InJobName, const TFunction<void(const FBEAssetManagerStartupJob&, TSharedPtr<FStreamableHandle>&)>& InJobFunc, float InJobWeight, const TArray<FString>& InDependencies)
+		: JobFunc(InJobFunc)
+		, JobName(InJobName)
+		, JobWeight(InJobWeight)
+		, Dependencies(InDependencies)
+	{}
+
+	/** Perform actual loading, will return a handle if it started an async load that is still in progress */
 	TSharedPtr<FStreamableHandle> DoJob() const;
 
+	/** Called once the job and any load it started have completed */
+	void OnJobComplete(const TSharedPtr<FStreamableHandle>& Handle) const;
+
 	void UpdateSubstepProgress(float NewProgress) const
 	{
 		SubstepProgressDelegate.ExecuteIfBound(NewProgress);
@@ -43,7 +61,7 @@ struct FBEAssetManagerStartupJob
 		{
 			// StreamableHandle::GetProgress traverses() a large graph and is quite expensive
 			double Now = FPlatformTime::Seconds();
-			if (LastUpdate - Now > 1.0 / 60)
+			if (Now - LastUpdate > 1.0 / 60)
 			{
 				SubstepProgressDelegate.Execute(StreamableHandle->GetProgress());
 				LastUpdate = Now;
@@ -0,0 +1,997 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+// Copyright Eigi Chin
+
+#include "BEReplicationGraph.h"
+
+#include "BEReplicationGraphSettings.h"
+#include "BELogChannels.h"
+#include "Character/BECharacter.h"
+#include "Player/BEPlayerController.h"
+#include "Team/BETeamPrivateInfo.h"
+#include "Team/BETeamSubsystem.h"
+
+#include "Engine/LevelScriptActor.h"
+#include "Engine/NetConnection.h"
+#include "Engine/ServerStatReplicator.h"
+#include "EngineUtils.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/PlayerState.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/SpectatorPawn.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Net/RepLayout.h"
+#include "Net/UnrealNetwork.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "UObject/UObjectIterator.h"
+
+#if WITH_GAMEPLAY_DEBUGGER
+#include "GameplayDebuggerCategoryReplicator.h"
+#endif
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(BEReplicationGraph)
+
+CSV_DEFINE_CATEGORY(BERepGraph, true);
+
+
+//////////////////////////////////////////////////////////////////////
+
+namespace BE::RepGraph
+{
+	float DestructionInfoMaxDist = 30000.f;
+	static FAutoConsoleVariableRef CVarBERepGraphDestructMaxDist(TEXT("BE.RepGraph.DestructInfo.MaxDist"), DestructionInfoMaxDist, TEXT("Max distance (not squared) to rep destruct infos at"), ECVF_Default);
+
+	int32 DisplayClientLevelStreaming = 0;
+	static FAutoConsoleVariableRef CVarBERepGraphDisplayClientLevelStreaming(TEXT("BE.RepGraph.DisplayClientLevelStreaming"), DisplayClientLevelStreaming, TEXT(""), ECVF_Default);
+
+	float CellSize = 10000.f;
+	static FAutoConsoleVariableRef CVarBERepGraphCellSize(TEXT("BE.RepGraph.CellSize"), CellSize, TEXT(""), ECVF_Default);
+
+	// Essentially "Min X" for replication. This is just an initial value. The system will reset itself if actors appears outside of this.
+	float SpatialBiasX = -200000.f;
+	static FAutoConsoleVariableRef CVarBERepGraphSpatialBiasX(TEXT("BE.RepGraph.SpatialBiasX"), SpatialBiasX, TEXT(""), ECVF_Default);
+
+	// Essentially "Min Y" for replication. This is just an initial value. The system will reset itself if actors appears outside of this.
+	float SpatialBiasY = -200000.f;
+	static FAutoConsoleVariableRef CVarBERepSpatialBiasY(TEXT("BE.RepGraph.SpatialBiasY"), SpatialBiasY, TEXT(""), ECVF_Default);
+
+	// How many buckets to spread dynamic, spatialized actors across. High number = more buckets = smaller effective replication frequency. This happens before individual actors do their own NetUpdateFrequency check.
+	int32 DynamicActorFrequencyBuckets = 3;
+	static FAutoConsoleVariableRef CVarBERepDynamicActorFrequencyBuckets(TEXT("BE.RepGraph.DynamicActorFrequencyBuckets"), DynamicActorFrequencyBuckets, TEXT(""), ECVF_Default);
+
+	int32 DisableSpatialRebuilds = 1;
+	static FAutoConsoleVariableRef CVarBERepDisableSpatialRebuilds(TEXT("BE.RepGraph.DisableSpatialRebuilds"), DisableSpatialRebuilds, TEXT(""), ECVF_Default);
+
+	int32 LogLazyInitClasses = 0;
+	static FAutoConsoleVariableRef CVarBERepLogLazyInitClasses(TEXT("BE.RepGraph.LogLazyInitClasses"), LogLazyInitClasses, TEXT(""), ECVF_Default);
+
+	int32 TargetPlayerStatesPerFrame = 2;
+	static FAutoConsoleVariableRef CVarBERepPlayerStatesPerFrame(TEXT("BE.RepGraph.PlayerStatesPerFrame"), TargetPlayerStatesPerFrame, TEXT("How many player states are replicated to each connection per frame"), ECVF_Default);
+
+	float CharacterCullDistance = 0.0f;
+	static FAutoConsoleVariableRef CVarBERepCharacterCullDistance(TEXT("BE.RepGraph.CharacterCullDistance"), CharacterCullDistance, TEXT("Cull distance (not squared) for characters, 0 keeps the class default"), ECVF_Default);
+
+	UReplicationDriver* ConditionalCreateReplicationDriver(UNetDriver* ForNetDriver, UWorld* World)
+	{
+		// Only create for GameNetDriver
+		if (World && ForNetDriver && ForNetDriver->NetDriverName == NAME_GameNetDriver)
+		{
+			const UBEReplicationGraphSettings* BERepGraphSettings = GetDefault<UBEReplicationGraphSettings>();
+
+			// Enable/Disable via developer settings
+			if (BERepGraphSettings && BERepGraphSettings->bDisableReplicationGraph)
+			{
+				UE_LOG(LogBERepGraph, Display, TEXT("Replication graph is disabled via BEReplicationGraphSettings."));
+				return nullptr;
+			}
+
+			UE_LOG(LogBERepGraph, Display, TEXT("Replication graph is enabled for %s in world %s."), *GetNameSafe(ForNetDriver), *GetPathNameSafe(World));
+
+			TSubclassOf<UBEReplicationGraph> GraphClass = BERepGraphSettings->DefaultReplicationGraphClass.TryLoadClass<UBEReplicationGraph>();
+			if (GraphClass.Get() == nullptr)
+			{
+				GraphClass = UBEReplicationGraph::StaticClass();
+			}
+
+			UBEReplicationGraph* BEReplicationGraph = NewObject<UBEReplicationGraph>(GetTransientPackage(), GraphClass.Get());
+			return BEReplicationGraph;
+		}
+
+		return nullptr;
+	}
+
+	static FAutoConsoleCommandWithWorld CmdPrintReplicationStats(
+		TEXT("BE.RepGraph.PrintReplicationStats"),
+		TEXT("Logs the average and max server replication cost since the last call, then resets the counters"),
+		FConsoleCommandWithWorldDelegate::CreateStatic(
+			[](UWorld* InWorld)
+			{
+				UNetDriver* NetDriver = InWorld ? InWorld->GetNetDriver() : nullptr;
+				UBEReplicationGraph* Graph = NetDriver ? Cast<UBEReplicationGraph>(NetDriver->GetReplicationDriver()) : nullptr;
+				if (Graph)
+				{
+					Graph->PrintReplicationStats();
+				}
+				else
+				{
+					UE_LOG(LogBERepGraph, Display, TEXT("BE replication graph is not active in this world"));
+				}
+			}));
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// UBEReplicationGraph
+
+UBEReplicationGraph::UBEReplicationGraph()
+{
+	if (!UReplicationDriver::CreateReplicationDriverDelegate().IsBound())
+	{
+		UReplicationDriver::CreateReplicationDriverDelegate().BindLambda(
+			[](UNetDriver* ForNetDriver, const FURL& URL, UWorld* World) -> UReplicationDriver*
+			{
+				return BE::RepGraph::ConditionalCreateReplicationDriver(ForNetDriver, World);
+			});
+	}
+}
+
+void UBEReplicationGraph::ResetGameWorldState()
+{
+	Super::ResetGameWorldState();
+
+	AlwaysRelevantStreamingLevelActors.Empty();
+	TeamPrivateInfos.Reset();
+
+	for (UNetReplicationGraphConnection* ConnManager : Connections)
+	{
+		for (UReplicationGraphNode* ConnectionNode : ConnManager->GetConnectionGraphNodes())
+		{
+			if (UBEReplicationGraphNode_AlwaysRelevant_ForConnection* AlwaysRelevantConnectionNode = Cast<UBEReplicationGraphNode_AlwaysRelevant_ForConnection>(ConnectionNode))
+			{
+				AlwaysRelevantConnectionNode->ResetGameWorldState();
+			}
+		}
+	}
+
+	for (UNetReplicationGraphConnection* ConnManager : PendingConnections)
+	{
+		for (UReplicationGraphNode* ConnectionNode : ConnManager->GetConnectionGraphNodes())
+		{
+			if (UBEReplicationGraphNode_AlwaysRelevant_ForConnection* AlwaysRelevantConnectionNode = Cast<UBEReplicationGraphNode_AlwaysRelevant_ForConnection>(ConnectionNode))
+			{
+				AlwaysRelevantConnectionNode->ResetGameWorldState();
+			}
+		}
+	}
+}
+
+EClassRepNodeMapping UBEReplicationGraph::GetClassNodeMapping(UClass* Class) const
+{
+	if (!Class)
+	{
+		return EClassRepNodeMapping::NotRouted;
+	}
+
+	if (const EClassRepNodeMapping* Ptr = ClassRepNodePolicies.FindWithoutClassRecursion(Class))
+	{
+		return *Ptr;
+	}
+
+	AActor* ActorCDO = Cast<AActor>(Class->GetDefaultObject());
+	if (!ActorCDO || !ActorCDO->GetIsReplicated())
+	{
+		return EClassRepNodeMapping::NotRouted;
+	}
+
+	auto ShouldSpatialize = [](const AActor* CDO)
+	{
+		return CDO->GetIsReplicated() && (!(CDO->bAlwaysRelevant || CDO->bOnlyRelevantToOwner || CDO->bNetUseOwnerRelevancy));
+	};
+
+	// Only handle this class if it differs from its super. There is no need to put every child class explicitly in the policy class map
+	UClass* SuperClass = Class->GetSuperClass();
+	if (AActor* SuperCDO = Cast<AActor>(SuperClass->GetDefaultObject()))
+	{
+		if (SuperCDO->GetIsReplicated() == ActorCDO->GetIsReplicated()
+			&& SuperCDO->bAlwaysRelevant == ActorCDO->bAlwaysRelevant
+			&& SuperCDO->bOnlyRelevantToOwner == ActorCDO->bOnlyRelevantToOwner
+			&& SuperCDO->bNetUseOwnerRelevancy == ActorCDO->bNetUseOwnerRelevancy)
+		{
+			return GetClassNodeMapping(SuperClass);
+		}
+	}
+
+	if (ShouldSpatialize(ActorCDO))
+	{
+		return EClassRepNodeMapping::Spatialize_Dynamic;
+	}
+	else if (ActorCDO->bAlwaysRelevant && !ActorCDO->bOnlyRelevantToOwner)
+	{
+		return EClassRepNodeMapping::RelevantAllConnections;
+	}
+
+	return EClassRepNodeMapping::NotRouted;
+}
+
+void UBEReplicationGraph::RegisterClassRepNodeMapping(UClass* Class)
+{
+	EClassRepNodeMapping Mapping = GetClassNodeMapping(Class);
+	ClassRepNodePolicies.Set(Class, Mapping);
+}
+
+void UBEReplicationGraph::InitClassReplicationInfo(FClassReplicationInfo& Info, UClass* Class, bool Spatialize) const
+{
+	AActor* CDO = Class->GetDefaultObject<AActor>();
+	if (Spatialize)
+	{
+		Info.SetCullDistanceSquared(CDO->NetCullDistanceSquared);
+		UE_LOG(LogBERepGraph, Log, TEXT("Setting cull distance for %s to %f (%f)"), *Class->GetName(), Info.GetCullDistanceSquared(), Info.GetCullDistance());
+	}
+
+	Info.ReplicationPeriodFrame = GetReplicationPeriodFrameForFrequency(CDO->NetUpdateFrequency);
+
+	UClass* NativeClass = Class;
+	while (!NativeClass->IsNative() && NativeClass->GetSuperClass() && NativeClass->GetSuperClass() != AActor::StaticClass())
+	{
+		NativeClass = NativeClass->GetSuperClass();
+	}
+
+	UE_LOG(LogBERepGraph, Log, TEXT("Setting replication period for %s (%s) to %d frames (%.2f)"), *Class->GetName(), *NativeClass->GetName(), Info.ReplicationPeriodFrame, CDO->NetUpdateFrequency);
+}
+
+bool UBEReplicationGraph::ConditionalInitClassReplicationInfo(UClass* ReplicatedClass, FClassReplicationInfo& ClassInfo)
+{
+	if (ExplicitlySetClasses.FindByPredicate([&](const UClass* SetClass) { return ReplicatedClass->IsChildOf(SetClass); }) != nullptr)
+	{
+		return false;
+	}
+
+	bool ClassIsSpatialized = IsSpatialized(ClassRepNodePolicies.GetChecked(ReplicatedClass));
+	InitClassReplicationInfo(ClassInfo, ReplicatedClass, ClassIsSpatialized);
+	return true;
+}
+
+void UBEReplicationGraph::AddClassRepInfo(UClass* Class, EClassRepNodeMapping Mapping)
+{
+	if (IsSpatialized(Mapping))
+	{
+		if (Class->GetDefaultObject<AActor>()->bAlwaysRelevant)
+		{
+			UE_LOG(LogBERepGraph, Warning, TEXT("Replicated Class %s is AlwaysRelevant but is initialized into a spatialized node (%s)"), *Class->GetName(), *StaticEnum<EClassRepNodeMapping>()->GetNameStringByValue((int64)Mapping));
+		}
+	}
+
+	ClassRepNodePolicies.Set(Class, Mapping);
+}
+
+void UBEReplicationGraph::RegisterClassReplicationInfo(UClass* ReplicatedClass)
+{
+	FClassReplicationInfo ClassInfo;
+	if (ConditionalInitClassReplicationInfo(ReplicatedClass, ClassInfo))
+	{
+		GlobalActorReplicationInfoMap.SetClassInfo(ReplicatedClass, ClassInfo);
+		UE_LOG(LogBERepGraph, Log, TEXT("Setting %s - %.2f"), *GetNameSafe(ReplicatedClass), ClassInfo.GetCullDistance());
+	}
+}
+
+void UBEReplicationGraph::InitGlobalActorClassSettings()
+{
+	// Setup our lazy init function for classes that are not currently loaded.
+	GlobalActorReplicationInfoMap.SetInitClassInfoFunc(
+		[this](UClass* Class, FClassReplicationInfo& ClassInfo)
+		{
+			RegisterClassRepNodeMapping(Class); // This needs to run before RegisterClassReplicationInfo.
+
+			const bool bHandled = ConditionalInitClassReplicationInfo(Class, ClassInfo);
+
+#if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
+			if (BE::RepGraph::LogLazyInitClasses != 0)
+			{
+				if (bHandled)
+				{
+					EClassRepNodeMapping Mapping = ClassRepNodePolicies.GetChecked(Class);
+					UE_LOG(LogBERepGraph, Warning, TEXT("%s was Lazy Initialized. (Parent: %s) %d."), *GetNameSafe(Class), *GetNameSafe(Class->GetSuperClass()), (int32)Mapping);
+
+					FClassReplicationInfo& ParentRepInfo = GlobalActorReplicationInfoMap.GetClassInfo(Class->GetSuperClass());
+					if (ClassInfo.BuildDebugStringDelta() != ParentRepInfo.BuildDebugStringDelta())
+					{
+						UE_LOG(LogBERepGraph, Warning, TEXT("Differences Found!"));
+						FString DebugStr = ParentRepInfo.BuildDebugStringDelta();
+						UE_LOG(LogBERepGraph, Warning, TEXT("  Parent: %s"), *DebugStr);
+
+						DebugStr = ClassInfo.BuildDebugStringDelta();
+						UE_LOG(LogBERepGraph, Warning, TEXT("  Class : %s"), *DebugStr);
+					}
+				}
+				else
+				{
+					UE_LOG(LogBERepGraph, Warning, TEXT("%s skipped Lazy Initialization because it does not differ from its parent. (Parent: %s)"), *GetNameSafe(Class), *GetNameSafe(Class->GetSuperClass()));
+				}
+			}
+#endif
+
+			return bHandled;
+		});
+
+	ClassRepNodePolicies.InitNewElement = [this](UClass* Class, EClassRepNodeMapping& NodeMapping)->bool
+	{
+		NodeMapping = GetClassNodeMapping(Class);
+		return true;
+	};
+
+	const UBEReplicationGraphSettings* BERepGraphSettings = GetDefault<UBEReplicationGraphSettings>();
+	check(BERepGraphSettings);
+
+	// Set Classes Node Mappings
+	for (const FBERepGraphActorClassSettings& ActorClassSettings : BERepGraphSettings->ClassSettings)
+	{
+		if (ActorClassSettings.bAddClassRepInfoToMap)
+		{
+			if (UClass* StaticActorClass = ActorClassSettings.GetStaticActorClass())
+			{
+				UE_LOG(LogBERepGraph, Log, TEXT("ActorClassSettings -- AddClassRepInfo - %s :: %i"), *StaticActorClass->GetName(), int(ActorClassSettings.ClassNodeMapping));
+				AddClassRepInfo(StaticActorClass, ActorClassSettings.ClassNodeMapping);
+			}
+		}
+	}
+
+#if WITH_GAMEPLAY_DEBUGGER
+	AddClassRepInfo(AGameplayDebuggerCategoryReplicator::StaticClass(), EClassRepNodeMapping::NotRouted);	// Replicated via UBEReplicationGraphNode_AlwaysRelevant_ForConnection
+	AGameplayDebuggerCategoryReplicator::NotifyDebuggerOwnerChange.AddUObject(this, &ThisClass::OnGameplayDebuggerOwnerChange);
+#endif
+
+	AddClassRepInfo(ALevelScriptActor::StaticClass(), EClassRepNodeMapping::NotRouted);	// Not needed
+	AddClassRepInfo(APlayerState::StaticClass(), EClassRepNodeMapping::NotRouted);		// Special cased via UBEReplicationGraphNode_PlayerStateFrequencyLimiter
+	AddClassRepInfo(AReplicationGraphDebugActor::StaticClass(), EClassRepNodeMapping::NotRouted);	// Not needed. Replicated special case inside RepGraph
+	AddClassRepInfo(AInfo::StaticClass(), EClassRepNodeMapping::RelevantAllConnections);	// Non spatialized, relevant to all (game state, team public info)
+
+	// Team private info is replicated via UBEReplicationGraphNode_AlwaysRelevant_ForConnection, only to members of the team
+	AddClassRepInfo(ABETeamPrivateInfo::StaticClass(), EClassRepNodeMapping::NotRouted);
+
+	TArray<UClass*> AllReplicatedClasses;
+
+	for (TObjectIterator<UClass> It; It; ++It)
+	{
+		UClass* Class = *It;
+		AActor* ActorCDO = Cast<AActor>(Class->GetDefaultObject());
+		if (!ActorCDO || !ActorCDO->GetIsReplicated())
+		{
+			continue;
+		}
+
+		// Skip SKEL and REINST classes. I don't know a better way to do this.
+		if (Class->GetName().StartsWith(TEXT("SKEL_")) || Class->GetName().StartsWith(TEXT("REINST_")))
+		{
+			continue;
+		}
+
+		// --------------------------------------------------------------------
+		// This is a replicated class. Save this off for the second pass below
+		// --------------------------------------------------------------------
+
+		AllReplicatedClasses.Add(Class);
+
+		RegisterClassRepNodeMapping(Class);
+	}
+
+	// -----------------------------------------------------------------------------------------------------------------
+	// Setup FClassReplicationInfo. This is essentially the per class replication settings. Some we set explicitly, the rest we are setting via looking at the legacy settings on AActor.
+	// -----------------------------------------------------------------------------------------------------------------
+
+	auto SetClassInfo = [&](UClass* Class, const FClassReplicationInfo& Info) { GlobalActorReplicationInfoMap.SetClassInfo(Class, Info); ExplicitlySetClasses.Add(Class); };
+	ExplicitlySetClasses.Reset();
+
+	FClassReplicationInfo CharacterClassRepInfo;
+	CharacterClassRepInfo.DistancePriorityScale = 1.f;
+	CharacterClassRepInfo.StarvationPriorityScale = 1.f;
+	CharacterClassRepInfo.ActorChannelFrameTimeout = 4;
+	CharacterClassRepInfo.SetCullDistanceSquared(ABECharacter::StaticClass()->GetDefaultObject<ABECharacter>()->NetCullDistanceSquared);
+
+	if (BE::RepGraph::CharacterCullDistance > 0.0f)
+	{
+		CharacterClassRepInfo.SetCullDistance(BE::RepGraph::CharacterCullDistance);
+	}
+
+	SetClassInfo(ACharacter::StaticClass(), CharacterClassRepInfo);
+	SetClassInfo(ABECharacter::StaticClass(), CharacterClassRepInfo);
+
+	// ---------------------------------------------------------------------
+	UReplicationGraphNode_ActorListFrequencyBuckets::DefaultSettings.ListSize = 12;
+	UReplicationGraphNode_ActorListFrequencyBuckets::DefaultSettings.NumBuckets = BE::RepGraph::DynamicActorFrequencyBuckets;
+	UReplicationGraphNode_ActorListFrequencyBuckets::DefaultSettings.BucketThresholds.Reset();
+
+	RPCSendPolicyMap.Reset();
+
+	// Set FClassReplicationInfo based on legacy settings from all replicated classes
+	for (UClass* ReplicatedClass : AllReplicatedClasses)
+	{
+		RegisterClassReplicationInfo(ReplicatedClass);
+	}
+
+	// Print out what we came up with
+	UE_LOG(LogBERepGraph, Log, TEXT(""));
+	UE_LOG(LogBERepGraph, Log, TEXT("Class Routing Map: "));
+	for (auto ClassMapIt = ClassRepNodePolicies.CreateIterator(); ClassMapIt; ++ClassMapIt)
+	{
+		UClass* Class = CastChecked<UClass>(ClassMapIt.Key().ResolveObjectPtr());
+		EClassRepNodeMapping Mapping = ClassMapIt.Value();
+
+		// Only print if different than native class
+		UClass* ParentNativeClass = GetParentNativeClass(Class);
+
+		EClassRepNodeMapping* ParentMapping = ClassRepNodePolicies.Get(ParentNativeClass);
+		if (ParentMapping && Class != ParentNativeClass && Mapping == *ParentMapping)
+		{
+			continue;
+		}
+
+		UE_LOG(LogBERepGraph, Log, TEXT("  %s (%s) -> %s"), *Class->GetName(), *GetNameSafe(ParentNativeClass), *StaticEnum<EClassRepNodeMapping>()->GetNameStringByValue(static_cast<uint32>(Mapping)));
+	}
+
+	UE_LOG(LogBERepGraph, Log, TEXT(""));
+	UE_LOG(LogBERepGraph, Log, TEXT("Class Settings Map: "));
+	FClassReplicationInfo DefaultValues;
+	for (auto ClassRepInfoIt = GlobalActorReplicationInfoMap.CreateClassMapIterator(); ClassRepInfoIt; ++ClassRepInfoIt)
+	{
+		UClass* Class = CastChecked<UClass>(ClassRepInfoIt.Key().ResolveObjectPtr());
+		const FClassReplicationInfo& ClassInfo = ClassRepInfoIt.Value().Get();
+		UE_LOG(LogBERepGraph, Log, TEXT("  %s (%s) -> %s"), *Class->GetName(), *GetNameSafe(GetParentNativeClass(Class)), *ClassInfo.BuildDebugStringDelta());
+	}
+
+	// Rep destruct infos based on CVar value
+	DestructInfoMaxDistanceSquared = BE::RepGraph::DestructionInfoMaxDist * BE::RepGraph::DestructionInfoMaxDist;
+
+	// Add to RPC_Multicast_OpenChannelForClass map
+	RPC_Multicast_OpenChannelForClass.Reset();
+	RPC_Multicast_OpenChannelForClass.Set(AReplicationGraphDebugActor::StaticClass(), false); // multicast RPCs are not sent to this class
+	RPC_Multicast_OpenChannelForClass.Set(AController::StaticClass(), false); // multicasts should never open channels on Controllers since opening a channel on a non-owner breaks the Controller's replication.
+	RPC_Multicast_OpenChannelForClass.Set(AServerStatReplicator::StaticClass(), false);
+
+	for (const FBERepGraphActorClassSettings& ActorClassSettings : BERepGraphSettings->ClassSettings)
+	{
+		if (UClass* StaticActorClass = ActorClassSettings.GetStaticActorClass())
+		{
+			if (ActorClassSettings.bAddToRPC_Multicast_OpenChannelForClassMap)
+			{
+				UE_LOG(LogBERepGraph, Log, TEXT("ActorClassSettings -- RPC_Multicast_OpenChannelForClass - %s"), *StaticActorClass->GetName());
+				RPC_Multicast_OpenChannelForClass.Set(StaticActorClass, ActorClassSettings.bRPC_Multicast_OpenChannelForClass);
+			}
+
+			if (ActorClassSettings.bOverrideCullDistance)
+			{
+				FClassReplicationInfo& ClassInfo = GlobalActorReplicationInfoMap.GetClassInfo(StaticActorClass);
+				ClassInfo.SetCullDistance(ActorClassSettings.CullDistance);
+				UE_LOG(LogBERepGraph, Log, TEXT("ActorClassSettings -- CullDistance - %s :: %.2f"), *StaticActorClass->GetName(), ActorClassSettings.CullDistance);
+			}
+		}
+	}
+}
+
+void UBEReplicationGraph::InitGlobalGraphNodes()
+{
+	// -----------------------------------------------
+	//	Spatial Actors
+	// -----------------------------------------------
+
+	GridNode = CreateNewNode<UReplicationGraphNode_GridSpatialization2D>();
+	GridNode->CellSize = BE::RepGraph::CellSize;
+	GridNode->SpatialBias = FVector2D(BE::RepGraph::SpatialBiasX, BE::RepGraph::SpatialBiasY);
+
+	if (BE::RepGraph::DisableSpatialRebuilds)
+	{
+		GridNode->AddToClassRebuildDenyList(AActor::StaticClass()); // Disable All spatial rebuilding
+	}
+
+	AddGlobalGraphNode(GridNode);
+
+	// -----------------------------------------------
+	//	Always Relevant (to everyone) Actors
+	// -----------------------------------------------
+	AlwaysRelevantNode = CreateNewNode<UReplicationGraphNode_ActorList>();
+	AddGlobalGraphNode(AlwaysRelevantNode);
+
+	// -----------------------------------------------
+	//	Player State specialization. This will return a rolling subset of the player states to replicate
+	// -----------------------------------------------
+	UBEReplicationGraphNode_PlayerStateFrequencyLimiter* PlayerStateNode = CreateNewNode<UBEReplicationGraphNode_PlayerStateFrequencyLimiter>();
+	AddGlobalGraphNode(PlayerStateNode);
+}
+
+void UBEReplicationGraph::InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection)
+{
+	Super::InitConnectionGraphNodes(RepGraphConnection);
+
+	UBEReplicationGraphNode_AlwaysRelevant_ForConnection* AlwaysRelevantConnectionNode = CreateNewNode<UBEReplicationGraphNode_AlwaysRelevant_ForConnection>();
+
+	// This node needs to know when client levels go in and out of visibility
+	RepGraphConnection->OnClientVisibleLevelNameAdd.AddUObject(AlwaysRelevantConnectionNode, &UBEReplicationGraphNode_AlwaysRelevant_ForConnection::OnClientLevelVisibilityAdd);
+	RepGraphConnection->OnClientVisibleLevelNameRemove.AddUObject(AlwaysRelevantConnectionNode, &UBEReplicationGraphNode_AlwaysRelevant_ForConnection::OnClientLevelVisibilityRemove);
+
+	AddConnectionGraphNode(AlwaysRelevantConnectionNode, RepGraphConnection);
+}
+
+EClassRepNodeMapping UBEReplicationGraph::GetMappingPolicy(UClass* Class)
+{
+	EClassRepNodeMapping* PolicyPtr = ClassRepNodePolicies.Get(Class);
+	EClassRepNodeMapping Policy = PolicyPtr ? *PolicyPtr : EClassRepNodeMapping::NotRouted;
+	return Policy;
+}
+
+void UBEReplicationGraph::RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo)
+{
+	if (ABETeamPrivateInfo* TeamPrivateInfo = Cast<ABETeamPrivateInfo>(ActorInfo.Actor))
+	{
+		TeamPrivateInfos.AddUnique(TeamPrivateInfo);
+	}
+
+	EClassRepNodeMapping Policy = GetMappingPolicy(ActorInfo.Class);
+	switch (Policy)
+	{
+		case EClassRepNodeMapping::NotRouted:
+		{
+			break;
+		}
+
+		case EClassRepNodeMapping::RelevantAllConnections:
+		{
+			if (ActorInfo.StreamingLevelName == NAME_None)
+			{
+				AlwaysRelevantNode->NotifyAddNetworkActor(ActorInfo);
+			}
+			else
+			{
+				FActorRepListRefView& RepList = AlwaysRelevantStreamingLevelActors.FindOrAdd(ActorInfo.StreamingLevelName);
+				RepList.ConditionalAdd(ActorInfo.Actor);
+			}
+			break;
+		}
+
+		case EClassRepNodeMapping::Spatialize_Static:
+		{
+			GridNode->AddActor_Static(ActorInfo, GlobalInfo);
+			break;
+		}
+
+		case EClassRepNodeMapping::Spatialize_Dynamic:
+		{
+			GridNode->AddActor_Dynamic(ActorInfo, GlobalInfo);
+			break;
+		}
+
+		case EClassRepNodeMapping::Spatialize_Dormancy:
+		{
+			GridNode->AddActor_Dormancy(ActorInfo, GlobalInfo);
+			break;
+		}
+	};
+}
+
+void UBEReplicationGraph::RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo)
+{
+	if (ABETeamPrivateInfo* TeamPrivateInfo = Cast<ABETeamPrivateInfo>(ActorInfo.Actor))
+	{
+		TeamPrivateInfos.Remove(TeamPrivateInfo);
+	}
+
+	EClassRepNodeMapping Policy = GetMappingPolicy(ActorInfo.Class);
+	switch (Policy)
+	{
+		case EClassRepNodeMapping::NotRouted:
+		{
+			break;
+		}
+
+		case EClassRepNodeMapping::RelevantAllConnections:
+		{
+			if (ActorInfo.StreamingLevelName == NAME_None)
+			{
+				AlwaysRelevantNode->NotifyRemoveNetworkActor(ActorInfo);
+			}
+			else
+			{
+				FActorRepListRefView& RepList = AlwaysRelevantStreamingLevelActors.FindChecked(ActorInfo.StreamingLevelName);
+				if (RepList.RemoveFast(ActorInfo.Actor) == false)
+				{
+					UE_LOG(LogBERepGraph, Warning, TEXT("Actor %s was not found in AlwaysRelevantStreamingLevelActors list. LevelName: %s"), *GetActorRepListTypeDebugString(ActorInfo.Actor), *ActorInfo.StreamingLevelName.ToString());
+				}
+			}
+
+			SetActorDestructionInfoToIgnoreDistanceCulling(ActorInfo.GetActor());
+
+			break;
+		}
+
+		case EClassRepNodeMapping::Spatialize_Static:
+		{
+			GridNode->RemoveActor_Static(ActorInfo);
+			break;
+		}
+
+		case EClassRepNodeMapping::Spatialize_Dynamic:
+		{
+			GridNode->RemoveActor_Dynamic(ActorInfo);
+			break;
+		}
+
+		case EClassRepNodeMapping::Spatialize_Dormancy:
+		{
+			GridNode->RemoveActor_Dormancy(ActorInfo);
+			break;
+		}
+	};
+}
+
+int32 UBEReplicationGraph::ServerReplicateActors(float DeltaSeconds)
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	const int32 NumReplicated = Super::ServerReplicateActors(DeltaSeconds);
+
+	const double ElapsedMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	CSV_CUSTOM_STAT(BERepGraph, ServerReplicateActorsMs, static_cast<float>(ElapsedMs), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(BERepGraph, NumConnections, Connections.Num(), ECsvCustomStatOp::Set);
+
+	ReplicationMsTotal += ElapsedMs;
+	ReplicationMsMax = FMath::Max(ReplicationMsMax, ElapsedMs);
+	ReplicatedActorsTotal += NumReplicated;
+	++ReplicationFrameCount;
+
+	return NumReplicated;
+}
+
+ABETeamPrivateInfo* UBEReplicationGraph::FindTeamPrivateInfo(int32 TeamId) const
+{
+	if (TeamId == INDEX_NONE)
+	{
+		return nullptr;
+	}
+
+	for (const TWeakObjectPtr<ABETeamPrivateInfo>& TeamPrivateInfoPtr : TeamPrivateInfos)
+	{
+		ABETeamPrivateInfo* TeamPrivateInfo = TeamPrivateInfoPtr.Get();
+		if (TeamPrivateInfo && (TeamPrivateInfo->GetTeamId() == TeamId))
+		{
+			return TeamPrivateInfo;
+		}
+	}
+
+	return nullptr;
+}
+
+void UBEReplicationGraph::PrintReplicationStats()
+{
+	if (ReplicationFrameCount > 0)
+	{
+		UE_LOG(LogBERepGraph, Display, TEXT("Replication stats over %d frames: %d connections, avg %.3f ms, max %.3f ms, avg %.1f actors replicated per frame"),
+			ReplicationFrameCount,
+			Connections.Num(),
+			ReplicationMsTotal / ReplicationFrameCount,
+			ReplicationMsMax,
+			static_cast<double>(ReplicatedActorsTotal) / ReplicationFrameCount);
+	}
+	else
+	{
+		UE_LOG(LogBERepGraph, Display, TEXT("No replication frames recorded yet"));
+	}
+
+	ReplicationMsTotal = 0.0;
+	ReplicationMsMax = 0.0;
+	ReplicationFrameCount = 0;
+	ReplicatedActorsTotal = 0;
+}
+
+#if WITH_GAMEPLAY_DEBUGGER
+void UBEReplicationGraph::OnGameplayDebuggerOwnerChange(AGameplayDebuggerCategoryReplicator* Debugger, APlayerController* OldOwner)
+{
+	auto GetAlwaysRelevantForConnectionNode = [this](APlayerController* Controller) -> UBEReplicationGraphNode_AlwaysRelevant_ForConnection*
+	{
+		if (Controller)
+		{
+			if (UNetConnection* NetConnection = Controller->GetNetConnection())
+			{
+				if (NetConnection->GetDriver() == NetDriver)
+				{
+					if (UNetReplicationGraphConnection* GraphConnection = FindOrAddConnectionManager(NetConnection))
+					{
+						for (UReplicationGraphNode* ConnectionNode : GraphConnection->GetConnectionGraphNodes())
+						{
+							if (UBEReplicationGraphNode_AlwaysRelevant_ForConnection* AlwaysRelevantConnectionNode = Cast<UBEReplicationGraphNode_AlwaysRelevant_ForConnection>(ConnectionNode))
+							{
+								return AlwaysRelevantConnectionNode;
+							}
+						}
+
+					}
+				}
+			}
+		}
+
+		return nullptr;
+	};
+
+	if (UBEReplicationGraphNode_AlwaysRelevant_ForConnection* AlwaysRelevantConnectionNode = GetAlwaysRelevantForConnectionNode(OldOwner))
+	{
+		AlwaysRelevantConnectionNode->GameplayDebugger = nullptr;
+	}
+
+	if (UBEReplicationGraphNode_AlwaysRelevant_ForConnection* AlwaysRelevantConnectionNode = GetAlwaysRelevantForConnectionNode(Debugger->GetReplicationOwner()))
+	{
+		AlwaysRelevantConnectionNode->GameplayDebugger = Debugger;
+	}
+}
+#endif
+
+void UBEReplicationGraph::PrintRepNodePolicies()
+{
+	UEnum* Enum = StaticEnum<EClassRepNodeMapping>();
+	if (!Enum)
+	{
+		return;
+	}
+
+	GLog->Logf(TEXT("===================================="));
+	GLog->Logf(TEXT("BE Replication Routing Policies"));
+	GLog->Logf(TEXT("===================================="));
+
+	for (auto It = ClassRepNodePolicies.CreateIterator(); It; ++It)
+	{
+		FObjectKey ObjKey = It.Key();
+
+		EClassRepNodeMapping Mapping = It.Value();
+
+		GLog->Logf(TEXT("%-40s --> %s"), *GetNameSafe(ObjKey.ResolveObjectPtr()), *Enum->GetNameStringByValue(static_cast<uint32>(Mapping)));
+	}
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// UBEReplicationGraphNode_AlwaysRelevant_ForConnection
+
+void UBEReplicationGraphNode_AlwaysRelevant_ForConnection::ResetGameWorldState()
+{
+	ReplicationActorList.Reset();
+	AlwaysRelevantStreamingLevelsNeedingReplication.Empty();
+}
+
+void UBEReplicationGraphNode_AlwaysRelevant_ForConnection::GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params)
+{
+	UBEReplicationGraph* BEGraph = CastChecked<UBEReplicationGraph>(GetOuter());
+
+	ReplicationActorList.Reset();
+
+	const UBETeamSubsystem* TeamSubsystem = nullptr;
+
+	for (const FNetViewer& CurViewer : Params.Viewers)
+	{
+		ReplicationActorList.ConditionalAdd(CurViewer.InViewer);
+		ReplicationActorList.ConditionalAdd(CurViewer.ViewTarget);
+
+		if (ABEPlayerController* PC = Cast<ABEPlayerController>(CurViewer.InViewer))
+		{
+			// 50% throttling of PlayerStates.
+			const bool bReplicatePS = (Params.ConnectionManager.ConnectionOrderNum % 2) == (Params.ReplicationFrameNum % 2);
+			if (bReplicatePS)
+			{
+				// Always return the player state to the owning player. Simulated proxy player states are handled by UBEReplicationGraphNode_PlayerStateFrequencyLimiter
+				if (APlayerState* PS = PC->PlayerState)
+				{
+					if (!bInitializedPlayerState)
+					{
+						bInitializedPlayerState = true;
+						FConnectionReplicationActorInfo& ConnectionActorInfo = Params.ConnectionManager.ActorInfoMap.FindOrAdd(PS);
+						ConnectionActorInfo.ReplicationPeriodFrame = 1;
+					}
+
+					ReplicationActorList.ConditionalAdd(PS);
+				}
+			}
+
+			FCachedAlwaysRelevantActorInfo& LastData = PastRelevantActorMap.FindOrAdd(CurViewer.Connection);
+
+			if (APawn* Pawn = PC->GetPawn())
+			{
+				UpdateCachedRelevantActor(Params, Pawn, LastData.LastViewer);
+
+				if (Pawn != CurViewer.ViewTarget)
+				{
+					ReplicationActorList.ConditionalAdd(Pawn);
+				}
+			}
+
+			if (APawn* ViewTargetPawn = Cast<APawn>(CurViewer.ViewTarget))
+			{
+				UpdateCachedRelevantActor(Params, ViewTargetPawn, LastData.LastViewTarget);
+			}
+
+			// Team private info is only relevant to the members of the team
+			if (!TeamSubsystem)
+			{
+				TeamSubsystem = BEGraph->GetWorld() ? BEGraph->GetWorld()->GetSubsystem<UBETeamSubsystem>() : nullptr;
+			}
+
+			if (TeamSubsystem)
+			{
+				if (ABETeamPrivateInfo* TeamPrivateInfo = BEGraph->FindTeamPrivateInfo(TeamSubsystem->FindTeamFromObject(PC)))
+				{
+					ReplicationActorList.ConditionalAdd(TeamPrivateInfo);
+				}
+			}
+		}
+	}
+
+	CleanupCachedRelevantActors(PastRelevantActorMap);
+
+	Params.OutGatheredReplicationLists.AddReplicationActorList(ReplicationActorList);
+
+	// Always relevant streaming level actors.
+	FPerConnectionActorInfoMap& ConnectionActorInfoMap = Params.ConnectionManager.ActorInfoMap;
+
+	TMap<FName, FActorRepListRefView>& AlwaysRelevantStreamingLevelActors = BEGraph->AlwaysRelevantStreamingLevelActors;
+
+	for (int32 Idx = AlwaysRelevantStreamingLevelsNeedingReplication.Num() - 1; Idx >= 0; --Idx)
+	{
+		const FName& StreamingLevel = AlwaysRelevantStreamingLevelsNeedingReplication[Idx];
+
+		FActorRepListRefView* Ptr = AlwaysRelevantStreamingLevelActors.Find(StreamingLevel);
+		if (Ptr == nullptr)
+		{
+			// No always relevant lists for that level
+			UE_CLOG(BE::RepGraph::DisplayClientLevelStreaming > 0, LogBERepGraph, Display, TEXT("CLIENTSTREAMING Removing %s from AlwaysRelevantStreamingLevelActors because FActorRepListRefView is null. %s "), *StreamingLevel.ToString(), *Params.ConnectionManager.GetName());
+			AlwaysRelevantStreamingLevelsNeedingReplication.RemoveAtSwap(Idx, 1, false);
+			continue;
+		}
+
+		FActorRepListRefView& RepList = *Ptr;
+
+		if (RepList.Num() > 0)
+		{
+			bool bAllDormant = true;
+			for (FActorRepListType Actor : RepList)
+			{
+				FConnectionReplicationActorInfo& ConnectionActorInfo = ConnectionActorInfoMap.FindOrAdd(Actor);
+				if (ConnectionActorInfo.bDormantOnConnection == false)
+				{
+					bAllDormant = false;
+					break;
+				}
+			}
+
+			if (bAllDormant)
+			{
+				UE_CLOG(BE::RepGraph::DisplayClientLevelStreaming > 0, LogBERepGraph, Display, TEXT("CLIENTSTREAMING All AlwaysRelevant Actors Dormant on StreamingLevel %s for %s. Removing list."), *StreamingLevel.ToString(), *Params.ConnectionManager.GetName());
+				AlwaysRelevantStreamingLevelsNeedingReplication.RemoveAtSwap(Idx, 1, false);
+			}
+			else
+			{
+				UE_CLOG(BE::RepGraph::DisplayClientLevelStreaming > 0, LogBERepGraph, Display, TEXT("CLIENTSTREAMING Adding always Actors on StreamingLevel %s for %s because it has at least one non dormant actor"), *StreamingLevel.ToString(), *Params.ConnectionManager.GetName());
+				Params.OutGatheredReplicationLists.AddReplicationActorList(RepList);
+			}
+		}
+		else
+		{
+			UE_LOG(LogBERepGraph, Warning, TEXT("UBEReplicationGraphNode_AlwaysRelevant_ForConnection::GatherActorListsForConnection - empty RepList %s"), *Params.ConnectionManager.GetName());
+		}
+
+	}
+
+#if WITH_GAMEPLAY_DEBUGGER
+	if (GameplayDebugger)
+	{
+		ReplicationActorList.ConditionalAdd(GameplayDebugger);
+	}
+#endif
+}
+
+void UBEReplicationGraphNode_AlwaysRelevant_ForConnection::OnClientLevelVisibilityAdd(FName LevelName, UWorld* StreamingWorld)
+{
+	UE_CLOG(BE::RepGraph::DisplayClientLevelStreaming > 0, LogBERepGraph, Display, TEXT("CLIENTSTREAMING ::OnClientLevelVisibilityAdd - %s"), *LevelName.ToString());
+	AlwaysRelevantStreamingLevelsNeedingReplication.Add(LevelName);
+}
+
+void UBEReplicationGraphNode_AlwaysRelevant_ForConnection::OnClientLevelVisibilityRemove(FName LevelName)
+{
+	UE_CLOG(BE::RepGraph::DisplayClientLevelStreaming > 0, LogBERepGraph, Display, TEXT("CLIENTSTREAMING ::OnClientLevelVisibilityRemove - %s"), *LevelName.ToString());
+	AlwaysRelevantStreamingLevelsNeedingReplication.Remove(LevelName);
+}
+
+void UBEReplicationGraphNode_AlwaysRelevant_ForConnection::LogNode(FReplicationGraphDebugInfo& DebugInfo, const FString& NodeName) const
+{
+	DebugInfo.Log(NodeName);
+	DebugInfo.PushIndent();
+	LogActorRepList(DebugInfo, NodeName, ReplicationActorList);
+
+	for (const FName& LevelName : AlwaysRelevantStreamingLevelsNeedingReplication)
+	{
+		UBEReplicationGraph* BEGraph = CastChecked<UBEReplicationGraph>(GetOuter());
+		if (FActorRepListRefView* RepList = BEGraph->AlwaysRelevantStreamingLevelActors.Find(LevelName))
+		{
+			LogActorRepList(DebugInfo, FString::Printf(TEXT("AlwaysRelevant StreamingLevel List: %s"), *LevelName.ToString()), *RepList);
+		}
+	}
+
+	DebugInfo.PopIndent();
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// UBEReplicationGraphNode_PlayerStateFrequencyLimiter
+
+UBEReplicationGraphNode_PlayerStateFrequencyLimiter::UBEReplicationGraphNode_PlayerStateFrequencyLimiter()
+{
+	bRequiresPrepareForReplicationCall = true;
+}
+
+void UBEReplicationGraphNode_PlayerStateFrequencyLimiter::PrepareForReplication()
+{
+	TargetActorsPerFrame = FMath::Max(BE::RepGraph::TargetPlayerStatesPerFrame, 1);
+
+	ReplicationActorLists.Reset();
+	ForceNetUpdateReplicationActorList.Reset();
+
+	ReplicationActorLists.AddDefaulted();
+	FActorRepListRefView* CurrentList = &ReplicationActorLists[0];
+
+	// We rebuild our lists of player states each frame. This is not as efficient as it could be but its the simplest way
+	// to handle players disconnecting and keeping the lists compact. If the lists were persistent we would need to defrag them as players left.
+
+	for (TActorIterator<APlayerState> It(GetWorld()); It; ++It)
+	{
+		APlayerState* PS = *It;
+		if (IsActorValidForReplicationGather(PS) == false)
+		{
+			continue;
+		}
+
+		if (CurrentList->Num() >= TargetActorsPerFrame)
+		{
+			ReplicationActorLists.AddDefaulted();
+			CurrentList = &ReplicationActorLists.Last();
+		}
+
+		CurrentList->Add(PS);
+	}
+}
+
+void UBEReplicationGraphNode_PlayerStateFrequencyLimiter::GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params)
+{
+	const int32 ListIdx = Params.ReplicationFrameNum % ReplicationActorLists.Num();
+	Params.OutGatheredReplicationLists.AddReplicationActorList(ReplicationActorLists[ListIdx]);
+
+	if (ForceNetUpdateReplicationActorList.Num() > 0)
+	{
+		Params.OutGatheredReplicationLists.AddReplicationActorList(ForceNetUpdateReplicationActorList);
+	}
+}
+
+void UBEReplicationGraphNode_PlayerStateFrequencyLimiter::LogNode(FReplicationGraphDebugInfo& DebugInfo, const FString& NodeName) const
+{
+	DebugInfo.Log(NodeName);
+	DebugInfo.PushIndent();
+
+	int32 i = 0;
+	for (const FActorRepListRefView& List : ReplicationActorLists)
+	{
+		LogActorRepList(DebugInfo, FString::Printf(TEXT("Bucket[%d]"), i++), List);
+	}
+
+	DebugInfo.PopIndent();
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// Console commands
+
+void BEPrintRepNodePolicies(UWorld* InWorld)
+{
+	if (UNetDriver* NetDriver = InWorld ? InWorld->GetNetDriver() : nullptr)
+	{
+		if (UBEReplicationGraph* Graph = Cast<UBEReplicationGraph>(NetDriver->GetReplicationDriver()))
+		{
+			Graph->PrintRepNodePolicies();
+		}
+	}
+}
+
+FAutoConsoleCommandWithWorld BEPrintRepNodePoliciesCmd(TEXT("BE.RepGraph.PrintRouting"), TEXT("Prints how actor classes are routed to RepGraph nodes"), FConsoleCommandWithWorldDelegate::CreateStatic(&BEPrintRepNodePolicies));
@@ -0,0 +1,157 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+// Copyright Eigi Chin
+
+#pragma once
+
+#include "ReplicationGraph.h"
+
+#include "BEReplicationGraphTypes.h"
+
+#include "BEReplicationGraph.generated.h"
+
+class AGameplayDebuggerCategoryReplicator;
+class ABETeamPrivateInfo;
+class UBEReplicationGraphNode_AlwaysRelevant_ForConnection;
+class UBEReplicationGraphNode_PlayerStateFrequencyLimiter;
+
+
+/**
+ * UBEReplicationGraph
+ *
+ *	BE Replication Graph implementation.
+ *	Characters and spatialized actors are routed through a 2D grid, team/game state info is always relevant,
+ *	player states are frequency limited and each connection additionally gets its own pawn, view target and team private info.
+ */
+UCLASS(transient, config=Engine)
+class UBEReplicationGraph : public UReplicationGraph
+{
+	GENERATED_BODY()
+
+public:
+	UBEReplicationGraph();
+
+	//~UReplicationGraph interface
+	virtual void ResetGameWorldState() override;
+	virtual void InitGlobalActorClassSettings() override;
+	virtual void InitGlobalGraphNodes() override;
+	virtual void InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection) override;
+	virtual void RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo) override;
+	virtual void RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo) override;
+	virtual int32 ServerReplicateActors(float DeltaSeconds) override;
+	//~End of UReplicationGraph interface
+
+	// Returns the team private info for the given team, or nullptr if it hasn't replicated to the graph yet
+	ABETeamPrivateInfo* FindTeamPrivateInfo(int32 TeamId) const;
+
+	// Logs the rolling replication cost, see BE.RepGraph.PrintReplicationStats
+	void PrintReplicationStats();
+
+	UPROPERTY()
+	TArray<TObjectPtr<UClass>> AlwaysRelevantClasses;
+
+	UPROPERTY()
+	TObjectPtr<UReplicationGraphNode_GridSpatialization2D> GridNode;
+
+	UPROPERTY()
+	TObjectPtr<UReplicationGraphNode_ActorList> AlwaysRelevantNode;
+
+	TMap<FName, FActorRepListRefView> AlwaysRelevantStreamingLevelActors;
+
+#if WITH_GAMEPLAY_DEBUGGER
+	void OnGameplayDebuggerOwnerChange(AGameplayDebuggerCategoryReplicator* Debugger, APlayerController* OldOwner);
+#endif
+
+	void PrintRepNodePolicies();
+
+private:
+	void AddClassRepInfo(UClass* Class, EClassRepNodeMapping Mapping);
+	void RegisterClassRepNodeMapping(UClass* Class);
+	EClassRepNodeMapping GetClassNodeMapping(UClass* Class) const;
+
+	void RegisterClassReplicationInfo(UClass* ReplicatedClass);
+	bool ConditionalInitClassReplicationInfo(UClass* ReplicatedClass, FClassReplicationInfo& ClassInfo);
+	void InitClassReplicationInfo(FClassReplicationInfo& Info, UClass* Class, bool Spatialize) const;
+
+	EClassRepNodeMapping GetMappingPolicy(UClass* Class);
+
+	bool IsSpatialized(EClassRepNodeMapping Mapping) const { return Mapping >= EClassRepNodeMapping::Spatialize_Static; }
+
+	TClassMap<EClassRepNodeMapping> ClassRepNodePolicies;
+
+	/** Classes that had their replication settings explictly set by code in UBEReplicationGraph::InitGlobalActorClassSettings */
+	TArray<UClass*> ExplicitlySetClasses;
+
+	// Team private infos are not routed to any global node, connections pick up the one for their own team
+	TArray<TWeakObjectPtr<ABETeamPrivateInfo>> TeamPrivateInfos;
+
+	// Rolling ServerReplicateActors cost, reset by BE.RepGraph.PrintReplicationStats
+	double ReplicationMsTotal = 0.0;
+	double ReplicationMsMax = 0.0;
+	int32 ReplicationFrameCount = 0;
+	int32 ReplicatedActorsTotal = 0;
+};
+
+
+/**
+ * UBEReplicationGraphNode_AlwaysRelevant_ForConnection
+ *
+ *	Per connection node: the viewers, their view targets and pawns, and the team private info of the connection's team.
+ */
+UCLASS()
+class UBEReplicationGraphNode_AlwaysRelevant_ForConnection : public UReplicationGraphNode_AlwaysRelevant_ForConnection
+{
+	GENERATED_BODY()
+
+public:
+	virtual void NotifyAddNetworkActor(const FNewReplicatedActorInfo& Actor) override { }
+	virtual bool NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound = true) override { return false; }
+	virtual void NotifyResetAllNetworkActors() override { }
+
+	virtual void GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params) override;
+
+	virtual void LogNode(FReplicationGraphDebugInfo& DebugInfo, const FString& NodeName) const override;
+
+	void OnClientLevelVisibilityAdd(FName LevelName, UWorld* StreamingWorld);
+	void OnClientLevelVisibilityRemove(FName LevelName);
+
+	void ResetGameWorldState();
+
+#if WITH_GAMEPLAY_DEBUGGER
+	AGameplayDebuggerCategoryReplicator* GameplayDebugger = nullptr;
+#endif
+
+private:
+	TArray<FName, TInlineAllocator<64>> AlwaysRelevantStreamingLevelsNeedingReplication;
+
+	bool bInitializedPlayerState = false;
+};
+
+
+/**
+ * UBEReplicationGraphNode_PlayerStateFrequencyLimiter
+ *
+ *	This is a specialized node for handling PlayerState replication in a frequency limited fashion. It tracks all player states but only returns a subset of them to the replication driver each frame.
+ */
+UCLASS()
+class UBEReplicationGraphNode_PlayerStateFrequencyLimiter : public UReplicationGraphNode
+{
+	GENERATED_BODY()
+
+public:
+	UBEReplicationGraphNode_PlayerStateFrequencyLimiter();
+
+	virtual void NotifyAddNetworkActor(const FNewReplicatedActorInfo& Actor) override { }
+	virtual bool NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound = true) override { return false; }
+
+	virtual void PrepareForReplication() override;
+	virtual void GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params) override;
+
+	virtual void LogNode(FReplicationGraphDebugInfo& DebugInfo, const FString& NodeName) const override;
+
+	/** How many actors we want to return to the replication driver per frame. Will not suppress ForceNetUpdate. */
+	int32 TargetActorsPerFrame = 2;
+
+private:
+	TArray<FActorRepListRefView> ReplicationActorLists;
+	FActorRepListRefView ForceNetUpdateReplicationActorList;
+};
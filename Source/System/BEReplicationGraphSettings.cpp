@@ -0,0 +1,14 @@
+// Copyright Eigi Chin
+
+#include "BEReplicationGraphSettings.h"
+#include "Misc/App.h"
+#include "System/BEReplicationGraph.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(BEReplicationGraphSettings)
+
+
+UBEReplicationGraphSettings::UBEReplicationGraphSettings()
+{
+	CategoryName = TEXT("Game");
+	DefaultReplicationGraphClass = UBEReplicationGraph::StaticClass();
+}
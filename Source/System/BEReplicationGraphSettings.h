@@ -0,0 +1,60 @@
+// Copyright Eigi Chin
+
+#pragma once
+
+#include "Engine/DeveloperSettingsBackedByCVars.h"
+
+#include "BEReplicationGraphTypes.h"
+
+#include "BEReplicationGraphSettings.generated.h"
+
+
+/**
+ * UBEReplicationGraphSettings
+ *
+ *	Default settings for the BE replication graph
+ */
+UCLASS(config = Game, defaultconfig, meta = (DisplayName = "BE Replication Graph"))
+class UBEReplicationGraphSettings : public UDeveloperSettingsBackedByCVars
+{
+	GENERATED_BODY()
+
+public:
+	UBEReplicationGraphSettings();
+
+public:
+	UPROPERTY(config, EditAnywhere, Category = ReplicationGraph)
+	bool bDisableReplicationGraph = true;
+
+	UPROPERTY(config, EditAnywhere, Category = ReplicationGraph, meta = (MetaClass = "/Script/BECore.BEReplicationGraph"))
+	FSoftClassPath DefaultReplicationGraphClass;
+
+	UPROPERTY(EditAnywhere, Category = DestructionInfo, meta = (ForceUnits = cm, ConsoleVariable = "BE.RepGraph.DestructInfo.MaxDist"))
+	float DestructionInfoMaxDist = 30000.f;
+
+	UPROPERTY(EditAnywhere, Category = SpatialGrid, meta = (ForceUnits = cm, ConsoleVariable = "BE.RepGraph.CellSize"))
+	float SpatialGridCellSize = 10000.0f;
+
+	// Essentially "Min X" for replication. This is just an initial value. The system will reset itself if actors appears outside of this.
+	UPROPERTY(EditAnywhere, Category = SpatialGrid, meta = (ForceUnits = cm, ConsoleVariable = "BE.RepGraph.SpatialBiasX"))
+	float SpatialBiasX = -200000.0f;
+
+	// Essentially "Min Y" for replication. This is just an initial value. The system will reset itself if actors appears outside of this.
+	UPROPERTY(EditAnywhere, Category = SpatialGrid, meta = (ForceUnits = cm, ConsoleVariable = "BE.RepGraph.SpatialBiasY"))
+	float SpatialBiasY = -200000.0f;
+
+	UPROPERTY(EditAnywhere, Category = SpatialGrid, meta = (ConsoleVariable = "BE.RepGraph.DisableSpatialRebuilds"))
+	bool bDisableSpatialRebuilds = true;
+
+	// How many player states are returned to each connection per frame by the player state frequency limiter node
+	UPROPERTY(EditAnywhere, Category = PlayerState, meta = (ClampMin = 1, ConsoleVariable = "BE.RepGraph.PlayerStatesPerFrame"))
+	int32 TargetPlayerStatesPerFrame = 2;
+
+	// Cull distance used for characters, overriding the (very large) NetCullDistanceSquared on ABECharacter. 0 keeps the character's own value.
+	UPROPERTY(EditAnywhere, Category = Character, meta = (ForceUnits = cm, ConsoleVariable = "BE.RepGraph.CharacterCullDistance"))
+	float CharacterCullDistance = 0.0f;
+
+	// Per class routing and cull distance overrides, applied on top of the defaults (e.g. to spatialize pickups with dormancy)
+	UPROPERTY(config, EditAnywhere, Category = ReplicationGraph)
+	TArray<FBERepGraphActorClassSettings> ClassSettings;
+};
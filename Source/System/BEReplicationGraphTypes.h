@@ -0,0 +1,99 @@
+// Copyright Eigi Chin
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/SoftObjectPath.h"
+#include "Misc/PackageName.h"
+#include "BELogChannels.h"
+
+#include "BEReplicationGraphTypes.generated.h"
+
+
+/**
+ * How an actor class is routed into the replication graph nodes
+ */
+UENUM()
+enum class EClassRepNodeMapping : uint32
+{
+	// Doesn't map to any node. Used for special case actors that are handled by special case nodes (e.g. player states)
+	NotRouted,
+
+	// Routes to an AlwaysRelevantNode or AlwaysRelevantStreamingLevelNode node
+	RelevantAllConnections,
+
+	// ONLY SPATIALIZED Enums below here! See UBEReplicationGraph::IsSpatialized
+
+	// Routes to GridNode: these actors don't move and don't need to be updated every frame
+	Spatialize_Static,
+
+	// Routes to GridNode: these actors mode frequently and are updated once per frame
+	Spatialize_Dynamic,
+
+	// Routes to GridNode: While dormant we treat as static. When flushed/not dormant dynamic. Note this is for things that "move while not dormant"
+	Spatialize_Dormancy,
+};
+
+/**
+ * Per class replication graph settings, configured in UBEReplicationGraphSettings
+ */
+USTRUCT()
+struct FBERepGraphActorClassSettings
+{
+	GENERATED_BODY()
+
+	FBERepGraphActorClassSettings() = default;
+
+	// Name of the class the settings will be applied to
+	UPROPERTY(EditAnywhere, meta = (AllowAbstract = "True"))
+	FSoftClassPath ActorClass;
+
+	// If we should add this class' replication info to the ClassRepNodePolicies map
+	UPROPERTY(EditAnywhere, meta = (InlineEditConditionToggle))
+	bool bAddClassRepInfoToMap = true;
+
+	// What ClassNodeMapping we should use when adding the class to the ClassRepNodePolicies map
+	UPROPERTY(EditAnywhere, meta = (EditCondition = "bAddClassRepInfoToMap"))
+	EClassRepNodeMapping ClassNodeMapping = EClassRepNodeMapping::NotRouted;
+
+	// If we should override the cull distance of the class (only used by spatialized classes)
+	UPROPERTY(EditAnywhere, meta = (InlineEditConditionToggle))
+	bool bOverrideCullDistance = false;
+
+	// Distance beyond which the class is no longer relevant to a connection
+	UPROPERTY(EditAnywhere, meta = (EditCondition = "bOverrideCullDistance", ForceUnits = "cm"))
+	float CullDistance = 15000.0f;
+
+	// Should we add this to the RPC_Multicast_OpenChannelForClass map
+	UPROPERTY(EditAnywhere, meta = (InlineEditConditionToggle))
+	bool bAddToRPC_Multicast_OpenChannelForClassMap = false;
+
+	// If this is added to RPC_Multicast_OpenChannelForClass map then should we actually open a channel or not
+	UPROPERTY(EditAnywhere, meta = (EditCondition = "bAddToRPC_Multicast_OpenChannelForClassMap"))
+	bool bRPC_Multicast_OpenChannelForClass = true;
+
+	UClass* GetStaticActorClass() const
+	{
+		UClass* StaticActorClass = nullptr;
+		const FString ActorClassNameString = ActorClass.ToString();
+		if (FPackageName::IsScriptPackage(ActorClassNameString))
+		{
+			StaticActorClass = FindObject<UClass>(nullptr, *ActorClassNameString, true);
+			if (!StaticActorClass)
+			{
+				UE_LOG(LogBERepGraph, Error, TEXT("FBERepGraphActorClassSettings: Cannot Find Static Class for %s"), *ActorClassNameString);
+			}
+		}
+		else
+		{
+			// Allow blueprint classes (e.g. pickups defined in game features) but load them now
+			StaticActorClass = ActorClass.TryLoadClass<AActor>();
+			if (!StaticActorClass)
+			{
+				UE_LOG(LogBERepGraph, Error, TEXT("FBERepGraphActorClassSettings: Cannot Load Class for %s"), *ActorClassNameString);
+			}
+		}
+
+		return StaticActorClass;
+	}
+};
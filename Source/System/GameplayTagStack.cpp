@@ -3,6 +3,7 @@
 #include "GameplayTagStack.h"
 
 #include "Logging/LogVerbosity.h"
+#include "Serialization/Archive.h"
 #include "UObject/Stack.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(GameplayTagStack)
@@ -82,6 +83,68 @@ void FGameplayTagStackContainer::RemoveStack(FGameplayTag Tag, int32 StackCount)
 	}
 }
 
+void FGameplayTagStackContainer::SetStackCount(FGameplayTag Tag, int32 NewCount)
+{
+	if (!Tag.IsValid())
+	{
+		FFrame::KismetExecutionMessage(TEXT("An invalid tag was passed to SetStackCount"), ELogVerbosity::Warning);
+		return;
+	}
+
+	for (auto It = Stacks.CreateIterator(); It; ++It)
+	{
+		FGameplayTagStack& Stack = *It;
+		if (Stack.Tag == Tag)
+		{
+			if (NewCount == 0)
+			{
+				It.RemoveCurrent();
+				TagToCountMap.Remove(Tag);
+				MarkArrayDirty();
+			}
+			else if (Stack.StackCount != NewCount)
+			{
+				Stack.StackCount = NewCount;
+				TagToCountMap[Tag] = NewCount;
+				MarkItemDirty(Stack);
+			}
+			return;
+		}
+	}
+
+	if (NewCount != 0)
+	{
+		FGameplayTagStack& NewStack = Stacks.Emplace_GetRef(Tag, NewCount);
+		MarkItemDirty(NewStack);
+		TagToCountMap.Add(Tag, NewCount);
+	}
+}
+
+void FGameplayTagStackContainer::SerializeAllStacksForMeasurement(FArchive& Ar, UPackageMap* Map) const
+{
+	check(Ar.IsSaving());
+
+	// Delta header: array replication key, base replication key, number of deleted and changed items
+	int32 ArrayKey = ArrayReplicationKey;
+	int32 BaseKey = INDEX_NONE;
+	int32 NumDeletes = 0;
+	int32 NumChanged = Stacks.Num();
+	Ar << ArrayKey << BaseKey << NumDeletes << NumChanged;
+
+	// Each changed item is its replication ID followed by its properties
+	bool bSuccess = true;
+	for (const FGameplayTagStack& Stack : Stacks)
+	{
+		int32 ReplicationID = Stack.ReplicationID;
+		FGameplayTag Tag = Stack.Tag;
+		int32 StackCount = Stack.StackCount;
+
+		Ar << ReplicationID;
+		Tag.NetSerialize(Ar, Map, bSuccess);
+		Ar << StackCount;
+	}
+}
+
 void FGameplayTagStackContainer::PreReplicatedRemove(const TArrayView<int32> RemovedIndices, int32 FinalSize)
 {
 	for (int32 Index : RemovedIndices)
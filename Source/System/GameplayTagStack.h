@@ -16,6 +16,8 @@
 
 #include "GameplayTagStack.generated.h"
 
+class FArchive;
+class UPackageMap;
 struct FGameplayTagStackContainer;
 struct FNetDeltaSerializeInfo;
 
@@ -66,6 +68,26 @@ public:
 	// Removes a specified number of stacks from the tag (does nothing if StackCount is below 1)
 	void RemoveStack(FGameplayTag Tag, int32 StackCount);
 
+	// Sets the stack count of the tag, removing it when NewCount is 0.
+	// Unlike AddStack/RemoveStack, negative counts are kept, for containers that store offsets from a default count.
+	void SetStackCount(FGameplayTag Tag, int32 NewCount);
+
+	// Returns the number of tags with a stack (each is one replicated item)
+	int32 GetNumStacks() const
+	{
+		return Stacks.Num();
+	}
+
+	// Returns every tag with a stack
+	void GetTags(TArray<FGameplayTag>& OutTags) const
+	{
+		TagToCountMap.GetKeys(OutTags);
+	}
+
+	// Writes every stack the way a delta sends them to a connection that has none yet, for measuring the replicated size.
+	// The output is not meant to be read back.
+	void SerializeAllStacksForMeasurement(FArchive& Ar, UPackageMap* Map) const;
+
 	// Returns the stack count of the specified tag (or 0 if the tag is not present)
 	int32 GetStackCount(FGameplayTag Tag) const
 	{
@@ -9,5 +9,5 @@
 ABETeamPrivateInfo::ABETeamPrivateInfo(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
-	//@TODO: Actually make private (using replication graph)
+	// Only replicated to members of the team when UBEReplicationGraph is enabled, see UBEReplicationGraphNode_AlwaysRelevant_ForConnection
 }
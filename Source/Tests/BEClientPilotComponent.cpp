@@ -0,0 +1,161 @@
+// Copyright Eigi Chin
+
+#include "BEClientPilotComponent.h"
+
+#include "Ability/BEAbilitySystemComponent.h"
+#include "Character/Component/BEPawnBasicComponent.h"
+#include "GameplayTag/BETags_Input.h"
+
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/PlatformTime.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(BEClientPilotComponent)
+
+
+UBEClientPilotComponent::UBEClientPilotComponent()
+{
+}
+
+void UBEClientPilotComponent::InitializePilot(APlayerController* InPlayerController, int32 Seed)
+{
+	PlayerController = InPlayerController;
+	RandomStream.Initialize(Seed);
+
+	TimeUntilDirectionChange = 0.0f;
+	TimeUntilFire = RandomStream.FRandRange(FireInterval.X, FireInterval.Y);
+	TimeUntilInteract = RandomStream.FRandRange(InteractInterval.X, InteractInterval.Y);
+	TimeUntilJump = RandomStream.FRandRange(JumpInterval.X, JumpInterval.Y);
+
+	LastThinkTime = FPlatformTime::Seconds();
+}
+
+void UBEClientPilotComponent::ThinkAndAct()
+{
+	const double Now = FPlatformTime::Seconds();
+	const float DeltaTime = static_cast<float>(Now - LastThinkTime);
+	LastThinkTime = Now;
+
+	APlayerController* PC = PlayerController.Get();
+	APawn* Pawn = PC ? PC->GetPawn() : nullptr;
+
+	UBEAbilitySystemComponent* BEASC = nullptr;
+	if (const UBEPawnBasicComponent* PawnBasic = Pawn ? UBEPawnBasicComponent::FindPawnBasicComponent(Pawn) : nullptr)
+	{
+		BEASC = PawnBasic->GetBEAbilitySystemComponent();
+	}
+
+	// Drop held inputs when the pawn changes (death, respawn) so nothing is left pressed on the old ability system
+	if (CachedASC.Get() != BEASC)
+	{
+		ReleaseAllInputTags();
+		CachedASC = BEASC;
+	}
+
+	if (!Pawn || !BEASC)
+	{
+		return;
+	}
+
+	UpdateMovement(Pawn, DeltaTime);
+	UpdateAbilityInput(BEASC, DeltaTime);
+}
+
+void UBEClientPilotComponent::UpdateMovement(APawn* Pawn, float DeltaTime)
+{
+	APlayerController* PC = PlayerController.Get();
+	check(PC);
+
+	TimeUntilDirectionChange -= DeltaTime;
+	if (TimeUntilDirectionChange <= 0.0f)
+	{
+		TargetYaw = RandomStream.FRandRange(-180.0f, 180.0f);
+		TimeUntilDirectionChange = RandomStream.FRandRange(DirectionChangeInterval.X, DirectionChangeInterval.Y);
+	}
+
+	// Turn towards the target direction, then move forward like a player holding the stick would
+
+	FRotator ControlRotation = PC->GetControlRotation();
+	const float YawDelta = FMath::FindDeltaAngleDegrees(ControlRotation.Yaw, TargetYaw);
+	const float MaxYawStep = TurnRateDegrees * DeltaTime;
+	ControlRotation.Yaw += FMath::Clamp(YawDelta, -MaxYawStep, MaxYawStep);
+	PC->SetControlRotation(ControlRotation);
+
+	const FRotator MovementRotation(0.0f, ControlRotation.Yaw, 0.0f);
+	Pawn->AddMovementInput(MovementRotation.RotateVector(FVector::ForwardVector), 1.0f);
+}
+
+void UBEClientPilotComponent::UpdateAbilityInput(UBEAbilitySystemComponent* BEASC, float DeltaTime)
+{
+	// Fire
+
+	if (FireTimeRemaining > 0.0f)
+	{
+		FireTimeRemaining -= DeltaTime;
+		if (FireTimeRemaining <= 0.0f)
+		{
+			ReleaseInputTag(BEASC, TAG_Input_Ability_Weapon_Attack);
+			TimeUntilFire = RandomStream.FRandRange(FireInterval.X, FireInterval.Y);
+		}
+	}
+	else
+	{
+		TimeUntilFire -= DeltaTime;
+		if (TimeUntilFire <= 0.0f)
+		{
+			PressInputTag(BEASC, TAG_Input_Ability_Weapon_Attack);
+			FireTimeRemaining = RandomStream.FRandRange(FireDuration.X, FireDuration.Y);
+		}
+	}
+
+	// Interact and jump are single presses, released on the next think
+
+	ReleaseInputTag(BEASC, TAG_Input_Ability_Interact);
+	ReleaseInputTag(BEASC, TAG_Input_Ability_Jump);
+
+	TimeUntilInteract -= DeltaTime;
+	if (TimeUntilInteract <= 0.0f)
+	{
+		PressInputTag(BEASC, TAG_Input_Ability_Interact);
+		TimeUntilInteract = RandomStream.FRandRange(InteractInterval.X, InteractInterval.Y);
+	}
+
+	TimeUntilJump -= DeltaTime;
+	if (TimeUntilJump <= 0.0f)
+	{
+		PressInputTag(BEASC, TAG_Input_Ability_Jump);
+		TimeUntilJump = RandomStream.FRandRange(JumpInterval.X, JumpInterval.Y);
+	}
+}
+
+void UBEClientPilotComponent::PressInputTag(UBEAbilitySystemComponent* BEASC, const FGameplayTag& InputTag)
+{
+	if (!HeldInputTags.HasTagExact(InputTag))
+	{
+		HeldInputTags.AddTag(InputTag);
+		BEASC->AbilityInputTagPressed(InputTag);
+	}
+}
+
+void UBEClientPilotComponent::ReleaseInputTag(UBEAbilitySystemComponent* BEASC, const FGameplayTag& InputTag)
+{
+	if (HeldInputTags.HasTagExact(InputTag))
+	{
+		HeldInputTags.RemoveTag(InputTag);
+		BEASC->AbilityInputTagReleased(InputTag);
+	}
+}
+
+void UBEClientPilotComponent::ReleaseAllInputTags()
+{
+	if (UBEAbilitySystemComponent* BEASC = CachedASC.Get())
+	{
+		for (const FGameplayTag& InputTag : HeldInputTags)
+		{
+			BEASC->AbilityInputTagReleased(InputTag);
+		}
+	}
+
+	HeldInputTags.Reset();
+	FireTimeRemaining = 0.0f;
+}
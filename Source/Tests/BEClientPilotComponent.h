@@ -0,0 +1,89 @@
+// Copyright Eigi Chin
+
+#pragma once
+
+#include "ClientPilotComponent.h"
+
+#include "GameplayTagContainer.h"
+#include "Math/RandomStream.h"
+
+#include "BEClientPilotComponent.generated.h"
+
+class APawn;
+class APlayerController;
+class UBEAbilitySystemComponent;
+
+
+/**
+ * UBEClientPilotComponent
+ *
+ *	Drives a headless client during load tests.
+ *	The pilot wanders around, fires and interacts through the same input tag path that player input uses,
+ *	so abilities are activated on the client and replicated to the server like they would be for a real player.
+ */
+UCLASS()
+class UBEClientPilotComponent : public UClientPilotComponent
+{
+	GENERATED_BODY()
+
+public:
+	UBEClientPilotComponent();
+
+	//~UClientPilotComponent interface
+	virtual void ThinkAndAct() override;
+	//~End of UClientPilotComponent interface
+
+	void InitializePilot(APlayerController* InPlayerController, int32 Seed);
+
+protected:
+	void UpdateMovement(APawn* Pawn, float DeltaTime);
+	void UpdateAbilityInput(UBEAbilitySystemComponent* BEASC, float DeltaTime);
+
+	void PressInputTag(UBEAbilitySystemComponent* BEASC, const FGameplayTag& InputTag);
+	void ReleaseInputTag(UBEAbilitySystemComponent* BEASC, const FGameplayTag& InputTag);
+
+	void ReleaseAllInputTags();
+
+protected:
+	// Seconds between picking a new direction to move in
+	UPROPERTY(EditDefaultsOnly, Category = "Pilot")
+	FVector2D DirectionChangeInterval = FVector2D(2.0f, 6.0f);
+
+	// Seconds between bursts of fire
+	UPROPERTY(EditDefaultsOnly, Category = "Pilot")
+	FVector2D FireInterval = FVector2D(1.0f, 4.0f);
+
+	// How long the attack input is held for each burst
+	UPROPERTY(EditDefaultsOnly, Category = "Pilot")
+	FVector2D FireDuration = FVector2D(0.2f, 1.5f);
+
+	// Seconds between interact presses
+	UPROPERTY(EditDefaultsOnly, Category = "Pilot")
+	FVector2D InteractInterval = FVector2D(5.0f, 15.0f);
+
+	// Seconds between jumps
+	UPROPERTY(EditDefaultsOnly, Category = "Pilot")
+	FVector2D JumpInterval = FVector2D(3.0f, 10.0f);
+
+	// Maximum yaw rate while turning towards the new direction
+	UPROPERTY(EditDefaultsOnly, Category = "Pilot")
+	float TurnRateDegrees = 180.0f;
+
+private:
+	TWeakObjectPtr<APlayerController> PlayerController;
+
+	TWeakObjectPtr<UBEAbilitySystemComponent> CachedASC;
+
+	FRandomStream RandomStream;
+
+	FGameplayTagContainer HeldInputTags;
+
+	double LastThinkTime = 0.0;
+
+	float TargetYaw = 0.0f;
+	float TimeUntilDirectionChange = 0.0f;
+	float TimeUntilFire = 0.0f;
+	float FireTimeRemaining = 0.0f;
+	float TimeUntilInteract = 0.0f;
+	float TimeUntilJump = 0.0f;
+};
@@ -0,0 +1,336 @@
+// Copyright Eigi Chin
+
+#include "BETestControllerLoadTest.h"
+
+#include "BEClientPilotComponent.h"
+#include "BELogChannels.h"
+
+#include "Dom/JsonObject.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "UObject/UObjectGlobals.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(BETestControllerLoadTest)
+
+
+//////////////////////////////////////////////////////////////////////
+
+namespace BELoadTest
+{
+	static double GetPercentile(TArray<float> Values, double Percentile)
+	{
+		if (Values.Num() == 0)
+		{
+			return 0.0;
+		}
+
+		Values.Sort();
+		const int32 Index = FMath::Clamp(FMath::CeilToInt(Percentile * Values.Num()) - 1, 0, Values.Num() - 1);
+		return Values[Index];
+	}
+
+	static double GetAverage(const TArray<float>& Values)
+	{
+		double Total = 0.0;
+		for (float Value : Values)
+		{
+			Total += Value;
+		}
+		return Values.Num() > 0 ? Total / Values.Num() : 0.0;
+	}
+
+	static double GetMax(const TArray<float>& Values)
+	{
+		return Values.Num() > 0 ? FMath::Max(Values) : 0.0;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////
+
+void UBETestControllerLoadTest::OnInit()
+{
+	Super::OnInit();
+
+	const TCHAR* CommandLine = FCommandLine::Get();
+
+	FParse::Value(CommandLine, TEXT("BELoadTest.Clients="), ExpectedClients);
+	FParse::Value(CommandLine, TEXT("BELoadTest.ConnectTimeout="), ConnectTimeoutSeconds);
+	FParse::Value(CommandLine, TEXT("BELoadTest.Warmup="), WarmupSeconds);
+	FParse::Value(CommandLine, TEXT("BELoadTest.Duration="), DurationSeconds);
+	FParse::Value(CommandLine, TEXT("BELoadTest.MaxFrameMs="), MaxFrameMs);
+	FParse::Value(CommandLine, TEXT("BELoadTest.MaxOutKBpsPerClient="), MaxOutKBpsPerClient);
+	FParse::Value(CommandLine, TEXT("BELoadTest.MaxGCMs="), MaxGCMs);
+
+	if (!FParse::Value(CommandLine, TEXT("BELoadTest.Report="), ReportPath))
+	{
+		ReportPath = FPaths::ProfilingDir() / TEXT("LoadTest.json");
+	}
+
+	PreGCHandle = FCoreUObjectDelegates::GetPreGarbageCollectDelegate().AddUObject(this, &ThisClass::HandlePreGarbageCollect);
+	PostGCHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddUObject(this, &ThisClass::HandlePostGarbageCollect);
+
+	Phase = ELoadTestPhase::WaitingForClients;
+	PhaseStartTime = FPlatformTime::Seconds();
+
+	UE_LOG(LogBE, Display, TEXT("Load test initialized: %d clients, %.0f seconds warmup, %.0f seconds measured"), ExpectedClients, WarmupSeconds, DurationSeconds);
+}
+
+void UBETestControllerLoadTest::BeginDestroy()
+{
+	FCoreUObjectDelegates::GetPreGarbageCollectDelegate().Remove(PreGCHandle);
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGCHandle);
+
+	Super::BeginDestroy();
+}
+
+void UBETestControllerLoadTest::OnPostMapChange(UWorld* World)
+{
+	Super::OnPostMapChange(World);
+
+	// The pilot is recreated for the new player controller after travel
+	PilotComponent = nullptr;
+}
+
+void UBETestControllerLoadTest::OnTick(float TimeDelta)
+{
+	Super::OnTick(TimeDelta);
+
+	if (IsRunningDedicatedServer())
+	{
+		TickServer(TimeDelta);
+	}
+	else
+	{
+		TickClient(TimeDelta);
+	}
+}
+
+void UBETestControllerLoadTest::TickClient(float TimeDelta)
+{
+	const double TimeInPhase = FPlatformTime::Seconds() - PhaseStartTime;
+
+	// Clients don't know when the server starts measuring, so they just run long enough to cover connect, warmup and measurement
+	if (TimeInPhase > ConnectTimeoutSeconds + WarmupSeconds + DurationSeconds)
+	{
+		UE_LOG(LogBE, Display, TEXT("Load test client finished"));
+		EndTest(0);
+		return;
+	}
+
+	if (!PilotComponent)
+	{
+		if (APlayerController* PC = GetFirstPlayerController())
+		{
+			PilotComponent = NewObject<UBEClientPilotComponent>(this);
+			PilotComponent->InitializePilot(PC, FPlatformProcess::GetCurrentProcessId());
+		}
+	}
+
+	if (PilotComponent)
+	{
+		PilotComponent->ThinkAndAct();
+	}
+}
+
+void UBETestControllerLoadTest::TickServer(float TimeDelta)
+{
+	const double Now = FPlatformTime::Seconds();
+	const double TimeInPhase = Now - PhaseStartTime;
+
+	switch (Phase)
+	{
+	case ELoadTestPhase::WaitingForClients:
+		if (GetNumClientConnections() >= ExpectedClients)
+		{
+			UE_LOG(LogBE, Display, TEXT("Load test: %d clients connected after %.1f seconds, warming up"), GetNumClientConnections(), TimeInPhase);
+			Phase = ELoadTestPhase::Warmup;
+			PhaseStartTime = Now;
+		}
+		else if (TimeInPhase > ConnectTimeoutSeconds)
+		{
+			UE_LOG(LogBE, Error, TEXT("Load test: only %d of %d clients connected within %.0f seconds"), GetNumClientConnections(), ExpectedClients, ConnectTimeoutSeconds);
+			WriteReport(false, { FString::Printf(TEXT("Only %d of %d clients connected"), GetNumClientConnections(), ExpectedClients) });
+			Phase = ELoadTestPhase::Done;
+			EndTest(1);
+		}
+		break;
+
+	case ELoadTestPhase::Warmup:
+		if (TimeInPhase > WarmupSeconds)
+		{
+			Phase = ELoadTestPhase::Measuring;
+			PhaseStartTime = Now;
+
+			NumGCs = 0;
+			TotalGCMs = 0.0;
+			LongestGCMs = 0.0;
+		}
+		break;
+
+	case ELoadTestPhase::Measuring:
+		SampleServerFrame();
+
+		if (TimeInPhase > DurationSeconds)
+		{
+			FinishServerTest();
+		}
+		break;
+
+	case ELoadTestPhase::Done:
+		break;
+	}
+}
+
+int32 UBETestControllerLoadTest::GetNumClientConnections() const
+{
+	const UWorld* World = GetWorld();
+	const UNetDriver* NetDriver = World ? World->GetNetDriver() : nullptr;
+	return NetDriver ? NetDriver->ClientConnections.Num() : 0;
+}
+
+void UBETestControllerLoadTest::SampleServerFrame()
+{
+	// The idle time is the wait for the tick rate, what is left is the time the server worked on the frame (same as FBEServerFrameStats)
+	const double DeltaTime = FApp::GetDeltaTime();
+	FrameTimesMs.Add(FMath::Max(DeltaTime - FApp::GetIdleTime(), 0.0) * 1000.0f);
+
+	if (const UNetDriver* NetDriver = GetWorld() ? GetWorld()->GetNetDriver() : nullptr)
+	{
+		// The net driver updates these once per second, sampling them every frame weights each second equally
+		OutKBps.Add(NetDriver->OutBytesPerSecond / 1024.0f);
+		InKBps.Add(NetDriver->InBytesPerSecond / 1024.0f);
+	}
+
+	MinConnections = FMath::Min(MinConnections, GetNumClientConnections());
+}
+
+void UBETestControllerLoadTest::HandlePreGarbageCollect()
+{
+	GCStartTime = FPlatformTime::Seconds();
+}
+
+void UBETestControllerLoadTest::HandlePostGarbageCollect()
+{
+	if ((Phase != ELoadTestPhase::Measuring) || (GCStartTime <= 0.0))
+	{
+		return;
+	}
+
+	const double GCMs = (FPlatformTime::Seconds() - GCStartTime) * 1000.0;
+	GCStartTime = 0.0;
+
+	++NumGCs;
+	TotalGCMs += GCMs;
+	LongestGCMs = FMath::Max(LongestGCMs, GCMs);
+}
+
+void UBETestControllerLoadTest::FinishServerTest()
+{
+	Phase = ELoadTestPhase::Done;
+
+	TArray<FString> Failures;
+	const bool bPassed = CheckThresholds(Failures);
+
+	for (const FString& Failure : Failures)
+	{
+		UE_LOG(LogBE, Error, TEXT("Load test: %s"), *Failure);
+	}
+
+	WriteReport(bPassed, Failures);
+
+	UE_LOG(LogBE, Display, TEXT("Load test %s"), bPassed ? TEXT("passed") : TEXT("failed"));
+	EndTest(bPassed ? 0 : 1);
+}
+
+bool UBETestControllerLoadTest::CheckThresholds(TArray<FString>& OutFailures) const
+{
+	const double FrameMsP95 = BELoadTest::GetPercentile(FrameTimesMs, 0.95);
+	if ((MaxFrameMs > 0.0) && (FrameMsP95 > MaxFrameMs))
+	{
+		OutFailures.Add(FString::Printf(TEXT("95th percentile server frame work time %.2f ms exceeds %.2f ms"), FrameMsP95, MaxFrameMs));
+	}
+
+	const double OutKBpsPerClient = BELoadTest::GetAverage(OutKBps) / FMath::Max(ExpectedClients, 1);
+	if ((MaxOutKBpsPerClient > 0.0) && (OutKBpsPerClient > MaxOutKBpsPerClient))
+	{
+		OutFailures.Add(FString::Printf(TEXT("Average outgoing bandwidth %.2f KB/s per client exceeds %.2f KB/s"), OutKBpsPerClient, MaxOutKBpsPerClient));
+	}
+
+	if ((MaxGCMs > 0.0) && (LongestGCMs > MaxGCMs))
+	{
+		OutFailures.Add(FString::Printf(TEXT("Longest garbage collection %.2f ms exceeds %.2f ms"), LongestGCMs, MaxGCMs));
+	}
+
+	if (MinConnections < ExpectedClients)
+	{
+		OutFailures.Add(FString::Printf(TEXT("Client connections dropped to %d of %d during the test"), MinConnections, ExpectedClients));
+	}
+
+	return OutFailures.Num() == 0;
+}
+
+void UBETestControllerLoadTest::WriteReport(bool bPassed, const TArray<FString>& Failures) const
+{
+	TSharedRef<FJsonObject> RootObject = MakeShared<FJsonObject>();
+	RootObject->SetStringField(TEXT("project"), FApp::GetProjectName());
+	RootObject->SetStringField(TEXT("map"), GetCurrentMap());
+	RootObject->SetNumberField(TEXT("expectedClients"), ExpectedClients);
+	RootObject->SetNumberField(TEXT("minClients"), MinConnections == MAX_int32 ? 0 : MinConnections);
+	RootObject->SetNumberField(TEXT("durationSeconds"), DurationSeconds);
+	RootObject->SetNumberField(TEXT("frames"), FrameTimesMs.Num());
+	RootObject->SetBoolField(TEXT("passed"), bPassed);
+
+	TSharedRef<FJsonObject> FrameObject = MakeShared<FJsonObject>();
+	FrameObject->SetNumberField(TEXT("avgMs"), BELoadTest::GetAverage(FrameTimesMs));
+	FrameObject->SetNumberField(TEXT("p50Ms"), BELoadTest::GetPercentile(FrameTimesMs, 0.50));
+	FrameObject->SetNumberField(TEXT("p95Ms"), BELoadTest::GetPercentile(FrameTimesMs, 0.95));
+	FrameObject->SetNumberField(TEXT("p99Ms"), BELoadTest::GetPercentile(FrameTimesMs, 0.99));
+	FrameObject->SetNumberField(TEXT("maxMs"), BELoadTest::GetMax(FrameTimesMs));
+	RootObject->SetObjectField(TEXT("serverFrameTime"), FrameObject);
+
+	TSharedRef<FJsonObject> BandwidthObject = MakeShared<FJsonObject>();
+	BandwidthObject->SetNumberField(TEXT("avgOutKBps"), BELoadTest::GetAverage(OutKBps));
+	BandwidthObject->SetNumberField(TEXT("maxOutKBps"), BELoadTest::GetMax(OutKBps));
+	BandwidthObject->SetNumberField(TEXT("avgInKBps"), BELoadTest::GetAverage(InKBps));
+	BandwidthObject->SetNumberField(TEXT("maxInKBps"), BELoadTest::GetMax(InKBps));
+	BandwidthObject->SetNumberField(TEXT("avgOutKBpsPerClient"), BELoadTest::GetAverage(OutKBps) / FMath::Max(ExpectedClients, 1));
+	RootObject->SetObjectField(TEXT("bandwidth"), BandwidthObject);
+
+	TSharedRef<FJsonObject> GCObject = MakeShared<FJsonObject>();
+	GCObject->SetNumberField(TEXT("count"), NumGCs);
+	GCObject->SetNumberField(TEXT("totalMs"), TotalGCMs);
+	GCObject->SetNumberField(TEXT("longestMs"), LongestGCMs);
+	RootObject->SetObjectField(TEXT("garbageCollection"), GCObject);
+
+	TArray<TSharedPtr<FJsonValue>> FailureValues;
+	for (const FString& Failure : Failures)
+	{
+		FailureValues.Add(MakeShared<FJsonValueString>(Failure));
+	}
+	RootObject->SetArrayField(TEXT("failures"), FailureValues);
+
+	FString JsonString;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonString);
+	FJsonSerializer::Serialize(RootObject, Writer);
+
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(ReportPath), true);
+
+	if (FFileHelper::SaveStringToFile(JsonString, *ReportPath))
+	{
+		UE_LOG(LogBE, Display, TEXT("Load test report written to %s"), *IFileManager::Get().ConvertToAbsolutePathForExternalAppForWrite(*ReportPath));
+	}
+	else
+	{
+		UE_LOG(LogBE, Error, TEXT("Failed to write load test report to %s"), *ReportPath);
+	}
+}
@@ -0,0 +1,104 @@
+// Copyright Eigi Chin
+
+#pragma once
+
+#include "GauntletTestController.h"
+
+#include "BETestControllerLoadTest.generated.h"
+
+class UBEClientPilotComponent;
+
+
+/**
+ * UBETestControllerLoadTest
+ *
+ *	Gauntlet controller for headless load tests, enabled with -gauntlet=BETestControllerLoadTest on the server and every client.
+ *
+ *	Clients (-nullrhi) are driven by UBEClientPilotComponent until the test duration elapses.
+ *	The dedicated server waits for the expected number of clients, samples frame work time (without the wait for the tick rate),
+ *	bandwidth and GC for the test duration, then writes a JSON report and exits with a non-zero code if a threshold was exceeded.
+ *
+ *	There is no Gauntlet C# node for this test in the plugin, start the processes directly (or from the project's own node):
+ *		<Project>Server <Map> -log -gauntlet=BETestControllerLoadTest -BELoadTest.Clients=N [options]
+ *		<Project>Client <ServerAddress> -nullrhi -nosound -unattended -gauntlet=BETestControllerLoadTest	(N times)
+ *	The exit code of the server is the result of the test.
+ *
+ *	-BELoadTest.Clients=N				Number of client connections to wait for before measuring (default 1).
+ *	-BELoadTest.ConnectTimeout=N		Seconds to wait for clients before failing (default 300).
+ *	-BELoadTest.Warmup=N				Seconds to wait after all clients connected before measuring (default 10).
+ *	-BELoadTest.Duration=N				Seconds to measure for (default 120).
+ *	-BELoadTest.Report=Path				Report path, Saved/Profiling/LoadTest.json by default.
+ *	-BELoadTest.MaxFrameMs=N			Fails if the 95th percentile server frame work time exceeds N ms.
+ *	-BELoadTest.MaxOutKBpsPerClient=N	Fails if the average outgoing server bandwidth per client exceeds N KB/s.
+ *	-BELoadTest.MaxGCMs=N				Fails if a single garbage collection takes longer than N ms.
+ */
+UCLASS()
+class UBETestControllerLoadTest : public UGauntletTestController
+{
+	GENERATED_BODY()
+
+protected:
+	//~UGauntletTestController interface
+	virtual void OnInit() override;
+	virtual void OnPostMapChange(UWorld* World) override;
+	virtual void OnTick(float TimeDelta) override;
+	virtual void BeginDestroy() override;
+	//~End of UGauntletTestController interface
+
+private:
+	enum class ELoadTestPhase : uint8
+	{
+		WaitingForClients,
+		Warmup,
+		Measuring,
+		Done
+	};
+
+	void TickServer(float TimeDelta);
+	void TickClient(float TimeDelta);
+
+	int32 GetNumClientConnections() const;
+
+	void SampleServerFrame();
+
+	void HandlePreGarbageCollect();
+	void HandlePostGarbageCollect();
+
+	void FinishServerTest();
+	bool CheckThresholds(TArray<FString>& OutFailures) const;
+	void WriteReport(bool bPassed, const TArray<FString>& Failures) const;
+
+private:
+	UPROPERTY(Transient)
+	TObjectPtr<UBEClientPilotComponent> PilotComponent;
+
+	ELoadTestPhase Phase = ELoadTestPhase::WaitingForClients;
+	double PhaseStartTime = 0.0;
+
+	// Settings
+
+	int32 ExpectedClients = 1;
+	double ConnectTimeoutSeconds = 300.0;
+	double WarmupSeconds = 10.0;
+	double DurationSeconds = 120.0;
+	FString ReportPath;
+	double MaxFrameMs = 0.0;
+	double MaxOutKBpsPerClient = 0.0;
+	double MaxGCMs = 0.0;
+
+	// Measurements
+
+	// Time the server worked on each frame, without the wait for the tick rate
+	TArray<float> FrameTimesMs;
+	TArray<float> OutKBps;
+	TArray<float> InKBps;
+	int32 MinConnections = MAX_int32;
+
+	int32 NumGCs = 0;
+	double TotalGCMs = 0.0;
+	double LongestGCMs = 0.0;
+	double GCStartTime = 0.0;
+
+	FDelegateHandle PreGCHandle;
+	FDelegateHandle PostGCHandle;
+};
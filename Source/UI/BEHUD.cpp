@@ -3,9 +3,12 @@
 
 #include "BEHUD.h"
 
+#include "UI/Subsystem/BEUIManagerSubsystem.h"
+
 #include "AbilitySystemComponent.h"
 #include "AbilitySystemGlobals.h"
 #include "Components/GameFrameworkComponentManager.h"
+#include "Engine/GameInstance.h"
 #include "Engine/EngineBaseTypes.h"
 #include "UObject/UObjectIterator.h"
 
@@ -36,6 +39,8 @@ void ABEHUD::BeginPlay()
 	UGameFrameworkComponentManager::SendGameFrameworkComponentExtensionEvent(this, UGameFrameworkComponentManager::NAME_GameActorReady);
 
 	Super::BeginPlay();
+
+	NotifyShowHUDChanged();
 }
 
 void ABEHUD::EndPlay(const EEndPlayReason::Type EndPlayReason)
@@ -45,6 +50,34 @@ void ABEHUD::EndPlay(const EEndPlayReason::Type EndPlayReason)
 	Super::EndPlay(EndPlayReason);
 }
 
+void ABEHUD::ShowHUD()
+{
+	Super::ShowHUD();
+
+	NotifyShowHUDChanged();
+}
+
+void ABEHUD::SetShowHUD(bool bNewShowHUD)
+{
+	if (bShowHUD != bNewShowHUD)
+	{
+		bShowHUD = bNewShowHUD;
+
+		NotifyShowHUDChanged();
+	}
+}
+
+void ABEHUD::NotifyShowHUDChanged()
+{
+	if (const UGameInstance* GameInstance = GetGameInstance())
+	{
+		if (UBEUIManagerSubsystem* UIManager = GameInstance->GetSubsystem<UBEUIManagerSubsystem>())
+		{
+			UIManager->SyncRootLayoutVisibilityToShowHUD();
+		}
+	}
+}
+
 void ABEHUD::GetDebugActorList(TArray<AActor*>& InOutList)
 {
 	UWorld* World = GetWorld();
@@ -31,6 +31,13 @@ class ABEHUD : public AHUD
 public:
 	ABEHUD(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
 
+	// Use this instead of writing bShowHUD directly, the root layouts are only synced when they are notified
+	UFUNCTION(BlueprintCallable, Category = "HUD")
+	void SetShowHUD(bool bNewShowHUD);
+
+	// The root layouts follow bShowHUD, they are only synced when it may have changed
+	void NotifyShowHUDChanged();
+
 protected:
 
 	//~UObject interface
@@ -43,6 +50,7 @@ protected:
 	//~End of AActor interface
 
 	//~AHUD interface
+	virtual void ShowHUD() override;
 	virtual void GetDebugActorList(TArray<AActor*>& InOutList) override;
 	//~End of AHUD interface
 };
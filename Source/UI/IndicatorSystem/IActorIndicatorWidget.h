@@ -28,3 +28,22 @@ public:
 	UFUNCTION(BlueprintNativeEvent, Category = "Indicator")
 	void UnbindIndicator(const UIndicatorDescriptor* Indicator);
 };
+
+UINTERFACE(BlueprintType)
+class BECORE_API UIndicatorClusterWidgetInterface : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+ * Implemented by the widget an indicator layer shows in place of indicators that overlap on screen.
+ */
+class IIndicatorClusterWidgetInterface
+{
+	GENERATED_BODY()
+
+public:
+	// Called whenever the indicators merged into the cluster change, most important first
+	UFUNCTION(BlueprintNativeEvent, Category = "Indicator")
+	void SetClusteredIndicators(const TArray<UIndicatorDescriptor*>& Indicators);
+};
@@ -2,101 +2,150 @@
 
 #include "IndicatorDescriptor.h"
 #include "Engine/LocalPlayer.h"
+#include "GameFramework/Actor.h"
 
-bool FIndicatorProjection::Project(const UIndicatorDescriptor& IndicatorDescriptor, const FSceneViewProjectionData& InProjectionData, const FVector2D& ScreenSize, FVector& OutScreenPositionWithDepth)
+bool FIndicatorProjection::Project(UIndicatorDescriptor& IndicatorDescriptor, const FSceneViewProjectionData& InProjectionData, const FVector2D& ScreenSize, FVector& OutScreenPositionWithDepth)
+{
+	FVector WorldLocation;
+	FBox Bounds;
+	if (GatherWorldState(IndicatorDescriptor, WorldLocation, Bounds))
+	{
+		return ProjectWorldState(IndicatorDescriptor.GetProjectionMode(), WorldLocation, Bounds, IndicatorDescriptor.GetBoundingBoxAnchor(), IndicatorDescriptor.GetScreenSpaceOffset(),
+			InProjectionData, ScreenSize, OutScreenPositionWithDepth);
+	}
+
+	return false;
+}
+
+bool FIndicatorProjection::GatherWorldState(UIndicatorDescriptor& IndicatorDescriptor, FVector& OutWorldLocation, FBox& OutBounds)
 {
 	if (USceneComponent* Component = IndicatorDescriptor.GetSceneComponent())
 	{
-		TOptional<FVector> WorldLocation;
 		if (IndicatorDescriptor.GetComponentSocketName() != NAME_None)
 		{
-			WorldLocation = Component->GetSocketTransform(IndicatorDescriptor.GetComponentSocketName()).GetLocation();
+			OutWorldLocation = Component->GetSocketTransform(IndicatorDescriptor.GetComponentSocketName()).GetLocation();
 		}
 		else
 		{
-			WorldLocation = Component->GetComponentLocation();
+			OutWorldLocation = Component->GetComponentLocation();
 		}
 
-		const FVector ProjectWorldLocation = WorldLocation.GetValue() + IndicatorDescriptor.GetWorldPositionOffset();
-		const EActorCanvasProjectionMode ProjectionMode = IndicatorDescriptor.GetProjectionMode();
-		
-		switch (ProjectionMode)
+		OutWorldLocation += IndicatorDescriptor.GetWorldPositionOffset();
+
+		switch (IndicatorDescriptor.GetProjectionMode())
 		{
-			case EActorCanvasProjectionMode::ComponentPoint:
+			case EActorCanvasProjectionMode::ActorBoundingBox:
+			case EActorCanvasProjectionMode::ActorScreenBoundingBox:
+				OutBounds = IndicatorDescriptor.GetActorBoundingBox();
+				break;
+			case EActorCanvasProjectionMode::ComponentBoundingBox:
+			case EActorCanvasProjectionMode::ComponentScreenBoundingBox:
+				OutBounds = Component->Bounds.GetBox();
+				break;
+			default:
+				OutBounds.Init();
+				break;
+		}
+
+		return true;
+	}
+
+	return false;
+}
+
+bool FIndicatorProjection::ProjectWorldState(EActorCanvasProjectionMode ProjectionMode, const FVector& WorldLocation, const FBox& Bounds, const FVector& BoundingBoxAnchor, const FVector2D& ScreenSpaceOffset,
+	const FSceneViewProjectionData& InProjectionData, const FVector2D& ScreenSize, FVector& OutScreenPositionWithDepth)
+{
+	switch (ProjectionMode)
+	{
+		case EActorCanvasProjectionMode::ComponentPoint:
+		{
+			FVector2D OutScreenSpacePosition;
+			if (ULocalPlayer::GetPixelPoint(InProjectionData, WorldLocation, OutScreenSpacePosition, &ScreenSize))
 			{
-				if (WorldLocation.IsSet())
-				{
-					FVector2D OutScreenSpacePosition;
-					if (ULocalPlayer::GetPixelPoint(InProjectionData, ProjectWorldLocation, OutScreenSpacePosition, &ScreenSize))
-					{
-						OutScreenSpacePosition += IndicatorDescriptor.GetScreenSpaceOffset();
-
-						OutScreenPositionWithDepth = FVector(OutScreenSpacePosition.X, OutScreenSpacePosition.Y, FVector::Dist(InProjectionData.ViewOrigin, ProjectWorldLocation));
-						return true;
-					}
-				}
-
-				return false;
+				OutScreenSpacePosition += ScreenSpaceOffset;
+
+				OutScreenPositionWithDepth = FVector(OutScreenSpacePosition.X, OutScreenSpacePosition.Y, FVector::Dist(InProjectionData.ViewOrigin, WorldLocation));
+				return true;
 			}
-			case EActorCanvasProjectionMode::ComponentScreenBoundingBox:
-			case EActorCanvasProjectionMode::ActorScreenBoundingBox:
+
+			return false;
+		}
+		case EActorCanvasProjectionMode::ComponentScreenBoundingBox:
+		case EActorCanvasProjectionMode::ActorScreenBoundingBox:
+		{
+			FVector2D LL, UR;
+			if (ULocalPlayer::GetPixelBoundingBox(InProjectionData, Bounds, LL, UR, &ScreenSize))
 			{
-				FBox IndicatorBox;
-				if (ProjectionMode == EActorCanvasProjectionMode::ActorScreenBoundingBox)
-				{
-					IndicatorBox = Component->GetOwner()->GetComponentsBoundingBox();
-				}
-				else
-				{
-					IndicatorBox = Component->Bounds.GetBox();
-				}
-
-				FVector2D LL, UR;
-				if (ULocalPlayer::GetPixelBoundingBox(InProjectionData, IndicatorBox, LL, UR, &ScreenSize))
-				{
-					const FVector& BoundingBoxAnchor = IndicatorDescriptor.GetBoundingBoxAnchor();
-					const FVector2D& ScreenSpaceOffset = IndicatorDescriptor.GetScreenSpaceOffset();
-					
-					OutScreenPositionWithDepth.X = FMath::Lerp(LL.X, UR.X, BoundingBoxAnchor.X) + ScreenSpaceOffset.X;
-					OutScreenPositionWithDepth.Y = FMath::Lerp(LL.Y, UR.Y, BoundingBoxAnchor.Y) + ScreenSpaceOffset.Y;
-					OutScreenPositionWithDepth.Z = FVector::Dist(InProjectionData.ViewOrigin, ProjectWorldLocation);
-					return true;
-				}
-
-				return false;
+				OutScreenPositionWithDepth.X = FMath::Lerp(LL.X, UR.X, BoundingBoxAnchor.X) + ScreenSpaceOffset.X;
+				OutScreenPositionWithDepth.Y = FMath::Lerp(LL.Y, UR.Y, BoundingBoxAnchor.Y) + ScreenSpaceOffset.Y;
+				OutScreenPositionWithDepth.Z = FVector::Dist(InProjectionData.ViewOrigin, WorldLocation);
+				return true;
 			}
-			case EActorCanvasProjectionMode::ActorBoundingBox:
-			case EActorCanvasProjectionMode::ComponentBoundingBox:
+
+			return false;
+		}
+		case EActorCanvasProjectionMode::ActorBoundingBox:
+		case EActorCanvasProjectionMode::ComponentBoundingBox:
+		{
+			const FVector ProjectBoxPoint = Bounds.GetCenter() + (Bounds.GetSize() * (BoundingBoxAnchor - FVector(0.5)));
+
+			FVector2D OutScreenSpacePosition;
+			if (ULocalPlayer::GetPixelPoint(InProjectionData, ProjectBoxPoint, OutScreenSpacePosition, &ScreenSize))
 			{
-				FBox IndicatorBox;
-				if (ProjectionMode == EActorCanvasProjectionMode::ActorBoundingBox)
-				{
-					IndicatorBox = Component->GetOwner()->GetComponentsBoundingBox();
-				}
-				else
-				{
-					IndicatorBox = Component->Bounds.GetBox();
-				}
-
-				const FVector ProjectBoxPoint = IndicatorBox.GetCenter() + (IndicatorBox.GetSize() * (IndicatorDescriptor.GetBoundingBoxAnchor() - FVector(0.5)));
-
-				FVector2D OutScreenSpacePosition;
-				if (ULocalPlayer::GetPixelPoint(InProjectionData, ProjectBoxPoint, OutScreenSpacePosition, &ScreenSize))
-				{
-					OutScreenSpacePosition += IndicatorDescriptor.GetScreenSpaceOffset();
-
-					OutScreenPositionWithDepth = FVector(OutScreenSpacePosition.X, OutScreenSpacePosition.Y, FVector::Dist(InProjectionData.ViewOrigin, ProjectBoxPoint));
-					return true;
-				}
-
-				return false;
+				OutScreenSpacePosition += ScreenSpaceOffset;
+
+				OutScreenPositionWithDepth = FVector(OutScreenSpacePosition.X, OutScreenSpacePosition.Y, FVector::Dist(InProjectionData.ViewOrigin, ProjectBoxPoint));
+				return true;
 			}
+
+			return false;
 		}
 	}
 
 	return false;
 }
 
+const FBox& UIndicatorDescriptor::GetActorBoundingBox()
+{
+	AActor* Owner = Component ? Component->GetOwner() : nullptr;
+	USceneComponent* RootComponent = Owner ? Owner->GetRootComponent() : nullptr;
+
+	// Follow the root of whichever actor we are attached to now
+	if (BoundsRootComponent.Get() != RootComponent)
+	{
+		if (USceneComponent* PreviousRootComponent = BoundsRootComponent.Get())
+		{
+			PreviousRootComponent->TransformUpdated.Remove(BoundsRootTransformUpdatedHandle);
+		}
+
+		BoundsRootTransformUpdatedHandle.Reset();
+		BoundsRootComponent = RootComponent;
+
+		if (RootComponent)
+		{
+			BoundsRootTransformUpdatedHandle = RootComponent->TransformUpdated.AddUObject(this, &ThisClass::HandleBoundsRootTransformUpdated);
+		}
+
+		bActorBoundsDirty = true;
+	}
+
+	if (bActorBoundsDirty)
+	{
+		CachedActorBounds = Owner ? Owner->GetComponentsBoundingBox() : FBox(ForceInit);
+
+		// Without a root there is nothing to tell us about movement, so don't hold on to the result
+		bActorBoundsDirty = (RootComponent == nullptr);
+	}
+
+	return CachedActorBounds;
+}
+
+void UIndicatorDescriptor::HandleBoundsRootTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	bActorBoundsDirty = true;
+}
+
 void UIndicatorDescriptor::SetIndicatorManagerComponent(UBEIndicatorManagerComponent* InManager)
 {
 	// Make sure nobody has set this.
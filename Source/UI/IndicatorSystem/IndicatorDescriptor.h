@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "BEIndicatorManagerComponent.h"
+#include "Components/SceneComponent.h"
 #include "Widgets/SWidget.h"
 #include "Widgets/SNullWidget.h"
 #include "SceneView.h"
@@ -14,11 +15,6 @@
 class UIndicatorDescriptor;
 class UBEIndicatorManagerComponent;
 
-struct FIndicatorProjection
-{
-	bool Project(const UIndicatorDescriptor& IndicatorDescriptor, const FSceneViewProjectionData& InProjectionData, const FVector2D& ScreenSize, FVector& ScreenPositionWithDepth);
-};
-
 UENUM(BlueprintType)
 enum class EActorCanvasProjectionMode : uint8
 {
@@ -29,6 +25,21 @@ enum class EActorCanvasProjectionMode : uint8
 	ActorScreenBoundingBox
 };
 
+struct FIndicatorProjection
+{
+	bool Project(UIndicatorDescriptor& IndicatorDescriptor, const FSceneViewProjectionData& InProjectionData, const FVector2D& ScreenSize, FVector& ScreenPositionWithDepth);
+
+	/**
+	 * Reads the world location (including the world position offset) and the bounds the indicator projects from.
+	 * Game thread only. Returns false if the indicator has no scene component.
+	 */
+	static bool GatherWorldState(UIndicatorDescriptor& IndicatorDescriptor, FVector& OutWorldLocation, FBox& OutBounds);
+
+	/** Projects gathered world state to the screen. Touches no UObjects, so it is safe to call from any thread. */
+	static bool ProjectWorldState(EActorCanvasProjectionMode ProjectionMode, const FVector& WorldLocation, const FBox& Bounds, const FVector& BoundingBoxAnchor, const FVector2D& ScreenSpaceOffset,
+		const FSceneViewProjectionData& InProjectionData, const FVector2D& ScreenSize, FVector& OutScreenPositionWithDepth);
+};
+
 /**
  * Describes and controls an active indicator.  It is highly recommended that your widget implements
  * IActorIndicatorWidget so that it can 'bind' to the associated data.
@@ -50,7 +61,11 @@ public:
 	UFUNCTION(BlueprintCallable)
 	USceneComponent* GetSceneComponent() const { return Component; }
 	UFUNCTION(BlueprintCallable)
-	void SetSceneComponent(USceneComponent* InComponent) { Component = InComponent; }
+	void SetSceneComponent(USceneComponent* InComponent)
+	{
+		Component = InComponent;
+		bActorBoundsDirty = true;
+	}
 
 	UFUNCTION(BlueprintCallable)
 	FName GetComponentSocketName() const { return ComponentSocketName; }
@@ -166,6 +181,14 @@ public:
 		BoundingBoxAnchor = InBoundingBoxAnchor;
 	}
 
+	// Bounds of the scene component's owner used by the actor bounding box modes.
+	// Cached until the owner's root component moves.
+	const FBox& GetActorBoundingBox();
+
+	// Forces the actor bounds to be recomputed, for bounds that change without the actor moving (e.g. animation).
+	UFUNCTION(BlueprintCallable)
+	void InvalidateActorBoundingBox() { bActorBoundsDirty = true; }
+
 public:
 	// Sorting Properties
 	//=======================
@@ -180,6 +203,28 @@ public:
 		Priority = InPriority;
 	}
 
+public:
+	// LOD Properties
+	//=======================
+
+	// Indicators further than this from the camera are hidden. 0 means no limit.
+	UFUNCTION(BlueprintCallable)
+	float GetMaxDrawDistance() const { return MaxDrawDistance; }
+	UFUNCTION(BlueprintCallable)
+	void SetMaxDrawDistance(float InMaxDrawDistance)
+	{
+		MaxDrawDistance = InMaxDrawDistance;
+	}
+
+	// Can this indicator be merged into a cluster widget when it overlaps others on screen?
+	UFUNCTION(BlueprintCallable)
+	bool GetAllowClustering() const { return bAllowClustering; }
+	UFUNCTION(BlueprintCallable)
+	void SetAllowClustering(bool bValue)
+	{
+		bAllowClustering = bValue;
+	}
+
 public:
 	UBEIndicatorManagerComponent* GetIndicatorManagerComponent() { return ManagerPtr.Get(); }
 	void SetIndicatorManagerComponent(UBEIndicatorManagerComponent* InManager);
@@ -198,6 +243,8 @@ private:
 	bool bOverrideScreenPosition = false;
 	UPROPERTY()
 	bool bAutoRemoveWhenIndicatorComponentIsNull = false;
+	UPROPERTY()
+	bool bAllowClustering = true;
 
 	UPROPERTY()
 	EActorCanvasProjectionMode ProjectionMode = EActorCanvasProjectionMode::ComponentPoint;
@@ -209,6 +256,9 @@ private:
 	UPROPERTY()
 	int32 Priority = 0;
 
+	UPROPERTY()
+	float MaxDrawDistance = 0.0f;
+
 	UPROPERTY()
 	FVector BoundingBoxAnchor = FVector(0.5, 0.5, 0.5);
 	UPROPERTY()
@@ -236,4 +286,17 @@ private:
 
 	TWeakPtr<SWidget> Content;
 	TWeakPtr<SWidget> CanvasHost;
+
+	// Created by SActorCanvas to stand in for a cluster of indicators
+	bool bIsClusterIndicator = false;
+
+private:
+	void HandleBoundsRootTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+
+	// The owner's root component whose transform invalidates CachedActorBounds
+	TWeakObjectPtr<USceneComponent> BoundsRootComponent;
+	FDelegateHandle BoundsRootTransformUpdatedHandle;
+
+	FBox CachedActorBounds = FBox(ForceInit);
+	bool bActorBoundsDirty = true;
 };
\ No newline at end of file
@@ -11,6 +11,32 @@
 #include "IndicatorLayer.generated.h"
 
 class SActorCanvas;
+class UUserWidget;
+
+USTRUCT(BlueprintType)
+struct FIndicatorLODSettings
+{
+	GENERATED_BODY()
+
+	/** Most indicator widgets shown at once (a cluster counts as one), the least important ones are hidden first. 0 means no limit. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=LOD, meta=(ClampMin=0))
+	int32 MaxVisibleIndicators = 0;
+
+	/**
+	 * Widget shown in place of indicators that overlap on screen, clustering is disabled without one.
+	 * Implement IIndicatorClusterWidgetInterface to receive the clustered indicators.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=Clustering)
+	TSoftClassPtr<UUserWidget> ClusterWidgetClass;
+
+	/** Indicators closer than this on screen (in slate units) are merged into one cluster. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=Clustering, meta=(ClampMin=0))
+	float ClusterRadius = 48.0f;
+
+	/** Whether indicators on screen cluster too, otherwise only the ones clamped to the screen edge do. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=Clustering)
+	bool bClusterOnScreenIndicators = false;
+};
 
 UCLASS()
 class UIndicatorLayer : public UWidget
@@ -22,6 +48,10 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=Appearance)
 	FSlateBrush ArrowBrush;
 
+	/** Limits on how many indicators are drawn, and how overlapping ones are merged. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=LOD)
+	FIndicatorLODSettings LODSettings;
+
 protected:
 	// UWidget interface
 	virtual void ReleaseSlateResources(bool bReleaseChildren) override;
@@ -7,6 +7,8 @@
 #include "IActorIndicatorWidget.h"
 #include "BEIndicatorManagerComponent.h"
 #include "Widgets/Layout/SBox.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
 
 namespace EArrowDirection
 {
@@ -20,6 +22,20 @@ namespace EArrowDirection
 	};
 }
 
+namespace BE::Indicators
+{
+	bool bParallelProjection = true;
+	static FAutoConsoleVariableRef CVarParallelProjection(TEXT("BE.Indicators.ParallelProjection"), bParallelProjection, TEXT("Should indicators be projected to the screen in parallel?"), ECVF_Default);
+
+	int32 ProjectionBatchSize = 32;
+	static FAutoConsoleVariableRef CVarProjectionBatchSize(TEXT("BE.Indicators.ProjectionBatchSize"), ProjectionBatchSize, TEXT("Minimum number of indicators projected by each parallel task."), ECVF_Default);
+}
+
+static bool SortsBefore(const SActorCanvas::FSlot& A, const SActorCanvas::FSlot& B)
+{
+	return A.GetPriority() == B.GetPriority() ? A.GetDepth() > B.GetDepth() : A.GetPriority() < B.GetPriority();
+}
+
 // Angles for the direction of the arrow to display
 const float ArrowRotations[EArrowDirection::MAX] =
 {
@@ -38,6 +54,82 @@ const FVector2D ArrowOffsets[EArrowDirection::MAX] =
 	FVector2D(0.0f, 1.0f)
 };
 
+/** Padding kept between clamped indicators and the canvas edge, leaves room for the arrow */
+static FIntPoint GetClampPadding(const FSlateBrush* ArrowBrush)
+{
+	const FVector2D ArrowWidgetSize = ArrowBrush ? ArrowBrush->GetImageSize() : FVector2D::ZeroVector;
+	return FIntPoint(10.0f, 10.0f) + FIntPoint(ArrowWidgetSize.X, ArrowWidgetSize.Y);
+}
+
+/** Clamps a screen position to the edges of the canvas, returns the edge it was clamped to or MAX if it was inside */
+static EArrowDirection::Type ClampScreenPosition(FVector2D& ScreenPosition, bool bInFrontOfCamera, const FVector2D& CanvasSize, const FIntPoint& FixedPadding, const FVector2D& SlotPaddingMin, const FVector2D& SlotPaddingMax)
+{
+	EArrowDirection::Type ClampDir = EArrowDirection::MAX;
+
+	const FVector Center = FVector(CanvasSize * 0.5f, 0.0f);
+
+	// Determine the size of inner screen rect to clamp within
+	const FIntPoint RectMin = FIntPoint(SlotPaddingMin.X, SlotPaddingMin.Y) + FixedPadding;
+	const FIntPoint RectMax = FIntPoint(CanvasSize.X - SlotPaddingMax.X, CanvasSize.Y - SlotPaddingMax.Y) - FixedPadding;
+	const FIntRect ClampRect(RectMin, RectMax);
+
+	// Make sure the screen position is within the clamp rect
+	if (!ClampRect.Contains(FIntPoint(ScreenPosition.X, ScreenPosition.Y)))
+	{
+		const FPlane Planes[] =
+		{
+			FPlane(FVector(1.0f, 0.0f, 0.0f), ClampRect.Min.X),	// Left
+			FPlane(FVector(0.0f, 1.0f, 0.0f), ClampRect.Min.Y),	// Top
+			FPlane(FVector(-1.0f, 0.0f, 0.0f), -ClampRect.Max.X),	// Right
+			FPlane(FVector(0.0f, -1.0f, 0.0f), -ClampRect.Max.Y)	// Bottom
+		};
+
+		for (int32 i = 0; i < EArrowDirection::MAX; ++i)
+		{
+			FVector NewPoint;
+			if (FMath::SegmentPlaneIntersection(Center, FVector(ScreenPosition, 0.0f), Planes[i], NewPoint))
+			{
+				ClampDir = (EArrowDirection::Type)i;
+				ScreenPosition = FVector2D(NewPoint);
+			}
+		}
+	}
+	else if (!bInFrontOfCamera)
+	{
+		const float ScreenXNorm = ScreenPosition.X / (RectMax.X - RectMin.X);
+		const float ScreenYNorm = ScreenPosition.Y / (RectMax.Y - RectMin.Y);
+		//we need to pin this thing to the side of the screen
+		if (ScreenXNorm < ScreenYNorm)
+		{
+			if (ScreenXNorm < (-ScreenYNorm + 1.0f))
+			{
+				ClampDir = EArrowDirection::Left;
+				ScreenPosition.X = ClampRect.Min.X;
+			}
+			else
+			{
+				ClampDir = EArrowDirection::Bottom;
+				ScreenPosition.Y = ClampRect.Max.Y;
+			}
+		}
+		else
+		{
+			if (ScreenXNorm < (-ScreenYNorm + 1.0f))
+			{
+				ClampDir = EArrowDirection::Top;
+				ScreenPosition.Y = ClampRect.Min.Y;
+			}
+			else
+			{
+				ClampDir = EArrowDirection::Right;
+				ScreenPosition.X = ClampRect.Max.X;
+			}
+		}
+	}
+
+	return ClampDir;
+}
+
 
 class SActorCanvasArrowWidget : public SLeafWidget
 {
@@ -150,6 +242,30 @@ void SActorCanvas::Construct(const FArguments& InArgs, const FLocalPlayerContext
 	UpdateActiveTimer();
 }
 
+void SActorCanvas::FProjectionSnapshot::Reset()
+{
+	Slots.Reset();
+	ProjectionModes.Reset();
+	WorldLocations.Reset();
+	Bounds.Reset();
+	BoundingBoxAnchors.Reset();
+	ScreenSpaceOffsets.Reset();
+	ScreenPositionsWithDepth.Reset();
+	ProjectionResults.Reset();
+}
+
+void SActorCanvas::FProjectionSnapshot::Add(FSlot* Slot, UIndicatorDescriptor& Indicator, const FVector& WorldLocation, const FBox& InBounds)
+{
+	Slots.Add(Slot);
+	ProjectionModes.Add(Indicator.GetProjectionMode());
+	WorldLocations.Add(WorldLocation);
+	Bounds.Add(InBounds);
+	BoundingBoxAnchors.Add(Indicator.GetBoundingBoxAnchor());
+	ScreenSpaceOffsets.Add(Indicator.GetScreenSpaceOffset());
+	ScreenPositionsWithDepth.AddUninitialized();
+	ProjectionResults.Add(false);
+}
+
 EActiveTimerReturnType SActorCanvas::UpdateCanvas(double InCurrentTime, float InDeltaTime)
 {
 	QUICK_SCOPE_CYCLE_COUNTER(STAT_SActorCanvas_UpdateCanvas);
@@ -194,11 +310,21 @@ EActiveTimerReturnType SActorCanvas::UpdateCanvas(double InCurrentTime, float In
 
 			bool IndicatorsChanged = false;
 
+			// Gather the world state of every visible indicator, this touches UObjects so stays on the game thread
+
+			ProjectionSnapshot.Reset();
+
 			for (int32 ChildIndex = 0; ChildIndex < CanvasChildren.Num(); ++ChildIndex)
 			{
 				SActorCanvas::FSlot& CurChild = CanvasChildren[ChildIndex];
 				UIndicatorDescriptor* Indicator = CurChild.Indicator;
 
+				// Cluster slots follow their leader, see UpdateLOD
+				if (Indicator->bIsClusterIndicator)
+				{
+					continue;
+				}
+
 				// If the slot content is invalid and we have permission to remove it
 				if (Indicator->CanAutomaticallyRemove())
 				{
@@ -227,21 +353,53 @@ EActiveTimerReturnType SActorCanvas::UpdateCanvas(double InCurrentTime, float In
 					IndicatorsChanged = true;
 				}
 
-				FVector ScreenPositionWithDepth;
-
-				FIndicatorProjection Projector;
-				const bool Success = Projector.Project(*Indicator, ProjectionData, PaintGeometry.Size, OUT ScreenPositionWithDepth);
-
-				if (!Success)
+				FVector WorldLocation;
+				FBox Bounds;
+				if (FIndicatorProjection::GatherWorldState(*Indicator, WorldLocation, Bounds))
+				{
+					ProjectionSnapshot.Add(&CurChild, *Indicator, WorldLocation, Bounds);
+				}
+				else
 				{
 					CurChild.SetHasValidScreenPosition(false);
 					CurChild.SetInFrontOfCamera(false);
 
 					IndicatorsChanged |= CurChild.bIsDirty();
 					CurChild.ClearDirtyFlag();
+				}
+			}
+
+			// Project, this is pure math on the snapshot
+
+			const int32 NumToProject = ProjectionSnapshot.Num();
+			const FVector2D ScreenSize = PaintGeometry.Size;
+
+			ParallelFor(TEXT("SActorCanvas.Project"), NumToProject, FMath::Max(BE::Indicators::ProjectionBatchSize, 1),
+				[this, &ProjectionData, &ScreenSize](int32 Index)
+				{
+					FProjectionSnapshot& Snapshot = ProjectionSnapshot;
+					Snapshot.ProjectionResults[Index] = FIndicatorProjection::ProjectWorldState(Snapshot.ProjectionModes[Index], Snapshot.WorldLocations[Index], Snapshot.Bounds[Index],
+						Snapshot.BoundingBoxAnchors[Index], Snapshot.ScreenSpaceOffsets[Index], ProjectionData, ScreenSize, Snapshot.ScreenPositionsWithDepth[Index]);
+				},
+				BE::Indicators::bParallelProjection ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+
+			// Apply the results to the slots
+
+			for (int32 Index = 0; Index < NumToProject; ++Index)
+			{
+				SActorCanvas::FSlot& CurChild = *ProjectionSnapshot.Slots[Index];
+				const UIndicatorDescriptor* Indicator = CurChild.Indicator;
+				const bool Success = ProjectionSnapshot.ProjectionResults[Index];
+
+				if (!Success)
+				{
+					CurChild.SetHasValidScreenPosition(false);
+					CurChild.SetInFrontOfCamera(false);
 					continue;
 				}
 
+				const FVector& ScreenPositionWithDepth = ProjectionSnapshot.ScreenPositionsWithDepth[Index];
+
 				CurChild.SetInFrontOfCamera(Success);
 				CurChild.SetHasValidScreenPosition(CurChild.GetInFrontOfCamera() || Indicator->GetClampToScreen());
 
@@ -249,15 +407,31 @@ EActiveTimerReturnType SActorCanvas::UpdateCanvas(double InCurrentTime, float In
 				{
 					// Only dirty the screen position if we can actually show this indicator.
 					CurChild.SetScreenPosition(FVector2D(ScreenPositionWithDepth));
-					CurChild.SetDepth(ScreenPositionWithDepth.X);
+					CurChild.SetDepth(ScreenPositionWithDepth.Z);
 				}
 
 				CurChild.SetPriority(Indicator->GetPriority());
+			}
+
+			UpdateLOD(PaintGeometry.Size);
+
+			for (int32 Index = 0; Index < NumToProject; ++Index)
+			{
+				SActorCanvas::FSlot& CurChild = *ProjectionSnapshot.Slots[Index];
 
 				IndicatorsChanged |= CurChild.bIsDirty();
 				CurChild.ClearDirtyFlag();
 			}
 
+			for (FCluster& Cluster : Clusters)
+			{
+				if (Cluster.Slot)
+				{
+					IndicatorsChanged |= Cluster.Slot->bIsDirty();
+					Cluster.Slot->ClearDirtyFlag();
+				}
+			}
+
 			if (IndicatorsChanged)
 			{
 				Invalidate(EInvalidateWidget::Paint);
@@ -310,20 +484,10 @@ void SActorCanvas::OnArrangeChildren(const FGeometry& AllottedGeometry, FArrange
 	if (bShowAnyIndicators)
 	{
 		const FVector2D ArrowWidgetSize = ActorCanvasArrowBrush->GetImageSize();
-		const FIntPoint FixedPadding = FIntPoint(10.0f, 10.0f) + FIntPoint(ArrowWidgetSize.X, ArrowWidgetSize.Y);
-		const FVector Center = FVector(AllottedGeometry.Size * 0.5f, 0.0f);
+		const FIntPoint FixedPadding = GetClampPadding(ActorCanvasArrowBrush);
 
 		// Sort the children
-		TArray<const SActorCanvas::FSlot*> SortedSlots;
-		for (int32 ChildIndex = 0; ChildIndex < CanvasChildren.Num(); ++ChildIndex)
-		{
-			SortedSlots.Add(&CanvasChildren[ChildIndex]);
-		}
-
-		SortedSlots.StableSort([](const SActorCanvas::FSlot& A, const SActorCanvas::FSlot& B)
-		{
-			return A.GetPriority() == B.GetPriority() ? A.GetDepth() > B.GetDepth() : A.GetPriority() < B.GetPriority();
-		});
+		UpdateSortedSlots();
 
 		// Go through all the sorted children
 		for (int32 ChildIndex = 0; ChildIndex < SortedSlots.Num(); ++ChildIndex)
@@ -355,66 +519,7 @@ void SActorCanvas::OnArrangeChildren(const FGeometry& AllottedGeometry, FArrange
 			if (bShouldClamp)
 			{
 				//figure out if we clamped to any edge of the screen
-				EArrowDirection::Type ClampDir = EArrowDirection::MAX;
-
-				// Determine the size of inner screen rect to clamp within
-				const FIntPoint RectMin = FIntPoint(SlotPaddingMin.X, SlotPaddingMin.Y) + FixedPadding;
-				const FIntPoint RectMax = FIntPoint(AllottedGeometry.Size.X - SlotPaddingMax.X, AllottedGeometry.Size.Y - SlotPaddingMax.Y) - FixedPadding;
-				const FIntRect ClampRect(RectMin, RectMax);
-
-				// Make sure the screen position is within the clamp rect
-				if (!ClampRect.Contains(FIntPoint(ScreenPosition.X, ScreenPosition.Y)))
-				{
-					const FPlane Planes[] =
-					{
-						FPlane(FVector(1.0f, 0.0f, 0.0f), ClampRect.Min.X),	// Left
-						FPlane(FVector(0.0f, 1.0f, 0.0f), ClampRect.Min.Y),	// Top
-						FPlane(FVector(-1.0f, 0.0f, 0.0f), -ClampRect.Max.X),	// Right
-						FPlane(FVector(0.0f, -1.0f, 0.0f), -ClampRect.Max.Y)	// Bottom
-					};
-
-					for (int32 i = 0; i < EArrowDirection::MAX; ++i)
-					{
-						FVector NewPoint;
-						if (FMath::SegmentPlaneIntersection(Center, FVector(ScreenPosition, 0.0f), Planes[i], NewPoint))
-						{
-							ClampDir = (EArrowDirection::Type)i;
-							ScreenPosition = FVector2D(NewPoint);
-						}
-					}
-				}
-				else if (!bInFrontOfCamera)
-				{
-					const float ScreenXNorm = ScreenPosition.X / (RectMax.X - RectMin.X);
-					const float ScreenYNorm = ScreenPosition.Y / (RectMax.Y - RectMin.Y);
-					//we need to pin this thing to the side of the screen
-					if (ScreenXNorm < ScreenYNorm)
-					{
-						if (ScreenXNorm < (-ScreenYNorm + 1.0f))
-						{
-							ClampDir = EArrowDirection::Left;
-							ScreenPosition.X = ClampRect.Min.X;
-						}
-						else
-						{
-							ClampDir = EArrowDirection::Bottom;
-							ScreenPosition.Y = ClampRect.Max.Y;
-						}
-					}
-					else
-					{
-						if (ScreenXNorm < (-ScreenYNorm + 1.0f))
-						{
-							ClampDir = EArrowDirection::Top;
-							ScreenPosition.Y = ClampRect.Min.Y;
-						}
-						else
-						{
-							ClampDir = EArrowDirection::Right;
-							ScreenPosition.X = ClampRect.Max.X;
-						}
-					}
-				}
+				const EArrowDirection::Type ClampDir = ClampScreenPosition(ScreenPosition, bInFrontOfCamera, AllottedGeometry.Size, FixedPadding, SlotPaddingMin, SlotPaddingMax);
 
 				bWasIndicatorClamped = (ClampDir != EArrowDirection::MAX);
 
@@ -493,6 +598,236 @@ void SActorCanvas::OnArrangeChildren(const FGeometry& AllottedGeometry, FArrange
 	ArrowIndexLastUpdate = NextArrowIndex;
 }
 
+void SActorCanvas::UpdateLOD(const FVector2D& CanvasSize)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SActorCanvas_UpdateLOD);
+
+	const bool bCanCluster = !LODSettings.ClusterWidgetClass.IsNull() && (LODSettings.ClusterRadius > 0.0f);
+	const float ClusterRadiusSquared = FMath::Square(LODSettings.ClusterRadius);
+	const FIntPoint FixedPadding = GetClampPadding(ActorCanvasArrowBrush);
+
+	// Distance culling, and where everything that is left ends up on screen
+
+	LODCandidates.Reset();
+
+	for (int32 Index = 0; Index < ProjectionSnapshot.Num(); ++Index)
+	{
+		SActorCanvas::FSlot& CurChild = *ProjectionSnapshot.Slots[Index];
+		const UIndicatorDescriptor* Indicator = CurChild.Indicator;
+
+		if (!CurChild.HasValidScreenPosition())
+		{
+			CurChild.SetIsLODCulled(false);
+			continue;
+		}
+
+		const float MaxDrawDistance = Indicator->GetMaxDrawDistance();
+		if ((MaxDrawDistance > 0.0f) && (CurChild.GetDepth() > MaxDrawDistance))
+		{
+			CurChild.SetIsLODCulled(true);
+			continue;
+		}
+
+		FLODCandidate& Candidate = LODCandidates.AddDefaulted_GetRef();
+		Candidate.Slot = &CurChild;
+		Candidate.DisplayPosition = CurChild.GetScreenPosition();
+
+		bool bIsClamped = false;
+		if (Indicator->GetClampToScreen())
+		{
+			FVector2D SlotSize = FVector2D::ZeroVector, SlotOffset = FVector2D::ZeroVector, SlotPaddingMin = FVector2D::ZeroVector, SlotPaddingMax = FVector2D::ZeroVector;
+			GetOffsetAndSize(Indicator, SlotSize, SlotOffset, SlotPaddingMin, SlotPaddingMax);
+
+			bIsClamped = ClampScreenPosition(Candidate.DisplayPosition, CurChild.GetInFrontOfCamera(), CanvasSize, FixedPadding, SlotPaddingMin, SlotPaddingMax) != EArrowDirection::MAX;
+		}
+
+		Candidate.bCanCluster = bCanCluster && Indicator->GetAllowClustering() && (bIsClamped || LODSettings.bClusterOnScreenIndicators);
+	}
+
+	// Most important first, they lead the clusters and are the last to go over the cap
+
+	LODCandidates.Sort([](const FLODCandidate& A, const FLODCandidate& B)
+	{
+		return A.Slot->GetPriority() == B.Slot->GetPriority() ? A.Slot->GetDepth() < B.Slot->GetDepth() : A.Slot->GetPriority() > B.Slot->GetPriority();
+	});
+
+	const int32 MaxVisibleIndicators = (LODSettings.MaxVisibleIndicators > 0) ? LODSettings.MaxVisibleIndicators : MAX_int32;
+	int32 NumVisible = 0;
+
+	LODGroups.Reset();
+
+	for (int32 CandidateIndex = 0; CandidateIndex < LODCandidates.Num(); ++CandidateIndex)
+	{
+		const FLODCandidate& Candidate = LODCandidates[CandidateIndex];
+
+		if (Candidate.bCanCluster)
+		{
+			FLODGroup* JoinedGroup = LODGroups.FindByPredicate([this, &Candidate, ClusterRadiusSquared](const FLODGroup& Group)
+			{
+				return FVector2D::DistSquared(LODCandidates[Group.LeaderCandidate].DisplayPosition, Candidate.DisplayPosition) <= ClusterRadiusSquared;
+			});
+
+			if (JoinedGroup)
+			{
+				JoinedGroup->Members.Add(Candidate.Slot->Indicator);
+				Candidate.Slot->SetIsLODCulled(true);
+				continue;
+			}
+		}
+
+		if (NumVisible >= MaxVisibleIndicators)
+		{
+			Candidate.Slot->SetIsLODCulled(true);
+			continue;
+		}
+
+		++NumVisible;
+		Candidate.Slot->SetIsLODCulled(false);
+
+		if (Candidate.bCanCluster)
+		{
+			FLODGroup& NewGroup = LODGroups.AddDefaulted_GetRef();
+			NewGroup.LeaderCandidate = CandidateIndex;
+			NewGroup.Members.Add(Candidate.Slot->Indicator);
+		}
+	}
+
+	// Groups of more than one indicator are shown as a single cluster widget
+
+	int32 NumActiveClusters = 0;
+
+	for (const FLODGroup& Group : LODGroups)
+	{
+		if (Group.Members.Num() > 1)
+		{
+			ActivateCluster(NumActiveClusters++, *LODCandidates[Group.LeaderCandidate].Slot, Group.Members);
+		}
+	}
+
+	for (int32 ClusterIndex = NumActiveClusters; ClusterIndex < Clusters.Num(); ++ClusterIndex)
+	{
+		DeactivateCluster(ClusterIndex);
+	}
+}
+
+void SActorCanvas::ActivateCluster(int32 ClusterIndex, FSlot& LeaderSlot, TArrayView<UIndicatorDescriptor* const> Members)
+{
+	if (!Clusters.IsValidIndex(ClusterIndex))
+	{
+		check(ClusterIndex == Clusters.Num());
+
+		UIndicatorDescriptor* ClusterIndicator = NewObject<UIndicatorDescriptor>();
+		ClusterIndicator->bIsClusterIndicator = true;
+		ClusterIndicator->SetIndicatorClass(LODSettings.ClusterWidgetClass);
+
+		Clusters.AddDefaulted_GetRef().Indicator = ClusterIndicator;
+		AddIndicatorForEntry(ClusterIndicator);
+	}
+
+	FCluster& Cluster = Clusters[ClusterIndex];
+
+	const UIndicatorDescriptor* Leader = LeaderSlot.Indicator;
+	UIndicatorDescriptor* ClusterIndicator = Cluster.Indicator;
+
+	// Lay out like the leader
+	ClusterIndicator->SetSceneComponent(Leader->GetSceneComponent());
+	ClusterIndicator->SetComponentSocketName(Leader->GetComponentSocketName());
+	ClusterIndicator->SetHAlign(Leader->GetHAlign());
+	ClusterIndicator->SetVAlign(Leader->GetVAlign());
+	ClusterIndicator->SetClampToScreen(Leader->GetClampToScreen());
+	ClusterIndicator->SetShowClampToScreenArrow(Leader->GetShowClampToScreenArrow());
+	ClusterIndicator->SetPriority(Leader->GetPriority());
+	ClusterIndicator->SetDesiredVisibility(true);
+
+	if (Cluster.Slot == nullptr)
+	{
+		for (int32 ChildIndex = 0; ChildIndex < CanvasChildren.Num(); ++ChildIndex)
+		{
+			if (CanvasChildren[ChildIndex].Indicator == ClusterIndicator)
+			{
+				Cluster.Slot = &CanvasChildren[ChildIndex];
+				break;
+			}
+		}
+	}
+
+	// Until the cluster widget has loaded, just show the leader
+	if (Cluster.Slot == nullptr)
+	{
+		LeaderSlot.SetIsLODCulled(false);
+		return;
+	}
+
+	LeaderSlot.SetIsLODCulled(true);
+
+	FSlot& ClusterSlot = *Cluster.Slot;
+	ClusterSlot.SetScreenPosition(LeaderSlot.GetScreenPosition());
+	ClusterSlot.SetDepth(LeaderSlot.GetDepth());
+	ClusterSlot.SetPriority(LeaderSlot.GetPriority());
+	ClusterSlot.SetInFrontOfCamera(LeaderSlot.GetInFrontOfCamera());
+	ClusterSlot.SetHasValidScreenPosition(true);
+	ClusterSlot.SetIsLODCulled(false);
+	ClusterSlot.SetIsIndicatorVisible(true);
+
+	const bool bMembersChanged = (Cluster.Members.Num() != Members.Num()) || !CompareItems(Cluster.Members.GetData(), Members.GetData(), Members.Num());
+	if (bMembersChanged)
+	{
+		Cluster.Members.Reset();
+		Cluster.Members.Append(Members.GetData(), Members.Num());
+
+		UUserWidget* ClusterWidget = ClusterIndicator->IndicatorWidget.Get();
+		if (ClusterWidget && ClusterWidget->GetClass()->ImplementsInterface(UIndicatorClusterWidgetInterface::StaticClass()))
+		{
+			IIndicatorClusterWidgetInterface::Execute_SetClusteredIndicators(ClusterWidget, Cluster.Members);
+		}
+	}
+}
+
+void SActorCanvas::DeactivateCluster(int32 ClusterIndex)
+{
+	FCluster& Cluster = Clusters[ClusterIndex];
+
+	Cluster.Indicator->SetDesiredVisibility(false);
+	Cluster.Members.Reset();
+
+	if (Cluster.Slot)
+	{
+		Cluster.Slot->SetIsIndicatorVisible(false);
+	}
+}
+
+void SActorCanvas::UpdateSortedSlots() const
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_SActorCanvas_UpdateSortedSlots);
+
+	if (bSortedSlotsDirty)
+	{
+		SortedSlots.Reset(CanvasChildren.Num());
+		for (int32 ChildIndex = 0; ChildIndex < CanvasChildren.Num(); ++ChildIndex)
+		{
+			SortedSlots.Add(&CanvasChildren[ChildIndex]);
+		}
+
+		bSortedSlotsDirty = false;
+	}
+
+	// Indicators barely move relative to each other between frames, so the list is almost always still sorted.
+	// Insertion sort is a single pass over a sorted list and only moves the slots that changed places, and it is stable.
+	for (int32 SortIndex = 1; SortIndex < SortedSlots.Num(); ++SortIndex)
+	{
+		const SActorCanvas::FSlot* SlotToInsert = SortedSlots[SortIndex];
+
+		int32 InsertIndex = SortIndex;
+		while ((InsertIndex > 0) && SortsBefore(*SlotToInsert, *SortedSlots[InsertIndex - 1]))
+		{
+			SortedSlots[InsertIndex] = SortedSlots[InsertIndex - 1];
+			--InsertIndex;
+		}
+
+		SortedSlots[InsertIndex] = SlotToInsert;
+	}
+}
+
 int32 SActorCanvas::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
 {
 	QUICK_SCOPE_CYCLE_COUNTER(STAT_SActorCanvas_OnPaint);
@@ -533,6 +868,11 @@ FString SActorCanvas::GetReferencerName() const
 void SActorCanvas::AddReferencedObjects( FReferenceCollector& Collector )
 {
 	Collector.AddReferencedObjects(AllIndicators);
+
+	for (FCluster& Cluster : Clusters)
+	{
+		Collector.AddReferencedObject(Cluster.Indicator);
+	}
 }
 
 void SActorCanvas::OnIndicatorAdded(UIndicatorDescriptor* Indicator)
@@ -562,7 +902,7 @@ void SActorCanvas::AddIndicatorForEntry(UIndicatorDescriptor* Indicator)
 			if (UIndicatorDescriptor* Indicator = IndicatorPtr.Get())
 			{
 				// While async loading this indicator widget we could have removed it.
-				if (!AllIndicators.Contains(Indicator))
+				if (!Indicator->bIsClusterIndicator && !AllIndicators.Contains(Indicator))
 				{
 					return;
 				}
@@ -623,6 +963,7 @@ SActorCanvas::FScopedWidgetSlotArguments SActorCanvas::AddActorSlot(UIndicatorDe
 		{
 			if (TSharedPtr<SActorCanvas> Canvas = WeakCanvas.Pin())
 			{
+				Canvas->bSortedSlotsDirty = true;
 				Canvas->UpdateActiveTimer();
 			}
 		}};
@@ -635,6 +976,7 @@ int32 SActorCanvas::RemoveActorSlot(const TSharedRef<SWidget>& SlotWidget)
 		if ( SlotWidget == CanvasChildren[SlotIdx].GetWidget() )
 		{
 			CanvasChildren.RemoveAt(SlotIdx);
+			bSortedSlotsDirty = true;
 
 			UpdateActiveTimer();
 
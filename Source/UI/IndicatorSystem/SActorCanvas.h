@@ -11,6 +11,7 @@
 #include "GameplayTaskTypes.h"
 #include "UObject/WeakInterfacePtr.h"
 #include "IndicatorDescriptor.h"
+#include "IndicatorLayer.h"
 #include "AsyncMixin.h"
 #include "Blueprint/UserWidgetPool.h"
 
@@ -36,6 +37,7 @@ public:
 			, bInFrontOfCamera(true)
 			, bHasValidScreenPosition(false)
 			, bDirty(true)
+			, bIsLODCulled(false)
 			, bWasIndicatorClamped(false)
 			, bWasIndicatorClampedStatusChanged(false)
 		{
@@ -111,6 +113,18 @@ public:
 			RefreshVisibility();
 		}
 
+		bool IsLODCulled() const { return bIsLODCulled; }
+		void SetIsLODCulled(bool bCulled)
+		{
+			if (bIsLODCulled != bCulled)
+			{
+				bIsLODCulled = bCulled;
+				bDirty = true;
+			}
+
+			RefreshVisibility();
+		}
+
 		bool bIsDirty() const { return bDirty; }
 
 		void ClearDirtyFlag()
@@ -137,7 +151,7 @@ public:
 	private:
 		void RefreshVisibility()
 		{
-			const bool bIsVisible = bIsIndicatorVisible && bHasValidScreenPosition;
+			const bool bIsVisible = bIsIndicatorVisible && bHasValidScreenPosition && !bIsLODCulled;
 			GetWidget()->SetVisibility(bIsVisible ? EVisibility::SelfHitTestInvisible : EVisibility::Collapsed);
 		}
 
@@ -151,6 +165,9 @@ public:
 		uint8 bInFrontOfCamera : 1;
 		uint8 bHasValidScreenPosition : 1;
 		uint8 bDirty : 1;
+
+		/** Hidden by the canvas LOD, i.e. too far away, merged into a cluster or over the widget cap */
+		uint8 bIsLODCulled : 1;
 		
 		/** 
 		 * Cached & frame-deferred value of whether the indicator was visually screen clamped last frame or not; 
@@ -198,6 +215,8 @@ public:
 
 	void SetDrawElementsInOrder(bool bInDrawElementsInOrder) { bDrawElementsInOrder = bInDrawElementsInOrder; }
 
+	void SetLODSettings(const FIndicatorLODSettings& InLODSettings) { LODSettings = InLODSettings; }
+
 	virtual FString GetReferencerName() const override;
 	virtual void AddReferencedObjects( FReferenceCollector& Collector ) override;
 	
@@ -224,7 +243,65 @@ private:
 
 	void UpdateActiveTimer();
 
+	/** Brings SortedSlots up to date with the current priorities and depths */
+	void UpdateSortedSlots() const;
+
+	/** Applies the max draw distances, clustering and the widget cap to the indicators projected this update */
+	void UpdateLOD(const FVector2D& CanvasSize);
+
+	/** Shows cluster ClusterIndex at the leader's position, standing in for the leader and Members */
+	void ActivateCluster(int32 ClusterIndex, FSlot& LeaderSlot, TArrayView<UIndicatorDescriptor* const> Members);
+	void DeactivateCluster(int32 ClusterIndex);
+
 private:
+	/**
+	 * World state of the visible indicators, gathered on the game thread and projected in parallel.
+	 * Kept as one array per field and reused every update so it doesn't allocate once warmed up.
+	 */
+	struct FProjectionSnapshot
+	{
+		TArray<FSlot*> Slots;
+		TArray<EActorCanvasProjectionMode> ProjectionModes;
+		TArray<FVector> WorldLocations;
+		TArray<FBox> Bounds;
+		TArray<FVector> BoundingBoxAnchors;
+		TArray<FVector2D> ScreenSpaceOffsets;
+
+		TArray<FVector> ScreenPositionsWithDepth;
+		TArray<bool> ProjectionResults;
+
+		void Reset();
+		void Add(FSlot* Slot, UIndicatorDescriptor& Indicator, const FVector& WorldLocation, const FBox& InBounds);
+		int32 Num() const { return Slots.Num(); }
+	};
+
+	/** An aggregate indicator shown in place of indicators that overlap on screen */
+	struct FCluster
+	{
+		/** Created by the canvas, kept alive by SActorCanvas::AddReferencedObjects */
+		UIndicatorDescriptor* Indicator = nullptr;
+
+		/** Found once the cluster widget has loaded */
+		FSlot* Slot = nullptr;
+
+		/** Indicators last sent to the cluster widget, the leader first */
+		TArray<UIndicatorDescriptor*> Members;
+	};
+
+	/** Scratch data for UpdateLOD */
+	struct FLODCandidate
+	{
+		FSlot* Slot = nullptr;
+		FVector2D DisplayPosition = FVector2D::ZeroVector;
+		bool bCanCluster = false;
+	};
+
+	struct FLODGroup
+	{
+		int32 LeaderCandidate = INDEX_NONE;
+		TArray<UIndicatorDescriptor*, TInlineAllocator<8>> Members;
+	};
+
 	TArray<UIndicatorDescriptor*> AllIndicators;
 	TArray<UIndicatorDescriptor*> InactiveIndicators;
 	
@@ -250,5 +327,18 @@ private:
 
 	mutable TOptional<FGeometry> OptionalPaintGeometry;
 
+	FProjectionSnapshot ProjectionSnapshot;
+
+	FIndicatorLODSettings LODSettings;
+	TArray<FCluster> Clusters;
+	TArray<FLODCandidate> LODCandidates;
+	TArray<FLODGroup> LODGroups;
+
+	/** Canvas slots in arrange order (priority, then back to front), kept between frames so it only needs fixing up */
+	mutable TArray<const FSlot*> SortedSlots;
+
+	/** Set when slots are added or removed, the next arrange rebuilds SortedSlots */
+	mutable bool bSortedSlotsDirty = true;
+
 	TSharedPtr<FActiveTimerHandle> TickHandle;
 };
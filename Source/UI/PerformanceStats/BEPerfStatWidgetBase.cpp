@@ -2,6 +2,7 @@
 
 #include "BEPerfStatWidgetBase.h"
 #include "Performance/BEPerformanceStatSubsystem.h"
+#include "UI/Subsystem/BEUIManagerSubsystem.h"
 
 //////////////////////////////////////////////////////////////////////
 // UBEPerfStatWidgetBase
@@ -33,3 +34,31 @@ double UBEPerfStatWidgetBase::FetchStatValue()
 		return 0.0;
 	}
 }
+
+void UBEPerfStatWidgetBase::NativeConstruct()
+{
+	Super::NativeConstruct();
+
+	if (UpdateInterval > 0.0f)
+	{
+		if (UBEUIManagerSubsystem* UIManager = GetGameInstance() ? GetGameInstance()->GetSubsystem<UBEUIManagerSubsystem>() : nullptr)
+		{
+			BudgetedUpdateHandle = UIManager->GetTickBudget().Register(FBEUIBudgetedUpdate::CreateUObject(this, &ThisClass::HandleBudgetedUpdate), UpdateInterval);
+		}
+	}
+}
+
+void UBEPerfStatWidgetBase::NativeDestruct()
+{
+	if (UBEUIManagerSubsystem* UIManager = GetGameInstance() ? GetGameInstance()->GetSubsystem<UBEUIManagerSubsystem>() : nullptr)
+	{
+		UIManager->GetTickBudget().Unregister(BudgetedUpdateHandle);
+	}
+
+	Super::NativeDestruct();
+}
+
+void UBEPerfStatWidgetBase::HandleBudgetedUpdate(float DeltaTime)
+{
+	OnStatValueUpdated(FetchStatValue());
+}
@@ -34,6 +34,25 @@ public:
 	UFUNCTION(BlueprintPure)
 	double FetchStatValue();
 
+protected:
+	//~UUserWidget interface
+	virtual void NativeConstruct() override;
+	virtual void NativeDestruct() override;
+	//~End of UUserWidget interface
+
+	// Called every UpdateInterval with the current value of the stat (unscaled)
+	UFUNCTION(BlueprintImplementableEvent)
+	void OnStatValueUpdated(double Value);
+
+	// How often OnStatValueUpdated is called through the UI tick budget, 0 disables it (the widget polls FetchStatValue itself)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=Display, meta=(ForceUnits=s, ClampMin=0.0))
+	float UpdateInterval = 0.0f;
+
+private:
+	void HandleBudgetedUpdate(float DeltaTime);
+
+	FDelegateHandle BudgetedUpdateHandle;
+
 protected:
 	// Cached subsystem pointer
 	UPROPERTY(Transient)
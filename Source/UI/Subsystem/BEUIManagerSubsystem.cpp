@@ -11,25 +11,35 @@ UBEUIManagerSubsystem::UBEUIManagerSubsystem()
 {
 }
 
-void UBEUIManagerSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+void UBEUIManagerSubsystem::NotifyPlayerAdded(UCommonLocalPlayer* LocalPlayer)
 {
-	Super::Initialize(Collection);
+	// The policy creates the root layout here and again once the player controller is set,
+	// register after it so the layout exists when we sync
+	Super::NotifyPlayerAdded(LocalPlayer);
 
-	TickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UBEUIManagerSubsystem::Tick), 0.0f);
+	if (LocalPlayer)
+	{
+		LocalPlayer->OnPlayerControllerSet.AddUObject(this, &ThisClass::HandlePlayerControllerSet);
+	}
+
+	SyncRootLayoutVisibilityToShowHUD();
 }
 
-void UBEUIManagerSubsystem::Deinitialize()
+void UBEUIManagerSubsystem::NotifyPlayerRemoved(UCommonLocalPlayer* LocalPlayer)
 {
-	Super::Deinitialize();
+	if (LocalPlayer)
+	{
+		LocalPlayer->OnPlayerControllerSet.RemoveAll(this);
+	}
+
+	Super::NotifyPlayerRemoved(LocalPlayer);
 
-	FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+	SyncRootLayoutVisibilityToShowHUD();
 }
 
-bool UBEUIManagerSubsystem::Tick(float DeltaTime)
+void UBEUIManagerSubsystem::HandlePlayerControllerSet(UCommonLocalPlayer* LocalPlayer, APlayerController* PlayerController)
 {
 	SyncRootLayoutVisibilityToShowHUD();
-	
-	return true;
 }
 
 void UBEUIManagerSubsystem::SyncRootLayoutVisibilityToShowHUD()
@@ -39,7 +49,7 @@ void UBEUIManagerSubsystem::SyncRootLayoutVisibilityToShowHUD()
 		for (const ULocalPlayer* LocalPlayer : GetGameInstance()->GetLocalPlayers())
 		{
 			bool bShouldShowUI = true;
-			
+
 			if (const APlayerController* PC = LocalPlayer->GetPlayerController(GetWorld()))
 			{
 				const AHUD* HUD = PC->GetHUD();
@@ -55,9 +65,9 @@ void UBEUIManagerSubsystem::SyncRootLayoutVisibilityToShowHUD()
 				const ESlateVisibility DesiredVisibility = bShouldShowUI ? ESlateVisibility::SelfHitTestInvisible : ESlateVisibility::Collapsed;
 				if (DesiredVisibility != RootLayout->GetVisibility())
 				{
-					RootLayout->SetVisibility(DesiredVisibility);	
+					RootLayout->SetVisibility(DesiredVisibility);
 				}
 			}
 		}
 	}
-}
\ No newline at end of file
+}
@@ -5,8 +5,13 @@
 #include "CoreMinimal.h"
 #include "GameUIManagerSubsystem.h"
 
+#include "UI/Subsystem/BEUITickBudget.h"
+
 #include "BEUIManagerSubsystem.generated.h"
 
+class APlayerController;
+class UCommonLocalPlayer;
+
 UCLASS()
 class UBEUIManagerSubsystem : public UGameUIManagerSubsystem
 {
@@ -16,12 +21,17 @@ public:
 
 	UBEUIManagerSubsystem();
 
-	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
-	virtual void Deinitialize() override;
+	virtual void NotifyPlayerAdded(UCommonLocalPlayer* LocalPlayer) override;
+	virtual void NotifyPlayerRemoved(UCommonLocalPlayer* LocalPlayer) override;
 
-private:
-	bool Tick(float DeltaTime);
+	// Shows or hides the root layouts to match AHUD::bShowHUD, called whenever the HUD, the players or their layouts change
 	void SyncRootLayoutVisibilityToShowHUD();
-	
-	FTSTicker::FDelegateHandle TickHandle;
-};
\ No newline at end of file
+
+	// Shared budget for low frequency UI updates, see FBEUITickBudget
+	FBEUITickBudget& GetTickBudget() { return TickBudget; }
+
+private:
+	void HandlePlayerControllerSet(UCommonLocalPlayer* LocalPlayer, APlayerController* PlayerController);
+
+	FBEUITickBudget TickBudget;
+};
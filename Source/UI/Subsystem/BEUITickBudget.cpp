@@ -0,0 +1,124 @@
+// Copyright Eigi Chin
+
+#include "BEUITickBudget.h"
+
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Stats/Stats.h"
+
+
+namespace BE::UI
+{
+	float TickBudgetMs = 0.5f;
+	static FAutoConsoleVariableRef CVarTickBudgetMs(TEXT("BE.UI.TickBudgetMs"), TickBudgetMs, TEXT("Time (in ms) budgeted updates of UI widgets may use per frame. At least one due update runs every frame."), ECVF_Default);
+}
+
+
+FBEUITickBudget::~FBEUITickBudget()
+{
+	if (TickHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+	}
+}
+
+FDelegateHandle FBEUITickBudget::Register(FBEUIBudgetedUpdate&& Update, float Interval)
+{
+	const double Now = FPlatformTime::Seconds();
+
+	FEntry& Entry = (bIsTicking ? PendingEntries : Entries).AddDefaulted_GetRef();
+	Entry.Handle = FDelegateHandle(FDelegateHandle::GenerateNewHandle);
+	Entry.Update = MoveTemp(Update);
+	Entry.Interval = FMath::Max(Interval, 0.0f);
+	Entry.LastUpdateTime = Now;
+	Entry.NextUpdateTime = Now;
+
+	if (!TickHandle.IsValid())
+	{
+		TickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FBEUITickBudget::Tick), 0.0f);
+	}
+
+	return Entry.Handle;
+}
+
+void FBEUITickBudget::Unregister(FDelegateHandle& Handle)
+{
+	if (!Handle.IsValid())
+	{
+		return;
+	}
+
+	PendingEntries.RemoveAll([&Handle](const FEntry& Entry) { return Entry.Handle == Handle; });
+
+	if (bIsTicking)
+	{
+		// Removed after the tick, the loop holds indices into Entries
+		if (FEntry* Entry = Entries.FindByPredicate([&Handle](const FEntry& Other) { return Other.Handle == Handle; }))
+		{
+			Entry->Update.Unbind();
+		}
+	}
+	else
+	{
+		Entries.RemoveAll([&Handle](const FEntry& Entry) { return Entry.Handle == Handle; });
+	}
+
+	Handle.Reset();
+}
+
+bool FBEUITickBudget::Tick(float DeltaTime)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_BEUITickBudget_Tick);
+
+	const double StartTime = FPlatformTime::Seconds();
+	const double BudgetSeconds = BE::UI::TickBudgetMs * 0.001;
+
+	// Most overdue first, so updates skipped by the budget are not starved
+
+	TArray<int32, TInlineAllocator<32>> DueIndices;
+	for (int32 Index = 0; Index < Entries.Num(); ++Index)
+	{
+		if (Entries[Index].NextUpdateTime <= StartTime)
+		{
+			DueIndices.Add(Index);
+		}
+	}
+
+	DueIndices.Sort([this](int32 A, int32 B) { return Entries[A].NextUpdateTime < Entries[B].NextUpdateTime; });
+
+	bIsTicking = true;
+
+	for (int32 RunIndex = 0; RunIndex < DueIndices.Num(); ++RunIndex)
+	{
+		const double Now = FPlatformTime::Seconds();
+		if ((RunIndex > 0) && ((Now - StartTime) > BudgetSeconds))
+		{
+			break;
+		}
+
+		FEntry& Entry = Entries[DueIndices[RunIndex]];
+		const float UpdateDeltaTime = static_cast<float>(Now - Entry.LastUpdateTime);
+
+		Entry.LastUpdateTime = Now;
+		Entry.NextUpdateTime = Now + Entry.Interval;
+
+		// Copy, the update may unregister itself
+		FBEUIBudgetedUpdate Update = Entry.Update;
+		Update.ExecuteIfBound(UpdateDeltaTime);
+	}
+
+	bIsTicking = false;
+
+	Entries.RemoveAll([](const FEntry& Entry) { return !Entry.Update.IsBound(); });
+	Entries.Append(MoveTemp(PendingEntries));
+	PendingEntries.Reset();
+
+	if (Entries.IsEmpty())
+	{
+		// Returning false removes the ticker
+		TickHandle.Reset();
+		return false;
+	}
+
+	return true;
+}
@@ -0,0 +1,57 @@
+// Copyright Eigi Chin
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/Ticker.h"
+#include "Delegates/Delegate.h"
+
+/** Called with the time since the previous call of the same update */
+DECLARE_DELEGATE_OneParam(FBEUIBudgetedUpdate, float /*DeltaTime*/);
+
+
+/**
+ * FBEUITickBudget
+ *
+ *	Runs low frequency UI updates (indicators, perf stats, etc.) from a single core ticker instead of one tick per widget.
+ *	At most BE.UI.TickBudgetMs is spent per frame, updates that don't fit run in the next frames, most overdue first.
+ *	The ticker only exists while updates are registered.
+ */
+class BECORE_API FBEUITickBudget
+{
+public:
+	FBEUITickBudget() {}
+	~FBEUITickBudget();
+
+	FBEUITickBudget(const FBEUITickBudget&) = delete;
+	FBEUITickBudget& operator=(const FBEUITickBudget&) = delete;
+
+	// Registers an update to run every Interval seconds (0 runs it every frame, still within the budget)
+	FDelegateHandle Register(FBEUIBudgetedUpdate&& Update, float Interval);
+
+	// Removes an update, safe to call from inside an update
+	void Unregister(FDelegateHandle& Handle);
+
+	int32 GetNumUpdates() const { return Entries.Num() + PendingEntries.Num(); }
+
+private:
+	bool Tick(float DeltaTime);
+
+	struct FEntry
+	{
+		FDelegateHandle Handle;
+		FBEUIBudgetedUpdate Update;
+		float Interval = 0.0f;
+		double LastUpdateTime = 0.0;
+		double NextUpdateTime = 0.0;
+	};
+
+	TArray<FEntry> Entries;
+
+	// Updates registered while ticking, added once the tick is done
+	TArray<FEntry> PendingEntries;
+
+	bool bIsTicking = false;
+
+	FTSTicker::FDelegateHandle TickHandle;
+};